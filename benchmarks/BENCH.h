@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/io/nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// -----------------------------------------------------------------------------------------------
+//      Minimal benchmark harness, in the spirit of unitTest/TEST.h (no external
+//      dependency). One executable per *_bench.cxx file.
+//
+//      BENCH(core, sort, 1'000, 1'000'000) {
+//          auto values = bench::data::values(state.size());   // setup, not timed
+//          state.measure([&] { return df::sort(values); });   // timed
+//      }
+//      RUN_BENCHMARKS()
+//
+//      Options:
+//        --filter=<substring>   only run the benchmarks whose name contains it
+//        --max-size=<n>         skip the scales larger than n
+//        --min-time=<seconds>   minimum measuring time per benchmark (0.5)
+//        --json=<file>          write the results as JSON
+//        --baseline=<file>      compare to a previous JSON output, and exit
+//                               with 1 if a median time regressed by more
+//        --tolerance=<ratio>    than this ratio (0.1, i.e. 10%)
+// -----------------------------------------------------------------------------------------------
+
+namespace bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Prevent the compiler from optimizing away a computed value
+     */
+    template <typename T> inline void keep(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Result {
+        std::string name; // group/name/size
+        size_t size = 0;
+        size_t iterations = 0;
+        double min_ms = 0;
+        double median_ms = 0;
+        double mean_ms = 0;
+        double stddev_ms = 0;
+        double items_per_second = 0;
+    };
+
+    class State {
+    public:
+        State(size_t size, double min_time)
+            : size_(size)
+            , items_(size)
+            , min_time_(min_time)
+        {
+        }
+
+        /**
+         * @brief The scale being measured
+         */
+        size_t size() const { return size_; }
+
+        /**
+         * @brief Number of items processed by one call (default: size()), for
+         * the throughput
+         */
+        void setItems(size_t items) { items_ = items; }
+
+        /**
+         * @brief Time repeated calls of f, after one warm-up call. Runs at
+         * least 3 times and min_time seconds, or a single measured call if it
+         * is slower than 10 min_time. The value returned by f (if any) is
+         * kept, so that the computation cannot be optimized away.
+         */
+        template <typename F> void measure(F&& f)
+        {
+            call(f);
+            times_.clear();
+            double total = 0;
+            while (total < 10 * min_time_ && (times_.size() < 3 || total < min_time_)) {
+                const auto start = Clock::now();
+                call(f);
+                const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                times_.push_back(ms);
+                total += ms / 1000.0;
+            }
+        }
+
+        Result result(const std::string& name) const
+        {
+            Result r;
+            r.name = name;
+            r.size = size_;
+            r.iterations = times_.size();
+            if (times_.empty()) {
+                return r;
+            }
+            std::vector<double> sorted = times_;
+            std::sort(sorted.begin(), sorted.end());
+            const size_t n = sorted.size();
+            r.min_ms = sorted.front();
+            r.median_ms = n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+            double sum = 0, sum2 = 0;
+            for (double t : sorted) {
+                sum += t;
+                sum2 += t * t;
+            }
+            r.mean_ms = sum / n;
+            r.stddev_ms = n > 1 ? std::sqrt(std::max(0.0, (sum2 - sum * sum / n) / (n - 1))) : 0.0;
+            r.items_per_second = r.median_ms > 0 ? items_ / (r.median_ms / 1000.0) : 0.0;
+            return r;
+        }
+
+    private:
+        template <typename F> void call(F& f)
+        {
+            if constexpr (std::is_void_v<decltype(f())>) {
+                f();
+            } else {
+                auto value = f();
+                keep(value);
+            }
+        }
+
+        size_t size_;
+        size_t items_;
+        double min_time_;
+        std::vector<double> times_;
+    };
+
+    using BenchFunction = std::function<void(State&)>;
+
+    struct BenchInfo {
+        const char* group;
+        const char* name;
+        std::vector<size_t> sizes;
+        BenchFunction fn;
+    };
+
+    inline std::vector<BenchInfo> benchmarks;
+
+    inline void register_benchmark(
+        const char* group, const char* name, std::vector<size_t> sizes, BenchFunction fn)
+    {
+        benchmarks.emplace_back(BenchInfo { group, name, std::move(sizes), fn });
+    }
+
+    // ------------------------------------------------------------------
+
+    namespace detail {
+
+        inline std::string option(int argc, char** argv, const std::string& key, const std::string& def)
+        {
+            const std::string prefix = "--" + key + "=";
+            for (int i = 1; i < argc; ++i) {
+                if (std::strncmp(argv[i], prefix.c_str(), prefix.size()) == 0) {
+                    return argv[i] + prefix.size();
+                }
+            }
+            return def;
+        }
+
+        inline std::string utc_now()
+        {
+            const std::time_t now = std::time(nullptr);
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+            return buffer;
+        }
+
+        inline nlohmann::json to_json(const std::vector<Result>& results)
+        {
+            nlohmann::json context;
+            context["date"] = utc_now();
+            context["threads"] = std::thread::hardware_concurrency();
+#if defined(__VERSION__)
+            context["compiler"] = __VERSION__;
+#endif
+#ifdef NDEBUG
+            context["build_type"] = "release";
+#else
+            context["build_type"] = "debug";
+#endif
+            nlohmann::json list = nlohmann::json::array();
+            for (const auto& r : results) {
+                list.push_back({ { "name", r.name }, { "size", r.size }, { "iterations", r.iterations },
+                    { "min_ms", r.min_ms }, { "median_ms", r.median_ms }, { "mean_ms", r.mean_ms },
+                    { "stddev_ms", r.stddev_ms }, { "items_per_second", r.items_per_second } });
+            }
+            return { { "context", context }, { "benchmarks", list } };
+        }
+
+        /**
+         * @brief Compare with a baseline JSON file. Returns the number of
+         * regressions (median time above (1 + tolerance) times the baseline).
+         */
+        inline size_t compare(const std::vector<Result>& results, const std::string& filename, double tolerance)
+        {
+            std::ifstream file(filename);
+            if (!file) {
+                throw std::runtime_error("Cannot open baseline file " + filename);
+            }
+            const auto baseline = nlohmann::json::parse(file);
+            std::map<std::string, double> previous;
+            for (const auto& b : baseline.at("benchmarks")) {
+                previous[b.at("name").get<std::string>()] = b.at("median_ms").get<double>();
+            }
+
+            size_t regressions = 0;
+            std::cout << "\nComparison with " << filename << " (tolerance " << tolerance * 100 << "%)\n";
+            for (const auto& r : results) {
+                auto it = previous.find(r.name);
+                if (it == previous.end() || it->second <= 0) {
+                    continue;
+                }
+                const double ratio = r.median_ms / it->second;
+                const bool regressed = ratio > 1 + tolerance;
+                regressions += regressed ? 1 : 0;
+                std::cout << (regressed ? "  REGRESSION " : "             ") << std::left << std::setw(40)
+                          << r.name << std::right << std::setprecision(4) << std::setw(12)
+                          << it->second << " ms -> " << std::setw(12) << r.median_ms << " ms  (x"
+                          << std::setprecision(2) << ratio << ")\n";
+            }
+            return regressions;
+        }
+
+    } // namespace detail
+
+    inline int run(int argc, char** argv)
+    {
+        const std::string filter = detail::option(argc, argv, "filter", "");
+        const size_t max_size = std::stoull(detail::option(argc, argv, "max-size", "18446744073709551615"));
+        const double min_time = std::stod(detail::option(argc, argv, "min-time", "0.5"));
+        const std::string json = detail::option(argc, argv, "json", "");
+        const std::string baseline = detail::option(argc, argv, "baseline", "");
+        const double tolerance = std::stod(detail::option(argc, argv, "tolerance", "0.1"));
+
+        std::vector<Result> results;
+        std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(8) << "iters"
+                  << std::setw(14) << "median (ms)" << std::setw(14) << "min (ms)" << std::setw(16)
+                  << "items/s" << "\n";
+        for (const auto& b : benchmarks) {
+            for (size_t size : b.sizes) {
+                const std::string name = std::string(b.group) + "/" + b.name + "/" + std::to_string(size);
+                if (size > max_size || name.find(filter) == std::string::npos) {
+                    continue;
+                }
+                State state(size, min_time);
+                b.fn(state);
+                auto r = state.result(name);
+                std::cout << std::left << std::setw(40) << r.name << std::right << std::setw(8)
+                          << r.iterations << std::fixed << std::setprecision(3) << std::setw(14)
+                          << r.median_ms << std::setw(14) << r.min_ms << std::scientific
+                          << std::setprecision(3) << std::setw(16) << r.items_per_second
+                          << std::defaultfloat << std::endl;
+                results.push_back(r);
+            }
+        }
+
+        if (!json.empty()) {
+            std::ofstream(json) << detail::to_json(results).dump(2) << "\n";
+        }
+        if (!baseline.empty()) {
+            return detail::compare(results, baseline, tolerance) == 0 ? 0 : 1;
+        }
+        return 0;
+    }
+
+} // namespace bench
+
+#define BENCH(group, name, ...)                                                                    \
+    void bench_##group##_##name(bench::State&);                                                    \
+    static struct bench_register_##group##_##name {                                                \
+        bench_register_##group##_##name()                                                          \
+        {                                                                                          \
+            bench::register_benchmark(#group, #name, { __VA_ARGS__ }, bench_##group##_##name);     \
+        }                                                                                          \
+    } bench_register_##group##_##name##_instance;                                                  \
+    void bench_##group##_##name(bench::State& state)
+
+#define RUN_BENCHMARKS()                                                                           \
+    int main(int argc, char** argv) { return bench::run(argc, argv); }
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "BENCH.h"
+#include "data.h"
+#include <dataframe/algebra/eigen.h>
+#include <dataframe/algebra/inv.h>
+
+BENCH(algebra, eigen_values_3x3, 1'000, 100'000, 1'000'000)
+{
+    auto matrices = bench::data::symmetric_matrices(state.size());
+    state.measure([&] { return df::eigenValues(matrices); });
+}
+
+BENCH(algebra, eigen_system_3x3, 1'000, 100'000, 1'000'000)
+{
+    auto matrices = bench::data::symmetric_matrices(state.size());
+    state.measure([&] { return df::eigenSystem(matrices); });
+}
+
+BENCH(algebra, inv_3x3, 1'000, 100'000, 1'000'000)
+{
+    auto matrices = bench::data::matrices(state.size());
+    state.measure([&] { return df::inv(matrices); });
+}
+
+RUN_BENCHMARKS()
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "BENCH.h"
+#include "data.h"
+#include <dataframe/Mask.h>
+#include <dataframe/core/filter.h>
+#include <dataframe/core/groupBy.h>
+#include <dataframe/core/map.h>
+#include <dataframe/core/memoize.h>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/core/sort.h>
+#include <dataframe/core/task_graph.h>
+#include <dataframe/core/whenAll.h>
+
+BENCH(core, map, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    state.measure([&] { return df::map([](double v, size_t) { return std::sqrt(v) * 2.0 + 1.0; }, values); });
+}
+
+BENCH(core, parallel_map, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    state.measure(
+        [&] { return df::parallel_map([](double v, size_t) { return std::sqrt(v) * 2.0 + 1.0; }, values); });
+}
+
+BENCH(core, filter, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    state.measure([&] { return df::filter([](double v, size_t) { return v < 0.5; }, values); });
+}
+
+BENCH(core, filter_par, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    state.measure([&] {
+        return df::filter([](double v, size_t) { return v < 0.5; }, values, df::ExecutionPolicy::PAR);
+    });
+}
+
+BENCH(core, mask_compare, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    state.measure([&] { return (values < 0.5).count(); });
+}
+
+BENCH(core, mask_filter, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    auto mask = (values < 0.5) & (values > 0.1);
+    state.measure([&] { return df::filter(mask, values); });
+}
+
+BENCH(core, filter_rows, 1'000, 100'000, 1'000'000)
+{
+    df::Dataframe frame;
+    frame.add("x", bench::data::values(state.size(), 1));
+    frame.add("y", bench::data::values(state.size(), 2));
+    frame.add("z", bench::data::values(state.size(), 3));
+    frame.add("id", bench::data::keys(state.size(), 1000));
+    frame.add("n", bench::data::points3(state.size()));
+    const auto& x = frame.get<double>("x");
+    const auto& y = frame.get<double>("y");
+    auto inside = (x >= 0.25) & (x <= 0.75) & (y >= 0.25) & (y <= 0.75);
+    state.measure([&] { return frame.filter_rows(inside).size(); });
+}
+
+BENCH(core, sort, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    state.measure([&] { return df::sort(values); });
+}
+
+BENCH(core, sort_strings, 1'000, 100'000, 1'000'000)
+{
+    auto words = bench::data::words(state.size(), state.size());
+    state.measure([&] { return df::sort(words); });
+}
+
+BENCH(core, sort_string_arena, 1'000, 100'000, 1'000'000)
+{
+    df::StringSerie words(bench::data::words(state.size(), state.size()));
+    state.measure([&] { return df::sort(words); });
+}
+
+BENCH(core, groupBy_agg, 1'000, 100'000, 10'000'000)
+{
+    auto keys = bench::data::keys(state.size(), 1000);
+    auto values = bench::data::values(state.size());
+    state.measure([&] {
+        return df::groupBy(keys).agg(values, df::agg::count(), df::agg::mean(), df::agg::max());
+    });
+}
+
+BENCH(core, groupBy_strings, 1'000, 100'000, 1'000'000)
+{
+    auto keys = bench::data::words(state.size(), 200);
+    auto values = bench::data::values(state.size());
+    state.measure([&] { return df::groupBy(keys).agg(values, df::agg::mean()); });
+}
+
+BENCH(core, groupBy_categorical, 1'000, 100'000, 1'000'000)
+{
+    df::CategoricalSerie keys(bench::data::words(state.size(), 200));
+    auto values = bench::data::values(state.size());
+    state.measure([&] { return df::groupBy(keys).agg(values, df::agg::mean()); });
+}
+
+// Cost of a cache hit: keyed by version (sampled check) vs by content, which
+// hashes the whole input as memoize() used to
+BENCH(core, memoize_hit, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    auto sum = df::memoize([](const df::Serie<double>& s) {
+        return s.reduce([](double acc, double v) { return acc + v; }, 0.0);
+    });
+    sum(values);
+    state.measure([&] { return *sum(values); });
+}
+
+BENCH(core, memoize_hit_content, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    df::MemoizeOptions options;
+    options.verify = df::Verify::Content;
+    auto sum = df::memoize([](const df::Serie<double>& s) {
+        return s.reduce([](double acc, double v) { return acc + v; }, 0.0);
+    }, options);
+    sum(values);
+    state.measure([&] { return *sum(values); });
+}
+
+BENCH(core, whenAll, 1'000, 100'000, 1'000'000)
+{
+    std::vector<df::Serie<double>> series(8, bench::data::values(state.size()));
+    state.measure([&] {
+        return df::whenAll(
+            [](const df::Serie<double>& s) { return s.map([](double v) { return std::sqrt(v); }); },
+            series);
+    });
+}
+
+// Two independent branches (sort, mean) over a shared input, then a join
+// stage, scheduled on the shared pool
+BENCH(core, task_graph, 1'000, 100'000, 1'000'000)
+{
+    auto values = std::make_shared<const df::Serie<double>>(bench::data::values(state.size()));
+    state.measure([&] {
+        df::TaskGraph graph;
+        auto in = graph.input("values", values);
+        auto sorted = graph.add("sort", [](const df::Serie<double>& s) { return df::sort(s); }, in);
+        auto mean = graph.add("mean",
+            [](const df::Serie<double>& s) {
+                return s.reduce([](double acc, double v) { return acc + v; }, 0.0) / s.size();
+            },
+            in);
+        auto median = graph.add("median",
+            [](const df::Serie<double>& s, double m) { return s[s.size() / 2] - m; }, sorted, mean);
+        graph.run();
+        return *median.get();
+    });
+}
+
+RUN_BENCHMARKS()
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/Dataframe.h>
+#include <dataframe/Serie.h>
+#include <dataframe/algebra/types.h>
+#include <dataframe/geo/gen_sphere.h>
+#include <dataframe/geo/grid/grid2d.h>
+#include <dataframe/utils/flat_hash.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------------------------------------------------
+//      Deterministic synthetic datasets for the benchmarks.
+//
+//      Values are derived from (seed, index) with the splitmix64 mixer, and not
+//      from <random> distributions whose output differs between standard
+//      libraries: a dataset is the same on every platform and compiler, so that
+//      timings can be compared between versions and machines.
+// -----------------------------------------------------------------------------------------------
+
+namespace bench {
+    namespace data {
+
+        /**
+         * @brief Uniform double in [0, 1), the i-th of the sequence `seed`
+         */
+        inline double uniform(uint64_t seed, uint64_t i)
+        {
+            return static_cast<double>(df::hash_mix(df::hash_mix(seed) ^ i) >> 11) * 0x1.0p-53;
+        }
+
+        inline double uniform(uint64_t seed, uint64_t i, double lo, double hi)
+        {
+            return lo + (hi - lo) * uniform(seed, i);
+        }
+
+        // Smooth field used for the values attached to points and grids
+        inline double field(double x, double y) { return std::sin(3 * x) * std::cos(2 * y) + 0.5 * x * y; }
+
+        /**
+         * @brief n uniform values in [lo, hi)
+         */
+        inline df::Serie<double> values(size_t n, uint64_t seed = 1, double lo = 0, double hi = 1)
+        {
+            std::vector<double> v(n);
+            for (size_t i = 0; i < n; ++i) {
+                v[i] = uniform(seed, i, lo, hi);
+            }
+            return df::Serie<double>(std::move(v));
+        }
+
+        /**
+         * @brief n integer keys in [0, groups)
+         */
+        inline df::Serie<int> keys(size_t n, size_t groups, uint64_t seed = 2)
+        {
+            std::vector<int> v(n);
+            for (size_t i = 0; i < n; ++i) {
+                v[i] = static_cast<int>(df::hash_mix(seed * 0x100000001b3ULL + i) % groups);
+            }
+            return df::Serie<int>(std::move(v));
+        }
+
+        /**
+         * @brief n strings drawn among `distinct` different words
+         */
+        inline df::Serie<std::string> words(size_t n, size_t distinct, uint64_t seed = 3)
+        {
+            std::vector<std::string> v(n);
+            for (size_t i = 0; i < n; ++i) {
+                v[i] = "word_" + std::to_string(df::hash_mix(seed * 0x100000001b3ULL + i) % distinct);
+            }
+            return df::Serie<std::string>(std::move(v));
+        }
+
+        /**
+         * @brief Point cloud, uniform in the unit square
+         */
+        inline df::Serie<Vector2> points2(size_t n, uint64_t seed = 4)
+        {
+            std::vector<Vector2> v(n);
+            for (size_t i = 0; i < n; ++i) {
+                v[i] = Vector2 { uniform(seed, 2 * i), uniform(seed, 2 * i + 1) };
+            }
+            return df::Serie<Vector2>(std::move(v));
+        }
+
+        /**
+         * @brief Point cloud, uniform in the unit cube
+         */
+        inline df::Serie<Vector3> points3(size_t n, uint64_t seed = 5)
+        {
+            std::vector<Vector3> v(n);
+            for (size_t i = 0; i < n; ++i) {
+                v[i] = Vector3 { uniform(seed, 3 * i), uniform(seed, 3 * i + 1), uniform(seed, 3 * i + 2) };
+            }
+            return df::Serie<Vector3>(std::move(v));
+        }
+
+        /**
+         * @brief field() sampled at the points
+         */
+        template <typename P> df::Serie<double> sampled(const df::Serie<P>& points)
+        {
+            return points.map([](const P& p, size_t) { return field(p[0], p[1]); });
+        }
+
+        /**
+         * @brief n x n grid on [-1, 1]^2 with the attribute "f" = field(x, y)
+         */
+        inline df::grid::Grid2D grid2(uint n)
+        {
+            df::grid::Grid2D grid { { -1.0, -1.0 }, { 2.0 / (n - 1), 2.0 / (n - 1) }, { n, n } };
+            std::vector<double> f(grid.total_points());
+            for (uint j = 0; j < n; ++j) {
+                for (uint i = 0; i < n; ++i) {
+                    auto p = grid.point_at(i, j);
+                    f[grid.linear_index(i, j)] = field(p[0], p[1]);
+                }
+            }
+            grid.attributes.add("f", df::Serie<double>(std::move(f)));
+            return grid;
+        }
+
+        /**
+         * @brief Triangulated unit sphere with about n vertices
+         */
+        inline std::tuple<df::Positions3, df::Triangles> sphere(size_t n)
+        {
+            const size_t lon = std::max<size_t>(8, static_cast<size_t>(std::sqrt(2.0 * n)));
+            return df::generateSphere(1.0, lon, lon / 2);
+        }
+
+        /**
+         * @brief n symmetric 3x3 matrices
+         */
+        inline df::Serie<df::SMatrix3D> symmetric_matrices(size_t n, uint64_t seed = 6)
+        {
+            std::vector<df::SMatrix3D> v(n);
+            for (size_t i = 0; i < n; ++i) {
+                v[i] = df::SMatrix3D { uniform(seed, 6 * i, 1, 2), uniform(seed, 6 * i + 1, -.5, .5),
+                    uniform(seed, 6 * i + 2, -.5, .5), uniform(seed, 6 * i + 3, 1, 2),
+                    uniform(seed, 6 * i + 4, -.5, .5), uniform(seed, 6 * i + 5, 1, 2) };
+            }
+            return df::Serie<df::SMatrix3D>(std::move(v));
+        }
+
+        /**
+         * @brief n full 3x3 matrices (row major), diagonally dominant
+         */
+        inline df::Serie<std::array<double, 9>> matrices(size_t n, uint64_t seed = 7)
+        {
+            std::vector<std::array<double, 9>> v(n);
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t k = 0; k < 9; ++k) {
+                    v[i][k] = uniform(seed, 9 * i + k, -1, 1) + (k % 4 == 0 ? 4.0 : 0.0);
+                }
+            }
+            return df::Serie<std::array<double, 9>>(std::move(v));
+        }
+
+        /**
+         * @brief Table with n rows: "id" (int64_t), "x", "y" (double) and "name"
+         * (string), the column types supported by all the readers and writers
+         */
+        inline df::Dataframe table(size_t n, uint64_t seed = 8)
+        {
+            std::vector<int64_t> id(n);
+            for (size_t i = 0; i < n; ++i) {
+                id[i] = static_cast<int64_t>(i);
+            }
+            df::Dataframe table;
+            table.add("id", df::Serie<int64_t>(std::move(id)));
+            table.add("x", values(n, seed, -100, 100));
+            table.add("y", values(n, seed + 1, 0, 1));
+            table.add("name", words(n, 1000, seed + 2));
+            return table;
+        }
+
+        /**
+         * @brief Regression dataset: `features` double columns "f0".."fk" and
+         * a noisy target "target" depending on the first ones
+         */
+        inline df::Dataframe regression(size_t n, size_t features = 8, uint64_t seed = 9)
+        {
+            df::Dataframe table;
+            std::vector<double> target(n, 0.0);
+            for (size_t f = 0; f < features; ++f) {
+                auto column = values(n, seed + f, -1, 1);
+                for (size_t i = 0; i < n; ++i) {
+                    target[i] += (f < 3 ? (f + 1.0) : 0.1) * column[i];
+                }
+                table.add("f" + std::to_string(f), column);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                target[i] += 0.05 * uniform(seed + 100, i, -1, 1);
+            }
+            table.add("target", df::Serie<double>(std::move(target)));
+            return table;
+        }
+
+    } // namespace data
+} // namespace bench
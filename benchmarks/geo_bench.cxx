@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "BENCH.h"
+#include "data.h"
+#include <dataframe/geo/curvature.h>
+#include <dataframe/geo/grid/contours.h>
+#include <dataframe/geo/interpolation/idw.h>
+#include <dataframe/geo/interpolation/natural_neighbor.h>
+#include <dataframe/geo/interpolation/rbf.h>
+#include <dataframe/geo/mesh/operators.h>
+#include <dataframe/geo/utils/kdtree.h>
+
+BENCH(geo, kdtree_build, 1'000, 100'000, 1'000'000)
+{
+    auto points = bench::data::points2(state.size());
+    auto values = bench::data::sampled(points);
+    state.measure([&] {
+        df::KDTree<double, 2> tree(values, points);
+        return tree.findNearest(Vector2 { 0.5, 0.5 });
+    });
+}
+
+BENCH(geo, kdtree_knn, 1'000, 100'000)
+{
+    auto points = bench::data::points2(100'000);
+    auto values = bench::data::sampled(points);
+    df::KDTree<double, 2> tree(values, points);
+    auto queries = bench::data::points2(state.size(), 40);
+    state.measure([&] { return tree.findNearest(queries, 8).size(); });
+}
+
+// Scale: number of targets, for 1000 scattered data points
+BENCH(geo, idw, 1'000, 10'000)
+{
+    auto points = bench::data::points2(1'000);
+    auto values = bench::data::sampled(points);
+    auto targets = bench::data::points2(state.size(), 41);
+    state.measure([&] { return df::idw(points, values, targets); });
+}
+
+// Scale: number of data points (dense solve), for 1000 targets
+BENCH(geo, rbf, 100, 1'000)
+{
+    auto points = bench::data::points2(state.size());
+    auto values = bench::data::sampled(points);
+    auto targets = bench::data::points2(1'000, 42);
+    state.measure([&] { return df::rbf_2d(points, values, targets); });
+}
+
+// Scale: number of targets, for 100k scattered data points
+BENCH(geo, natural_neighbor, 1'000, 100'000, 1'000'000)
+{
+    auto points = bench::data::points2(100'000);
+    auto values = bench::data::sampled(points);
+    df::NaturalNeighborInterpolator<double> nn(points, values);
+    auto targets = bench::data::points2(state.size(), 43);
+    state.measure([&] { return nn.interpolate(targets); });
+}
+
+// Scale: number of grid nodes
+BENCH(geo, contours, 10'000, 1'000'000, 16'000'000)
+{
+    auto grid = bench::data::grid2(static_cast<uint>(std::sqrt(double(state.size()))));
+    const std::vector<double> levels { -0.5, -0.25, 0.0, 0.25, 0.5 };
+    state.measure([&] { return df::contours(grid, "f", levels); });
+}
+
+// Scale: number of vertices
+BENCH(geo, curvature, 10'000, 1'000'000)
+{
+    auto [vertices, triangles] = bench::data::sphere(state.size());
+    state.setItems(vertices.size());
+    state.measure([&] { return df::MeshOperators<3>(vertices, triangles).meanCurvature(); });
+}
+
+RUN_BENCHMARKS()
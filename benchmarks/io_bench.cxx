@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "BENCH.h"
+#include "data.h"
+#include <dataframe/io/binary_serialization.h>
+#include <dataframe/io/csv.h>
+#include <dataframe/io/json.h>
+#include <filesystem>
+#include <sstream>
+
+// The readers take a file name: round trips go through the temporary directory
+namespace {
+    std::string temp_file(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("dataframe_bench_" + name)).string();
+    }
+} // namespace
+
+BENCH(io, write_csv, 1'000, 100'000, 1'000'000)
+{
+    auto table = bench::data::table(state.size());
+    state.measure([&] {
+        std::ostringstream os;
+        df::io::write_csv(table, os);
+        return os.str().size();
+    });
+}
+
+BENCH(io, read_csv, 1'000, 100'000, 1'000'000)
+{
+    const auto file = temp_file("read.csv");
+    df::io::write_csv(bench::data::table(state.size()), file);
+    state.measure([&] { return df::io::read_csv(file); });
+    std::filesystem::remove(file);
+}
+
+BENCH(io, read_csv_string_arena, 1'000, 100'000, 1'000'000)
+{
+    const auto file = temp_file("read_arena.csv");
+    df::io::write_csv(bench::data::table(state.size()), file);
+    df::io::CSVOptions options;
+    options.string_arena = true;
+    state.measure([&] { return df::io::read_csv(file, options); });
+    std::filesystem::remove(file);
+}
+
+BENCH(io, write_json, 1'000, 100'000)
+{
+    auto table = bench::data::table(state.size());
+    state.measure([&] {
+        std::ostringstream os;
+        df::io::write_json(table, os, false);
+        return os.str().size();
+    });
+}
+
+BENCH(io, read_json, 1'000, 100'000)
+{
+    const auto file = temp_file("read.json");
+    df::io::write_json(bench::data::table(state.size()), file, false);
+    state.measure([&] { return df::io::read_json(file); });
+    std::filesystem::remove(file);
+}
+
+BENCH(io, binary_round_trip, 1'000, 100'000, 10'000'000)
+{
+    auto values = bench::data::values(state.size());
+    state.measure([&] {
+        std::stringstream ss;
+        df::io::save(values, ss);
+        return df::io::load<double>(ss);
+    });
+}
+
+RUN_BENCHMARKS()
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "BENCH.h"
+#include "data.h"
+#include <dataframe/ml/genetic_algorithm.h>
+#include <dataframe/ml/random_forest.h>
+
+// Scale: number of training rows, 8 features, 10 trees of depth <= 12
+BENCH(ml, random_forest_fit, 500, 2'000)
+{
+    auto table = bench::data::regression(state.size());
+    state.measure([&] {
+        auto rf = ml::create_random_forest_regressor(10, 3, 12);
+        rf.fit(table, "target");
+        return rf.predict(table);
+    });
+}
+
+// Scale: population size, 10 parameters (Rastrigin), 50 generations
+BENCH(ml, genetic_algorithm, 50, 500)
+{
+    const size_t dims = 10;
+    df::Serie<double> lower(std::vector<double>(dims, -5.12));
+    df::Serie<double> upper(std::vector<double>(dims, 5.12));
+    auto rastrigin = [](const df::Serie<double>& x) {
+        double sum = 10.0 * x.size();
+        for (double v : x) {
+            sum += v * v - 10.0 * std::cos(2 * M_PI * v);
+        }
+        return sum;
+    };
+    state.setItems(state.size() * 50);
+    state.measure([&] {
+        ml::GeneticAlgorithm ga(state.size(), 0.8, 0.1, 2, 50);
+        return ga.optimize<double>(rastrigin, lower, upper, true).second;
+    });
+}
+
+RUN_BENCHMARKS()
@@ -54,7 +54,7 @@ int main() {
     // Access decomposed attributes
     auto posX = manager.getSerie<double>("Px");
     auto stressXX = manager.getSerie<double>("Sxx");
-    auto tXX = manager.getSerie<double>("Txx");
+    auto t11 = manager.getSerie<double>("T11");
 
     return 0;
 }
@@ -0,0 +1,425 @@
+GOCAD TSurf 1
+HEADER {
+name:mesh
+}
+PROPERTIES FRIC
+ESIZES 1
+TFACE
+PVRTX 0 0 0 1 0
+PVRTX 1 0.156434 0 0.987688 0
+PVRTX 2 0.144527 0.0598649 0.987688 0
+PVRTX 3 0.110616 0.110616 0.987688 0
+PVRTX 4 0.0598649 0.144527 0.987688 0
+PVRTX 5 9.57885e-18 0.156434 0.987688 0
+PVRTX 6 -0.0598649 0.144527 0.987688 0
+PVRTX 7 -0.110616 0.110616 0.987688 0
+PVRTX 8 -0.144527 0.0598649 0.987688 0
+PVRTX 9 -0.156434 1.91577e-17 0.987688 0
+PVRTX 10 -0.144527 -0.0598649 0.987688 0
+PVRTX 11 -0.110616 -0.110616 0.987688 0
+PVRTX 12 -0.0598649 -0.144527 0.987688 0
+PVRTX 13 -2.87365e-17 -0.156434 0.987688 0
+PVRTX 14 0.0598649 -0.144527 0.987688 0
+PVRTX 15 0.110616 -0.110616 0.987688 0
+PVRTX 16 0.144527 -0.0598649 0.987688 0
+PVRTX 17 0.309017 0 0.951057 0
+PVRTX 18 0.285494 0.118256 0.951057 0
+PVRTX 19 0.218508 0.218508 0.951057 0
+PVRTX 20 0.118256 0.285494 0.951057 0
+PVRTX 21 1.89218e-17 0.309017 0.951057 0
+PVRTX 22 -0.118256 0.285494 0.951057 0
+PVRTX 23 -0.218508 0.218508 0.951057 0
+PVRTX 24 -0.285494 0.118256 0.951057 0
+PVRTX 25 -0.309017 3.78437e-17 0.951057 0
+PVRTX 26 -0.285494 -0.118256 0.951057 0
+PVRTX 27 -0.218508 -0.218508 0.951057 0
+PVRTX 28 -0.118256 -0.285494 0.951057 0
+PVRTX 29 -5.67655e-17 -0.309017 0.951057 0
+PVRTX 30 0.118256 -0.285494 0.951057 0
+PVRTX 31 0.218508 -0.218508 0.951057 0
+PVRTX 32 0.285494 -0.118256 0.951057 0
+PVRTX 33 0.45399 0 0.891007 0
+PVRTX 34 0.419433 0.173735 0.891007 0
+PVRTX 35 0.32102 0.32102 0.891007 0
+PVRTX 36 0.173735 0.419433 0.891007 0
+PVRTX 37 2.77989e-17 0.45399 0.891007 0
+PVRTX 38 -0.173735 0.419433 0.891007 0
+PVRTX 39 -0.32102 0.32102 0.891007 0
+PVRTX 40 -0.419433 0.173735 0.891007 0
+PVRTX 41 -0.45399 5.55978e-17 0.891007 0
+PVRTX 42 -0.419433 -0.173735 0.891007 0
+PVRTX 43 -0.32102 -0.32102 0.891007 0
+PVRTX 44 -0.173735 -0.419433 0.891007 0
+PVRTX 45 -8.33967e-17 -0.45399 0.891007 0
+PVRTX 46 0.173735 -0.419433 0.891007 0
+PVRTX 47 0.32102 -0.32102 0.891007 0
+PVRTX 48 0.419433 -0.173735 0.891007 0
+PVRTX 49 0.587785 0 0.809017 0
+PVRTX 50 0.543043 0.224936 0.809017 0
+PVRTX 51 0.415627 0.415627 0.809017 0
+PVRTX 52 0.224936 0.543043 0.809017 0
+PVRTX 53 3.59915e-17 0.587785 0.809017 0
+PVRTX 54 -0.224936 0.543043 0.809017 0
+PVRTX 55 -0.415627 0.415627 0.809017 0
+PVRTX 56 -0.543043 0.224936 0.809017 0
+PVRTX 57 -0.587785 7.19829e-17 0.809017 0
+PVRTX 58 -0.543043 -0.224936 0.809017 0
+PVRTX 59 -0.415627 -0.415627 0.809017 0
+PVRTX 60 -0.224936 -0.543043 0.809017 0
+PVRTX 61 -1.07974e-16 -0.587785 0.809017 0
+PVRTX 62 0.224936 -0.543043 0.809017 0
+PVRTX 63 0.415627 -0.415627 0.809017 0
+PVRTX 64 0.543043 -0.224936 0.809017 0
+PVRTX 65 0.707107 0 0.707107 0
+PVRTX 66 0.653281 0.270598 0.707107 0
+PVRTX 67 0.5 0.5 0.707107 0
+PVRTX 68 0.270598 0.653281 0.707107 0
+PVRTX 69 4.32978e-17 0.707107 0.707107 0
+PVRTX 70 -0.270598 0.653281 0.707107 0
+PVRTX 71 -0.5 0.5 0.707107 0
+PVRTX 72 -0.653281 0.270598 0.707107 0
+PVRTX 73 -0.707107 8.65956e-17 0.707107 0
+PVRTX 74 -0.653281 -0.270598 0.707107 0
+PVRTX 75 -0.5 -0.5 0.707107 0
+PVRTX 76 -0.270598 -0.653281 0.707107 0
+PVRTX 77 -1.29893e-16 -0.707107 0.707107 0
+PVRTX 78 0.270598 -0.653281 0.707107 0
+PVRTX 79 0.5 -0.5 0.707107 0
+PVRTX 80 0.653281 -0.270598 0.707107 0
+PVRTX 81 0.809017 0 0.587785 0
+PVRTX 82 0.747434 0.309597 0.587785 0
+PVRTX 83 0.572061 0.572061 0.587785 0
+PVRTX 84 0.309597 0.747434 0.587785 0
+PVRTX 85 4.9538e-17 0.809017 0.587785 0
+PVRTX 86 -0.309597 0.747434 0.587785 0
+PVRTX 87 -0.572061 0.572061 0.587785 0
+PVRTX 88 -0.747434 0.309597 0.587785 0
+PVRTX 89 -0.809017 9.9076e-17 0.587785 0
+PVRTX 90 -0.747434 -0.309597 0.587785 0
+PVRTX 91 -0.572061 -0.572061 0.587785 0
+PVRTX 92 -0.309597 -0.747434 0.587785 0
+PVRTX 93 -1.48614e-16 -0.809017 0.587785 0
+PVRTX 94 0.309597 -0.747434 0.587785 0
+PVRTX 95 0.572061 -0.572061 0.587785 0
+PVRTX 96 0.747434 -0.309597 0.587785 0
+PVRTX 97 0.891007 0 0.45399 0
+PVRTX 98 0.823183 0.340973 0.45399 0
+PVRTX 99 0.630037 0.630037 0.45399 0
+PVRTX 100 0.340973 0.823183 0.45399 0
+PVRTX 101 5.45584e-17 0.891007 0.45399 0
+PVRTX 102 -0.340973 0.823183 0.45399 0
+PVRTX 103 -0.630037 0.630037 0.45399 0
+PVRTX 104 -0.823183 0.340973 0.45399 0
+PVRTX 105 -0.891007 1.09117e-16 0.45399 0
+PVRTX 106 -0.823183 -0.340973 0.45399 0
+PVRTX 107 -0.630037 -0.630037 0.45399 0
+PVRTX 108 -0.340973 -0.823183 0.45399 0
+PVRTX 109 -1.63675e-16 -0.891007 0.45399 0
+PVRTX 110 0.340973 -0.823183 0.45399 0
+PVRTX 111 0.630037 -0.630037 0.45399 0
+PVRTX 112 0.823183 -0.340973 0.45399 0
+PVRTX 113 0.951057 0 0.309017 0
+PVRTX 114 0.878662 0.363954 0.309017 0
+PVRTX 115 0.672499 0.672499 0.309017 0
+PVRTX 116 0.363954 0.878662 0.309017 0
+PVRTX 117 5.82354e-17 0.951057 0.309017 0
+PVRTX 118 -0.363954 0.878662 0.309017 0
+PVRTX 119 -0.672499 0.672499 0.309017 0
+PVRTX 120 -0.878662 0.363954 0.309017 0
+PVRTX 121 -0.951057 1.16471e-16 0.309017 0
+PVRTX 122 -0.878662 -0.363954 0.309017 0
+PVRTX 123 -0.672499 -0.672499 0.309017 0
+PVRTX 124 -0.363954 -0.878662 0.309017 0
+PVRTX 125 -1.74706e-16 -0.951057 0.309017 0
+PVRTX 126 0.363954 -0.878662 0.309017 0
+PVRTX 127 0.672499 -0.672499 0.309017 0
+PVRTX 128 0.878662 -0.363954 0.309017 0
+PVRTX 129 0.987688 0 0.156434 0
+PVRTX 130 0.912505 0.377972 0.156434 0
+PVRTX 131 0.698401 0.698401 0.156434 0
+PVRTX 132 0.377972 0.912505 0.156434 0
+PVRTX 133 6.04785e-17 0.987688 0.156434 0
+PVRTX 134 -0.377972 0.912505 0.156434 0
+PVRTX 135 -0.698401 0.698401 0.156434 0
+PVRTX 136 -0.912505 0.377972 0.156434 0
+PVRTX 137 -0.987688 1.20957e-16 0.156434 0
+PVRTX 138 -0.912505 -0.377972 0.156434 0
+PVRTX 139 -0.698401 -0.698401 0.156434 0
+PVRTX 140 -0.377972 -0.912505 0.156434 0
+PVRTX 141 -1.81435e-16 -0.987688 0.156434 0
+PVRTX 142 0.377972 -0.912505 0.156434 0
+PVRTX 143 0.698401 -0.698401 0.156434 0
+PVRTX 144 0.912505 -0.377972 0.156434 0
+TRGL 0 1 2
+TRGL 0 2 3
+TRGL 0 3 4
+TRGL 0 4 5
+TRGL 0 5 6
+TRGL 0 6 7
+TRGL 0 7 8
+TRGL 0 8 9
+TRGL 0 9 10
+TRGL 0 10 11
+TRGL 0 11 12
+TRGL 0 12 13
+TRGL 0 13 14
+TRGL 0 14 15
+TRGL 0 15 16
+TRGL 0 16 1
+TRGL 1 17 2
+TRGL 2 17 18
+TRGL 2 18 3
+TRGL 3 18 19
+TRGL 3 19 4
+TRGL 4 19 20
+TRGL 4 20 5
+TRGL 5 20 21
+TRGL 5 21 6
+TRGL 6 21 22
+TRGL 6 22 7
+TRGL 7 22 23
+TRGL 7 23 8
+TRGL 8 23 24
+TRGL 8 24 9
+TRGL 9 24 25
+TRGL 9 25 10
+TRGL 10 25 26
+TRGL 10 26 11
+TRGL 11 26 27
+TRGL 11 27 12
+TRGL 12 27 28
+TRGL 12 28 13
+TRGL 13 28 29
+TRGL 13 29 14
+TRGL 14 29 30
+TRGL 14 30 15
+TRGL 15 30 31
+TRGL 15 31 16
+TRGL 16 31 32
+TRGL 16 32 1
+TRGL 1 32 17
+TRGL 17 33 18
+TRGL 18 33 34
+TRGL 18 34 19
+TRGL 19 34 35
+TRGL 19 35 20
+TRGL 20 35 36
+TRGL 20 36 21
+TRGL 21 36 37
+TRGL 21 37 22
+TRGL 22 37 38
+TRGL 22 38 23
+TRGL 23 38 39
+TRGL 23 39 24
+TRGL 24 39 40
+TRGL 24 40 25
+TRGL 25 40 41
+TRGL 25 41 26
+TRGL 26 41 42
+TRGL 26 42 27
+TRGL 27 42 43
+TRGL 27 43 28
+TRGL 28 43 44
+TRGL 28 44 29
+TRGL 29 44 45
+TRGL 29 45 30
+TRGL 30 45 46
+TRGL 30 46 31
+TRGL 31 46 47
+TRGL 31 47 32
+TRGL 32 47 48
+TRGL 32 48 17
+TRGL 17 48 33
+TRGL 33 49 34
+TRGL 34 49 50
+TRGL 34 50 35
+TRGL 35 50 51
+TRGL 35 51 36
+TRGL 36 51 52
+TRGL 36 52 37
+TRGL 37 52 53
+TRGL 37 53 38
+TRGL 38 53 54
+TRGL 38 54 39
+TRGL 39 54 55
+TRGL 39 55 40
+TRGL 40 55 56
+TRGL 40 56 41
+TRGL 41 56 57
+TRGL 41 57 42
+TRGL 42 57 58
+TRGL 42 58 43
+TRGL 43 58 59
+TRGL 43 59 44
+TRGL 44 59 60
+TRGL 44 60 45
+TRGL 45 60 61
+TRGL 45 61 46
+TRGL 46 61 62
+TRGL 46 62 47
+TRGL 47 62 63
+TRGL 47 63 48
+TRGL 48 63 64
+TRGL 48 64 33
+TRGL 33 64 49
+TRGL 49 65 50
+TRGL 50 65 66
+TRGL 50 66 51
+TRGL 51 66 67
+TRGL 51 67 52
+TRGL 52 67 68
+TRGL 52 68 53
+TRGL 53 68 69
+TRGL 53 69 54
+TRGL 54 69 70
+TRGL 54 70 55
+TRGL 55 70 71
+TRGL 55 71 56
+TRGL 56 71 72
+TRGL 56 72 57
+TRGL 57 72 73
+TRGL 57 73 58
+TRGL 58 73 74
+TRGL 58 74 59
+TRGL 59 74 75
+TRGL 59 75 60
+TRGL 60 75 76
+TRGL 60 76 61
+TRGL 61 76 77
+TRGL 61 77 62
+TRGL 62 77 78
+TRGL 62 78 63
+TRGL 63 78 79
+TRGL 63 79 64
+TRGL 64 79 80
+TRGL 64 80 49
+TRGL 49 80 65
+TRGL 65 81 66
+TRGL 66 81 82
+TRGL 66 82 67
+TRGL 67 82 83
+TRGL 67 83 68
+TRGL 68 83 84
+TRGL 68 84 69
+TRGL 69 84 85
+TRGL 69 85 70
+TRGL 70 85 86
+TRGL 70 86 71
+TRGL 71 86 87
+TRGL 71 87 72
+TRGL 72 87 88
+TRGL 72 88 73
+TRGL 73 88 89
+TRGL 73 89 74
+TRGL 74 89 90
+TRGL 74 90 75
+TRGL 75 90 91
+TRGL 75 91 76
+TRGL 76 91 92
+TRGL 76 92 77
+TRGL 77 92 93
+TRGL 77 93 78
+TRGL 78 93 94
+TRGL 78 94 79
+TRGL 79 94 95
+TRGL 79 95 80
+TRGL 80 95 96
+TRGL 80 96 65
+TRGL 65 96 81
+TRGL 81 97 82
+TRGL 82 97 98
+TRGL 82 98 83
+TRGL 83 98 99
+TRGL 83 99 84
+TRGL 84 99 100
+TRGL 84 100 85
+TRGL 85 100 101
+TRGL 85 101 86
+TRGL 86 101 102
+TRGL 86 102 87
+TRGL 87 102 103
+TRGL 87 103 88
+TRGL 88 103 104
+TRGL 88 104 89
+TRGL 89 104 105
+TRGL 89 105 90
+TRGL 90 105 106
+TRGL 90 106 91
+TRGL 91 106 107
+TRGL 91 107 92
+TRGL 92 107 108
+TRGL 92 108 93
+TRGL 93 108 109
+TRGL 93 109 94
+TRGL 94 109 110
+TRGL 94 110 95
+TRGL 95 110 111
+TRGL 95 111 96
+TRGL 96 111 112
+TRGL 96 112 81
+TRGL 81 112 97
+TRGL 97 113 98
+TRGL 98 113 114
+TRGL 98 114 99
+TRGL 99 114 115
+TRGL 99 115 100
+TRGL 100 115 116
+TRGL 100 116 101
+TRGL 101 116 117
+TRGL 101 117 102
+TRGL 102 117 118
+TRGL 102 118 103
+TRGL 103 118 119
+TRGL 103 119 104
+TRGL 104 119 120
+TRGL 104 120 105
+TRGL 105 120 121
+TRGL 105 121 106
+TRGL 106 121 122
+TRGL 106 122 107
+TRGL 107 122 123
+TRGL 107 123 108
+TRGL 108 123 124
+TRGL 108 124 109
+TRGL 109 124 125
+TRGL 109 125 110
+TRGL 110 125 126
+TRGL 110 126 111
+TRGL 111 126 127
+TRGL 111 127 112
+TRGL 112 127 128
+TRGL 112 128 97
+TRGL 97 128 113
+TRGL 113 129 114
+TRGL 114 129 130
+TRGL 114 130 115
+TRGL 115 130 131
+TRGL 115 131 116
+TRGL 116 131 132
+TRGL 116 132 117
+TRGL 117 132 133
+TRGL 117 133 118
+TRGL 118 133 134
+TRGL 118 134 119
+TRGL 119 134 135
+TRGL 119 135 120
+TRGL 120 135 136
+TRGL 120 136 121
+TRGL 121 136 137
+TRGL 121 137 122
+TRGL 122 137 138
+TRGL 122 138 123
+TRGL 123 138 139
+TRGL 123 139 124
+TRGL 124 139 140
+TRGL 124 140 125
+TRGL 125 140 141
+TRGL 125 141 126
+TRGL 126 141 142
+TRGL 126 142 127
+TRGL 127 142 143
+TRGL 127 143 128
+TRGL 128 143 144
+TRGL 128 144 113
+TRGL 113 144 129
+END
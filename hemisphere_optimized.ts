@@ -0,0 +1,425 @@
+GOCAD TSurf 1
+HEADER {
+name:mesh
+}
+PROPERTIES FRIC
+ESIZES 1
+TFACE
+PVRTX 0 0.0759275 -0.0208759 0.974654 0
+PVRTX 1 0.0836497 -0.136009 0.96469 0
+PVRTX 2 0.155872 -0.120613 0.957178 0
+PVRTX 3 0.13905 -0.125391 0.959404 0
+PVRTX 4 0.154254 -0.0147089 0.964592 0
+PVRTX 5 0.140954 -0.0135771 0.966863 0
+PVRTX 6 0.153611 -0.00347709 0.965197 0
+PVRTX 7 0.125954 0.0582559 0.967679 0
+PVRTX 8 0.0563743 0.104946 0.972399 0
+PVRTX 9 0.0480591 0.130585 0.967751 0
+PVRTX 10 0.088246 0.0651886 0.970929 0
+PVRTX 11 -0.0135303 0.0714844 0.974217 0
+PVRTX 12 0.00461524 0.0456245 0.976135 0
+PVRTX 13 -0.00343014 0.00254499 0.977787 0
+PVRTX 14 -0.058499 -0.00599208 0.977466 0
+PVRTX 15 -0.0269254 -0.0767267 0.974116 0
+PVRTX 16 0.0450673 -0.0933285 0.972059 0
+PVRTX 17 0.133689 -0.181262 0.949965 0
+PVRTX 18 0.135628 -0.102534 0.961935 0
+PVRTX 19 0.179809 -0.145511 0.948011 0
+PVRTX 20 0.243923 -0.0238465 0.945228 0
+PVRTX 21 0.202885 0.017922 0.954844 0
+PVRTX 22 0.213602 0.0562165 0.95151 0
+PVRTX 23 0.150978 0.0715917 0.962595 0
+PVRTX 24 0.0820763 0.185686 0.954994 0
+PVRTX 25 -0.00646784 0.160897 0.963855 0
+PVRTX 26 0.00456398 0.0970064 0.972707 0
+PVRTX 27 -0.0507636 0.0778919 0.973065 0
+PVRTX 28 -0.0662086 0.0564831 0.973773 0
+PVRTX 29 -0.0745189 -0.0450325 0.973494 0
+PVRTX 30 -0.101148 -0.0393449 0.971519 0
+PVRTX 31 -0.0176813 -0.174124 0.96174 0
+PVRTX 32 0.0312164 -0.177651 0.960623 0
+PVRTX 33 0.126434 -0.23098 0.93967 0
+PVRTX 34 0.218361 -0.159915 0.938546 0
+PVRTX 35 0.231624 -0.0293207 0.948333 0
+PVRTX 36 0.27815 -0.0134222 0.935572 0
+PVRTX 37 0.238614 0.1269 0.937826 0
+PVRTX 38 0.22831 0.114578 0.943021 0
+PVRTX 39 0.103058 0.163104 0.957938 0
+PVRTX 40 0.0691048 0.232465 0.946188 0
+PVRTX 41 -0.0600666 0.235539 0.947439 0
+PVRTX 42 -0.0800077 0.103877 0.967781 0
+PVRTX 43 -0.144403 0.0413703 0.966074 0
+PVRTX 44 -0.165611 0.00840052 0.962684 0
+PVRTX 45 -0.155684 -0.118237 0.956834 0
+PVRTX 46 -0.0569312 -0.12956 0.966149 0
+PVRTX 47 0.0140476 -0.213169 0.952527 0
+PVRTX 48 0.122675 -0.264785 0.932173 0
+PVRTX 49 0.194099 -0.278829 0.913862 0
+PVRTX 50 0.320962 -0.19431 0.900254 0
+PVRTX 51 0.383596 -0.066778 0.89456 0
+PVRTX 52 0.314205 0.0875702 0.921343 0
+PVRTX 53 0.310338 0.153884 0.91333 0
+PVRTX 54 0.197642 0.256124 0.920729 0
+PVRTX 55 0.0847234 0.307149 0.921658 0
+PVRTX 56 -0.0183199 0.324086 0.920777 0
+PVRTX 57 -0.0944235 0.289514 0.929068 0
+PVRTX 58 -0.168543 0.124412 0.954411 0
+PVRTX 59 -0.242764 0.0279698 0.945557 0
+PVRTX 60 -0.210855 -0.0908857 0.954341 0
+PVRTX 61 -0.1631 -0.206396 0.94019 0
+PVRTX 62 -0.113755 -0.261355 0.933933 0
+PVRTX 63 0.0578016 -0.275097 0.935067 0
+PVRTX 64 0.159422 -0.26344 0.928261 0
+PVRTX 65 0.307778 -0.288576 0.882744 0
+PVRTX 66 0.445222 -0.174113 0.849668 0
+PVRTX 67 0.435335 0.0257036 0.874281 0
+PVRTX 68 0.397794 0.188784 0.870112 0
+PVRTX 69 0.36314 0.298375 0.856343 0
+PVRTX 70 0.2234 0.359764 0.879131 0
+PVRTX 71 0.0229359 0.423929 0.882482 0
+PVRTX 72 -0.12876 0.385731 0.886602 0
+PVRTX 73 -0.25051 0.322537 0.888534 0
+PVRTX 74 -0.324354 0.12268 0.911842 0
+PVRTX 75 -0.34484 0.0211443 0.91589 0
+PVRTX 76 -0.304911 -0.188371 0.90788 0
+PVRTX 77 -0.277387 -0.305678 0.890878 0
+PVRTX 78 -0.107311 -0.406161 0.880601 0
+PVRTX 79 0.0533342 -0.379775 0.895862 0
+PVRTX 80 0.22026 -0.406572 0.857314 0
+PVRTX 81 0.467879 -0.285765 0.80674 0
+PVRTX 82 0.598359 -0.11996 0.765003 0
+PVRTX 83 0.555325 0.11088 0.795092 0
+PVRTX 84 0.474029 0.322275 0.794348 0
+PVRTX 85 0.376954 0.453687 0.786657 0
+PVRTX 86 0.177416 0.529973 0.797525 0
+PVRTX 87 -0.0737389 0.537856 0.81872 0
+PVRTX 88 -0.290493 0.452454 0.81768 0
+PVRTX 89 -0.443163 0.323919 0.810413 0
+PVRTX 90 -0.488982 0.0990316 0.843041 0
+PVRTX 91 -0.488875 -0.092258 0.845349 0
+PVRTX 92 -0.403748 -0.334536 0.821976 0
+PVRTX 93 -0.292434 -0.4584 0.819991 0
+PVRTX 94 -0.0756555 -0.568258 0.792851 0
+PVRTX 95 0.170199 -0.526112 0.807425 0
+PVRTX 96 0.307384 -0.464565 0.801236 0
+PVRTX 97 0.693294 -0.254013 0.645606 0
+PVRTX 98 0.747558 0.0165268 0.639792 0
+PVRTX 99 0.665882 0.28615 0.657432 0
+PVRTX 100 0.509909 0.510035 0.658447 0
+PVRTX 101 0.311771 0.657469 0.666326 0
+PVRTX 102 0.0488502 0.713712 0.668279 0
+PVRTX 103 -0.252461 0.656301 0.686416 0
+PVRTX 104 -0.503361 0.502762 0.673303 0
+PVRTX 105 -0.658324 0.268023 0.681723 0
+PVRTX 106 -0.69356 -0.00775628 0.700353 0
+PVRTX 107 -0.634179 -0.286352 0.697118 0
+PVRTX 108 -0.474424 -0.525653 0.678434 0
+PVRTX 109 -0.248341 -0.681407 0.662618 0
+PVRTX 110 0.0411962 -0.727997 0.651122 0
+PVRTX 111 0.317706 -0.654081 0.657665 0
+PVRTX 112 0.505802 -0.503856 0.670741 0
+PVRTX 113 0.870079 -0.16178 0.42144 0
+PVRTX 114 0.865484 0.180122 0.424897 0
+PVRTX 115 0.725329 0.488245 0.44351 0
+PVRTX 116 0.485965 0.721945 0.449191 0
+PVRTX 117 0.186041 0.849476 0.453015 0
+PVRTX 118 -0.150568 0.851622 0.460616 0
+PVRTX 119 -0.476523 0.721461 0.463556 0
+PVRTX 120 -0.727154 0.482392 0.446092 0
+PVRTX 121 -0.851275 0.165344 0.460709 0
+PVRTX 122 -0.843673 -0.176252 0.46745 0
+PVRTX 123 -0.709213 -0.49228 0.464463 0
+PVRTX 124 -0.465827 -0.732732 0.456092 0
+PVRTX 125 -0.151133 -0.864962 0.437245 0
+PVRTX 126 0.194142 -0.857645 0.436458 0
+PVRTX 127 0.499902 -0.724685 0.433754 0
+PVRTX 128 0.733897 -0.475478 0.4446 0
+PVRTX 129 0.987688 0 0.156434 0
+PVRTX 130 0.912505 0.377972 0.156434 0
+PVRTX 131 0.698401 0.698401 0.156434 0
+PVRTX 132 0.377972 0.912505 0.156434 0
+PVRTX 133 6.04785e-17 0.987688 0.156434 0
+PVRTX 134 -0.377972 0.912505 0.156434 0
+PVRTX 135 -0.698401 0.698401 0.156434 0
+PVRTX 136 -0.912505 0.377972 0.156434 0
+PVRTX 137 -0.987688 1.20957e-16 0.156434 0
+PVRTX 138 -0.912505 -0.377972 0.156434 0
+PVRTX 139 -0.698401 -0.698401 0.156434 0
+PVRTX 140 -0.377972 -0.912505 0.156434 0
+PVRTX 141 -1.81435e-16 -0.987688 0.156434 0
+PVRTX 142 0.377972 -0.912505 0.156434 0
+PVRTX 143 0.698401 -0.698401 0.156434 0
+PVRTX 144 0.912505 -0.377972 0.156434 0
+TRGL 0 1 2
+TRGL 0 2 3
+TRGL 0 3 4
+TRGL 0 4 5
+TRGL 0 5 6
+TRGL 0 6 7
+TRGL 0 7 8
+TRGL 0 8 9
+TRGL 0 9 10
+TRGL 0 10 11
+TRGL 0 11 12
+TRGL 0 12 13
+TRGL 0 13 14
+TRGL 0 14 15
+TRGL 0 15 16
+TRGL 0 16 1
+TRGL 1 17 2
+TRGL 2 17 18
+TRGL 2 18 3
+TRGL 3 18 19
+TRGL 3 19 4
+TRGL 4 19 20
+TRGL 4 20 5
+TRGL 5 20 21
+TRGL 5 21 6
+TRGL 6 21 22
+TRGL 6 22 7
+TRGL 7 22 23
+TRGL 7 23 8
+TRGL 8 23 24
+TRGL 8 24 9
+TRGL 9 24 25
+TRGL 9 25 10
+TRGL 10 25 26
+TRGL 10 26 11
+TRGL 11 26 27
+TRGL 11 27 12
+TRGL 12 27 28
+TRGL 12 28 13
+TRGL 13 28 29
+TRGL 13 29 14
+TRGL 14 29 30
+TRGL 14 30 15
+TRGL 15 30 31
+TRGL 15 31 16
+TRGL 16 31 32
+TRGL 16 32 1
+TRGL 1 32 17
+TRGL 17 33 18
+TRGL 18 33 34
+TRGL 18 34 19
+TRGL 19 34 35
+TRGL 19 35 20
+TRGL 20 35 36
+TRGL 20 36 21
+TRGL 21 36 37
+TRGL 21 37 22
+TRGL 22 37 38
+TRGL 22 38 23
+TRGL 23 38 39
+TRGL 23 39 24
+TRGL 24 39 40
+TRGL 24 40 25
+TRGL 25 40 41
+TRGL 25 41 26
+TRGL 26 41 42
+TRGL 26 42 27
+TRGL 27 42 43
+TRGL 27 43 28
+TRGL 28 43 44
+TRGL 28 44 29
+TRGL 29 44 45
+TRGL 29 45 30
+TRGL 30 45 46
+TRGL 30 46 31
+TRGL 31 46 47
+TRGL 31 47 32
+TRGL 32 47 48
+TRGL 32 48 17
+TRGL 17 48 33
+TRGL 33 49 34
+TRGL 34 49 50
+TRGL 34 50 35
+TRGL 35 50 51
+TRGL 35 51 36
+TRGL 36 51 52
+TRGL 36 52 37
+TRGL 37 52 53
+TRGL 37 53 38
+TRGL 38 53 54
+TRGL 38 54 39
+TRGL 39 54 55
+TRGL 39 55 40
+TRGL 40 55 56
+TRGL 40 56 41
+TRGL 41 56 57
+TRGL 41 57 42
+TRGL 42 57 58
+TRGL 42 58 43
+TRGL 43 58 59
+TRGL 43 59 44
+TRGL 44 59 60
+TRGL 44 60 45
+TRGL 45 60 61
+TRGL 45 61 46
+TRGL 46 61 62
+TRGL 46 62 47
+TRGL 47 62 63
+TRGL 47 63 48
+TRGL 48 63 64
+TRGL 48 64 33
+TRGL 33 64 49
+TRGL 49 65 50
+TRGL 50 65 66
+TRGL 50 66 51
+TRGL 51 66 67
+TRGL 51 67 52
+TRGL 52 67 68
+TRGL 52 68 53
+TRGL 53 68 69
+TRGL 53 69 54
+TRGL 54 69 70
+TRGL 54 70 55
+TRGL 55 70 71
+TRGL 55 71 56
+TRGL 56 71 72
+TRGL 56 72 57
+TRGL 57 72 73
+TRGL 57 73 58
+TRGL 58 73 74
+TRGL 58 74 59
+TRGL 59 74 75
+TRGL 59 75 60
+TRGL 60 75 76
+TRGL 60 76 61
+TRGL 61 76 77
+TRGL 61 77 62
+TRGL 62 77 78
+TRGL 62 78 63
+TRGL 63 78 79
+TRGL 63 79 64
+TRGL 64 79 80
+TRGL 64 80 49
+TRGL 49 80 65
+TRGL 65 81 66
+TRGL 66 81 82
+TRGL 66 82 67
+TRGL 67 82 83
+TRGL 67 83 68
+TRGL 68 83 84
+TRGL 68 84 69
+TRGL 69 84 85
+TRGL 69 85 70
+TRGL 70 85 86
+TRGL 70 86 71
+TRGL 71 86 87
+TRGL 71 87 72
+TRGL 72 87 88
+TRGL 72 88 73
+TRGL 73 88 89
+TRGL 73 89 74
+TRGL 74 89 90
+TRGL 74 90 75
+TRGL 75 90 91
+TRGL 75 91 76
+TRGL 76 91 92
+TRGL 76 92 77
+TRGL 77 92 93
+TRGL 77 93 78
+TRGL 78 93 94
+TRGL 78 94 79
+TRGL 79 94 95
+TRGL 79 95 80
+TRGL 80 95 96
+TRGL 80 96 65
+TRGL 65 96 81
+TRGL 81 97 82
+TRGL 82 97 98
+TRGL 82 98 83
+TRGL 83 98 99
+TRGL 83 99 84
+TRGL 84 99 100
+TRGL 84 100 85
+TRGL 85 100 101
+TRGL 85 101 86
+TRGL 86 101 102
+TRGL 86 102 87
+TRGL 87 102 103
+TRGL 87 103 88
+TRGL 88 103 104
+TRGL 88 104 89
+TRGL 89 104 105
+TRGL 89 105 90
+TRGL 90 105 106
+TRGL 90 106 91
+TRGL 91 106 107
+TRGL 91 107 92
+TRGL 92 107 108
+TRGL 92 108 93
+TRGL 93 108 109
+TRGL 93 109 94
+TRGL 94 109 110
+TRGL 94 110 95
+TRGL 95 110 111
+TRGL 95 111 96
+TRGL 96 111 112
+TRGL 96 112 81
+TRGL 81 112 97
+TRGL 97 113 98
+TRGL 98 113 114
+TRGL 98 114 99
+TRGL 99 114 115
+TRGL 99 115 100
+TRGL 100 115 116
+TRGL 100 116 101
+TRGL 101 116 117
+TRGL 101 117 102
+TRGL 102 117 118
+TRGL 102 118 103
+TRGL 103 118 119
+TRGL 103 119 104
+TRGL 104 119 120
+TRGL 104 120 105
+TRGL 105 120 121
+TRGL 105 121 106
+TRGL 106 121 122
+TRGL 106 122 107
+TRGL 107 122 123
+TRGL 107 123 108
+TRGL 108 123 124
+TRGL 108 124 109
+TRGL 109 124 125
+TRGL 109 125 110
+TRGL 110 125 126
+TRGL 110 126 111
+TRGL 111 126 127
+TRGL 111 127 112
+TRGL 112 127 128
+TRGL 112 128 97
+TRGL 97 128 113
+TRGL 113 129 114
+TRGL 114 129 130
+TRGL 114 130 115
+TRGL 115 130 131
+TRGL 115 131 116
+TRGL 116 131 132
+TRGL 116 132 117
+TRGL 117 132 133
+TRGL 117 133 118
+TRGL 118 133 134
+TRGL 118 134 119
+TRGL 119 134 135
+TRGL 119 135 120
+TRGL 120 135 136
+TRGL 120 136 121
+TRGL 121 136 137
+TRGL 121 137 122
+TRGL 122 137 138
+TRGL 122 138 123
+TRGL 123 138 139
+TRGL 123 139 124
+TRGL 124 139 140
+TRGL 124 140 125
+TRGL 125 140 141
+TRGL 125 141 126
+TRGL 126 141 142
+TRGL 126 142 127
+TRGL 127 142 143
+TRGL 127 143 128
+TRGL 128 143 144
+TRGL 128 144 113
+TRGL 113 144 129
+END
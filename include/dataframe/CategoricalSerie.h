@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include "Serie.h"
+#include "StringSerie.h"
+#include "utils/flat_hash.h"
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace df {
+
+/**
+ * @brief Distinct values of a categorical column, each one identified by a
+ * code (its insertion rank).
+ *
+ * A dictionary only grows: the code of a value never changes, so that
+ * several CategoricalSerie (chunks of a column, files read with the same
+ * io::CSVOptions::dictionaries...) can share it through a shared_ptr and
+ * compare their codes directly.
+ *
+ * encode() is not thread-safe. A dictionary shared by several threads must
+ * only be read.
+ */
+class Dictionary {
+  public:
+    Dictionary() = default;
+    Dictionary(const Dictionary &other);
+    Dictionary &operator=(const Dictionary &other);
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+
+    /**
+     * @brief Code of value, added to the dictionary if not present
+     * @throws std::runtime_error if the dictionary holds 2^32 values
+     */
+    uint32_t encode(std::string_view value);
+
+    /**
+     * @brief Code of value, or nullptr if not present
+     */
+    const uint32_t *find(std::string_view value) const {
+        return index_.find(value);
+    }
+
+    /**
+     * @throws std::out_of_range if code >= size()
+     */
+    const std::string &operator[](uint32_t code) const;
+
+    /**
+     * @brief The values, in code order
+     */
+    const std::deque<std::string> &values() const { return values_; }
+
+    /**
+     * @brief Rank of each code when the values are sorted (rank[code])
+     */
+    std::vector<uint32_t> ranks() const;
+
+  private:
+    // A deque never moves its elements: the keys of index_ are views on them
+    std::deque<std::string> values_;
+    FlatHashMap<std::string_view, uint32_t> index_;
+};
+
+/**
+ * @brief A dictionary-encoded string column: each row stores the code of its
+ * value in a (shared) Dictionary.
+ *
+ * The codes are stored on 8 bits while the codes are below 256, then on 16
+ * and 32 bits (the storage is widened when a larger code is added). Grouping,
+ * sorting, finding the distinct values or joining work on the codes, and
+ * compare or hash each distinct string once, instead of once per row (see
+ * groupBy, argsort, unique and join_indices).
+ *
+ * Nulls are stored in a validity bitmap, as for Serie (see
+ * Serie::validity()). A null value reads as an empty string.
+ *
+ * @code
+ * df::CategoricalSerie city{"Paris", "Lyon", "Paris"};
+ * city.code(2);         // 0
+ * city[1];              // "Lyon"
+ * city.codeWidth();     // 1 byte per row
+ *
+ * // Chunks sharing their dictionary have comparable codes
+ * df::CategoricalSerie other(city.dictionary());
+ * other.add("Lyon");    // code 1
+ *
+ * auto stats = df::groupBy(city).agg(price, df::agg::mean());
+ * @endcode
+ */
+class CategoricalSerie : public SerieBase {
+  public:
+    using value_type = std::string;
+    using Codes = std::variant<std::vector<uint8_t>, std::vector<uint16_t>,
+                               std::vector<uint32_t>>;
+
+    explicit CategoricalSerie(
+        std::shared_ptr<Dictionary> dictionary = std::make_shared<Dictionary>());
+    CategoricalSerie(std::initializer_list<std::string_view> values);
+    explicit CategoricalSerie(
+        const Serie<std::string> &serie,
+        std::shared_ptr<Dictionary> dictionary = std::make_shared<Dictionary>());
+    explicit CategoricalSerie(
+        const StringSerie &serie,
+        std::shared_ptr<Dictionary> dictionary = std::make_shared<Dictionary>());
+
+    std::string type() const override { return "CategoricalSerie"; }
+    int typeId() const override { return -1; }
+    size_t size() const override;
+    bool empty() const { return size() == 0; }
+
+    void reserve(size_t n);
+
+    /**
+     * @brief Append a value, encoded with (and added to) the dictionary
+     */
+    void add(std::string_view value);
+
+    /**
+     * @throws std::out_of_range if code is not in the dictionary
+     */
+    void addCode(uint32_t code);
+    void addNull();
+
+    /**
+     * @throws std::out_of_range if index >= size()
+     */
+    const std::string &operator[](size_t index) const;
+
+    /**
+     * @brief Code of row index (unchecked). A null row holds 0, which is
+     * also the code of the first dictionary value: see isNull()
+     */
+    uint32_t code(size_t index) const;
+
+    /**
+     * @brief Copy of the codes
+     */
+    Serie<uint32_t> codes() const;
+
+    /**
+     * @brief Number of bytes per code (1, 2 or 4)
+     */
+    size_t codeWidth() const;
+
+    /**
+     * @brief Call f with the typed vector of codes (std::vector<uint8_t>,
+     * std::vector<uint16_t> or std::vector<uint32_t>)
+     */
+    template <typename F> decltype(auto) visitCodes(F &&f) const {
+        return std::visit(std::forward<F>(f), codes_);
+    }
+
+    const std::shared_ptr<Dictionary> &dictionary() const {
+        return dictionary_;
+    }
+
+    // Missing values, as for Serie
+    bool hasNulls() const;
+    size_t nullCount() const;
+    bool isNull(size_t index) const;
+    bool isValid(size_t index) const { return !isNull(index); }
+    const Mask &validity() const { return validity_; }
+
+    /**
+     * @throws std::runtime_error if the mask size differs from size()
+     */
+    void setValidity(const Mask &validity);
+
+    /**
+     * @brief The gathered rows share the dictionary
+     */
+    std::shared_ptr<SerieBase>
+    gather(const std::vector<int64_t> &indices) const override;
+
+    /**
+     * @brief The values at the set bits of mask, sharing the dictionary
+     * @throws std::runtime_error if mask.size() != size()
+     */
+    CategoricalSerie select(const Mask &mask) const;
+
+    /**
+     * @brief Decoded values (nulls are kept)
+     */
+    Serie<std::string> toSerie() const;
+
+  private:
+    void widen(uint32_t code);
+
+    std::shared_ptr<Dictionary> dictionary_;
+    Codes codes_;
+    Mask validity_;
+};
+
+} // namespace df
+
+#include "inline/CategoricalSerie.hxx"
@@ -22,8 +22,14 @@
  */
 
 #pragma once
+#include "CategoricalSerie.h"
+#include "Mask.h"
 #include "Serie.h"
+#include "StringSerie.h"
 #include "types.h"
+#include "utils/flat_hash.h"
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <stdexcept>
@@ -71,6 +77,42 @@ namespace df {
  * }
  * @endcode
  */
+/**
+ * @brief A column of a Dataframe, resolved once by name and type (see
+ * Dataframe::handle). Accessing the values through the handle involves no
+ * name lookup nor type check, which is what inner loops want.
+ *
+ * The handle shares the ownership of the Serie: it stays valid even if the
+ * column is later removed from the Dataframe.
+ *
+ * @code
+ * auto depth = dataframe.handle<double>("depth");
+ * for (size_t i = 0; i < depth.size(); ++i) {
+ *     sum += depth[i];
+ * }
+ * @endcode
+ */
+template <typename T> class ColumnHandle {
+  public:
+    ColumnHandle() = default;
+    ColumnHandle(const std::string &name, std::shared_ptr<Serie<T>> serie)
+        : name_(name), serie_(std::move(serie)) {}
+
+    const std::string &name() const { return name_; }
+    explicit operator bool() const { return serie_ != nullptr; }
+
+    const Serie<T> &serie() const { return *serie_; }
+    const Serie<T> &operator*() const { return *serie_; }
+    const Serie<T> *operator->() const { return serie_.get(); }
+
+    size_t size() const { return serie_->size(); }
+    const T &operator[](size_t i) const { return serie_->data()[i]; }
+
+  private:
+    std::string name_;
+    std::shared_ptr<Serie<T>> serie_;
+};
+
 class Dataframe {
   public:
     struct SerieInfo {
@@ -80,10 +122,17 @@ class Dataframe {
         template <typename T>
         SerieInfo(const Serie<T> &serie)
             : data(std::make_shared<Serie<T>>(serie)), type(typeid(Serie<T>)) {}
+
+        SerieInfo(const std::shared_ptr<SerieBase> &serie)
+            : data(serie), type(typeid(*serie)) {}
     };
 
     Dataframe() = default;
     ~Dataframe() = default;
+    Dataframe(const Dataframe &other);
+    Dataframe(Dataframe &&other) noexcept;
+    Dataframe &operator=(const Dataframe &other);
+    Dataframe &operator=(Dataframe &&other) noexcept;
 
     // Iterator type aliases
     using iterator = std::map<std::string, SerieInfo>::iterator;
@@ -123,6 +172,13 @@ class Dataframe {
     template <typename T>
     void add(const std::string &name, const ArrayType<T> &array);
 
+    /**
+     * @brief Add a type-erased serie (e.g. from SerieBase::gather or
+     * io::load) to the Dataframe, without copying it
+     * @throws std::runtime_error if a serie with this name already exists
+     */
+    void add(const std::string &name, const std::shared_ptr<SerieBase> &serie);
+
     /**
      * Remove a serie from the Dataframe
      * @throws std::runtime_error if the serie doesn't exist
@@ -130,11 +186,11 @@ class Dataframe {
     void remove(const std::string &name);
 
     const SerieBase &get(const std::string &name) const {
-        auto it = series_.find(name);
-        if (it == series_.end()) {
+        const SerieInfo *info = find(name);
+        if (!info) {
             throw std::runtime_error("Serie not found: " + name);
         }
-        return *(it->second.data); // assuming data is the shared_ptr<SerieBase>
+        return *(info->data);
     }
 
     /**
@@ -145,6 +201,28 @@ class Dataframe {
     template <typename T> const Serie<T> &get(const std::string &name) const;
     template <typename T> Serie<T> &get(const std::string &name);
 
+    /**
+     * Get a StringSerie by name (see io::CSVOptions::string_arena)
+     * @throws std::runtime_error if the serie doesn't exist or is not a
+     * StringSerie
+     */
+    const StringSerie &strings(const std::string &name) const;
+
+    /**
+     * Get a CategoricalSerie by name
+     * @throws std::runtime_error if the serie doesn't exist or is not a
+     * CategoricalSerie
+     */
+    const CategoricalSerie &categorical(const std::string &name) const;
+
+    /**
+     * @brief Resolve a column once, for repeated access without lookup
+     * @throws std::runtime_error if the serie doesn't exist or if there's a
+     * type mismatch
+     */
+    template <typename T>
+    ColumnHandle<T> handle(const std::string &name) const;
+
     /**
      * Get the type info for a serie
      * @throws std::runtime_error if the serie doesn't exist
@@ -173,6 +251,16 @@ class Dataframe {
      */
     std::vector<std::string> names() const;
 
+    /**
+     * @brief Keep the rows of the set bits of mask, in every serie. The series
+     * are gathered in parallel.
+     * @code
+     * auto deep = df.filter_rows(df.get<double>("z") < -1000.0);
+     * @endcode
+     * @throws std::runtime_error if a serie size differs from the mask size
+     */
+    Dataframe filter_rows(const Mask &mask) const;
+
     /**
      * Clear all series from the Dataframe
      */
@@ -186,8 +274,32 @@ class Dataframe {
      */
     void dump(std::ostream &os = std::cout, size_t max_preview = 5) const;
 
+    /**
+     * @brief Changes each time a column is added or removed (versions are
+     * unique across all the Dataframes). Caches derived from the columns (see
+     * attributes::Manager) compare it to know when they are stale. Values
+     * modified in place through the non-const get<T>() are not tracked: call
+     * touch() after such a modification.
+     */
+    uint64_t version() const { return version_; }
+    void touch() { version_ = nextVersion(); }
+
   private:
     std::map<std::string, SerieInfo> series_;
+    // Hashed name -> SerieInfo index over series_ (map nodes are stable)
+    FlatHashMap<std::string, SerieInfo *> index_;
+    uint64_t version_ = 0;
+
+    const SerieInfo *find(const std::string &name) const;
+    template <typename T>
+    const std::shared_ptr<SerieBase> &
+    checked(const std::string &name) const; // throws
+    void reindex();
+
+    static uint64_t nextVersion() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
 
     void printSeriesOverview(std::ostream &, int, int, int) const;
 
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <dataframe/core/ExecutionPolicy.h>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+namespace df {
+
+template <typename T> class Serie;
+
+/**
+ * @brief A boolean column packed into 64-bit words.
+ *
+ * Serie<bool> is a std::vector<bool>: bits are read and written one at a
+ * time, and threads writing neighbor elements share words. A Mask exposes
+ * its words instead, so that:
+ * - the logical operators (~, &, |, ^) work 64 rows at a time,
+ * - count() is a popcount and forEachSet() skips the zero words,
+ * - the comparison operators (and Mask::from() with ExecutionPolicy::PAR)
+ *   build the words in parallel, each thread owning whole words.
+ *
+ * The bits past size() in the last word are always zero.
+ *
+ * @code
+ * auto deep = (depth > 100.0) & ~df::Mask(df::stats::isOutlier(depth));
+ * size_t n = deep.count();
+ * auto values = df::filter(deep, depth);
+ * @endcode
+ */
+class Mask {
+  public:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    Mask() = default;
+    explicit Mask(size_t size, bool value = false);
+    Mask(std::initializer_list<bool> values);
+    explicit Mask(const Serie<bool> &serie);
+
+    /**
+     * @brief Mask of predicate(value) or predicate(value, index) over the
+     * values of a Serie. The predicate is only called from several threads
+     * (for large series) with ExecutionPolicy::PAR.
+     */
+    template <typename T, typename P>
+    static Mask from(const Serie<T> &serie, P &&predicate,
+                     ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
+    /**
+     * @brief Mask of bit(i) for i in [0, size), computed in parallel for
+     * large sizes unless exec is ExecutionPolicy::SEQ. bit should be cheap
+     * and branch-free: it is called in a loop building one word at a time.
+     */
+    template <typename F>
+    static Mask generate(size_t size, F &&bit,
+                         ExecutionPolicy exec = ExecutionPolicy::PAR);
+
+    /**
+     * @brief Mask made of the given words (bit i of the mask is bit i % 64 of
+     * words[i / 64]). The bits past size are cleared.
+     * @throws std::runtime_error if the number of words does not match size
+     */
+    static Mask fromWords(std::vector<Word> words, size_t size);
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    bool operator[](size_t index) const {
+        return (words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+    }
+
+    /**
+     * @throws std::out_of_range if index >= size()
+     */
+    bool test(size_t index) const;
+    void set(size_t index, bool value = true);
+    void push_back(bool value);
+
+    /**
+     * @brief Number of set bits
+     */
+    size_t count() const;
+    bool any() const;
+    bool all() const { return count() == size_; }
+    bool none() const { return !any(); }
+
+    Mask operator~() const;
+
+    /**
+     * @throws std::runtime_error if the masks have different sizes
+     */
+    Mask &operator&=(const Mask &other);
+    Mask &operator|=(const Mask &other);
+    Mask &operator^=(const Mask &other);
+
+    bool operator==(const Mask &other) const = default;
+
+    /**
+     * @brief Call callback(index) for each set bit, in increasing order
+     */
+    template <typename F> void forEachSet(F &&callback) const;
+
+    /**
+     * @brief Indices of the set bits, in increasing order
+     */
+    std::vector<size_t> indices() const;
+
+    Serie<bool> toSerie() const;
+
+    /**
+     * @brief The values of serie at the set bits (stream compaction). Large
+     * series are compacted in parallel: set bits are counted per chunk of
+     * words, an exclusive prefix sum of the counts gives where each chunk
+     * writes, then every chunk scatters its values into the pre-sized output.
+     * The nulls of serie are kept.
+     * @throws std::runtime_error if serie.size() != size()
+     */
+    template <typename T> Serie<T> select(const Serie<T> &serie) const;
+
+    const std::vector<Word> &words() const { return words_; }
+
+  private:
+    template <typename T>
+    Serie<T> compact(const std::vector<T> &values) const;
+    void checkSize(const Mask &other, const char *op) const;
+    void clearTail();
+
+    std::vector<Word> words_;
+    size_t size_ = 0;
+};
+
+inline Mask operator&(Mask a, const Mask &b) { return a &= b; }
+inline Mask operator|(Mask a, const Mask &b) { return a |= b; }
+inline Mask operator^(Mask a, const Mask &b) { return a ^= b; }
+
+// ----------------------------------------------------------------
+
+/**
+ * @brief Element-wise comparisons of a numeric Serie with a scalar or with
+ * another Serie of the same size, as a Mask.
+ *
+ * @code
+ * auto m = (x >= 0.0) & (x < y);
+ * @endcode
+ */
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<(const Serie<T> &serie, U value);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<=(const Serie<T> &serie, U value);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>(const Serie<T> &serie, U value);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>=(const Serie<T> &serie, U value);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator==(const Serie<T> &serie, U value);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator!=(const Serie<T> &serie, U value);
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<(const Serie<T> &a, const Serie<U> &b);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<=(const Serie<T> &a, const Serie<U> &b);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>(const Serie<T> &a, const Serie<U> &b);
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>=(const Serie<T> &a, const Serie<U> &b);
+
+} // namespace df
+
+// The inline definitions need Serie, and are included by Serie.h
+#include "Serie.h"
@@ -22,9 +22,13 @@
  */
 
 #pragma once
+#include "Mask.h"
 #include "types.h"
+#include "utils/type_registry.h"
+#include <atomic>
 #include <cstdint>
 #include <iomanip>
+#include <memory>
 #include <vector>
 
 namespace df {
@@ -37,8 +41,87 @@ class SerieBase {
     virtual ~SerieBase() = default;
     virtual size_t size() const = 0;
     virtual std::string type() const = 0;
+
+    /**
+     * @brief Id of the value type in column_types (-1 if not registered)
+     */
+    virtual int typeId() const = 0;
+
+    /**
+     * @brief New Serie of the same type made of the rows at the given
+     * indices (typed gather). A negative index gives a null (see
+     * Serie::validity()): NaN for floating point types, a default-constructed
+     * value otherwise.
+     */
+    virtual std::shared_ptr<SerieBase>
+    gather(const std::vector<int64_t> &indices) const = 0;
 };
 
+template <typename T> class Serie;
+
+/**
+ * @brief Call f(serie) with the Serie<T> behind a type-erased column, for
+ * the T of column_types (see utils/type_registry.h). The dispatch is a
+ * single indexed call; f is instantiated for every registered type, so use
+ * `if constexpr` to restrict what it does.
+ *
+ * @code
+ * df::visit(dataframe.get("depth"), [](const auto& serie) {
+ *     using T = typename std::decay_t<decltype(serie)>::value_type;
+ *     if constexpr (std::is_arithmetic_v<T>) { ... }
+ * });
+ * @endcode
+ * @return false if the type of the column is not registered (f is not
+ * called)
+ */
+template <typename F> bool visit(const SerieBase &serie, F &&f);
+
+// --------------------------------------------------------------
+
+namespace detail {
+
+/**
+ * @brief Version token of a Serie (see Serie::version()). Copies share the
+ * token, a mutation resets it and a new one is drawn, from a global counter,
+ * the next time it is asked for.
+ */
+class SerieVersion {
+  public:
+    SerieVersion() = default;
+    SerieVersion(const SerieVersion &other) : value_(other.load()) {}
+    SerieVersion(SerieVersion &&other) noexcept : value_(other.load()) {
+        other.touch();
+    }
+    SerieVersion &operator=(const SerieVersion &other) {
+        value_.store(other.load(), std::memory_order_relaxed);
+        return *this;
+    }
+    SerieVersion &operator=(SerieVersion &&other) noexcept {
+        if (this != &other) {
+            value_.store(other.load(), std::memory_order_relaxed);
+            other.touch();
+        }
+        return *this;
+    }
+
+    uint64_t get() const;
+
+    // Only written when set, so that concurrent writes of different
+    // elements do not bounce the cache line
+    void touch() {
+        if (load() != 0) {
+            value_.store(0, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    uint64_t load() const { return value_.load(std::memory_order_relaxed); }
+
+    mutable std::atomic<uint64_t> value_{0};
+};
+
+} // namespace detail
+
 // --------------------------------------------------------------
 
 /**
@@ -70,6 +153,9 @@ template <typename T> class Serie : public SerieBase {
     // Standard container type definitions
     using value_type = T;
     using ArrayType = std::vector<T>;
+    // T& and const T&, except for bool (bits of a std::vector<bool>)
+    using reference = typename ArrayType::reference;
+    using const_reference = typename ArrayType::const_reference;
     using Self = Serie<T>;
     using iterator = typename ArrayType::iterator;
     using const_iterator = typename ArrayType::const_iterator;
@@ -85,21 +171,25 @@ template <typename T> class Serie : public SerieBase {
     // Constructors
     Serie() = default;
     Serie(const ArrayType &values);
+    Serie(ArrayType &&values) : data_(std::move(values)) {}
     Serie(const std::initializer_list<T> &values);
     explicit Serie(size_t size) : data_(size) {}
     Serie(size_t size, const T &value) : data_(size, value) {}
 
     // Basic operations
     std::string type() const override;
+    int typeId() const override { return type_id<T>; }
     size_t size() const override;
     bool empty() const;
     template <typename U> Serie<U> as() const;
     void reserve(size_t n);
+    std::shared_ptr<SerieBase>
+    gather(const std::vector<int64_t> &indices) const override;
 
     // Element access
-    T &operator[](size_t index);
+    reference operator[](size_t index);
     void set(size_t index, const T &value);
-    const T &operator[](size_t index) const;
+    const_reference operator[](size_t index) const;
     void add(const T &value);
     const ArrayType &data() const;
     const ArrayType &asArray() const;
@@ -109,8 +199,66 @@ template <typename T> class Serie : public SerieBase {
     template <typename F> auto map(F &&callback) const;
     template <typename F, typename AccT> auto reduce(F &&, AccT) const;
 
+    /**
+     * @brief Missing values (nulls), stored Arrow-style in a validity bitmap:
+     * bit i is set if value i is valid. A Serie without null has no bitmap
+     * (validity() is empty), so integer columns do not need a sentinel or a
+     * double copy to represent missing values. The value stored at a null
+     * slot is NaN for floating point types, T{} otherwise.
+     *
+     * map(), as(), gather() and Mask::select() keep the nulls. set() and
+     * operator[] do not change the validity.
+     *
+     * @code
+     * df::Serie<int64_t> ages{31, 0, 45};
+     * ages.setNull(1);
+     * ages.add(28);
+     * ages.addNull();
+     * size_t n = ages.nullCount();       // 2
+     * auto known = ages.dropNulls();     // {31, 45, 28}
+     * @endcode
+     */
+    bool hasNulls() const;
+    size_t nullCount() const;
+    bool isNull(size_t index) const;
+    bool isValid(size_t index) const { return !isNull(index); }
+
+    /**
+     * @throws std::out_of_range if index >= size()
+     */
+    void setNull(size_t index, bool null = true);
+    void addNull();
+
+    const Mask &validity() const { return validity_; }
+
+    /**
+     * @brief Replace the validity bitmap (an empty mask removes it)
+     * @throws std::runtime_error if the mask size differs from size()
+     */
+    void setValidity(const Mask &validity);
+
+    /**
+     * @brief The valid values only
+     */
+    Serie dropNulls() const;
+
+    /**
+     * @brief Token identifying the current content: two Series with the same
+     * version hold the same values. Copies keep the version of their source,
+     * any change through the Serie (non-const operator[] or iterators, set,
+     * add, setNull...) gives a new one. O(1); used as a cache key by
+     * memoize() (see core/memoize.h).
+     */
+    uint64_t version() const { return version_.get(); }
+
   private:
+    template <typename U> friend class Serie;
+
+    static T missingValue();
+
     ArrayType data_;
+    Mask validity_;
+    detail::SerieVersion version_;
 };
 
 } // namespace df
@@ -119,3 +267,4 @@ template <typename T>
 std::ostream &operator<<(std::ostream &o, const df::Serie<T> &s);
 
 #include "inline/Serie.hxx"
+#include "inline/Mask.hxx"
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include "Serie.h"
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace df {
+
+/**
+ * @brief A string column stored Arrow-style: the bytes of all the values in
+ * one contiguous buffer, and an offsets array (value i is
+ * bytes[offsets[i], offsets[i + 1])).
+ *
+ * Serie<std::string> makes one heap allocation per value longer than the
+ * small string buffer. A StringSerie makes none per value: appending copies
+ * the characters at the end of the buffer, and the values are read as
+ * std::string_view. Copying, gathering and serializing a StringSerie move
+ * two flat arrays.
+ *
+ * Nulls are stored in a validity bitmap, as for Serie (see
+ * Serie::validity()). A null value is an empty view.
+ *
+ * The views are invalidated by add() (the buffer may grow), as the
+ * iterators of a std::vector.
+ *
+ * @code
+ * df::StringSerie cities{"Paris", "Lyon", "Paris"};
+ * std::string_view city = cities[1];
+ * auto sorted = df::sort(cities); // core/sort.h
+ * df::Dataframe frame;
+ * frame.add("city", std::make_shared<df::StringSerie>(cities));
+ * @endcode
+ */
+class StringSerie : public SerieBase {
+  public:
+    using value_type = std::string_view;
+    using Offset = uint64_t;
+
+    StringSerie() = default;
+    StringSerie(std::initializer_list<std::string_view> values);
+    explicit StringSerie(const Serie<std::string> &serie);
+
+    std::string type() const override { return "StringSerie"; }
+    int typeId() const override { return -1; }
+    size_t size() const override { return offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Reserve room for n values made of bytes characters in total
+     */
+    void reserve(size_t n, size_t bytes = 0);
+
+    void add(std::string_view value);
+    void addNull();
+
+    /**
+     * @throws std::out_of_range if index >= size()
+     */
+    std::string_view operator[](size_t index) const;
+
+    /**
+     * @brief Unchecked access, for the kernels
+     */
+    std::string_view view(size_t index) const {
+        return std::string_view(bytes_.data() + offsets_[index],
+                                offsets_[index + 1] - offsets_[index]);
+    }
+
+    const std::vector<Offset> &offsets() const { return offsets_; }
+    const std::vector<char> &bytes() const { return bytes_; }
+
+    // Missing values, as for Serie
+    bool hasNulls() const;
+    size_t nullCount() const;
+    bool isNull(size_t index) const;
+    bool isValid(size_t index) const { return !isNull(index); }
+    const Mask &validity() const { return validity_; }
+
+    /**
+     * @throws std::runtime_error if the mask size differs from size()
+     */
+    void setValidity(const Mask &validity);
+
+    std::shared_ptr<SerieBase>
+    gather(const std::vector<int64_t> &indices) const override;
+
+    /**
+     * @brief The values at the set bits of mask, nulls included
+     * @throws std::runtime_error if mask.size() != size()
+     */
+    StringSerie select(const Mask &mask) const;
+
+    /**
+     * @brief Copy of the values as std::string (nulls are kept)
+     */
+    Serie<std::string> toSerie() const;
+
+    template <typename F> void forEach(F &&callback) const;
+
+    /**
+     * @brief Hash of value i (std::hash<std::string_view>), computed on the
+     * bytes in place
+     */
+    size_t hash(size_t index) const;
+
+    /**
+     * @brief Lexicographic comparison of the values i and j: negative, zero
+     * or positive
+     */
+    int compare(size_t i, size_t j) const;
+
+  private:
+    std::vector<Offset> offsets_{0};
+    std::vector<char> bytes_;
+    Mask validity_;
+};
+
+} // namespace df
+
+#include "inline/StringSerie.hxx"
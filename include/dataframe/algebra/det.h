@@ -32,6 +32,8 @@ namespace df {
      *
      * This function applies the determinant operation to each FullMatrix element
      * in the input Serie, returning a Serie of scalar determinant values.
+     * Matrices are processed in batches (closed-form for 2x2 and 3x3, LU with
+     * partial pivoting up to 8x8), in parallel for large Series.
      *
      * @tparam T The element type (e.g., double, float)
      * @tparam N The matrix dimension (2 for 2x2, 3 for 3x3, etc.)
@@ -45,6 +47,7 @@ namespace df {
      *
      * This function applies the determinant operation to each SymmetricMatrix element
      * in the input Serie, returning a Serie of scalar determinant values.
+     * Same batched kernels as for FullMatrix.
      *
      * @tparam T The element type (e.g., double, float)
      * @tparam N The matrix dimension (2 for 2x2, 3 for 3x3, etc.)
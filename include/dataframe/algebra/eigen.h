@@ -35,6 +35,10 @@ namespace df {
     template <typename T, size_t N>
     using EigenSystem = std::pair<std::array<T, N>, FullMatrix<T, N>>;
 
+    /**
+     * @brief Eigenvalues, sorted in descending order. The 2x2 and 3x3
+     * floating point cases are dispatched to eigenValuesAnalytic.
+     */
     template <typename T, size_t N>
     Serie<std::array<T, N>> eigenValues(const Serie<SymmetricMatrix<T, N>>& serie);
 
@@ -44,6 +48,31 @@ namespace df {
     template <typename T, size_t N>
     Serie<EigenSystem<T, N>> eigenSystem(const Serie<SymmetricMatrix<T, N>>& serie);
 
+    /**
+     * @brief Batched closed-form solvers for 2x2 and 3x3 symmetric matrices.
+     *
+     * The matrices are processed by blocks, component by component, in
+     * parallel chunks. The eigenvalues come from the roots of the
+     * characteristic polynomial (trigonometric form for 3x3), the 3x3
+     * eigenvectors from cross products of the rows of (A - lambda I).
+     * Matrices with (nearly) repeated eigenvalues fall back to the Jacobi
+     * solver.
+     *
+     * Eigenvalues are sorted in descending order, eigenvectors are the
+     * columns of the FullMatrix. The 2x2 eigenvectors match the ones of
+     * eigenVectors. For 3x3, the largest component of the first and last
+     * eigenvectors is positive, and the frame is right-handed.
+     */
+    template <typename T, size_t N>
+    Serie<std::array<T, N>> eigenValuesAnalytic(const Serie<SymmetricMatrix<T, N>>& serie);
+
+    template <typename T, size_t N>
+    Serie<FullMatrix<T, N>> eigenVectorsAnalytic(const Serie<SymmetricMatrix<T, N>>& serie);
+
+    template <typename T, size_t N>
+    Serie<EigenSystem<T, N>> eigenSystemAnalytic(const Serie<SymmetricMatrix<T, N>>& serie);
+
 } // namespace df
 
 #include "inline/eigen.hxx"
+#include "inline/eigen_analytic.hxx"
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <dataframe/algebra/types.h>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/utils.h>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Batched kernels for small dense matrices (N <= 8).
+ *
+ * The matrices of a Serie are processed by blocks of batch_lanes elements,
+ * stored component by component (a[i][j][lane]), so that every loop over
+ * the lanes is branch-free and can be vectorized by the compiler. Blocks are
+ * distributed over parallel chunks for large Series.
+ */
+
+namespace df {
+    namespace detail {
+
+        constexpr size_t batch_lanes = 8;
+
+        // Below this size, the batched kernels run on a single thread
+        constexpr size_t batch_parallel_threshold = 4096;
+
+        template <typename T, size_t R, size_t C> using LaneBlock = T[R][C][batch_lanes];
+
+        /**
+         * Run kernel(start, count) on the blocks of lanes covering [0, n)
+         */
+        template <typename F> void for_each_lane_block(size_t n, F&& kernel)
+        {
+            const size_t num_chunks
+                = n < batch_parallel_threshold ? 1 : get_optimal_threads(n / 4);
+            parallel_for_chunks(n, num_chunks, [&](size_t, size_t start, size_t end) {
+                for (size_t b = start; b < end; b += batch_lanes) {
+                    kernel(b, std::min(batch_lanes, end - b));
+                }
+            });
+        }
+
+        // Load matrices into the first N columns of a lane block
+        template <typename T, size_t N, size_t C, typename MAT>
+        void load_lanes(const MAT* m, size_t count, LaneBlock<T, N, C>& a)
+        {
+            for (size_t l = 0; l < count; ++l) {
+                for (size_t i = 0; i < N; ++i) {
+                    for (size_t j = 0; j < N; ++j) {
+                        a[i][j][l] = m[l](i, j);
+                    }
+                }
+            }
+        }
+
+        // Singularity threshold of each lane: N eps max|a_ij|
+        template <typename T, size_t N, size_t C>
+        void singular_tolerance(const LaneBlock<T, N, C>& a, size_t count, T* tol)
+        {
+            for (size_t l = 0; l < count; ++l) {
+                tol[l] = T(0);
+            }
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    for (size_t l = 0; l < count; ++l) {
+                        tol[l] = std::max(tol[l], std::abs(a[i][j][l]));
+                    }
+                }
+            }
+            for (size_t l = 0; l < count; ++l) {
+                tol[l] *= T(N) * std::numeric_limits<T>::epsilon();
+            }
+        }
+
+        /**
+         * Gaussian elimination with partial pivoting on [A | B], where A is
+         * NxN and B has C - N columns. On output, A holds U and B the
+         * transformed right-hand sides. Row swaps are applied with masks, the
+         * pivot row being different from one lane to another.
+         * @param det Determinant of each lane
+         * @param singular Set for lanes with a pivot below the tolerance
+         */
+        template <typename T, size_t N, size_t C>
+        void gauss_lanes(LaneBlock<T, N, C>& a, size_t count, T* det, bool* singular)
+        {
+            T tol[batch_lanes] {};
+            singular_tolerance<T, N, C>(a, count, tol);
+            for (size_t l = 0; l < count; ++l) {
+                det[l] = T(1);
+                singular[l] = false;
+            }
+
+            for (size_t k = 0; k < N; ++k) {
+                T best[batch_lanes] {};
+                size_t pivot[batch_lanes] {};
+                for (size_t l = 0; l < count; ++l) {
+                    best[l] = std::abs(a[k][k][l]);
+                    pivot[l] = k;
+                }
+                for (size_t r = k + 1; r < N; ++r) {
+                    for (size_t l = 0; l < count; ++l) {
+                        const T v = std::abs(a[r][k][l]);
+                        const bool larger = v > best[l];
+                        best[l] = larger ? v : best[l];
+                        pivot[l] = larger ? r : pivot[l];
+                    }
+                }
+
+                for (size_t r = k + 1; r < N; ++r) {
+                    for (size_t j = k; j < C; ++j) {
+                        for (size_t l = 0; l < count; ++l) {
+                            const bool swap = pivot[l] == r;
+                            const T x = a[k][j][l], y = a[r][j][l];
+                            a[k][j][l] = swap ? y : x;
+                            a[r][j][l] = swap ? x : y;
+                        }
+                    }
+                }
+
+                T inv[batch_lanes] {};
+                for (size_t l = 0; l < count; ++l) {
+                    const T p = a[k][k][l];
+                    det[l] *= pivot[l] == k ? p : -p;
+                    singular[l] = singular[l] || !(std::abs(p) > tol[l]);
+                    inv[l] = p != T(0) ? T(1) / p : T(0);
+                }
+
+                for (size_t r = k + 1; r < N; ++r) {
+                    T f[batch_lanes] {};
+                    for (size_t l = 0; l < count; ++l) {
+                        f[l] = a[r][k][l] * inv[l];
+                    }
+                    for (size_t j = k + 1; j < C; ++j) {
+                        for (size_t l = 0; l < count; ++l) {
+                            a[r][j][l] -= f[l] * a[k][j][l];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Back substitution U x = b for the C - N right-hand sides of a
+        // block reduced by gauss_lanes. The solutions replace the rhs.
+        template <typename T, size_t N, size_t C>
+        void back_substitute_lanes(LaneBlock<T, N, C>& a, size_t count)
+        {
+            for (size_t c = N; c < C; ++c) {
+                for (size_t i = N; i-- > 0;) {
+                    for (size_t l = 0; l < count; ++l) {
+                        T s = a[i][c][l];
+                        for (size_t j = i + 1; j < N; ++j) {
+                            s -= a[i][j][l] * a[j][c][l];
+                        }
+                        a[i][c][l] = s / a[i][i][l];
+                    }
+                }
+            }
+        }
+
+        /**
+         * In-place Cholesky factorization A = L L^T (lower part of a) and
+         * solve of A x = b. No pivoting, so all the lanes follow the same
+         * path.
+         * @param failed Set for lanes that are not (numerically) positive
+         * definite. Their solution is meaningless.
+         */
+        template <typename T, size_t N>
+        void cholesky_solve_lanes(
+            LaneBlock<T, N, N + 1>& a, size_t count, bool* failed)
+        {
+            T tol[batch_lanes] {};
+            singular_tolerance<T, N, N + 1>(a, count, tol);
+            for (size_t l = 0; l < count; ++l) {
+                failed[l] = false;
+            }
+
+            for (size_t k = 0; k < N; ++k) {
+                T inv[batch_lanes] {};
+                for (size_t l = 0; l < count; ++l) {
+                    T d = a[k][k][l];
+                    for (size_t p = 0; p < k; ++p) {
+                        d -= a[k][p][l] * a[k][p][l];
+                    }
+                    failed[l] = failed[l] || !(d > tol[l]);
+                    d = std::sqrt(std::max(d, tol[l]));
+                    a[k][k][l] = d;
+                    inv[l] = d > T(0) ? T(1) / d : T(0);
+                }
+                for (size_t i = k + 1; i < N; ++i) {
+                    for (size_t l = 0; l < count; ++l) {
+                        T s = a[i][k][l];
+                        for (size_t p = 0; p < k; ++p) {
+                            s -= a[i][p][l] * a[k][p][l];
+                        }
+                        a[i][k][l] = s * inv[l];
+                    }
+                }
+            }
+
+            // L y = b, then L^T x = y
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t l = 0; l < count; ++l) {
+                    T s = a[i][N][l];
+                    for (size_t p = 0; p < i; ++p) {
+                        s -= a[i][p][l] * a[p][N][l];
+                    }
+                    a[i][N][l] = s / a[i][i][l];
+                }
+            }
+            for (size_t i = N; i-- > 0;) {
+                for (size_t l = 0; l < count; ++l) {
+                    T s = a[i][N][l];
+                    for (size_t p = i + 1; p < N; ++p) {
+                        s -= a[p][i][l] * a[p][N][l];
+                    }
+                    a[i][N][l] = s / a[i][i][l];
+                }
+            }
+        }
+
+        // Closed-form determinants of 2x2 and 3x3 lane blocks
+        template <typename T, size_t N, size_t C>
+        void det_closed_form_lanes(const LaneBlock<T, N, C>& a, size_t count, T* det)
+        {
+            static_assert(N == 2 || N == 3);
+            for (size_t l = 0; l < count; ++l) {
+                if constexpr (N == 2) {
+                    det[l] = a[0][0][l] * a[1][1][l] - a[0][1][l] * a[1][0][l];
+                } else {
+                    det[l] = a[0][0][l] * (a[1][1][l] * a[2][2][l] - a[1][2][l] * a[2][1][l])
+                        - a[0][1][l] * (a[1][0][l] * a[2][2][l] - a[1][2][l] * a[2][0][l])
+                        + a[0][2][l] * (a[1][0][l] * a[2][1][l] - a[1][1][l] * a[2][0][l]);
+                }
+            }
+        }
+
+        // Singularity test of closed-form determinants: |det| <= N eps max|a_ij|^N
+        template <typename T, size_t N, size_t C>
+        void singular_closed_form(
+            const LaneBlock<T, N, C>& a, const T* det, size_t count, bool* singular)
+        {
+            T tol[batch_lanes] {};
+            singular_tolerance<T, N, C>(a, count, tol);
+            for (size_t l = 0; l < count; ++l) {
+                const T scale = tol[l] / (T(N) * std::numeric_limits<T>::epsilon());
+                singular[l] = !(std::abs(det[l]) > tol[l] * (N == 2 ? scale : scale * scale));
+            }
+        }
+
+        // Closed-form inverse (adjugate / det) of 2x2 and 3x3 lane blocks
+        template <typename T, size_t N>
+        void inv_closed_form_lanes(const LaneBlock<T, N, N>& a, const T* det, size_t count,
+            LaneBlock<T, N, N>& r)
+        {
+            static_assert(N == 2 || N == 3);
+            for (size_t l = 0; l < count; ++l) {
+                const T d = det[l] != T(0) ? T(1) / det[l] : T(0);
+                if constexpr (N == 2) {
+                    r[0][0][l] = a[1][1][l] * d;
+                    r[0][1][l] = -a[0][1][l] * d;
+                    r[1][0][l] = -a[1][0][l] * d;
+                    r[1][1][l] = a[0][0][l] * d;
+                } else {
+                    r[0][0][l] = (a[1][1][l] * a[2][2][l] - a[1][2][l] * a[2][1][l]) * d;
+                    r[0][1][l] = (a[0][2][l] * a[2][1][l] - a[0][1][l] * a[2][2][l]) * d;
+                    r[0][2][l] = (a[0][1][l] * a[1][2][l] - a[0][2][l] * a[1][1][l]) * d;
+                    r[1][0][l] = (a[1][2][l] * a[2][0][l] - a[1][0][l] * a[2][2][l]) * d;
+                    r[1][1][l] = (a[0][0][l] * a[2][2][l] - a[0][2][l] * a[2][0][l]) * d;
+                    r[1][2][l] = (a[0][2][l] * a[1][0][l] - a[0][0][l] * a[1][2][l]) * d;
+                    r[2][0][l] = (a[1][0][l] * a[2][1][l] - a[1][1][l] * a[2][0][l]) * d;
+                    r[2][1][l] = (a[0][1][l] * a[2][0][l] - a[0][0][l] * a[2][1][l]) * d;
+                    r[2][2][l] = (a[0][0][l] * a[1][1][l] - a[0][1][l] * a[1][0][l]) * d;
+                }
+            }
+        }
+
+        template <typename T, size_t N> void check_matrix_size()
+        {
+            static_assert(std::is_floating_point_v<T>, "batched kernels require floating points");
+            static_assert(N >= 1 && N <= 8, "batched kernels support 1x1 to 8x8 matrices");
+        }
+
+        /**
+         * Determinant of every matrix (FullMatrix or SymmetricMatrix)
+         */
+        template <typename T, size_t N, typename MAT>
+        Serie<T> batched_det(const Serie<MAT>& serie)
+        {
+            check_matrix_size<T, N>();
+            const MAT* m = serie.data().data();
+            std::vector<T> result(serie.size());
+
+            for_each_lane_block(serie.size(), [&](size_t start, size_t count) {
+                LaneBlock<T, N, N> a;
+                load_lanes<T, N, N>(m + start, count, a);
+                if constexpr (N == 2 || N == 3) {
+                    det_closed_form_lanes<T, N, N>(a, count, result.data() + start);
+                } else {
+                    bool singular[batch_lanes] {};
+                    gauss_lanes<T, N, N>(a, count, result.data() + start, singular);
+                }
+            });
+            return Serie<T>(result);
+        }
+
+        /**
+         * Inverse of every matrix (FullMatrix or SymmetricMatrix)
+         * @throws std::runtime_error if a matrix is singular
+         */
+        template <typename T, size_t N, typename MAT>
+        Serie<MAT> batched_inv(const Serie<MAT>& serie)
+        {
+            check_matrix_size<T, N>();
+            const MAT* m = serie.data().data();
+            std::vector<MAT> result(serie.size());
+
+            for_each_lane_block(serie.size(), [&](size_t start, size_t count) {
+                T det[batch_lanes] {};
+                bool singular[batch_lanes] {};
+                LaneBlock<T, N, N> inverse;
+
+                if constexpr (N == 2 || N == 3) {
+                    LaneBlock<T, N, N> a;
+                    load_lanes<T, N, N>(m + start, count, a);
+                    det_closed_form_lanes<T, N, N>(a, count, det);
+                    singular_closed_form<T, N, N>(a, det, count, singular);
+                    inv_closed_form_lanes<T, N>(a, det, count, inverse);
+                } else {
+                    // Gauss-Jordan on [A | I]
+                    LaneBlock<T, N, 2 * N> a;
+                    load_lanes<T, N, 2 * N>(m + start, count, a);
+                    for (size_t i = 0; i < N; ++i) {
+                        for (size_t j = 0; j < N; ++j) {
+                            for (size_t l = 0; l < count; ++l) {
+                                a[i][N + j][l] = i == j ? T(1) : T(0);
+                            }
+                        }
+                    }
+                    gauss_lanes<T, N, 2 * N>(a, count, det, singular);
+                    back_substitute_lanes<T, N, 2 * N>(a, count);
+                    for (size_t i = 0; i < N; ++i) {
+                        for (size_t j = 0; j < N; ++j) {
+                            for (size_t l = 0; l < count; ++l) {
+                                inverse[i][j][l] = a[i][N + j][l];
+                            }
+                        }
+                    }
+                }
+
+                for (size_t l = 0; l < count; ++l) {
+                    if (singular[l]) {
+                        throw std::runtime_error(
+                            concat("Matrix is singular (index ", start + l, ")"));
+                    }
+                    MAT& r = result[start + l];
+                    for (size_t i = 0; i < N; ++i) {
+                        for (size_t j = 0; j < N; ++j) {
+                            r(i, j) = inverse[i][j][l];
+                        }
+                    }
+                }
+            });
+            return Serie<MAT>(result);
+        }
+
+        /**
+         * Solution of A_i x_i = b_i for every element. Symmetric matrices
+         * are first tried with Cholesky, lanes that are not positive
+         * definite being solved again with Gaussian elimination.
+         * @throws std::runtime_error if a matrix is singular
+         */
+        template <typename T, size_t N, typename MAT>
+        Serie<Vector<T, N>> batched_solve(const Serie<MAT>& A, const Serie<Vector<T, N>>& b)
+        {
+            check_matrix_size<T, N>();
+            if (A.size() != b.size()) {
+                throw std::invalid_argument(concat("solve: the Series of matrices (size ",
+                    A.size(), ") and of vectors (size ", b.size(), ") differ in size"));
+            }
+
+            const MAT* m = A.data().data();
+            const Vector<T, N>* v = b.data().data();
+            std::vector<Vector<T, N>> result(A.size());
+
+            auto load = [&](LaneBlock<T, N, N + 1>& a, size_t start, size_t count) {
+                load_lanes<T, N, N + 1>(m + start, count, a);
+                for (size_t i = 0; i < N; ++i) {
+                    for (size_t l = 0; l < count; ++l) {
+                        a[i][N][l] = v[start + l][i];
+                    }
+                }
+            };
+
+            for_each_lane_block(A.size(), [&](size_t start, size_t count) {
+                LaneBlock<T, N, N + 1> a;
+                bool singular[batch_lanes] {};
+                load(a, start, count);
+
+                bool cholesky = false;
+                if constexpr (std::is_same_v<MAT, SymmetricMatrix<T, N>>) {
+                    cholesky_solve_lanes<T, N>(a, count, singular);
+                    cholesky = std::none_of(singular, singular + count, [](bool s) { return s; });
+                }
+                if (!cholesky) {
+                    T det[batch_lanes] {};
+                    load(a, start, count);
+                    gauss_lanes<T, N, N + 1>(a, count, det, singular);
+                    back_substitute_lanes<T, N, N + 1>(a, count);
+                }
+
+                for (size_t l = 0; l < count; ++l) {
+                    if (singular[l]) {
+                        throw std::runtime_error(
+                            concat("Matrix is singular (index ", start + l, ")"));
+                    }
+                    for (size_t i = 0; i < N; ++i) {
+                        result[start + l][i] = a[i][N][l];
+                    }
+                }
+            });
+            return Serie<Vector<T, N>>(result);
+        }
+
+    } // namespace detail
+} // namespace df
@@ -1,16 +1,29 @@
+#include <dataframe/algebra/inline/batched.hxx>
+
 namespace df {
 
+    // The batched kernels handle floating point matrices up to 8x8, other
+    // matrices are processed one by one
     template <typename T, std::size_t N> inline Serie<T> det(const Serie<FullMatrix<T, N>>& serie)
     {
-        return serie.map(
-            [](const FullMatrix<T, N>& matrix, size_t) -> T { return matrix.determinant(); });
+        if constexpr (std::is_floating_point_v<T> && N <= 8) {
+            return detail::batched_det<T, N>(serie);
+        } else {
+            return serie.map(
+                [](const FullMatrix<T, N>& matrix, size_t) -> T { return matrix.determinant(); });
+        }
     }
 
     template <typename T, std::size_t N>
     inline Serie<T> det(const Serie<SymmetricMatrix<T, N>>& serie)
     {
-        return serie.map(
-            [](const SymmetricMatrix<T, N>& matrix, size_t) -> T { return matrix.determinant(); });
+        if constexpr (std::is_floating_point_v<T> && N <= 8) {
+            return detail::batched_det<T, N>(serie);
+        } else {
+            return serie.map([](const SymmetricMatrix<T, N>& matrix, size_t) -> T {
+                return matrix.determinant();
+            });
+        }
     }
 
     template <typename T, std::size_t N> inline auto bind_det_fullmatrix()
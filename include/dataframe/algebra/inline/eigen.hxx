@@ -159,10 +159,14 @@ namespace df {
     {
         static_assert(std::is_arithmetic<T>::value, "eigenValues requires arithmetic type");
 
-        return serie.map([](const auto& mat, size_t index) {
-            auto result = jacobi_symmetric_eigen(mat);
-            return result.first;
-        });
+        if constexpr ((N == 2 || N == 3) && std::is_floating_point_v<T>) {
+            return eigenValuesAnalytic(serie);
+        } else {
+            return serie.map([](const auto& mat, size_t index) {
+                auto result = jacobi_symmetric_eigen(mat);
+                return result.first;
+            });
+        }
     }
 
     template <typename T, size_t N>
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dataframe/core/parallel_map.h>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+namespace df {
+    namespace detail {
+
+        // Number of matrices processed together, component by component
+        // (structure of arrays), so that the lane loops can be vectorized
+        constexpr size_t eigen_lanes = 16;
+
+        // Below this size, the batched solvers run on a single thread
+        constexpr size_t eigen_parallel_threshold = 4096;
+
+        /**
+         * Closed-form 2x2 solver on one block of lanes. Eigenvalues are
+         * mean +- radius, the eigenvectors are the rotation of angle
+         * atan2(2 xy, xx - yy) / 2.
+         */
+        template <typename T, bool WithVectors>
+        void eigen2_block(const SymmetricMatrix<T, 2>* in, size_t count,
+            std::array<T, 2>* values, FullMatrix<T, 2>* vectors)
+        {
+            T xx[eigen_lanes] {}, xy[eigen_lanes] {}, yy[eigen_lanes] {};
+            T w0[eigen_lanes] {}, w1[eigen_lanes] {};
+            for (size_t l = 0; l < count; ++l) {
+                const auto& m = in[l].data();
+                xx[l] = m[0];
+                xy[l] = m[1];
+                yy[l] = m[2];
+            }
+
+            for (size_t l = 0; l < count; ++l) {
+                const T mean = (xx[l] + yy[l]) / T(2);
+                const T radius = std::hypot((xx[l] - yy[l]) / T(2), xy[l]);
+                w0[l] = mean + radius;
+                w1[l] = mean - radius;
+            }
+
+            for (size_t l = 0; l < count; ++l) {
+                values[l] = { w0[l], w1[l] };
+            }
+
+            if constexpr (WithVectors) {
+                T c[eigen_lanes] {}, s[eigen_lanes] {};
+                for (size_t l = 0; l < count; ++l) {
+                    const T theta = std::atan2(T(2) * xy[l], xx[l] - yy[l]) / T(2);
+                    c[l] = std::cos(theta);
+                    s[l] = std::sin(theta);
+                }
+                for (size_t l = 0; l < count; ++l) {
+                    auto& v = vectors[l].data(); // column-major
+                    v = { c[l], s[l], -s[l], c[l] };
+                }
+            }
+        }
+
+        /**
+         * Closed-form 3x3 eigenvalues (trigonometric solution of the
+         * characteristic polynomial of the deviatoric part), sorted in
+         * descending order. Branch-free over the lanes.
+         */
+        template <typename T>
+        void eigen3_values(const T* xx, const T* xy, const T* xz, const T* yy, const T* yz,
+            const T* zz, T* w0, T* w1, T* w2, size_t count)
+        {
+            constexpr T third = T(1) / T(3);
+            constexpr T two_pi_3 = T(2) * std::numbers::pi_v<T> / T(3);
+
+            for (size_t l = 0; l < count; ++l) {
+                const T q = (xx[l] + yy[l] + zz[l]) * third;
+                const T a = xx[l] - q, b = yy[l] - q, c = zz[l] - q;
+                const T p1 = xy[l] * xy[l] + xz[l] * xz[l] + yz[l] * yz[l];
+                const T p2 = a * a + b * b + c * c + T(2) * p1;
+                const T p = std::sqrt(p2 / T(6));
+                const T inv = p > T(0) ? T(1) / p : T(0);
+
+                // det((A - qI) / p) / 2
+                const T ba = a * inv, bb = b * inv, bc = c * inv;
+                const T bxy = xy[l] * inv, bxz = xz[l] * inv, byz = yz[l] * inv;
+                T r = (ba * (bb * bc - byz * byz) - bxy * (bxy * bc - byz * bxz)
+                          + bxz * (bxy * byz - bb * bxz))
+                    / T(2);
+                r = std::clamp(r, T(-1), T(1));
+
+                const T phi = std::acos(r) * third;
+                w0[l] = q + T(2) * p * std::cos(phi);
+                w2[l] = q + T(2) * p * std::cos(phi + two_pi_3);
+                // Round-off may break the ordering of (nearly) equal roots
+                w1[l] = std::clamp(T(3) * q - w0[l] - w2[l], w2[l], w0[l]);
+            }
+        }
+
+        // Cross product of the two rows of (A - wI) giving the largest
+        // result: a vector of the null space of (A - wI)
+        template <typename T>
+        inline void eigen3_null_vector(T xx, T xy, T xz, T yy, T yz, T zz, T w, T* v, T& norm2)
+        {
+            const T r0[3] = { xx - w, xy, xz };
+            const T r1[3] = { xy, yy - w, yz };
+            const T r2[3] = { xz, yz, zz - w };
+
+            auto cross = [](const T* a, const T* b, T* out) {
+                out[0] = a[1] * b[2] - a[2] * b[1];
+                out[1] = a[2] * b[0] - a[0] * b[2];
+                out[2] = a[0] * b[1] - a[1] * b[0];
+                return out[0] * out[0] + out[1] * out[1] + out[2] * out[2];
+            };
+
+            T c01[3], c02[3], c12[3];
+            const T n01 = cross(r0, r1, c01);
+            const T n02 = cross(r0, r2, c02);
+            const T n12 = cross(r1, r2, c12);
+            const T* best = n01 >= n02 ? (n01 >= n12 ? c01 : c12) : (n02 >= n12 ? c02 : c12);
+            norm2 = std::max(n01, std::max(n02, n12));
+            v[0] = best[0];
+            v[1] = best[1];
+            v[2] = best[2];
+        }
+
+        // Normalize, with the largest component made positive
+        template <typename T> inline void eigen3_canonical(T* v, T norm2)
+        {
+            const T inv = T(1) / std::sqrt(norm2);
+            const size_t k = std::abs(v[0]) >= std::abs(v[1])
+                ? (std::abs(v[0]) >= std::abs(v[2]) ? 0 : 2)
+                : (std::abs(v[1]) >= std::abs(v[2]) ? 1 : 2);
+            const T s = v[k] < T(0) ? -inv : inv;
+            v[0] *= s;
+            v[1] *= s;
+            v[2] *= s;
+        }
+
+        /**
+         * Hybrid 3x3 solver on one block of lanes (in the spirit of Kopp's
+         * dsyevh3): closed-form eigenvalues, eigenvectors of the extreme
+         * eigenvalues from cross products of the rows of (A - wI), the middle
+         * one completing a right-handed frame. Matrices with (nearly)
+         * repeated eigenvalues, where the cross products are inaccurate,
+         * fall back to the Jacobi solver.
+         */
+        template <typename T, bool WithVectors>
+        void eigen3_block(const SymmetricMatrix<T, 3>* in, size_t count,
+            std::array<T, 3>* values, FullMatrix<T, 3>* vectors)
+        {
+            T xx[eigen_lanes] {}, xy[eigen_lanes] {}, xz[eigen_lanes] {};
+            T yy[eigen_lanes] {}, yz[eigen_lanes] {}, zz[eigen_lanes] {};
+            T w0[eigen_lanes] {}, w1[eigen_lanes] {}, w2[eigen_lanes] {};
+            for (size_t l = 0; l < count; ++l) {
+                const auto& m = in[l].data();
+                xx[l] = m[0];
+                xy[l] = m[1];
+                xz[l] = m[2];
+                yy[l] = m[3];
+                yz[l] = m[4];
+                zz[l] = m[5];
+            }
+
+            eigen3_values(xx, xy, xz, yy, yz, zz, w0, w1, w2, count);
+
+            for (size_t l = 0; l < count; ++l) {
+                values[l] = { w0[l], w1[l], w2[l] };
+            }
+
+            if constexpr (WithVectors) {
+                const T eps = std::numeric_limits<T>::epsilon();
+                for (size_t l = 0; l < count; ++l) {
+                    const T scale = std::max(std::abs(w0[l]), std::abs(w2[l]));
+                    const T gap = std::min(w0[l] - w1[l], w1[l] - w2[l]);
+
+                    T v0[3], v2[3], n0, n2;
+                    eigen3_null_vector(xx[l], xy[l], xz[l], yy[l], yz[l], zz[l], w0[l], v0, n0);
+                    eigen3_null_vector(xx[l], xy[l], xz[l], yy[l], yz[l], zz[l], w2[l], v2, n2);
+
+                    // The cross products are of order gap^2: below, they
+                    // are dominated by round-off
+                    const T threshold = T(1e4) * eps * scale;
+                    if (!(gap > threshold) || !(n0 > T(0)) || !(n2 > T(0))) {
+                        auto system = jacobi_symmetric_eigen(in[l], T(64) * eps * scale);
+                        values[l] = system.first;
+                        vectors[l] = system.second;
+                        continue;
+                    }
+
+                    eigen3_canonical(v0, n0);
+                    eigen3_canonical(v2, n2);
+                    // v1 = v2 x v0, so that (v0, v1, v2) is right-handed
+                    const T v1[3] = { v2[1] * v0[2] - v2[2] * v0[1], v2[2] * v0[0] - v2[0] * v0[2],
+                        v2[0] * v0[1] - v2[1] * v0[0] };
+
+                    auto& v = vectors[l].data(); // column-major
+                    v = { v0[0], v0[1], v0[2], v1[0], v1[1], v1[2], v2[0], v2[1], v2[2] };
+                }
+            }
+        }
+
+        template <typename T, size_t N, bool WithVectors>
+        void eigen_analytic(const Serie<SymmetricMatrix<T, N>>& serie, std::array<T, N>* values,
+            FullMatrix<T, N>* vectors)
+        {
+            static_assert(N == 2 || N == 3, "closed-form eigen solvers exist for N = 2 and 3");
+            static_assert(std::is_floating_point_v<T>, "eigen solvers require floating points");
+
+            const auto& data = serie.data();
+            const size_t n = data.size();
+            const size_t num_chunks
+                = n < eigen_parallel_threshold ? 1 : get_optimal_threads(n / 4);
+
+            parallel_for_chunks(n, num_chunks, [&](size_t, size_t start, size_t end) {
+                for (size_t b = start; b < end; b += eigen_lanes) {
+                    const size_t count = std::min(eigen_lanes, end - b);
+                    FullMatrix<T, N>* out = WithVectors ? vectors + b : nullptr;
+                    if constexpr (N == 2) {
+                        eigen2_block<T, WithVectors>(data.data() + b, count, values + b, out);
+                    } else {
+                        eigen3_block<T, WithVectors>(data.data() + b, count, values + b, out);
+                    }
+                }
+            });
+        }
+
+    } // namespace detail
+
+    template <typename T, size_t N>
+    inline Serie<std::array<T, N>> eigenValuesAnalytic(const Serie<SymmetricMatrix<T, N>>& serie)
+    {
+        std::vector<std::array<T, N>> values(serie.size());
+        detail::eigen_analytic<T, N, false>(serie, values.data(), nullptr);
+        return Serie<std::array<T, N>>(values);
+    }
+
+    template <typename T, size_t N>
+    inline Serie<FullMatrix<T, N>> eigenVectorsAnalytic(const Serie<SymmetricMatrix<T, N>>& serie)
+    {
+        std::vector<std::array<T, N>> values(serie.size());
+        std::vector<FullMatrix<T, N>> vectors(serie.size());
+        detail::eigen_analytic<T, N, true>(serie, values.data(), vectors.data());
+        return Serie<FullMatrix<T, N>>(vectors);
+    }
+
+    template <typename T, size_t N>
+    inline Serie<EigenSystem<T, N>> eigenSystemAnalytic(const Serie<SymmetricMatrix<T, N>>& serie)
+    {
+        std::vector<std::array<T, N>> values(serie.size());
+        std::vector<FullMatrix<T, N>> vectors(serie.size());
+        detail::eigen_analytic<T, N, true>(serie, values.data(), vectors.data());
+
+        std::vector<EigenSystem<T, N>> result;
+        result.reserve(serie.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            result.emplace_back(values[i], vectors[i]);
+        }
+        return Serie<EigenSystem<T, N>>(result);
+    }
+
+} // namespace df
@@ -16,6 +16,7 @@
 #include <array>
 #include <cmath>
 #include <dataframe/Serie.h>
+#include <dataframe/algebra/inline/batched.hxx>
 #include <dataframe/algebra/types.h>
 #include <dataframe/utils/utils.h>
 #include <stdexcept>
@@ -290,6 +291,26 @@ namespace df {
         return serie.map([](const MAT& m, size_t) { return m.inverse(); });
     }
 
+    template <typename T, size_t N>
+    inline Serie<FullMatrix<T, N>> inv(const Serie<FullMatrix<T, N>>& serie)
+    {
+        if constexpr (std::is_floating_point_v<T> && N <= 8) {
+            return detail::batched_inv<T, N>(serie);
+        } else {
+            return serie.map([](const FullMatrix<T, N>& m, size_t) { return m.inverse(); });
+        }
+    }
+
+    template <typename T, size_t N>
+    inline Serie<SymmetricMatrix<T, N>> inv(const Serie<SymmetricMatrix<T, N>>& serie)
+    {
+        if constexpr (std::is_floating_point_v<T> && N <= 8) {
+            return detail::batched_inv<T, N>(serie);
+        } else {
+            return serie.map([](const SymmetricMatrix<T, N>& m, size_t) { return m.inverse(); });
+        }
+    }
+
     template <typename T, size_t N>
     inline Serie<std::array<T, N>> inv(const Serie<std::array<T, N>>& serie)
     {
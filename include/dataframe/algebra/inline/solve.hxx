@@ -22,6 +22,7 @@
  */
 
 #include <Eigen/Dense>
+#include <dataframe/algebra/inline/batched.hxx>
 
 namespace df {
 
@@ -61,6 +62,18 @@ template <typename T> inline Serie<T> solve(const Serie<T> &A, const Serie<T> &b
     return Serie<T>(result);
 }
 
+template <typename T, size_t N>
+inline Serie<Vector<T, N>> solve(const Serie<FullMatrix<T, N>> &A,
+                                 const Serie<Vector<T, N>> &b) {
+    return detail::batched_solve<T, N>(A, b);
+}
+
+template <typename T, size_t N>
+inline Serie<Vector<T, N>> solve(const Serie<SymmetricMatrix<T, N>> &A,
+                                 const Serie<Vector<T, N>> &b) {
+    return detail::batched_solve<T, N>(A, b);
+}
+
 // Helper function for pipe operations
 template <typename T> inline auto bind_solve(const Serie<T> &b) {
     return [&b](const Serie<T> &A) { return solve(A, b); };
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/utils.h>
+#include <stdexcept>
+
+namespace df {
+
+    inline double CSRMatrix::operator()(size_t i, size_t j) const
+    {
+        for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+            if (columns[k] == j) {
+                return values[k];
+            }
+        }
+        return 0;
+    }
+
+    inline Serie<double> CSRMatrix::diagonal() const
+    {
+        std::vector<double> d(rows());
+        for (size_t i = 0; i < d.size(); ++i) {
+            d[i] = (*this)(i, i);
+        }
+        return Serie<double>(d);
+    }
+
+    template <typename T> Serie<T> CSRMatrix::multiply(const Serie<T>& x) const
+    {
+        if (x.size() != cols) {
+            throw std::runtime_error(
+                concat("CSRMatrix::multiply: expected ", cols, " values, got ", x.size()));
+        }
+        const size_t n = rows();
+        std::vector<T> y(n);
+        const T* xs = x.data().data();
+        detail::parallel_for_chunks(n, std::min(n, detail::get_optimal_threads(nonZeros())),
+            [&](size_t, size_t start, size_t end) {
+                for (size_t i = start; i < end; ++i) {
+                    T acc {};
+                    for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                        acc += xs[columns[k]] * values[k];
+                    }
+                    y[i] = acc;
+                }
+            });
+        return Serie<T>(y);
+    }
+
+    template <typename T> Serie<T> operator*(const CSRMatrix& A, const Serie<T>& x)
+    {
+        return A.multiply(x);
+    }
+
+} // namespace df
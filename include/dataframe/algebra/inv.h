@@ -30,6 +30,18 @@ namespace df {
      * @throws std::runtime_error if matrix is singular or dimension not supported
      */
     template <typename MAT> Serie<MAT> inv(const Serie<MAT>& serie);
+
+    /**
+     * Batched inverse of FullMatrix and SymmetricMatrix (1x1 to 8x8), in
+     * parallel for large Series. Closed-form for 2x2 and 3x3, Gauss-Jordan
+     * with partial pivoting otherwise.
+     * @throws std::runtime_error if a matrix is singular (pivot, or
+     * determinant for 2x2 and 3x3, below N eps max|a_ij| to the power 1 or N)
+     */
+    template <typename T, size_t N>
+    Serie<FullMatrix<T, N>> inv(const Serie<FullMatrix<T, N>>& serie);
+    template <typename T, size_t N>
+    Serie<SymmetricMatrix<T, N>> inv(const Serie<SymmetricMatrix<T, N>>& serie);
     template <typename T, size_t N> Serie<std::array<T, N>> inv(const Serie<std::array<T, N>>& serie);
 
     template <typename MAT> auto bind_inv();
@@ -23,6 +23,7 @@
 
 #pragma once
 #include <dataframe/Serie.h>
+#include <dataframe/algebra/types.h>
 
 namespace df {
 
@@ -34,6 +35,22 @@ namespace df {
  */
 template <typename T> Serie<T> solve(const Serie<T> &A, const Serie<T> &b);
 
+/**
+ * @brief Solves A_i x_i = b_i for every element of the Series (1x1 to 8x8
+ * systems, e.g. per-cell 3x3 or 6x6 updates). The systems are processed in
+ * batches, in parallel for large Series: Gaussian elimination with partial
+ * pivoting for FullMatrix, Cholesky for SymmetricMatrix (with a fallback on
+ * Gaussian elimination for matrices that are not positive definite).
+ * @throws std::invalid_argument if A and b differ in size
+ * @throws std::runtime_error if a matrix is singular
+ */
+template <typename T, size_t N>
+Serie<Vector<T, N>> solve(const Serie<FullMatrix<T, N>> &A,
+                          const Serie<Vector<T, N>> &b);
+template <typename T, size_t N>
+Serie<Vector<T, N>> solve(const Serie<SymmetricMatrix<T, N>> &A,
+                          const Serie<Vector<T, N>> &b);
+
 // Helper function for pipe operations
 template <typename T> auto bind_solve(const Serie<T> &b);
 
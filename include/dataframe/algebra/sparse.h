@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <dataframe/Serie.h>
+#include <vector>
+
+namespace df {
+
+    /**
+     * @brief Sparse matrix in compressed sparse row (CSR) format.
+     *
+     * The entries of row i are `columns[k]` / `values[k]` for k in
+     * [offsets[i], offsets[i + 1]). Products are computed in parallel over
+     * the rows, each row being a gather: no write conflict, no atomics.
+     *
+     * @code
+     * df::CSRMatrix L = ...;
+     * df::Serie<double> y = L * x;       // or L.multiply(x)
+     * df::Serie<Vector3> Lx = L * positions; // works for vector values too
+     * @endcode
+     */
+    struct CSRMatrix {
+        size_t cols = 0;
+        std::vector<size_t> offsets { 0 };
+        std::vector<uint32_t> columns;
+        std::vector<double> values;
+
+        size_t rows() const { return offsets.size() - 1; }
+        size_t nonZeros() const { return columns.size(); }
+
+        /**
+         * @brief Value at (i, j), or 0 if the entry is not stored
+         */
+        double operator()(size_t i, size_t j) const;
+
+        /**
+         * @brief Diagonal entries (0 when not stored)
+         */
+        Serie<double> diagonal() const;
+
+        /**
+         * @brief y = A * x, with T a scalar or a vector type (x[j] * a_ij
+         * and += must be defined)
+         */
+        template <typename T> Serie<T> multiply(const Serie<T>& x) const;
+    };
+
+    template <typename T> Serie<T> operator*(const CSRMatrix& A, const Serie<T>& x);
+
+} // namespace df
+
+#include "inline/sparse.hxx"
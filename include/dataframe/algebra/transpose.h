@@ -25,6 +25,8 @@
 #include <array>
 #include <cmath>
 #include <dataframe/Serie.h>
+#include <dataframe/algebra/types.h>
+#include <dataframe/core/parallel_map.h>
 #include <dataframe/utils/utils.h>
 #include <stdexcept>
 
@@ -65,6 +67,29 @@ Serie<std::array<T, N>> transpose(const Serie<std::array<T, N>> &serie) {
         [](const auto &m, size_t) { return detail::transpose_matrix(m); });
 }
 
+/**
+ * Transpose of every FullMatrix, in parallel for large Series
+ */
+template <typename T, size_t N>
+Serie<FullMatrix<T, N>> transpose(const Serie<FullMatrix<T, N>> &serie) {
+    const auto &in = serie.data();
+    std::vector<FullMatrix<T, N>> result(in.size());
+    const size_t num_chunks = detail::get_optimal_threads(in.size() / 4);
+    detail::parallel_for_chunks(
+        in.size(), num_chunks, [&](size_t, size_t start, size_t end) {
+            for (size_t k = start; k < end; ++k) {
+                const auto &m = in[k].data();
+                auto &r = result[k].data();
+                for (size_t i = 0; i < N; ++i) {
+                    for (size_t j = 0; j < N; ++j) {
+                        r[i * N + j] = m[j * N + i];
+                    }
+                }
+            }
+        });
+    return Serie<FullMatrix<T, N>>(result);
+}
+
 template <typename T, size_t N> auto bind_transpose() {
     return
         [](const Serie<std::array<T, N>> &serie) { return transpose(serie); };
@@ -14,7 +14,9 @@
 
 #pragma once
 #include <array>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace df {
 
@@ -175,9 +175,11 @@ namespace df {
                 const Dataframe& dataframe, const std::string& name) const
             {
                 // Handle vector components (e.g., Px, Py, Pz)
+                // (only for vector columns, as "Sxy" also ends with 'y')
                 if (name.length() >= 2
                     && (name.back() == 'x' || name.back() == 'y' || name.back() == 'z'
-                        || name.back() == 'w')) {
+                        || name.back() == 'w')
+                    && getVectorComponentNames(dataframe, name.substr(0, name.length() - 1))) {
                     std::string baseName = name.substr(0, name.length() - 1);
                     char comp = name.back();
                     size_t index = (comp == 'x') ? 0 : (comp == 'y') ? 1 : (comp == 'z') ? 2 : 3;
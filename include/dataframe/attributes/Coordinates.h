@@ -44,8 +44,16 @@ namespace df {
 
                 // Only decompose if we're targeting scalars or vectors
                 if (targetDim == DecompDimension::Scalar) {
-                    // For vectors of any dimension, create coordinate components
-                    for (size_t i = 0; i < coordNames_.size(); ++i) {
+                    // One component per coordinate, for vector columns only
+                    size_t dim = 0;
+                    if (dataframe.has<Vector2D>(name)) {
+                        dim = 2;
+                    } else if (dataframe.has<Vector3D>(name)) {
+                        dim = 3;
+                    } else if (dataframe.has<Vector4D>(name)) {
+                        dim = 4;
+                    }
+                    for (size_t i = 0; i < std::min(dim, coordNames_.size()); ++i) {
                         result.push_back(name + "_" + coordNames_[i]);
                     }
                 }
@@ -25,6 +25,10 @@
 #include <dataframe/Dataframe.h>
 #include <dataframe/Serie.h>
 #include <dataframe/types.h>
+#include <dataframe/utils/flat_hash.h>
+#include <array>
+#include <memory>
+#include <mutex>
 
 namespace df {
     namespace attributes {
@@ -82,6 +86,27 @@ namespace df {
 
         // -----------------------------------------------------------
 
+        /**
+         * @brief Serves the attributes derived from the columns of a Dataframe
+         * by a list of decomposers (e.g. "Px", "Py", "Pz" from a Vector3 "P").
+         *
+         * The derived names are listed once in a catalog (name -> source
+         * column, decomposer), built lazily and rebuilt only when the
+         * Dataframe changes (see Dataframe::version) or when a decomposer is
+         * added. hasAttribute() is a hash lookup, and a derived Serie is
+         * computed on its first request and then served from a cache.
+         *
+         * @code
+         * df::attributes::Manager manager(dataframe);
+         * manager.addDecomposer(df::attributes::Components());
+         * if (manager.hasAttribute(DecompDimension::Scalar, "Sxy")) {
+         *     const auto& sxy = manager.component("Sxy"); // no copy
+         * }
+         * @endcode
+         *
+         * @note The Manager keeps a reference to the Dataframe, which must
+         * outlive it. Queries are thread-safe.
+         */
         class Manager {
         public:
             explicit Manager(const Dataframe& df);
@@ -94,15 +119,49 @@ namespace df {
 
             template <typename T> Serie<T> getSerie(const std::string& name) const;
 
+            /**
+             * @brief The derived Serie `name`, computed once and cached until
+             * the Dataframe changes. The reference stays valid until then.
+             * @throws std::runtime_error if there is no such attribute
+             */
+            const Serie<double>& component(
+                const std::string& name, DecompDimension targetDim = DecompDimension::Scalar) const;
+
             bool hasAttribute(DecompDimension, const std::string&) const;
 
+            /**
+             * @brief Name of the Dataframe column an attribute is derived from
+             * @throws std::runtime_error if there is no such attribute
+             */
+            std::string source(DecompDimension, const std::string&) const;
+
             void clear();
 
             size_t decomposerCount() const;
 
         private:
+            struct Entry {
+                std::string name;
+                std::string source;
+                const Decomposer* decomposer;
+                std::shared_ptr<const Serie<double>> cache;
+            };
+
+            struct Catalog {
+                std::vector<Entry> entries; // in column then decomposer order
+                FlatHashMap<std::string, uint32_t> index; // name -> entry
+            };
+
+            Catalog& catalog(DecompDimension) const; // requires mutex_
+            Entry& entry(DecompDimension, const std::string&) const; // requires mutex_
+
             const Dataframe& dataframe_;
             std::vector<std::unique_ptr<Decomposer>> decomposers_;
+
+            mutable std::mutex mutex_;
+            mutable std::array<Catalog, 3> catalogs_;
+            mutable std::array<uint64_t, 3> versions_ {};
+            mutable std::array<bool, 3> built_ {};
         };
 
         // -----------------------------------------------------------
@@ -92,12 +92,12 @@ namespace df {
 
         // ---------------------------------------------------------------
 
-        Manager::Manager(const Dataframe& df)
+        inline Manager::Manager(const Dataframe& df)
             : dataframe_(df)
         {
         }
 
-        Manager::Manager(const Manager& other)
+        inline Manager::Manager(const Manager& other)
             : dataframe_(other.dataframe_)
         {
             for (const auto& decomposer : other.decomposers_) {
@@ -107,76 +107,110 @@ namespace df {
             }
         }
 
-        void Manager::addDecomposer(const Decomposer& decomposer)
+        inline void Manager::addDecomposer(const Decomposer& decomposer)
         {
+            std::lock_guard<std::mutex> lock(mutex_);
             decomposers_.push_back(decomposer.clone());
+            built_ = {};
         }
 
-        std::vector<std::string> Manager::getNames(DecompDimension targetDim) const
+        inline Manager::Catalog& Manager::catalog(DecompDimension targetDim) const
         {
-            std::vector<std::string> result;
+            const size_t d = static_cast<size_t>(targetDim) - 1;
+            Catalog& catalog = catalogs_[d];
+            if (built_[d] && versions_[d] == dataframe_.version()) {
+                return catalog;
+            }
 
+            catalog.entries.clear();
+            catalog.index.clear();
             for (const auto& name : dataframe_.names()) {
+                const auto& serie = dataframe_.get(name);
                 for (const auto& decomposer : decomposers_) {
-                    if (!decomposer)
+                    if (!decomposer) {
                         continue;
+                    }
+                    for (auto& derived : decomposer->names(dataframe_, targetDim, serie, name)) {
+                        // The first decomposer providing a name serves it
+                        auto [id, inserted] = catalog.index.try_emplace(
+                            derived, static_cast<uint32_t>(catalog.entries.size()));
+                        if (inserted) {
+                            catalog.entries.push_back(
+                                Entry { std::move(derived), name, decomposer.get(), nullptr });
+                        }
+                    }
+                }
+            }
+            versions_[d] = dataframe_.version();
+            built_[d] = true;
+            return catalog;
+        }
 
-                    const auto& serie = dataframe_.get(name);
+        inline Manager::Entry& Manager::entry(DecompDimension targetDim, const std::string& name) const
+        {
+            Catalog& c = catalog(targetDim);
+            const uint32_t* id = c.index.find(name);
+            if (!id) {
+                throw std::runtime_error("Unable to find serie with name: " + name);
+            }
+            return c.entries[*id];
+        }
 
-                    auto decomposed_names = decomposer->names(dataframe_, targetDim, serie, name);
-                    result.insert(result.end(), decomposed_names.begin(), decomposed_names.end());
-                }
+        inline std::vector<std::string> Manager::getNames(DecompDimension targetDim) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const Catalog& c = catalog(targetDim);
+            std::vector<std::string> result;
+            result.reserve(c.entries.size());
+            for (const auto& e : c.entries) {
+                result.push_back(e.name);
             }
             return result;
         }
 
+        inline const Serie<double>& Manager::component(
+            const std::string& name, DecompDimension targetDim) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Entry& e = entry(targetDim, name);
+            if (!e.cache) {
+                e.cache = std::make_shared<const Serie<double>>(
+                    e.decomposer->serie(dataframe_, targetDim, e.name));
+            }
+            return *e.cache;
+        }
+
         template <typename T> Serie<T> Manager::getSerie(const std::string& name) const
         {
-            for (const auto& decomposer : decomposers_) {
-                if (!decomposer)
-                    continue;
-
-                if constexpr (details::is_std_array<T>::value) {
-                    // auto DIM = details::array_dimension<T>::value;
-                    // auto serie =
-                    //     decomposer->serie(dataframe_, DecompDimension::Vector, name);
-                    // if (!serie.empty()) {
-                    //     return serie.template as<T>();
-                    // }
-                } else if constexpr (details::is_container<T>::value) {
-                    // todo
-                } else {
-                    static_assert(std::is_arithmetic<T>::value || details::is_container<T>::value,
-                        "Type must be either arithmetic or a container type");
-                    auto serie = decomposer->serie(dataframe_, DecompDimension::Scalar, name);
-                    if (!serie.empty()) {
-                        return serie.template as<T>();
-                    }
-                }
+            static_assert(std::is_arithmetic<T>::value, "getSerie requires an arithmetic type");
+            const Serie<double>& serie = component(name, DecompDimension::Scalar);
+            if constexpr (std::is_same_v<T, double>) {
+                return serie;
+            } else {
+                return serie.template as<T>();
             }
-            throw std::runtime_error("Unable to find serie with name: " + name);
-            // return Serie<T>();
         }
 
-        bool Manager::hasAttribute(DecompDimension targetDim, const std::string& name) const
+        inline bool Manager::hasAttribute(DecompDimension targetDim, const std::string& name) const
         {
-            for (const auto& decomposer : decomposers_) {
-                if (!decomposer)
-                    continue;
+            std::lock_guard<std::mutex> lock(mutex_);
+            return catalog(targetDim).index.contains(name);
+        }
 
-                try {
-                    auto serie = decomposer->serie(dataframe_, targetDim, name);
-                    return !serie.empty();
-                } catch (const std::exception&) {
-                    continue;
-                }
-            }
-            return false;
+        inline std::string Manager::source(DecompDimension targetDim, const std::string& name) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return entry(targetDim, name).source;
         }
 
-        void Manager::clear() { decomposers_.clear(); }
+        inline void Manager::clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            decomposers_.clear();
+            built_ = {};
+        }
 
-        size_t Manager::decomposerCount() const { return decomposers_.size(); }
+        inline size_t Manager::decomposerCount() const { return decomposers_.size(); }
 
         // Helper function to create a Manager
         template <typename... Ts>
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Aggregators for GroupBy::agg (see core/groupBy.h).
+ *
+ * An aggregator describes how to reduce the values of one group, through a
+ * small mergeable state:
+ * - `std::string name() const`: name of the output column,
+ * - `template <typename T> auto init() const`: empty state,
+ * - `template <typename T, typename S> void update(S&, const T&) const`,
+ * - `template <typename S> void merge(S&, const S&) const`: combine two
+ *   partial states (computed on different chunks of rows),
+ * - `template <typename S> auto finalize(const S&) const`: output value.
+ *
+ * Any type following this protocol can be given to GroupBy::agg.
+ *
+ * @code
+ * auto result = df::groupBy(city).agg(price,
+ *     df::agg::count(), df::agg::mean(), df::agg::max(),
+ *     df::agg::custom("sum2", 0.0,
+ *         [](double& acc, double v) { acc += v * v; },
+ *         [](double& acc, double other) { acc += other; }));
+ * @endcode
+ */
+
+namespace df {
+namespace agg {
+
+/**
+ * @brief Sum of the values. Integral values are summed as int64_t, floating
+ * point values as double.
+ */
+struct Sum {
+    std::string label = "sum";
+    std::string name() const { return label; }
+
+    template <typename T> auto init() const {
+        static_assert(std::is_arithmetic_v<T>, "sum requires arithmetic values");
+        if constexpr (std::is_integral_v<T>) {
+            return int64_t{0};
+        } else {
+            return double{0};
+        }
+    }
+    template <typename T, typename S> void update(S &s, const T &v) const {
+        s += static_cast<S>(v);
+    }
+    template <typename S> void merge(S &s, const S &other) const { s += other; }
+    template <typename S> S finalize(const S &s) const { return s; }
+};
+
+/**
+ * @brief Arithmetic mean of the values (as double)
+ */
+struct Mean {
+    struct State {
+        double sum = 0;
+        size_t count = 0;
+    };
+
+    std::string label = "mean";
+    std::string name() const { return label; }
+
+    template <typename T> State init() const {
+        static_assert(std::is_arithmetic_v<T>,
+                      "mean requires arithmetic values");
+        return State{};
+    }
+    template <typename T> void update(State &s, const T &v) const {
+        s.sum += static_cast<double>(v);
+        ++s.count;
+    }
+    void merge(State &s, const State &other) const {
+        s.sum += other.sum;
+        s.count += other.count;
+    }
+    double finalize(const State &s) const {
+        return s.count == 0 ? 0.0 : s.sum / static_cast<double>(s.count);
+    }
+};
+
+/**
+ * @brief Number of rows in the group (as uint32_t)
+ */
+struct Count {
+    std::string label = "count";
+    std::string name() const { return label; }
+
+    template <typename T> uint32_t init() const { return 0; }
+    template <typename T> void update(uint32_t &s, const T &) const { ++s; }
+    void merge(uint32_t &s, const uint32_t &other) const { s += other; }
+    uint32_t finalize(const uint32_t &s) const { return s; }
+};
+
+/**
+ * @brief Minimum (Less) or maximum (Greater) of the values
+ */
+template <typename Compare> struct Extremum {
+    template <typename T> struct State {
+        T value{};
+        bool set = false;
+    };
+
+    std::string label;
+    std::string name() const { return label; }
+
+    template <typename T> State<T> init() const { return State<T>{}; }
+    template <typename T> void update(State<T> &s, const T &v) const {
+        if (!s.set || Compare{}(v, s.value)) {
+            s.value = v;
+            s.set = true;
+        }
+    }
+    template <typename T>
+    void merge(State<T> &s, const State<T> &other) const {
+        if (other.set) {
+            update(s, other.value);
+        }
+    }
+    template <typename T> T finalize(const State<T> &s) const {
+        return s.value;
+    }
+};
+
+/**
+ * @brief User-defined aggregator: an initial state, an update function
+ * `void(S&, const T&)` and a merge function `void(S&, const S&)`. The final
+ * state is the output value.
+ */
+template <typename S, typename Update, typename Merge> struct Custom {
+    std::string label;
+    S initial;
+    Update update_fn;
+    Merge merge_fn;
+
+    std::string name() const { return label; }
+
+    template <typename T> S init() const { return initial; }
+    template <typename T> void update(S &s, const T &v) const {
+        update_fn(s, v);
+    }
+    void merge(S &s, const S &other) const { merge_fn(s, other); }
+    S finalize(const S &s) const { return s; }
+};
+
+/**
+ * @brief Aggregator wrapping a streaming accumulator (see
+ * stats/accumulators.h: `add(value)` and `merge(other)`), finalized by
+ * `finalize(accumulator)`.
+ */
+template <typename Acc, typename Finalize> struct Accumulate {
+    std::string label;
+    Acc prototype;
+    Finalize finalize_fn;
+
+    std::string name() const { return label; }
+
+    template <typename T> Acc init() const { return prototype; }
+    template <typename T> void update(Acc &s, const T &v) const { s.add(v); }
+    void merge(Acc &s, const Acc &other) const { s.merge(other); }
+    auto finalize(const Acc &s) const { return finalize_fn(s); }
+};
+
+// ----------------------------------------------------------
+
+inline Sum sum(const std::string &name = "sum") { return Sum{name}; }
+inline Mean mean(const std::string &name = "mean") { return Mean{name}; }
+inline Count count(const std::string &name = "count") { return Count{name}; }
+
+inline Extremum<std::less<>> min(const std::string &name = "min") {
+    return Extremum<std::less<>>{name};
+}
+
+inline Extremum<std::greater<>> max(const std::string &name = "max") {
+    return Extremum<std::greater<>>{name};
+}
+
+template <typename S, typename Update, typename Merge>
+Custom<S, std::decay_t<Update>, std::decay_t<Merge>>
+custom(const std::string &name, const S &initial, Update &&update,
+       Merge &&merge) {
+    return {name, initial, std::forward<Update>(update),
+            std::forward<Merge>(merge)};
+}
+
+/**
+ * @code
+ * auto result = df::groupBy(zone).agg(depth,
+ *     df::agg::accumulate("std", df::stats::Moments<double>(),
+ *         [](const auto& m) { return m.std_dev(); }));
+ * @endcode
+ */
+template <typename Acc, typename Finalize>
+Accumulate<Acc, std::decay_t<Finalize>>
+accumulate(const std::string &name, const Acc &prototype,
+           Finalize &&finalize) {
+    return {name, prototype, std::forward<Finalize>(finalize)};
+}
+
+} // namespace agg
+} // namespace df
@@ -24,6 +24,7 @@
 #pragma once
 #include "ExecutionPolicy.h"
 #include <iostream>
+#include <utility>
 
 /**
  * // Example usage:
@@ -31,10 +32,11 @@
  * template<typename T>
  * Serie<T> sort_with_policy(const Serie<T>& serie, ExecutionPolicy exec) {
  *      std::vector<T> result(serie.data());
- *      auto policy = get_execution_policy(exec);
  *
  *      #if HAS_PARALLEL_ALGORITHMS
- *          std::sort(policy, result.begin(), result.end());
+ *          with_execution_policy(exec, [&](auto policy) {
+ *              std::sort(policy, result.begin(), result.end());
+ *          });
  *      #else
  *          std::sort(result.begin(), result.end());
  *      #endif
@@ -62,17 +64,19 @@ namespace df {
 
 #if HAS_PARALLEL_ALGORITHMS
 
-    // When parallel algorithms are available
+    // When parallel algorithms are available. The standard policies have
+    // distinct types, so the selected one is passed to a callback instead of
+    // being returned.
     struct ExecutionPolicyTraits {
-        static auto get_policy(ExecutionPolicy exec)
+        template <typename F> static decltype(auto) with_policy(ExecutionPolicy exec, F&& f)
         {
             switch (exec) {
             case ExecutionPolicy::PAR:
-                return std::execution::par;
+                return f(std::execution::par);
             case ExecutionPolicy::PAR_UNSEQ:
-                return std::execution::par_unseq;
+                return f(std::execution::par_unseq);
             default:
-                return std::execution::seq;
+                return f(std::execution::seq);
             }
         }
 
@@ -87,7 +91,10 @@ namespace df {
         struct dummy_policy { };
         static constexpr dummy_policy seq {};
 
-        static dummy_policy get_policy(ExecutionPolicy) { return seq; }
+        template <typename F> static decltype(auto) with_policy(ExecutionPolicy, F&& f)
+        {
+            return f(seq);
+        }
 
         static constexpr bool has_parallel_support = false;
     };
@@ -97,10 +104,10 @@ namespace df {
     // Helper function to check at runtime if parallel algorithms are supported
     constexpr bool has_parallel_algorithms() { return ExecutionPolicyTraits::has_parallel_support; }
 
-    // Helper to get the actual execution policy
-    inline auto get_execution_policy(ExecutionPolicy exec = ExecutionPolicy::SEQ)
+    // Call f(policy) with the standard execution policy matching exec
+    template <typename F> decltype(auto) with_execution_policy(ExecutionPolicy exec, F&& f)
     {
-        return ExecutionPolicyTraits::get_policy(exec);
+        return ExecutionPolicyTraits::with_policy(exec, std::forward<F>(f));
     }
 
     /**
@@ -22,19 +22,37 @@
  */
 
 #pragma once
+#include <dataframe/Mask.h>
 #include <dataframe/Serie.h>
+#include <tuple>
 
 namespace df {
 
-// Single series version
+// Single series version. The predicate may also be a Mask (the rows of its
+// set bits are kept). The predicate is evaluated from several threads only
+// with ExecutionPolicy::PAR (see Mask::from); the kept values are compacted in
+// parallel in any case (see Mask::select)
 template <typename F, typename T>
-auto filter(F &&predicate, const Serie<T> &serie) -> Serie<T>;
+auto filter(F &&predicate, const Serie<T> &serie,
+            ExecutionPolicy exec = ExecutionPolicy::SEQ) -> Serie<T>;
 
-// Multi series version
+// Multi series version: predicate(first[i], second[i], args[i]..., i) selects
+// the values of first. The predicate is evaluated sequentially
 template <typename F, typename T, typename... Args>
 auto filter(F &&predicate, const Serie<T> &first, const Serie<T> &second,
             const Args &...args) -> Serie<T>;
 
+/**
+ * @brief Apply the same selection to several series
+ * @code
+ * auto inside = (x >= xmin) & (x <= xmax) & (y >= ymin) & (y <= ymax);
+ * auto [px, py, pz] = df::select(inside, x, y, z);
+ * @endcode
+ * @throws std::runtime_error if a serie size differs from the mask size
+ */
+template <typename... Ts>
+std::tuple<Serie<Ts>...> select(const Mask &mask, const Serie<Ts> &...series);
+
 // Bind function for multiple series
 template <typename F> auto bind_filter(F &&predicate, const auto &second);
 
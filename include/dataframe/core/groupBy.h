@@ -13,7 +13,10 @@
  */
 
 #pragma once
+#include <dataframe/Dataframe.h>
 #include <dataframe/Serie.h>
+#include <dataframe/core/agg.h>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <tuple>
@@ -141,6 +144,96 @@ template <typename KeyFunc> auto bind_groupBy(KeyFunc &&key_func);
  */
 template <typename Predicate> auto bind_groupByPredicate(Predicate &&pred);
 
+/**
+ * @brief Grouping of the rows of a key Serie, used to aggregate other Series
+ * without materializing the groups.
+ *
+ * Each row gets a dense group id in [0, size()), groups being sorted by key
+ * (as with the std::map returned by the other groupBy functions). Integer
+ * keys spanning a small range are grouped by counting; other keys (strings,
+ * floating points, large integer ranges...) use an open-addressing hash
+ * table per chunk of rows, the chunks being processed in parallel.
+ *
+ * agg() reduces a value Serie per group in a single pass: each chunk of rows
+ * builds its own partial states, merged at the end. The result is a
+ * columnar Dataframe with a "key" column and one column per aggregator. Null
+ * values (see Serie::validity()) are skipped, so agg::count() counts the
+ * valid values of each group.
+ *
+ * @code
+ * df::Serie<std::string> city{"Paris", "Lyon", "Paris", "Nice", "Lyon"};
+ * df::Serie<double> price{10, 20, 30, 40, 50};
+ *
+ * auto g = df::groupBy(city);
+ * auto result = g.agg(price, df::agg::count(), df::agg::sum(), df::agg::max());
+ *
+ * // result.get<std::string>("key") = {"Lyon", "Nice", "Paris"}
+ * // result.get<uint32_t>("count")  = {2, 1, 2}
+ * // result.get<double>("sum")      = {70, 40, 40}
+ * // result.get<double>("max")      = {50, 40, 30}
+ *
+ * // Groups computed once can aggregate several Series
+ * auto qty = g.agg(quantity, df::agg::mean("mean_qty"));
+ * @endcode
+ */
+template <typename K> class GroupBy {
+  public:
+    explicit GroupBy(const Serie<K> &keys);
+
+    /**
+     * @brief Grouping of a dictionary-encoded column (K must be std::string).
+     * The rows are grouped by code, and only the distinct values are
+     * compared. Null rows form the group of the empty string.
+     */
+    explicit GroupBy(const CategoricalSerie &keys);
+
+    /**
+     * Number of groups
+     */
+    size_t size() const { return keys_.size(); }
+
+    /**
+     * Unique keys, sorted. The i-th key is the one of group i
+     */
+    const Serie<K> &keys() const { return keys_; }
+
+    /**
+     * Group id of each row
+     */
+    const std::vector<uint32_t> &groupIds() const { return ids_; }
+
+    /**
+     * Number of rows per group
+     */
+    Serie<uint32_t> counts() const;
+
+    /**
+     * @brief Aggregate a value Serie per group (see core/agg.h).
+     * @throws std::runtime_error if the Serie does not have one value per row
+     */
+    template <typename T, typename... Aggs>
+    Dataframe agg(const Serie<T> &values, const Aggs &...aggs) const;
+
+  private:
+    void buildDense(const Serie<K> &keys, K min, uint64_t range);
+    void buildHashed(const Serie<K> &keys);
+
+    Serie<K> keys_;
+    std::vector<uint32_t> ids_;
+};
+
+/**
+ * @brief Groups the rows of a Serie by value, for aggregations.
+ * @see GroupBy
+ */
+template <typename K> GroupBy<K> groupBy(const Serie<K> &keys);
+
+/**
+ * @brief Groups the rows of a CategoricalSerie by value, for aggregations.
+ * @see GroupBy
+ */
+GroupBy<std::string> groupBy(const CategoricalSerie &keys);
+
 } // namespace df
 
 #include "inline/groupBy.hxx"
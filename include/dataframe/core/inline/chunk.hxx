@@ -15,6 +15,7 @@
 #include <dataframe/core/merge.h>
 #include <numeric>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace df {
@@ -96,9 +97,12 @@ inline auto chunk(size_t chunk_size, const Serie<T> &first,
     std::vector<std::tuple<Serie<T>, Serie<Ts>...>> result;
     result.reserve(num_chunks);
 
+    // Index-based access, so that several series may share the same type
+    auto emplace_chunk = [&]<size_t... Is>(size_t i, std::index_sequence<Is...>) {
+        result.emplace_back(std::get<Is>(chunks)[i]...);
+    };
     for (size_t i = 0; i < num_chunks; ++i) {
-        result.emplace_back(std::get<std::vector<Serie<T>>>(chunks)[i],
-                            std::get<std::vector<Serie<Ts>>>(chunks)[i]...);
+        emplace_chunk(i, std::index_sequence_for<T, Ts...>{});
     }
 
     return result;
@@ -22,39 +22,50 @@
  */
 
 #include <dataframe/utils/utils.h>
+#include <tuple>
 #include <type_traits>
 
 namespace df {
 
 // Single series version
 template <typename F, typename T>
-inline auto filter(F &&predicate, const Serie<T> &serie) -> Serie<T> {
-    std::vector<T> filtered;
-    filtered.reserve(serie.size()); // Reserve max possible size
-
-    for (size_t i = 0; i < serie.size(); ++i) {
-        if (predicate(serie[i], i)) {
-            filtered.push_back(serie[i]);
+inline auto filter(F &&predicate, const Serie<T> &serie, ExecutionPolicy exec)
+    -> Serie<T> {
+    if constexpr (std::is_same_v<std::decay_t<F>, Mask>) {
+        if (predicate.size() != serie.size()) {
+            throw std::runtime_error(concat("filter: mask size (",
+                                            predicate.size(),
+                                            ") differs from serie size (",
+                                            serie.size(), ")"));
         }
+        return predicate.select(serie);
+    } else {
+        return Mask::from(serie, predicate, exec).select(serie);
     }
-
-    return Serie<T>(filtered);
 }
 
 // Multi series version
 template <typename F, typename T, typename... Args>
 inline auto filter(F &&predicate, const Serie<T> &first, const Serie<T> &second,
             const Args &...args) -> Serie<T> {
-    std::vector<T> filtered;
-    filtered.reserve(first.size()); // Reserve max possible size
-
-    for (size_t i = 0; i < first.size(); ++i) {
-        if (predicate(first[i], second[i], (args[i])..., i)) {
-            filtered.push_back(first[i]);
-        }
+    if (first.size() != second.size() ||
+        (!((first.size() == args.size()) && ...))) {
+        throw std::runtime_error("All series must have the same size in filter");
     }
 
-    return Serie<T>(filtered);
+    const auto &a = first.data();
+    const auto &b = second.data();
+    auto mask = Mask::generate(
+        a.size(),
+        [&](size_t i) { return predicate(a[i], b[i], (args.data()[i])..., i); },
+        ExecutionPolicy::SEQ);
+    return mask.select(first);
+}
+
+template <typename... Ts>
+inline std::tuple<Serie<Ts>...> select(const Mask &mask,
+                                       const Serie<Ts> &...series) {
+    return std::tuple<Serie<Ts>...>(mask.select(series)...);
 }
 
 // Bind function for multiple series
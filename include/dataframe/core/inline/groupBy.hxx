@@ -12,7 +12,11 @@
  * all copies or substantial portions of the Software.
  */
 
+#include <algorithm>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/flat_hash.h>
 #include <functional>
+#include <limits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -187,4 +191,282 @@ inline auto bind_groupByPredicate(Predicate &&pred) {
     };
 }
 
+// ----------------------------------------------------------
+
+namespace detail {
+
+// Below this number of rows, grouping and aggregation run on a single thread
+constexpr size_t groupby_parallel_threshold = 10000;
+
+inline size_t groupby_chunks(size_t rows) {
+    return rows < groupby_parallel_threshold ? 1 : get_optimal_threads(rows);
+}
+
+// k - min for integral keys with k >= min, without overflow
+template <typename K> uint64_t key_offset(K k, K min) {
+    return static_cast<uint64_t>(k) - static_cast<uint64_t>(min);
+}
+
+} // namespace detail
+
+template <typename K> GroupBy<K>::GroupBy(const Serie<K> &keys) {
+    if constexpr (std::is_integral_v<K>) {
+        if (!keys.empty()) {
+            const auto &data = keys.data();
+            auto [lo, hi] = std::minmax_element(data.begin(), data.end());
+            // Counting is worth it when the key range is not much larger
+            // than the number of rows. The difference is taken in unsigned
+            // arithmetic (no overflow for keys spanning more than 2^63), and
+            // a range of 2^64 wraps to 0, which goes to the hashed path.
+            const uint64_t span = detail::key_offset(*hi, *lo);
+            const uint64_t range = span + 1;
+            if (range != 0 &&
+                range <= 2 * static_cast<uint64_t>(data.size()) + 1024 &&
+                range <= (uint64_t{1} << 26)) {
+                buildDense(keys, *lo, range);
+                return;
+            }
+        }
+    }
+    buildHashed(keys);
+}
+
+// Categorical keys: presence table over the codes, then the present codes
+// are sorted by value to get the group ids
+template <typename K> GroupBy<K>::GroupBy(const CategoricalSerie &keys) {
+    static_assert(std::is_same_v<K, std::string>,
+                  "a CategoricalSerie is grouped by std::string keys");
+    const auto &dictionary = *keys.dictionary();
+    const auto &values = dictionary.values();
+    const size_t n = keys.size();
+
+    // The null rows go to the group of "", with its own code if "" is not in
+    // the dictionary
+    const uint32_t *empty = dictionary.find("");
+    const auto null_code =
+        empty ? *empty : static_cast<uint32_t>(dictionary.size());
+    auto code_of = [&](const auto &codes, size_t i) -> uint32_t {
+        return keys.isNull(i) ? null_code : codes[i];
+    };
+
+    std::vector<uint32_t> group(dictionary.size() + 1, 0);
+    keys.visitCodes([&](const auto &codes) {
+        for (size_t i = 0; i < n; ++i) {
+            group[code_of(codes, i)] = 1;
+        }
+    });
+
+    std::vector<uint32_t> present;
+    for (uint32_t c = 0; c < group.size(); ++c) {
+        if (group[c]) {
+            present.push_back(c);
+        }
+    }
+    const std::string none;
+    auto value_of = [&](uint32_t c) -> const std::string & {
+        return c < values.size() ? values[c] : none;
+    };
+    std::sort(present.begin(), present.end(), [&](uint32_t a, uint32_t b) {
+        return value_of(a) < value_of(b);
+    });
+
+    std::vector<std::string> unique;
+    unique.reserve(present.size());
+    for (size_t g = 0; g < present.size(); ++g) {
+        group[present[g]] = static_cast<uint32_t>(g);
+        unique.push_back(value_of(present[g]));
+    }
+    keys_ = Serie<K>(unique);
+
+    ids_.resize(n);
+    keys.visitCodes([&](const auto &codes) {
+        detail::parallel_for_chunks(
+            n, detail::groupby_chunks(n),
+            [&](size_t, size_t start, size_t end) {
+                for (size_t i = start; i < end; ++i) {
+                    ids_[i] = group[code_of(codes, i)];
+                }
+            });
+    });
+}
+
+// Low-cardinality integer keys: presence table over [min, max], then prefix
+// count gives the (sorted) group id of each key value
+template <typename K>
+void GroupBy<K>::buildDense(const Serie<K> &keys, K min, uint64_t range) {
+    const auto &data = keys.data();
+    const size_t n = data.size();
+    std::vector<uint32_t> rank(static_cast<size_t>(range), 0);
+    for (const K &k : data) {
+        rank[detail::key_offset(k, min)] = 1;
+    }
+
+    std::vector<K> unique;
+    uint32_t next = 0;
+    for (size_t v = 0; v < rank.size(); ++v) {
+        if (rank[v]) {
+            unique.push_back(
+                static_cast<K>(static_cast<uint64_t>(min) + v));
+            rank[v] = next++;
+        }
+    }
+    keys_ = Serie<K>(unique);
+
+    ids_.resize(n);
+    detail::parallel_for_chunks(
+        n, detail::groupby_chunks(n), [&](size_t, size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                ids_[i] = rank[detail::key_offset(data[i], min)];
+            }
+        });
+}
+
+// General keys: each chunk assigns local ids with its own hash table, the
+// local keys are then merged, sorted, and the local ids remapped
+template <typename K> void GroupBy<K>::buildHashed(const Serie<K> &keys) {
+    const auto &data = keys.data();
+    const size_t n = data.size();
+    const size_t num_chunks = detail::groupby_chunks(n);
+
+    ids_.resize(n);
+    std::vector<std::vector<K>> local_keys(num_chunks);
+
+    detail::parallel_for_chunks(
+        n, num_chunks, [&](size_t c, size_t start, size_t end) {
+            FlatHashMap<K, uint32_t> table;
+            auto &ordered = local_keys[c];
+            for (size_t i = start; i < end; ++i) {
+                auto [id, inserted] = table.try_emplace(
+                    data[i], static_cast<uint32_t>(ordered.size()));
+                if (inserted) {
+                    ordered.push_back(data[i]);
+                }
+                ids_[i] = *id;
+            }
+        });
+
+    std::vector<K> unique;
+    for (const auto &ordered : local_keys) {
+        unique.insert(unique.end(), ordered.begin(), ordered.end());
+    }
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    if (unique.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("groupBy: too many groups");
+    }
+
+    detail::parallel_for_chunks(
+        n, num_chunks, [&](size_t c, size_t start, size_t end) {
+            const auto &ordered = local_keys[c];
+            std::vector<uint32_t> remap(ordered.size());
+            for (size_t j = 0; j < ordered.size(); ++j) {
+                remap[j] = static_cast<uint32_t>(
+                    std::lower_bound(unique.begin(), unique.end(),
+                                     ordered[j]) -
+                    unique.begin());
+            }
+            for (size_t i = start; i < end; ++i) {
+                ids_[i] = remap[ids_[i]];
+            }
+        });
+    keys_ = Serie<K>(unique);
+}
+
+template <typename K> Serie<uint32_t> GroupBy<K>::counts() const {
+    std::vector<uint32_t> result(size(), 0);
+    for (uint32_t id : ids_) {
+        ++result[id];
+    }
+    return Serie<uint32_t>(result);
+}
+
+template <typename K>
+template <typename T, typename... Aggs>
+Dataframe GroupBy<K>::agg(const Serie<T> &values, const Aggs &...aggs) const {
+    if (values.size() != ids_.size()) {
+        throw std::runtime_error(
+            "GroupBy::agg: the values must have the same size as the keys (" +
+            std::to_string(values.size()) + " vs " +
+            std::to_string(ids_.size()) + ")");
+    }
+
+    const auto &data = values.data();
+    const size_t n = data.size();
+    const size_t groups = size();
+    const Mask &valid = values.validity();
+    const bool skip_nulls = !valid.empty();
+
+    // One dense vector of states per aggregator and per chunk. The number of
+    // chunks is limited so that partial states never outnumber the rows.
+    size_t num_chunks = detail::groupby_chunks(n);
+    if (groups > 0) {
+        num_chunks = std::max<size_t>(1, std::min(num_chunks, n / groups));
+    }
+
+    using States = std::tuple<
+        std::vector<decltype(aggs.template init<T>())>...>;
+    std::vector<States> partials(num_chunks);
+    const auto indices = std::index_sequence_for<Aggs...>{};
+
+    detail::parallel_for_chunks(
+        n, num_chunks, [&](size_t c, size_t start, size_t end) {
+            auto &states = partials[c];
+            [&]<size_t... Is>(std::index_sequence<Is...>) {
+                ((std::get<Is>(states).assign(groups, aggs.template init<T>())),
+                 ...);
+                for (size_t i = start; i < end; ++i) {
+                    if (skip_nulls && !valid[i]) {
+                        continue;
+                    }
+                    const uint32_t g = ids_[i];
+                    (aggs.update(std::get<Is>(states)[g], data[i]), ...);
+                }
+            }(indices);
+        });
+
+    // Merge the partial states into the first chunk, group ranges in parallel
+    if (num_chunks > 1) {
+        detail::parallel_for_chunks(
+            groups, detail::groupby_chunks(groups),
+            [&](size_t, size_t start, size_t end) {
+                auto &target = partials[0];
+                for (size_t c = 1; c < num_chunks; ++c) {
+                    const auto &source = partials[c];
+                    [&]<size_t... Is>(std::index_sequence<Is...>) {
+                        for (size_t g = start; g < end; ++g) {
+                            (aggs.merge(std::get<Is>(target)[g],
+                                        std::get<Is>(source)[g]),
+                             ...);
+                        }
+                    }(indices);
+                }
+            });
+    }
+
+    Dataframe result;
+    result.add("key", keys_);
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        auto finalize = [&](const auto &a, const auto &states) {
+            using R = std::decay_t<decltype(a.finalize(states[0]))>;
+            std::vector<R> column;
+            column.reserve(groups);
+            for (const auto &state : states) {
+                column.push_back(a.finalize(state));
+            }
+            result.add(a.name(), Serie<R>(column));
+        };
+        (finalize(aggs, std::get<Is>(partials[0])), ...);
+    }(indices);
+
+    return result;
+}
+
+template <typename K> inline GroupBy<K> groupBy(const Serie<K> &keys) {
+    return GroupBy<K>(keys);
+}
+
+inline GroupBy<std::string> groupBy(const CategoricalSerie &keys) {
+    return GroupBy<std::string>(keys);
+}
+
 } // namespace df
@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/flat_hash.h>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace df {
+
+namespace detail {
+
+// Below this number of rows, the hash join runs on a single thread
+constexpr size_t join_parallel_threshold = 10000;
+
+template <typename K> inline uint64_t join_hash(const K &key) {
+    return hash_mix(static_cast<uint64_t>(std::hash<K>{}(key)));
+}
+
+// Sorted keys without NaN (NaN breaks the ordering the merge relies on)
+template <typename K> bool join_mergeable(const std::vector<K> &keys) {
+    if constexpr (std::is_floating_point_v<K>) {
+        if (std::any_of(keys.begin(), keys.end(),
+                        [](K k) { return std::isnan(k); })) {
+            return false;
+        }
+    }
+    return std::is_sorted(keys.begin(), keys.end());
+}
+
+inline void join_emit(JoinIndices &out, int64_t l, int64_t r) {
+    out.left.push_back(l);
+    out.right.push_back(r);
+}
+
+template <typename K>
+JoinIndices sort_merge_join(const std::vector<K> &l, const std::vector<K> &r,
+                            JoinType how) {
+    JoinIndices out;
+    out.left.reserve(std::max(l.size(), r.size()));
+    out.right.reserve(std::max(l.size(), r.size()));
+
+    size_t i = 0, j = 0;
+    while (i < l.size() && j < r.size()) {
+        if (l[i] < r[j]) {
+            if (how != JoinType::INNER) {
+                join_emit(out, static_cast<int64_t>(i), -1);
+            }
+            ++i;
+        } else if (r[j] < l[i]) {
+            if (how == JoinType::OUTER) {
+                join_emit(out, -1, static_cast<int64_t>(j));
+            }
+            ++j;
+        } else {
+            // Cartesian product of the two runs of equal keys
+            size_t ie = i + 1, je = j + 1;
+            while (ie < l.size() && !(l[i] < l[ie])) {
+                ++ie;
+            }
+            while (je < r.size() && !(r[j] < r[je])) {
+                ++je;
+            }
+            for (size_t a = i; a < ie; ++a) {
+                for (size_t b = j; b < je; ++b) {
+                    join_emit(out, static_cast<int64_t>(a),
+                              static_cast<int64_t>(b));
+                }
+            }
+            i = ie;
+            j = je;
+        }
+    }
+    for (; how != JoinType::INNER && i < l.size(); ++i) {
+        join_emit(out, static_cast<int64_t>(i), -1);
+    }
+    for (; how == JoinType::OUTER && j < r.size(); ++j) {
+        join_emit(out, -1, static_cast<int64_t>(j));
+    }
+    return out;
+}
+
+// Hash table over the right rows of one radix partition. The rows sharing a
+// key are contiguous in `rows`, between offsets[g] and offsets[g + 1].
+template <typename K> struct JoinPartition {
+    FlatHashMap<K, uint32_t> table;
+    std::vector<uint32_t> offsets;
+    std::vector<int64_t> rows;
+};
+
+template <typename K>
+JoinIndices hash_join(const std::vector<K> &l, const std::vector<K> &r,
+                      JoinType how) {
+    const size_t threads = get_optimal_threads(std::max(l.size(), r.size()));
+    const bool parallel =
+        std::max(l.size(), r.size()) >= join_parallel_threshold;
+
+    // Radix partitioning of the right rows on the high bits of the hash
+    unsigned bits = 0;
+    if (parallel) {
+        while ((size_t{1} << bits) < threads * 4) {
+            ++bits;
+        }
+    }
+    const size_t num_partitions = size_t{1} << bits;
+    auto partition_of = [bits](uint64_t h) {
+        return bits == 0 ? size_t{0} : static_cast<size_t>(h >> (64 - bits));
+    };
+
+    std::vector<uint32_t> part(r.size());
+    std::vector<size_t> part_offsets(num_partitions + 1, 0);
+    for (size_t j = 0; j < r.size(); ++j) {
+        part[j] = static_cast<uint32_t>(partition_of(join_hash(r[j])));
+        ++part_offsets[part[j] + 1];
+    }
+    for (size_t p = 0; p < num_partitions; ++p) {
+        part_offsets[p + 1] += part_offsets[p];
+    }
+    std::vector<int64_t> scattered(r.size());
+    {
+        std::vector<size_t> cursor(part_offsets.begin(), part_offsets.end() - 1);
+        for (size_t j = 0; j < r.size(); ++j) {
+            scattered[cursor[part[j]]++] = static_cast<int64_t>(j);
+        }
+    }
+
+    std::vector<JoinPartition<K>> partitions(num_partitions);
+    parallel_for_chunks(
+        num_partitions, parallel ? threads : 1,
+        [&](size_t, size_t first, size_t last) {
+            for (size_t p = first; p < last; ++p) {
+                auto &partition = partitions[p];
+                const size_t begin = part_offsets[p];
+                const size_t count = part_offsets[p + 1] - begin;
+                partition.table.reserve(count);
+
+                std::vector<uint32_t> group(count);
+                std::vector<uint32_t> sizes;
+                for (size_t k = 0; k < count; ++k) {
+                    const K &key = r[static_cast<size_t>(scattered[begin + k])];
+                    auto [g, inserted] = partition.table.try_emplace(
+                        key, static_cast<uint32_t>(sizes.size()));
+                    if (inserted) {
+                        sizes.push_back(0);
+                    }
+                    group[k] = *g;
+                    ++sizes[*g];
+                }
+
+                partition.offsets.assign(sizes.size() + 1, 0);
+                for (size_t g = 0; g < sizes.size(); ++g) {
+                    partition.offsets[g + 1] = partition.offsets[g] + sizes[g];
+                }
+                partition.rows.resize(count);
+                std::vector<uint32_t> cursor(partition.offsets.begin(),
+                                             partition.offsets.end() - 1);
+                for (size_t k = 0; k < count; ++k) {
+                    partition.rows[cursor[group[k]]++] = scattered[begin + k];
+                }
+            }
+        });
+
+    // Probe with chunks of left rows, concatenated in order
+    const size_t num_chunks = parallel ? threads : 1;
+    std::vector<JoinIndices> chunks(num_chunks);
+    parallel_for_chunks(
+        l.size(), num_chunks, [&](size_t c, size_t start, size_t end) {
+            auto &out = chunks[c];
+            out.left.reserve(end - start);
+            out.right.reserve(end - start);
+            for (size_t i = start; i < end; ++i) {
+                const auto &partition = partitions[partition_of(join_hash(l[i]))];
+                const uint32_t *g = partition.table.find(l[i]);
+                if (g) {
+                    for (uint32_t k = partition.offsets[*g];
+                         k < partition.offsets[*g + 1]; ++k) {
+                        join_emit(out, static_cast<int64_t>(i),
+                                  partition.rows[k]);
+                    }
+                } else if (how != JoinType::INNER) {
+                    join_emit(out, static_cast<int64_t>(i), -1);
+                }
+            }
+        });
+
+    JoinIndices out;
+    if (num_chunks == 1) {
+        out = std::move(chunks[0]);
+    } else {
+        size_t total = 0;
+        for (const auto &chunk : chunks) {
+            total += chunk.size();
+        }
+        out.left.reserve(total);
+        out.right.reserve(total);
+        for (const auto &chunk : chunks) {
+            out.left.insert(out.left.end(), chunk.left.begin(), chunk.left.end());
+            out.right.insert(out.right.end(), chunk.right.begin(),
+                             chunk.right.end());
+        }
+    }
+
+    if (how == JoinType::OUTER) {
+        std::vector<uint8_t> matched(r.size(), 0);
+        for (int64_t j : out.right) {
+            if (j >= 0) {
+                matched[static_cast<size_t>(j)] = 1;
+            }
+        }
+        for (size_t j = 0; j < r.size(); ++j) {
+            if (!matched[j]) {
+                join_emit(out, -1, static_cast<int64_t>(j));
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace detail
+
+template <typename K>
+inline JoinIndices join_indices(const Serie<K> &left, const Serie<K> &right,
+                                JoinType how) {
+    const auto &l = left.data();
+    const auto &r = right.data();
+    if (detail::join_mergeable(l) && detail::join_mergeable(r)) {
+        return detail::sort_merge_join(l, r, how);
+    }
+    return detail::hash_join(l, r, how);
+}
+
+inline JoinIndices join_indices(const CategoricalSerie &left,
+                               const CategoricalSerie &right, JoinType how) {
+    const auto &dictionary = *left.dictionary();
+    const size_t k = dictionary.size();
+    const auto none = static_cast<uint32_t>(k); // null or unknown value
+
+    // Right codes -> left codes
+    std::vector<uint32_t> translate;
+    if (right.dictionary() != left.dictionary()) {
+        const auto &values = right.dictionary()->values();
+        translate.resize(values.size());
+        for (size_t c = 0; c < values.size(); ++c) {
+            const uint32_t *code = dictionary.find(values[c]);
+            translate[c] = code ? *code : none;
+        }
+    }
+    std::vector<uint32_t> rk(right.size());
+    right.visitCodes([&](const auto &codes) {
+        for (size_t j = 0; j < codes.size(); ++j) {
+            if (right.isNull(j)) {
+                rk[j] = none;
+            } else {
+                rk[j] = translate.empty() ? codes[j] : translate[codes[j]];
+            }
+        }
+    });
+
+    // Right rows bucketed by code, in increasing order
+    std::vector<size_t> offsets(k + 2, 0);
+    for (uint32_t c : rk) {
+        ++offsets[c + 1];
+    }
+    for (size_t c = 1; c < offsets.size(); ++c) {
+        offsets[c] += offsets[c - 1];
+    }
+    std::vector<int64_t> rows(rk.size());
+    {
+        std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t j = 0; j < rk.size(); ++j) {
+            rows[cursor[rk[j]]++] = static_cast<int64_t>(j);
+        }
+    }
+
+    JoinIndices out;
+    out.left.reserve(left.size());
+    out.right.reserve(left.size());
+    std::vector<uint8_t> matched(k, 0);
+    left.visitCodes([&](const auto &codes) {
+        for (size_t i = 0; i < codes.size(); ++i) {
+            const uint32_t c = codes[i];
+            if (!left.isNull(i) && offsets[c] != offsets[c + 1]) {
+                matched[c] = 1;
+                for (size_t r = offsets[c]; r < offsets[c + 1]; ++r) {
+                    detail::join_emit(out, static_cast<int64_t>(i), rows[r]);
+                }
+            } else if (how != JoinType::INNER) {
+                detail::join_emit(out, static_cast<int64_t>(i), -1);
+            }
+        }
+    });
+
+    if (how == JoinType::OUTER) {
+        for (size_t j = 0; j < rk.size(); ++j) {
+            if (rk[j] == none || !matched[rk[j]]) {
+                detail::join_emit(out, -1, static_cast<int64_t>(j));
+            }
+        }
+    }
+    return out;
+}
+
+namespace detail {
+
+// Key column of a categorical join: the left key, or the right one for the
+// unmatched right rows. The left dictionary is shared, or copied if some
+// right values are not in it.
+inline CategoricalSerie join_categorical_keys(const CategoricalSerie &lk,
+                                              const CategoricalSerie &rk,
+                                              const JoinIndices &idx) {
+    auto dictionary = lk.dictionary();
+    for (size_t i = 0; i < idx.size(); ++i) {
+        if (idx.left[i] < 0) {
+            const auto j = static_cast<size_t>(idx.right[i]);
+            if (!rk.isNull(j) && !dictionary->find(rk[j])) {
+                dictionary = std::make_shared<Dictionary>(*dictionary);
+                break;
+            }
+        }
+    }
+
+    CategoricalSerie keys(dictionary);
+    keys.reserve(idx.size());
+    for (size_t i = 0; i < idx.size(); ++i) {
+        if (idx.left[i] >= 0) {
+            const auto l = static_cast<size_t>(idx.left[i]);
+            if (lk.isNull(l)) {
+                keys.addNull();
+            } else {
+                keys.addCode(lk.code(l));
+            }
+        } else {
+            const auto j = static_cast<size_t>(idx.right[i]);
+            if (rk.isNull(j)) {
+                keys.addNull();
+            } else {
+                keys.add(rk[j]);
+            }
+        }
+    }
+    return keys;
+}
+
+} // namespace detail
+
+inline Dataframe join(const Dataframe &left, const Dataframe &right,
+                      const std::string &on, JoinType how) {
+    if (!left.has(on) || !right.has(on)) {
+        throw std::runtime_error(
+            concat("join: key column '", on, "' must exist in both Dataframes"));
+    }
+    if (left.type(on) != right.type(on)) {
+        throw std::runtime_error(
+            concat("join: key column '", on, "' has different types (",
+                   left.type_name(on), " vs ", right.type_name(on), ")"));
+    }
+
+    Dataframe result;
+    JoinIndices idx;
+    const auto *lc = dynamic_cast<const CategoricalSerie *>(&left.get(on));
+    const auto *rc = dynamic_cast<const CategoricalSerie *>(&right.get(on));
+    bool supported = lc && rc;
+    if (supported) {
+        idx = join_indices(*lc, *rc, how);
+        result.add(on, std::make_shared<CategoricalSerie>(
+                           detail::join_categorical_keys(*lc, *rc, idx)));
+    } else {
+        visit(left.get(on), [&](const auto &left_keys) {
+            using K = typename std::decay_t<decltype(left_keys)>::value_type;
+            if constexpr (std::is_arithmetic_v<K> ||
+                          std::is_same_v<K, std::string>) {
+                const auto &right_keys = right.get<K>(on);
+                const auto &lk = left_keys.data();
+                const auto &rk = right_keys.data();
+                idx = join_indices(left_keys, right_keys, how);
+
+                // Key of the left row, or of the right one if unmatched
+                std::vector<K> keys(idx.size());
+                for (size_t i = 0; i < idx.size(); ++i) {
+                    keys[i] = idx.left[i] >= 0
+                                  ? lk[static_cast<size_t>(idx.left[i])]
+                                  : rk[static_cast<size_t>(idx.right[i])];
+                }
+                result.add(on, Serie<K>(keys));
+                supported = true;
+            }
+        });
+    }
+    if (!supported) {
+        throw std::runtime_error(concat("join: unsupported key type ",
+                                        left.type_name(on), " for column '",
+                                        on, "'"));
+    }
+
+    // Typed gathers of all the other columns, in parallel
+    struct Task {
+        std::string name;
+        const SerieBase *serie;
+        const std::vector<int64_t> *indices;
+    };
+    std::vector<Task> tasks;
+    for (const auto &[name, info] : left) {
+        if (name != on) {
+            tasks.push_back({right.has(name) ? name + "_left" : name,
+                             info.data.get(), &idx.left});
+        }
+    }
+    for (const auto &[name, info] : right) {
+        if (name != on) {
+            tasks.push_back({left.has(name) ? name + "_right" : name,
+                             info.data.get(), &idx.right});
+        }
+    }
+
+    std::vector<std::shared_ptr<SerieBase>> columns(tasks.size());
+    const size_t rows = idx.size() * tasks.size();
+    detail::parallel_for_chunks(
+        tasks.size(),
+        std::min(tasks.size(), detail::get_optimal_threads(rows)),
+        [&](size_t, size_t first, size_t last) {
+            for (size_t t = first; t < last; ++t) {
+                columns[t] = tasks[t].serie->gather(*tasks[t].indices);
+            }
+        });
+    for (size_t t = 0; t < tasks.size(); ++t) {
+        result.add(tasks[t].name, columns[t]);
+    }
+    return result;
+}
+
+} // namespace df
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+namespace df {
+
+namespace detail {
+
+inline uint64_t hash_combine(uint64_t seed, uint64_t h) {
+    return hash_mix(seed ^ h);
+}
+
+// Trivially copyable values are hashed through their bytes (8 at a time), so
+// that doubles, ints and fixed-size arrays (Vector3, Stress...) do not need a
+// std::hash specialization
+template <typename T> uint64_t hash_value(const T &value) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        const char *bytes = reinterpret_cast<const char *>(&value);
+        uint64_t h = sizeof(T);
+        size_t i = 0;
+        for (; i + 8 <= sizeof(T); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, 8);
+            h = hash_combine(h, word);
+        }
+        if (i < sizeof(T)) {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + i, sizeof(T) - i);
+            h = hash_combine(h, word);
+        }
+        return h;
+    } else {
+        return static_cast<uint64_t>(std::hash<T>{}(value));
+    }
+}
+
+template <typename T>
+uint64_t hash_at(const Serie<T> &serie, size_t i, uint64_t h) {
+    const T value = serie.data()[i];
+    h = hash_combine(h, hash_value(value));
+    return serie.isNull(i) ? hash_combine(h, 1) : h;
+}
+
+template <typename R> struct memoized_serie : std::false_type {};
+template <typename U> struct memoized_serie<Serie<U>> : std::true_type {};
+
+// Results that can be spilled with io::save / io::load
+template <typename R> struct spillable : std::false_type {};
+template <typename U>
+struct spillable<Serie<U>>
+    : std::bool_constant<std::is_arithmetic_v<U> ||
+                         std::is_same_v<U, std::string>> {};
+
+} // namespace detail
+
+template <typename T> uint64_t sampled_hash(const Serie<T> &serie, size_t samples) {
+    const size_t n = serie.size();
+    uint64_t h = detail::hash_combine(0, n);
+    if (n <= samples) {
+        for (size_t i = 0; i < n; ++i) {
+            h = detail::hash_at(serie, i, h);
+        }
+    } else if (samples == 1) {
+        h = detail::hash_at(serie, 0, h);
+    } else if (samples > 1) {
+        for (size_t k = 0; k < samples; ++k) {
+            h = detail::hash_at(serie, k * (n - 1) / (samples - 1), h);
+        }
+    }
+    return h;
+}
+
+template <typename T> uint64_t content_hash(const Serie<T> &serie) {
+    uint64_t h = detail::hash_combine(0, serie.size());
+    for (size_t i = 0; i < serie.size(); ++i) {
+        const T value = serie.data()[i];
+        h = detail::hash_combine(h, detail::hash_value(value));
+    }
+    for (uint64_t word : serie.validity().words()) {
+        h = detail::hash_combine(h, word);
+    }
+    return h;
+}
+
+template <typename T>
+Fingerprint fingerprint(const Serie<T> &serie, size_t samples) {
+    return Fingerprint{serie.version(), serie.size(),
+                       sampled_hash(serie, samples)};
+}
+
+template <typename R> size_t memoize_bytes(const R &result) {
+    if constexpr (detail::memoized_serie<R>::value) {
+        using U = typename R::value_type;
+        size_t bytes = sizeof(R) + result.validity().words().size() * 8;
+        if constexpr (std::is_same_v<U, bool>) {
+            bytes += result.size() / 8;
+        } else if constexpr (std::is_same_v<U, std::string>) {
+            for (const auto &value : result.data()) {
+                bytes += sizeof(U) + value.size();
+            }
+        } else {
+            bytes += result.size() * sizeof(U);
+        }
+        return bytes;
+    } else {
+        return sizeof(R);
+    }
+}
+
+// ----------------------------------------------------------
+
+template <typename F>
+inline Memoized<F>::Memoized(F f, std::chrono::seconds timeout)
+    : func(std::move(f)) {
+    options_.timeout = timeout;
+}
+
+template <typename F>
+inline Memoized<F>::Memoized(F f, const MemoizeOptions &options)
+    : func(std::move(f)), options_(options) {}
+
+template <typename F>
+template <typename T>
+std::shared_ptr<const typename Memoized<F>::template Result<T>>
+Memoized<F>::operator()(const Serie<T> &s) const {
+    using R = Result<T>;
+    const std::type_index type(typeid(Serie<T>));
+    const bool by_content = options_.verify == Verify::Content;
+    const bool spilling = detail::spillable<R>::value && type_id<T> >= 0 &&
+                          !options_.spill_directory.empty();
+
+    // The content hash is O(n): only computed to key by content, or to look
+    // for a spilled result after a miss. It names the spilled files, so the
+    // input type is hashed by its registry id, which (unlike typeid's
+    // hash_code) does not change between runs. An unregistered type hashes as
+    // 0: in memory, the entry type is compared anyway.
+    auto hash_input = [&] {
+        return detail::hash_combine(content_hash(s),
+                                    static_cast<uint64_t>(type_id<T> + 1));
+    };
+    uint64_t hash = by_content ? hash_input() : 0;
+    const uint64_t key = by_content ? hash : s.version();
+    const uint64_t sample = options_.verify == Verify::None
+                                ? 0
+                                : sampled_hash(s, options_.samples);
+
+    { // Scope for lock
+        std::lock_guard lock(mutex);
+        auto found = index_.find(key);
+        if (found != index_.end()) {
+            auto it = found->second;
+            if (it->type == type && it->size == s.size() &&
+                it->sample == sample &&
+                !expired(*it, std::chrono::steady_clock::now())) {
+                entries_.splice(entries_.begin(), entries_, it);
+                ++stats_.hits;
+                return std::static_pointer_cast<const R>(it->value);
+            }
+            // Stale, or the input changed behind the version
+            erase(it);
+        }
+        ++stats_.misses;
+    }
+
+    std::shared_ptr<const R> result;
+    bool from_disk = false;
+    if constexpr (detail::spillable<R>::value) {
+        if (spilling) {
+            if (!by_content) {
+                hash = hash_input();
+            }
+            result = load_spilled<R>(hash);
+            from_disk = result != nullptr;
+        }
+    }
+    if (!result) {
+        result = std::make_shared<const R>(func(s));
+        if constexpr (detail::spillable<R>::value) {
+            if (spilling) {
+                spill(hash, *result);
+            }
+        }
+    }
+
+    { // Scope for lock
+        std::lock_guard lock(mutex);
+        if (from_disk) {
+            ++stats_.disk_hits;
+        }
+        insert(Entry{key, type, s.size(), sample, result,
+                     memoize_bytes(*result), std::chrono::steady_clock::now()});
+    }
+
+    return result;
+}
+
+template <typename F>
+inline bool
+Memoized<F>::expired(const Entry &entry,
+                     std::chrono::steady_clock::time_point now) const {
+    return options_.timeout != std::chrono::seconds::max() &&
+           now - entry.timestamp >= options_.timeout;
+}
+
+template <typename F>
+inline void Memoized<F>::erase(typename Entries::iterator it) const {
+    bytes_ -= it->bytes;
+    index_.erase(it->key);
+    entries_.erase(it);
+}
+
+template <typename F> inline void Memoized<F>::insert(Entry entry) const {
+    // A result larger than the whole budget is returned but not kept
+    if (options_.max_entries == 0 ||
+        (options_.max_bytes != 0 && entry.bytes > options_.max_bytes)) {
+        return;
+    }
+
+    auto found = index_.find(entry.key);
+    if (found != index_.end()) {
+        erase(found->second);
+    }
+
+    bytes_ += entry.bytes;
+    entries_.push_front(std::move(entry));
+    index_[entries_.front().key] = entries_.begin();
+
+    while (entries_.size() > options_.max_entries ||
+           (options_.max_bytes != 0 && bytes_ > options_.max_bytes)) {
+        erase(std::prev(entries_.end()));
+        ++stats_.evictions;
+    }
+}
+
+template <typename F>
+template <typename R>
+std::shared_ptr<const R> Memoized<F>::load_spilled(uint64_t hash) const {
+    namespace fs = std::filesystem;
+    const fs::path path =
+        fs::path(options_.spill_directory) / (std::to_string(hash) + ".bin");
+    std::error_code ec;
+    if (!fs::exists(path, ec)) {
+        return nullptr;
+    }
+    try {
+        using U = typename R::value_type;
+        return std::make_shared<const R>(io::load<U>(path.string()));
+    } catch (const std::runtime_error &) {
+        // Truncated or foreign file: recompute and overwrite it
+        return nullptr;
+    }
+}
+
+template <typename F>
+template <typename R>
+void Memoized<F>::spill(uint64_t hash, const R &result) const {
+    namespace fs = std::filesystem;
+    const fs::path directory(options_.spill_directory);
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec) {
+        throw std::runtime_error(
+            concat("memoize: cannot create the spill directory '",
+                   directory.string(), "': ", ec.message()));
+    }
+
+    // Written aside then renamed, so that a concurrent run never reads a
+    // partial file
+    const std::string name = std::to_string(hash);
+    const fs::path tmp =
+        directory /
+        concat(name, ".", std::hash<std::thread::id>{}(std::this_thread::get_id()),
+               ".tmp");
+    io::save(result, tmp.string());
+    fs::rename(tmp, directory / (name + ".bin"), ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+    }
+}
+
+template <typename F> inline void Memoized<F>::clear_cache() {
+    std::lock_guard lock(mutex);
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+template <typename F> inline size_t Memoized<F>::cache_size() const {
+    std::lock_guard lock(mutex);
+    return entries_.size();
+}
+
+template <typename F> inline size_t Memoized<F>::cache_bytes() const {
+    std::lock_guard lock(mutex);
+    return bytes_;
+}
+
+template <typename F> inline MemoizeStats Memoized<F>::stats() const {
+    std::lock_guard lock(mutex);
+    return stats_;
+}
+
+template <typename F>
+inline void Memoized<F>::set_timeout(std::chrono::seconds timeout) {
+    std::lock_guard lock(mutex);
+    options_.timeout = timeout;
+}
+
+} // namespace df
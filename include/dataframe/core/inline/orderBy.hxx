@@ -21,9 +21,9 @@
  *
  */
 
-#include <dataframe/core/execution_policy.h>
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
 
 namespace df {
 
@@ -34,34 +34,11 @@ inline Serie<T> orderBy(const Serie<T> &serie, KeyFunc keyFn, bool ascending,
         return serie;
     }
 
-    // Create indices for the sort
-    std::vector<size_t> indices(serie.size());
-    std::iota(indices.begin(), indices.end(), 0);
-
-    // Get the execution policy
-    auto policy = get_execution_policy(exec);
-
-    // Sort indices based on the key function
-    auto comparator = [&](size_t i, size_t j) {
-        auto key_i = keyFn(serie[i]);
-        auto key_j = keyFn(serie[j]);
-        return ascending ? (key_i < key_j) : (key_i > key_j);
-    };
-
-#if HAS_PARALLEL_ALGORITHMS
-    std::sort(policy, indices.begin(), indices.end(), comparator);
-#else
-    std::sort(indices.begin(), indices.end(), comparator);
-#endif
-
-    // Create the sorted result
-    std::vector<T> result;
-    result.reserve(serie.size());
-    for (size_t idx : indices) {
-        result.push_back(serie[idx]);
-    }
-
-    return Serie<T>(result);
+    // Keys are computed once, then argsorted
+    auto perm = detail::argsort_values(
+        serie.map([&](const T &v) { return keyFn(v); }).data(),
+        ascending ? SortOrder::ASCENDING : SortOrder::DESCENDING, false, exec);
+    return Serie<T>(detail::gather_values(serie.data(), perm));
 }
 
 /**
@@ -82,4 +59,93 @@ auto bind_orderBy(KeyFunc keyFn, bool ascending, ExecutionPolicy exec) {
     };
 }
 
-} // namespace df
\ No newline at end of file
+inline Serie<uint32_t> argsort(const Dataframe &dataframe,
+                               const std::vector<std::string> &columns,
+                               const std::vector<SortOrder> &orders,
+                               ExecutionPolicy exec) {
+    if (columns.empty()) {
+        throw std::runtime_error("orderBy: no key column given");
+    }
+    if (!orders.empty() && orders.size() != columns.size()) {
+        throw std::runtime_error(
+            concat("orderBy: ", orders.size(), " orders given for ",
+                   columns.size(), " columns"));
+    }
+
+    size_t n = 0;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        if (!dataframe.has(columns[c])) {
+            throw std::runtime_error(
+                concat("orderBy: column '", columns[c], "' does not exist"));
+        }
+        const size_t size = dataframe.get(columns[c]).size();
+        if (c > 0 && size != n) {
+            throw std::runtime_error("orderBy: key columns must have the "
+                                     "same size");
+        }
+        n = size;
+    }
+
+    // LSD over the columns: stable sorts from the least significant column
+    // to the most significant one
+    auto perm = detail::identity_permutation(n);
+    for (size_t c = columns.size(); c-- > 0;) {
+        const SortOrder order = orders.empty() ? SortOrder::ASCENDING : orders[c];
+        if (const auto *categories = dynamic_cast<const CategoricalSerie *>(
+                &dataframe.get(columns[c]))) {
+            // Sorted on the rank of the codes (the order is in the keys)
+            const auto keys = detail::category_keys(*categories, order);
+            auto next = detail::argsort_values(
+                detail::gather_values(keys, perm), SortOrder::ASCENDING,
+                false, exec);
+            for (auto &i : next) {
+                i = perm[i];
+            }
+            perm.swap(next);
+            continue;
+        }
+        bool supported = false;
+        visit(dataframe.get(columns[c]), [&](const auto &serie) {
+            using K = typename std::decay_t<decltype(serie)>::value_type;
+            if constexpr (std::is_arithmetic_v<K> ||
+                          std::is_same_v<K, std::string>) {
+                auto next = detail::argsort_values(
+                    detail::gather_values(serie.data(), perm), order, false,
+                    exec);
+                for (auto &i : next) {
+                    i = perm[i];
+                }
+                perm.swap(next);
+                supported = true;
+            }
+        });
+        if (!supported) {
+            throw std::runtime_error(
+                concat("orderBy: unsupported type ",
+                       dataframe.type_name(columns[c]), " for column '",
+                       columns[c], "'"));
+        }
+    }
+    return Serie<uint32_t>(perm);
+}
+
+inline Dataframe orderBy(const Dataframe &dataframe,
+                         const std::vector<std::string> &columns,
+                         const std::vector<SortOrder> &orders,
+                         ExecutionPolicy exec) {
+    const auto perm = argsort(dataframe, columns, orders, exec);
+    std::vector<int64_t> indices(perm.begin(), perm.end());
+
+    Dataframe result;
+    for (const auto &[name, info] : dataframe) {
+        if (info.data->size() != indices.size()) {
+            throw std::runtime_error(
+                concat("orderBy: column '", name, "' has ", info.data->size(),
+                       " rows instead of ", indices.size()));
+        }
+        result.add(name, info.data->gather(indices));
+    }
+    return result;
+}
+
+} // namespace df
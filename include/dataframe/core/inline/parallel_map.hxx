@@ -21,8 +21,11 @@
  *
  */
 
+#include <algorithm>
 #include <future>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace df {
@@ -41,7 +44,52 @@ inline size_t get_optimal_threads(size_t data_size) {
     const size_t available_threads = std::thread::hardware_concurrency();
     const size_t max_useful_threads =
         (data_size + min_items_per_thread - 1) / min_items_per_thread;
-    return std::min(available_threads, max_useful_threads);
+    return std::max<size_t>(1, std::min(available_threads, max_useful_threads));
+}
+
+// Split [0, total) into num_chunks contiguous ranges and run
+// callback(chunk_index, start, end) for each of them, one thread per range.
+// The last range is run on the calling thread. Range boundaries are
+// multiples of alignment (see bool_alignment).
+template <typename F>
+void parallel_for_chunks(size_t total, size_t num_chunks, F &&callback,
+                         size_t alignment = 1) {
+    if (num_chunks <= 1 || total == 0) {
+        callback(size_t{0}, size_t{0}, total);
+        return;
+    }
+
+    size_t chunk_size = get_chunk_size(total, num_chunks);
+    chunk_size = (chunk_size + alignment - 1) / alignment * alignment;
+    std::vector<std::future<void>> futures;
+    futures.reserve(num_chunks);
+
+    size_t last_start = 0;
+    size_t last_chunk = 0;
+    for (size_t i = 0; i < num_chunks; ++i) {
+        size_t start = std::min(i * chunk_size, total);
+        size_t end = std::min(start + chunk_size, total);
+        if (i + 1 == num_chunks) {
+            last_start = start;
+            last_chunk = i;
+            break;
+        }
+        futures.push_back(std::async(std::launch::async, [&callback, i, start, end]() {
+            callback(i, start, end);
+        }));
+    }
+    callback(last_chunk, last_start, total);
+
+    for (auto &future : futures) {
+        future.get();
+    }
+}
+
+// Chunk alignment for writing into a std::vector<T> from several threads:
+// the elements of a std::vector<bool> are bits packed into words, and two
+// threads must never write into the same word
+template <typename T> constexpr size_t bool_alignment() {
+    return std::is_same_v<T, bool> ? 64 : 1;
 }
 
 // Process a chunk of data for single series
@@ -70,37 +118,39 @@ void process_chunk_multi(F &&callback, const Serie<T> &first,
     }
 }
 
+// A null in any input Serie gives a null, as with the binary operators.
+// Other arguments have no nulls.
+template <typename U> void merge_validity(Mask &valid, const Serie<U> &serie) {
+    const Mask &other = serie.validity();
+    if (!other.empty()) {
+        valid = valid.empty() ? other : valid & other;
+    }
+}
+
+template <typename A> void merge_validity(Mask &, const A &) {}
+
 } // namespace detail
 
 // Single series parallel map
 template <typename F, typename T>
 inline auto parallel_map(F &&callback, const Serie<T> &serie) {
     using ResultType = decltype(callback(serie[0], 0));
-    std::vector<ResultType> result(serie.size());
 
     if (serie.size() < 1000) { // For small series, use regular map
         return serie.map(std::forward<F>(callback));
     }
 
-    const size_t num_threads = detail::get_optimal_threads(serie.size());
-    const size_t chunk_size = detail::get_chunk_size(serie.size(), num_threads);
-    std::vector<std::future<void>> futures;
-
-    for (size_t i = 0; i < num_threads; ++i) {
-        size_t start = i * chunk_size;
-        size_t end = std::min(start + chunk_size, serie.size());
-
-        futures.push_back(std::async(
-            std::launch::async, detail::process_chunk_single<F, T, ResultType>,
-            std::ref(callback), std::ref(serie), std::ref(result), start, end));
-    }
-
-    // Wait for all threads to complete
-    for (auto &future : futures) {
-        future.wait();
-    }
-
-    return Serie<ResultType>(result);
+    std::vector<ResultType> result(serie.size());
+    detail::parallel_for_chunks(
+        serie.size(), detail::get_optimal_threads(serie.size()),
+        [&](size_t, size_t start, size_t end) {
+            detail::process_chunk_single(callback, serie, result, start, end);
+        },
+        detail::bool_alignment<ResultType>());
+
+    Serie<ResultType> mapped(std::move(result));
+    mapped.setValidity(serie.validity());
+    return mapped;
 }
 
 // Multi series parallel map
@@ -108,35 +158,29 @@ template <typename F, typename T, typename... Args>
 inline auto parallel_map(F &&callback, const Serie<T> &first,
                          const Serie<T> &second, const Args &...args) {
     using ResultType = decltype(callback(first[0], second[0], (args[0])..., 0));
-    std::vector<ResultType> result(first.size());
 
+    Serie<ResultType> mapped;
     if (first.size() < 1000) { // For small series, use regular map
-        return map(std::forward<F>(callback), first, second, args...);
-    }
-
-    const size_t num_threads = detail::get_optimal_threads(first.size());
-    const size_t chunk_size = detail::get_chunk_size(first.size(), num_threads);
-    std::vector<std::future<void>> futures;
-
-    auto args_tuple = std::make_tuple(std::ref(args)...);
-
-    for (size_t i = 0; i < num_threads; ++i) {
-        size_t start = i * chunk_size;
-        size_t end = std::min(start + chunk_size, first.size());
-
-        futures.push_back(
-            std::async(std::launch::async,
-                       detail::process_chunk_multi<F, T, ResultType, Args...>,
-                       std::ref(callback), std::ref(first), std::ref(second),
-                       std::ref(args_tuple), std::ref(result), start, end));
-    }
-
-    // Wait for all threads to complete
-    for (auto &future : futures) {
-        future.wait();
+        mapped = map(std::forward<F>(callback), first, second, args...);
+    } else {
+        std::vector<ResultType> result(first.size());
+        const std::tuple<const Args &...> args_tuple(args...);
+        detail::parallel_for_chunks(
+            first.size(), detail::get_optimal_threads(first.size()),
+            [&](size_t, size_t start, size_t end) {
+                detail::process_chunk_multi(callback, first, second,
+                                            args_tuple, result, start, end);
+            },
+            detail::bool_alignment<ResultType>());
+        mapped = Serie<ResultType>(std::move(result));
     }
 
-    return Serie<ResultType>(result);
+    Mask valid;
+    detail::merge_validity(valid, first);
+    detail::merge_validity(valid, second);
+    (detail::merge_validity(valid, args), ...);
+    mapped.setValidity(valid);
+    return mapped;
 }
 
 // Bind function for pipe operator
@@ -0,0 +1,467 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <dataframe/core/ExecutionPolicy.h>
+#include <dataframe/core/parallel_map.h>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Implementation details of the radix sort and argsort (see core/sort.h)
+
+namespace df {
+namespace detail {
+
+// Below this size, sorting runs on a single thread whatever the policy
+constexpr size_t sort_parallel_threshold = 1 << 16;
+
+inline size_t sort_chunks(size_t n, ExecutionPolicy exec) {
+    if (exec == ExecutionPolicy::SEQ || n < sort_parallel_threshold) {
+        return 1;
+    }
+    return get_optimal_threads(n);
+}
+
+template <typename T>
+constexpr bool is_radix_sortable_v =
+    std::is_arithmetic_v<T> && sizeof(T) <= 8;
+
+// Unsigned key type holding the order-preserving encoding of T
+template <typename T>
+using radix_key_t = std::conditional_t<(sizeof(T) <= 4), uint32_t, uint64_t>;
+
+/**
+ * Order-preserving encoding of a value into an unsigned key: the sign bit of
+ * signed integers is flipped, negative floats have all their bits flipped
+ * and positive ones their sign bit. NaN gets the smallest or the largest key.
+ * Descending order is the bitwise complement of the ascending key.
+ */
+template <typename T> struct RadixEncoder {
+    using Key = radix_key_t<T>;
+    static constexpr unsigned bits = sizeof(T) * 8;
+    static constexpr Key mask =
+        bits == sizeof(Key) * 8 ? ~Key{0} : ((Key{1} << bits) - 1);
+    static constexpr Key sign = Key{1} << (bits - 1);
+
+    bool descending = false;
+    bool nan_first = false;
+
+    Key encode(T value) const {
+        Key k;
+        if constexpr (std::is_floating_point_v<T>) {
+            if (std::isnan(value)) {
+                return nan_first ? Key{0} : mask;
+            }
+            using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+            Key b = static_cast<Key>(std::bit_cast<Bits>(value));
+            k = (b & sign) ? (~b & mask) : (b | sign);
+        } else if constexpr (std::is_signed_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            k = static_cast<Key>(static_cast<U>(value)) ^ sign;
+        } else {
+            k = static_cast<Key>(value);
+        }
+        return descending ? (~k & mask) : k;
+    }
+
+    T decode(Key k) const {
+        if (descending) {
+            k = ~k & mask;
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+            using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+            Key b = (k & sign) ? (k ^ sign) : (~k & mask);
+            return std::bit_cast<T>(static_cast<Bits>(b));
+        } else if constexpr (std::is_signed_v<T>) {
+            using U = std::make_unsigned_t<T>;
+            return static_cast<T>(static_cast<U>(k ^ sign));
+        } else {
+            return static_cast<T>(k);
+        }
+    }
+};
+
+// Ranges up to this size are sorted with LSD passes (they fit in cache),
+// unless they are too small to amortize the 256-entry histograms
+constexpr size_t radix_lsd_threshold = 1 << 16;
+
+inline size_t radix_digit(uint64_t key, size_t byte) {
+    return static_cast<size_t>((key >> (byte * 8)) & 0xFF);
+}
+
+// Stable scatter of [start, end) on one byte, to the given digit offsets
+template <typename Key>
+void radix_scatter(const Key *keys, const uint32_t *perm, Key *keys_out,
+                   uint32_t *perm_out, size_t start, size_t end, size_t byte,
+                   std::array<size_t, 256> offset) {
+    if (perm) {
+        for (size_t i = start; i < end; ++i) {
+            const size_t pos = offset[radix_digit(keys[i], byte)]++;
+            keys_out[pos] = keys[i];
+            perm_out[pos] = perm[i];
+        }
+    } else {
+        for (size_t i = start; i < end; ++i) {
+            keys_out[offset[radix_digit(keys[i], byte)]++] = keys[i];
+        }
+    }
+}
+
+/**
+ * LSD passes over bytes [0, bytes) of a (small) range. The histograms of all
+ * the bytes are computed in one read; passes where all the keys share the
+ * same digit are skipped. The result ends up in keys/perm.
+ */
+template <typename Key>
+void radix_lsd(Key *keys, uint32_t *perm, Key *tmp, uint32_t *perm_tmp,
+               size_t n, size_t bytes) {
+    std::array<std::array<size_t, 256>, sizeof(Key)> counts{};
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t byte = 0; byte < bytes; ++byte) {
+            ++counts[byte][radix_digit(keys[i], byte)];
+        }
+    }
+
+    Key *src = keys, *dst = tmp;
+    uint32_t *perm_src = perm, *perm_dst = perm_tmp;
+    for (size_t byte = 0; byte < bytes; ++byte) {
+        std::array<size_t, 256> offset;
+        size_t total = 0;
+        bool trivial = false;
+        for (size_t d = 0; d < 256; ++d) {
+            offset[d] = total;
+            total += counts[byte][d];
+            trivial = trivial || counts[byte][d] == n;
+        }
+        if (trivial) {
+            continue;
+        }
+        radix_scatter(src, perm_src, dst, perm_dst, 0, n, byte, offset);
+        std::swap(src, dst);
+        std::swap(perm_src, perm_dst);
+    }
+    if (src != keys) {
+        std::copy_n(src, n, keys);
+        if (perm) {
+            std::copy_n(perm_src, n, perm);
+        }
+    }
+}
+
+/**
+ * MSD pass on `byte` over a range, then recursion on each digit bucket with
+ * the next lower byte, until the buckets are small enough for radix_lsd.
+ * Buckets stay cache-local, unlike full-array LSD passes whose scatter to
+ * 256 far apart locations is bound by TLB misses on large arrays.
+ */
+template <typename Key>
+void radix_msd(Key *keys, uint32_t *perm, Key *tmp, uint32_t *perm_tmp,
+               size_t n, size_t byte) {
+    while (true) {
+        if (n <= 64) {
+            // Stable insertion sort
+            for (size_t i = 1; i < n; ++i) {
+                const Key k = keys[i];
+                const uint32_t q = perm ? perm[i] : 0;
+                size_t j = i;
+                for (; j > 0 && keys[j - 1] > k; --j) {
+                    keys[j] = keys[j - 1];
+                    if (perm) {
+                        perm[j] = perm[j - 1];
+                    }
+                }
+                keys[j] = k;
+                if (perm) {
+                    perm[j] = q;
+                }
+            }
+            return;
+        }
+        if (n <= radix_lsd_threshold && n >= 1024 * (byte + 1)) {
+            radix_lsd(keys, perm, tmp, perm_tmp, n, byte + 1);
+            return;
+        }
+
+        std::array<size_t, 256> count{};
+        for (size_t i = 0; i < n; ++i) {
+            ++count[radix_digit(keys[i], byte)];
+        }
+        if (*std::max_element(count.begin(), count.end()) == n) {
+            if (byte == 0) {
+                return;
+            }
+            --byte; // Same digit everywhere: go down one byte
+            continue;
+        }
+
+        std::array<size_t, 256> offset;
+        size_t total = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            offset[d] = total;
+            total += count[d];
+        }
+        radix_scatter(keys, perm, tmp, perm_tmp, 0, n, byte, offset);
+        std::copy_n(tmp, n, keys);
+        if (perm) {
+            std::copy_n(perm_tmp, n, perm);
+        }
+
+        if (byte > 0) {
+            for (size_t d = 0; d < 256; ++d) {
+                if (count[d] > 1) {
+                    const size_t o = offset[d];
+                    radix_msd(keys + o, perm ? perm + o : nullptr, tmp + o,
+                              perm ? perm_tmp + o : nullptr, count[d], byte - 1);
+                }
+            }
+        }
+        return;
+    }
+}
+
+/**
+ * Stable radix sort of `keys` on their `key_bytes` low bytes, carrying
+ * `perm` along when not null.
+ *
+ * The most significant non-trivial byte is processed over the whole array
+ * in chunks (per-chunk histograms, then a parallel scatter where each chunk
+ * writes to its own precomputed offsets). The 256 resulting buckets are then
+ * sorted independently and in parallel by radix_msd.
+ */
+template <typename Key>
+void radix_sort_keys(std::vector<Key> &keys, std::vector<uint32_t> *perm,
+                     size_t key_bytes, size_t num_chunks) {
+    const size_t n = keys.size();
+    if (n < 2 || key_bytes == 0) {
+        return;
+    }
+    num_chunks = std::max<size_t>(1, std::min(num_chunks, n));
+
+    std::vector<Key> tmp(n);
+    std::vector<uint32_t> perm_tmp(perm ? n : 0);
+    uint32_t *p = perm ? perm->data() : nullptr;
+    uint32_t *pt = perm ? perm_tmp.data() : nullptr;
+
+    if (num_chunks == 1) {
+        radix_msd(keys.data(), p, tmp.data(), pt, n, key_bytes - 1);
+        return;
+    }
+
+    std::vector<std::array<size_t, 256>> counts(num_chunks);
+    for (size_t byte = key_bytes; byte-- > 0;) {
+        parallel_for_chunks(n, num_chunks, [&](size_t c, size_t start, size_t end) {
+            auto &count = counts[c];
+            count.fill(0);
+            for (size_t i = start; i < end; ++i) {
+                ++count[radix_digit(keys[i], byte)];
+            }
+        });
+
+        // Exclusive prefix over (digit, chunk)
+        std::array<size_t, 257> bucket{};
+        size_t total = 0;
+        bool trivial = false;
+        for (size_t d = 0; d < 256; ++d) {
+            bucket[d] = total;
+            for (size_t c = 0; c < num_chunks; ++c) {
+                const size_t count = counts[c][d];
+                counts[c][d] = total;
+                total += count;
+            }
+            trivial = trivial || total - bucket[d] == n;
+        }
+        bucket[256] = total;
+        if (trivial) {
+            continue;
+        }
+
+        parallel_for_chunks(n, num_chunks, [&](size_t c, size_t start, size_t end) {
+            radix_scatter(keys.data(), p, tmp.data(), pt, start, end, byte,
+                          counts[c]);
+        });
+        keys.swap(tmp);
+        if (perm) {
+            perm->swap(perm_tmp);
+            p = perm->data();
+            pt = perm_tmp.data();
+        }
+
+        if (byte > 0) {
+            parallel_for_chunks(256, num_chunks, [&](size_t, size_t first, size_t last) {
+                for (size_t d = first; d < last; ++d) {
+                    const size_t o = bucket[d];
+                    const size_t size = bucket[d + 1] - o;
+                    if (size > 1) {
+                        radix_msd(keys.data() + o, p ? p + o : nullptr,
+                                  tmp.data() + o, p ? pt + o : nullptr, size,
+                                  byte - 1);
+                    }
+                }
+            });
+        }
+        return;
+    }
+}
+
+/**
+ * Stable sort of a vector with a comparator: chunks sorted in parallel with
+ * std::stable_sort, then merged two by two (in parallel) until one remains.
+ */
+template <typename V, typename Compare>
+void parallel_stable_sort(std::vector<V> &values, Compare comp,
+                          size_t num_chunks) {
+    const size_t n = values.size();
+    if (num_chunks <= 1 || n < 2) {
+        std::stable_sort(values.begin(), values.end(), comp);
+        return;
+    }
+
+    const size_t chunk = get_chunk_size(n, num_chunks);
+    parallel_for_chunks(n, num_chunks, [&](size_t, size_t start, size_t end) {
+        std::stable_sort(values.begin() + start, values.begin() + end, comp);
+    });
+
+    std::vector<V> buffer(n);
+    for (size_t width = chunk; width < n; width *= 2) {
+        const size_t pairs = (n + 2 * width - 1) / (2 * width);
+        parallel_for_chunks(pairs, std::min(pairs, num_chunks),
+                            [&](size_t, size_t first, size_t last) {
+                                for (size_t p = first; p < last; ++p) {
+                                    const size_t lo = p * 2 * width;
+                                    const size_t mid = std::min(lo + width, n);
+                                    const size_t hi = std::min(lo + 2 * width, n);
+                                    std::merge(values.begin() + lo,
+                                               values.begin() + mid,
+                                               values.begin() + mid,
+                                               values.begin() + hi,
+                                               buffer.begin() + lo, comp);
+                                }
+                            });
+        values.swap(buffer);
+    }
+}
+
+inline std::vector<uint32_t> identity_permutation(size_t n) {
+    if (n > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error(
+            "argsort: too many elements for a Serie<uint32_t> permutation");
+    }
+    std::vector<uint32_t> perm(n);
+    std::iota(perm.begin(), perm.end(), 0u);
+    return perm;
+}
+
+/**
+ * Stable permutation sorting `values`. Radix sort for arithmetic types,
+ * stable comparison sort (operator<) otherwise. For floating point values,
+ * NaN are placed last, or first if nan_first, whatever the order.
+ */
+template <typename T>
+std::vector<uint32_t> argsort_values(const std::vector<T> &values,
+                                     SortOrder order, bool nan_first,
+                                     ExecutionPolicy exec) {
+    const size_t n = values.size();
+    auto perm = identity_permutation(n);
+    const size_t num_chunks = sort_chunks(n, exec);
+
+    if constexpr (is_radix_sortable_v<T>) {
+        RadixEncoder<T> encoder{order == SortOrder::DESCENDING, nan_first};
+        std::vector<radix_key_t<T>> keys(n);
+        parallel_for_chunks(n, num_chunks, [&](size_t, size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                keys[i] = encoder.encode(values[i]);
+            }
+        });
+        radix_sort_keys(keys, &perm, sizeof(T), num_chunks);
+    } else {
+        if (order == SortOrder::ASCENDING) {
+            parallel_stable_sort(
+                perm,
+                [&](uint32_t a, uint32_t b) { return values[a] < values[b]; },
+                num_chunks);
+        } else {
+            parallel_stable_sort(
+                perm,
+                [&](uint32_t a, uint32_t b) { return values[b] < values[a]; },
+                num_chunks);
+        }
+    }
+    return perm;
+}
+
+/**
+ * Sorted copy of arithmetic values: radix sort of the encoded keys, decoded
+ * back (no permutation needed)
+ */
+template <typename T>
+std::vector<T> radix_sort_values(const std::vector<T> &values, SortOrder order,
+                                 bool nan_first, ExecutionPolicy exec) {
+    const size_t n = values.size();
+    const size_t num_chunks = sort_chunks(n, exec);
+    RadixEncoder<T> encoder{order == SortOrder::DESCENDING, nan_first};
+
+    // Chunks of std::vector<bool> must not share words
+    std::vector<radix_key_t<T>> keys(n);
+    parallel_for_chunks(
+        n, num_chunks,
+        [&](size_t, size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                keys[i] = encoder.encode(values[i]);
+            }
+        },
+        bool_alignment<T>());
+    radix_sort_keys(keys, static_cast<std::vector<uint32_t> *>(nullptr),
+                    sizeof(T), num_chunks);
+
+    std::vector<T> result(n);
+    parallel_for_chunks(
+        n, num_chunks,
+        [&](size_t, size_t start, size_t end) {
+            for (size_t i = start; i < end; ++i) {
+                result[i] = encoder.decode(keys[i]);
+            }
+        },
+        bool_alignment<T>());
+    return result;
+}
+
+template <typename T>
+std::vector<T> gather_values(const std::vector<T> &values,
+                             const std::vector<uint32_t> &perm) {
+    std::vector<T> result;
+    result.reserve(perm.size());
+    for (uint32_t i : perm) {
+        result.push_back(values[i]);
+    }
+    return result;
+}
+
+} // namespace detail
+} // namespace df
@@ -15,17 +15,9 @@
 namespace df {
 
 template <typename F, typename T>
-inline Serie<T> reject(F &&predicate, const Serie<T> &serie) {
-    std::vector<T> result;
-    result.reserve(serie.size()); // Reserve maximum possible size
-
-    for (size_t i = 0; i < serie.size(); ++i) {
-        if (!predicate(serie[i], i)) {
-            result.push_back(serie[i]);
-        }
-    }
-
-    return Serie<T>(result);
+inline Serie<T> reject(F &&predicate, const Serie<T> &serie,
+                       ExecutionPolicy exec) {
+    return (~Mask::from(serie, predicate, exec)).select(serie);
 }
 
 template <typename F, typename T, typename... Args>
@@ -36,16 +28,13 @@ inline Serie<T> reject(F &&predicate, const Serie<T> &first,
         throw std::runtime_error("All series must have the same size");
     }
 
-    std::vector<T> result;
-    result.reserve(first.size());
-
-    for (size_t i = 0; i < first.size(); ++i) {
-        if (!predicate(first[i], second[i], (args[i])..., i)) {
-            result.push_back(first[i]);
-        }
-    }
-
-    return Serie<T>(result);
+    const auto &a = first.data();
+    const auto &b = second.data();
+    auto mask = Mask::generate(
+        a.size(),
+        [&](size_t i) { return !predicate(a[i], b[i], (args.data()[i])..., i); },
+        ExecutionPolicy::SEQ);
+    return mask.select(first);
 }
 
 template <typename T> inline auto less_than(T threshold) {
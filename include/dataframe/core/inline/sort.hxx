@@ -21,50 +21,36 @@
  *
  */
 
+#include "radix_sort.hxx"
 #include <algorithm>
-#include <execution>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 namespace df {
 
-#if HAS_PARALLEL_ALGORITHMS
-#else
-// Overload sort to ignore the execution policy when parallel support is missing
-template <typename Iterator, typename Compare>
-void sort(ExecutionPolicyTraits::dummy_policy, Iterator first, Iterator last,
-          Compare comp) {
-    std::sort(first, last, comp);
-}
-
-template <typename Iterator>
-void sort(ExecutionPolicyTraits::dummy_policy, Iterator first, Iterator last) {
-    std::sort(first, last);
-}
-#endif
-
 template <typename T> class Sort {
   public:
-    // Basic sort with order and execution policy
+    // Basic sort with order and execution policy. Arithmetic types use a
+    // (parallel) LSD radix sort
     static Serie<T> sort(const Serie<T> &serie,
                          SortOrder order = SortOrder::ASCENDING,
                          ExecutionPolicy exec = ExecutionPolicy::SEQ) {
-        std::vector<T> result(serie.data());
-        auto policy = get_execution_policy(exec);
-
-        if (order == SortOrder::ASCENDING) {
-#if HAS_PARALLEL_ALGORITHMS
-            std::sort(policy, result.begin(), result.end());
-#else
-            std::sort(result.begin(), result.end());
-#endif
+        if constexpr (detail::is_radix_sortable_v<T>) {
+            return Serie<T>(
+                detail::radix_sort_values(serie.data(), order, false, exec));
         } else {
-#if HAS_PARALLEL_ALGORITHMS
-            std::sort(policy, result.begin(), result.end(), std::greater<T>());
-#else
-            std::sort(result.begin(), result.end(), std::greater<T>());
-#endif
+            std::vector<T> result(serie.data());
+            const size_t num_chunks = detail::sort_chunks(result.size(), exec);
+            if (order == SortOrder::ASCENDING) {
+                detail::parallel_stable_sort(result, std::less<T>(),
+                                             num_chunks);
+            } else {
+                detail::parallel_stable_sort(result, std::greater<T>(),
+                                             num_chunks);
+            }
+            return Serie<T>(result);
         }
-        return Serie<T>(result);
     }
 
     // Sort with custom comparator
@@ -72,45 +58,25 @@ template <typename T> class Sort {
     static Serie<T> sort(const Serie<T> &serie, Compare comp,
                          ExecutionPolicy exec = ExecutionPolicy::SEQ) {
         std::vector<T> result(serie.data());
-        auto policy = get_execution_policy(exec);
-
-#if HAS_PARALLEL_ALGORITHMS
-        std::sort(policy, result.begin(), result.end(), comp);
-#else
-        std::sort(result.begin(), result.end(), comp);
-#endif
-
+        const size_t num_chunks = detail::sort_chunks(result.size(), exec);
+        if (num_chunks == 1) {
+            std::sort(result.begin(), result.end(), comp);
+        } else {
+            detail::parallel_stable_sort(result, comp, num_chunks);
+        }
         return Serie<T>(result);
     }
 
-    // Sort by key function
+    // Sort by key function. The keys are computed once, then argsorted
+    // (decorate-sort-undecorate). Stable.
     template <typename KeyFunc>
     static Serie<T> sort_by(const Serie<T> &serie, KeyFunc key_func,
                             SortOrder order = SortOrder::ASCENDING,
                             ExecutionPolicy exec = ExecutionPolicy::SEQ) {
-        std::vector<size_t> indices(serie.size());
-        std::iota(indices.begin(), indices.end(), 0);
-        auto policy = get_execution_policy(exec);
-
-        auto comp = [&](size_t i, size_t j) {
-            if (order == SortOrder::ASCENDING) {
-                return key_func(serie[i]) < key_func(serie[j]);
-            }
-            return key_func(serie[i]) > key_func(serie[j]);
-        };
-
-#if HAS_PARALLEL_ALGORITHMS
-        std::sort(policy, indices.begin(), indices.end(), comp);
-#else
-        std::sort(indices.begin(), indices.end(), comp);
-#endif
-
-        std::vector<T> result;
-        result.reserve(serie.size());
-        for (size_t idx : indices) {
-            result.push_back(serie[idx]);
-        }
-        return Serie<T>(result);
+        auto perm = detail::argsort_values(
+            serie.map([&](const T &v) { return key_func(v); }).data(), order,
+            false, exec);
+        return Serie<T>(detail::gather_values(serie.data(), perm));
     }
 
     // Sort with NaN handling
@@ -118,30 +84,28 @@ template <typename T> class Sort {
                              SortOrder order = SortOrder::ASCENDING,
                              bool nan_first = false,
                              ExecutionPolicy exec = ExecutionPolicy::SEQ) {
-        std::vector<T> result(serie.data());
-        auto policy = get_execution_policy(exec);
-
-        auto comp = [order, nan_first](const T &a, const T &b) {
-            bool a_nan = std::isnan(a);
-            bool b_nan = std::isnan(b);
-
-            if (a_nan && b_nan)
-                return false;
-            if (a_nan)
-                return nan_first;
-            if (b_nan)
-                return !nan_first;
-
-            return order == SortOrder::ASCENDING ? a < b : a > b;
-        };
+        if constexpr (detail::is_radix_sortable_v<T>) {
+            return Serie<T>(detail::radix_sort_values(serie.data(), order,
+                                                      nan_first, exec));
+        } else {
+            std::vector<T> result(serie.data());
+            auto comp = [order, nan_first](const T &a, const T &b) {
+                bool a_nan = std::isnan(a);
+                bool b_nan = std::isnan(b);
 
-#if HAS_PARALLEL_ALGORITHMS
-        std::sort(policy, result.begin(), result.end(), comp);
-#else
-        std::sort(result.begin(), result.end(), comp);
-#endif
+                if (a_nan && b_nan)
+                    return false;
+                if (a_nan)
+                    return nan_first;
+                if (b_nan)
+                    return !nan_first;
 
-        return Serie<T>(result);
+                return order == SortOrder::ASCENDING ? a < b : a > b;
+            };
+            detail::parallel_stable_sort(
+                result, comp, detail::sort_chunks(result.size(), exec));
+            return Serie<T>(result);
+        }
     }
 };
 
@@ -168,6 +132,105 @@ Serie<T> sort_nan(const Serie<T> &serie, SortOrder order, bool nan_first,
     return Sort<T>::sort_nan(serie, order, nan_first, exec);
 }
 
+template <typename T>
+Serie<uint32_t> argsort(const Serie<T> &serie, SortOrder order, bool nan_first,
+                        ExecutionPolicy exec) {
+    return Serie<uint32_t>(
+        detail::argsort_values(serie.data(), order, nan_first, exec));
+}
+
+template <typename T, typename KeyFunc>
+Serie<uint32_t> argsort_by(const Serie<T> &serie, KeyFunc key_func,
+                           SortOrder order, ExecutionPolicy exec) {
+    return argsort(serie.map([&](const T &v) { return key_func(v); }), order,
+                   false, exec);
+}
+
+inline Serie<uint32_t> argsort(const StringSerie &serie, SortOrder order,
+                               ExecutionPolicy exec) {
+    const size_t n = serie.size();
+    auto perm = detail::identity_permutation(n);
+    const bool descending = order == SortOrder::DESCENDING;
+    detail::parallel_stable_sort(
+        perm,
+        [&](uint32_t a, uint32_t b) {
+            const bool a_null = serie.isNull(a);
+            const bool b_null = serie.isNull(b);
+            if (a_null || b_null) {
+                return !a_null;
+            }
+            const int cmp = serie.compare(a, b);
+            return descending ? cmp > 0 : cmp < 0;
+        },
+        detail::sort_chunks(n, exec));
+    return Serie<uint32_t>(std::move(perm));
+}
+
+inline StringSerie sort(const StringSerie &serie, SortOrder order,
+                        ExecutionPolicy exec) {
+    const auto perm = argsort(serie, order, exec);
+    const std::vector<int64_t> indices(perm.data().begin(), perm.data().end());
+    return std::move(
+        *std::static_pointer_cast<StringSerie>(serie.gather(indices)));
+}
+
+namespace detail {
+
+// Sort key of each row of a categorical Serie: the rank of its value among
+// the dictionary values (reversed for a descending order), nulls last
+inline std::vector<uint32_t> category_keys(const CategoricalSerie &serie,
+                                           SortOrder order) {
+    const auto &dictionary = *serie.dictionary();
+    std::vector<uint32_t> rank = dictionary.ranks();
+    if (order == SortOrder::DESCENDING) {
+        for (auto &r : rank) {
+            r = static_cast<uint32_t>(rank.size() - 1) - r;
+        }
+    }
+    const auto null_key = static_cast<uint32_t>(dictionary.size());
+
+    std::vector<uint32_t> keys(serie.size());
+    serie.visitCodes([&](const auto &codes) {
+        for (size_t i = 0; i < codes.size(); ++i) {
+            keys[i] = serie.isNull(i) ? null_key : rank[codes[i]];
+        }
+    });
+    return keys;
+}
+
+} // namespace detail
+
+inline Serie<uint32_t> argsort(const CategoricalSerie &serie, SortOrder order,
+                               ExecutionPolicy) {
+    const size_t n = serie.size();
+    if (n > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("argsort: too many elements");
+    }
+    const auto keys = detail::category_keys(serie, order);
+
+    // Counting sort on the keys (stable)
+    std::vector<uint32_t> start(serie.dictionary()->size() + 2, 0);
+    for (uint32_t key : keys) {
+        ++start[key + 1];
+    }
+    for (size_t k = 1; k < start.size(); ++k) {
+        start[k] += start[k - 1];
+    }
+    std::vector<uint32_t> perm(n);
+    for (size_t i = 0; i < n; ++i) {
+        perm[start[keys[i]]++] = static_cast<uint32_t>(i);
+    }
+    return Serie<uint32_t>(std::move(perm));
+}
+
+inline CategoricalSerie sort(const CategoricalSerie &serie, SortOrder order,
+                             ExecutionPolicy exec) {
+    const auto perm = argsort(serie, order, exec);
+    const std::vector<int64_t> indices(perm.data().begin(), perm.data().end());
+    return std::move(
+        *std::static_pointer_cast<CategoricalSerie>(serie.gather(indices)));
+}
+
 // Bind functions for pipeline operations with parallel support
 template <typename T> auto bind_sort(SortOrder order, ExecutionPolicy exec) {
     return [order, exec](const Serie<T> &serie) {
@@ -187,4 +250,11 @@ auto bind_sort_by(KeyFunc key_func, SortOrder order, ExecutionPolicy exec) {
     };
 }
 
+template <typename T>
+auto bind_argsort(SortOrder order, bool nan_first, ExecutionPolicy exec) {
+    return [order, nan_first, exec](const Serie<T> &serie) {
+        return argsort(serie, order, nan_first, exec);
+    };
+}
+
 } // namespace df
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+namespace df {
+
+namespace detail {
+
+// Pool and worker index of the calling thread (see TaskPool::workerIndex)
+struct TaskWorker {
+    const TaskPool *pool = nullptr;
+    size_t index = 0;
+};
+
+inline TaskWorker &current_task_worker() {
+    static thread_local TaskWorker worker;
+    return worker;
+}
+
+// Completion count shared by the tasks of one wait. The tasks hold it by
+// shared_ptr, so it outlives the waiting function.
+struct TaskCounter {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t remaining = 0;
+    std::exception_ptr error;
+
+    void done(std::exception_ptr e = nullptr) {
+        std::lock_guard lock(mutex);
+        if (e && !error) {
+            error = e;
+        }
+        if (--remaining == 0) {
+            cv.notify_all();
+        }
+    }
+};
+
+// Wait for the counter to reach 0, running queued tasks meanwhile. The
+// timed wait picks up tasks queued later by other threads.
+inline void help_until_done(TaskPool &pool, TaskCounter &counter) {
+    std::unique_lock lock(counter.mutex);
+    while (counter.remaining != 0) {
+        lock.unlock();
+        const bool ran = pool.tryRunOne();
+        lock.lock();
+        if (!ran && counter.remaining != 0) {
+            counter.cv.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+}
+
+} // namespace detail
+
+inline TaskPool::TaskPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i] { work(i); });
+    }
+}
+
+inline TaskPool::~TaskPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+inline TaskPool &TaskPool::shared() {
+    static TaskPool pool;
+    return pool;
+}
+
+inline void TaskPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+inline bool TaskPool::tryRunOne() {
+    std::function<void()> task;
+    {
+        std::lock_guard lock(mutex_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+    }
+    task();
+    return true;
+}
+
+inline size_t TaskPool::workerIndex() const {
+    const auto &worker = detail::current_task_worker();
+    return worker.pool == this ? worker.index : size();
+}
+
+inline void TaskPool::work(size_t index) {
+    detail::current_task_worker() = detail::TaskWorker{this, index};
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return; // stopped
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+template <typename F> void TaskPool::parallel_for(size_t n, F &&f) {
+    if (n == 0) {
+        return;
+    }
+    if (n == 1) {
+        f(size_t{0});
+        return;
+    }
+
+    auto counter = std::make_shared<detail::TaskCounter>();
+    counter->remaining = n;
+    auto call = [&f, counter](size_t i) {
+        try {
+            f(i);
+            counter->done();
+        } catch (...) {
+            counter->done(std::current_exception());
+        }
+    };
+    for (size_t i = 1; i < n; ++i) {
+        submit([call, i] { call(i); });
+    }
+    call(0);
+
+    detail::help_until_done(*this, *counter);
+    if (counter->error) {
+        std::rethrow_exception(counter->error);
+    }
+}
+
+// ----------------------------------------------------------
+
+template <typename T>
+std::shared_ptr<const T> TaskGraph::Node<T>::get() const {
+    if (!slot_ || !slot_->value) {
+        throw std::runtime_error(
+            "TaskGraph::Node::get: no result (the graph was not run, or the "
+            "node failed)");
+    }
+    return slot_->value;
+}
+
+inline TaskGraph::TaskGraph(TaskPool &pool) : pool_(pool) {}
+
+template <typename T> void TaskGraph::check(const Node<T> &input) const {
+    if (!input.slot_ || input.id_ >= tasks_.size()) {
+        throw std::invalid_argument(
+            "TaskGraph::add: the input is not a node of this graph");
+    }
+}
+
+inline size_t TaskGraph::addTask(const std::string &name,
+                                 std::function<void()> run,
+                                 std::function<void()> reset,
+                                 const std::vector<size_t> &inputs) {
+    const size_t id = tasks_.size();
+    tasks_.push_back(
+        Task{name, std::move(run), std::move(reset), {}, inputs.size()});
+    for (size_t input : inputs) {
+        tasks_[input].dependents.push_back(id);
+    }
+    return id;
+}
+
+template <typename F, typename... Ts>
+auto TaskGraph::add(const std::string &name, F &&f, const Node<Ts> &...inputs)
+    -> Node<std::decay_t<std::invoke_result_t<F &, const Ts &...>>> {
+    using R = std::decay_t<std::invoke_result_t<F &, const Ts &...>>;
+    static_assert(!std::is_void_v<R>,
+                  "TaskGraph::add: a node must return a value");
+    (check(inputs), ...);
+
+    auto slot = std::make_shared<Slot<R>>();
+    auto run = [slot, f = std::forward<F>(f),
+                in = std::make_tuple(inputs.slot_...)]() mutable {
+        slot->value = std::apply(
+            [&](const auto &...from) {
+                return std::make_shared<const R>(f(*from->value...));
+            },
+            in);
+    };
+    const size_t id = addTask(
+        name, std::move(run), [slot] { slot->value.reset(); }, {inputs.id_...});
+    return Node<R>(id, slot);
+}
+
+template <typename T>
+TaskGraph::Node<T> TaskGraph::input(const std::string &name,
+                                    std::shared_ptr<const T> value) {
+    auto slot = std::make_shared<Slot<T>>();
+    const size_t id = addTask(
+        name, [slot, value] { slot->value = value; },
+        [slot] { slot->value.reset(); }, {});
+    return Node<T>(id, slot);
+}
+
+// Scheduling state of one run, shared with the tasks in flight
+struct TaskGraph::RunState : detail::TaskCounter {
+    TaskGraph *graph = nullptr;
+    std::chrono::steady_clock::time_point origin;
+    std::vector<size_t> pending;
+    std::vector<char> failed;
+
+    double elapsed() const {
+        return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - origin)
+            .count();
+    }
+};
+
+// Run node i, then schedule the dependents it made ready. Each task only
+// writes its own slot and trace entry.
+inline void TaskGraph::execute(const std::shared_ptr<RunState> &state,
+                               size_t i) {
+    TaskGraph &graph = *state->graph;
+    Task &task = graph.tasks_[i];
+    NodeTiming &timing = graph.trace_[i];
+    timing.thread = graph.pool_.workerIndex();
+    timing.start = state->elapsed();
+
+    bool skip;
+    {
+        std::lock_guard lock(state->mutex);
+        skip = state->failed[i] != 0;
+    }
+    std::exception_ptr error;
+    if (!skip) {
+        try {
+            task.run();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    timing.end = state->elapsed();
+    timing.skipped = skip;
+
+    std::vector<size_t> ready;
+    {
+        std::lock_guard lock(state->mutex);
+        for (size_t d : task.dependents) {
+            if (skip || error) {
+                state->failed[d] = 1;
+            }
+            if (--state->pending[d] == 0) {
+                ready.push_back(d);
+            }
+        }
+    }
+    for (size_t d : ready) {
+        graph.pool_.submit([state, d] { execute(state, d); });
+    }
+    state->done(error);
+}
+
+inline void TaskGraph::run() {
+    const size_t n = tasks_.size();
+    trace_.assign(n, NodeTiming{});
+    if (n == 0) {
+        return;
+    }
+
+    auto state = std::make_shared<RunState>();
+    state->graph = this;
+    state->remaining = n;
+    state->pending.resize(n);
+    state->failed.assign(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        tasks_[i].reset();
+        state->pending[i] = tasks_[i].dependencies;
+        trace_[i].name = tasks_[i].name;
+    }
+
+    state->origin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        if (tasks_[i].dependencies == 0) {
+            pool_.submit([state, i] { execute(state, i); });
+        }
+    }
+    detail::help_until_done(pool_, *state);
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+inline void TaskGraph::printTrace(std::ostream &o) const {
+    for (const auto &node : trace_) {
+        o << node.name << "\tthread " << node.thread << "\tstart "
+          << node.start << " ms\t"
+          << (node.skipped ? std::string("skipped")
+                           : std::to_string(node.duration()) + " ms")
+          << "\n";
+    }
+}
+
+} // namespace df
@@ -26,6 +26,7 @@
 #include <type_traits>
 #include <unordered_set>
 #include <dataframe/core/execution_policy.h>
+#include <dataframe/utils/flat_hash.h>
 #include <vector>
 
 namespace df {
@@ -182,6 +183,44 @@ Serie<T> unique_by(const Serie<T> &serie, KeyFunc keyFn, ExecutionPolicy exec) {
     }
 }
 
+inline StringSerie unique(const StringSerie &serie) {
+    // The keys are views on the bytes of serie
+    FlatHashMap<std::string_view, uint32_t> seen;
+    StringSerie result;
+    bool null_seen = false;
+    for (size_t i = 0; i < serie.size(); ++i) {
+        if (serie.isNull(i)) {
+            if (!null_seen) {
+                result.addNull();
+                null_seen = true;
+            }
+        } else if (seen.try_emplace(serie.view(i), 0).second) {
+            result.add(serie.view(i));
+        }
+    }
+    return result;
+}
+
+inline CategoricalSerie unique(const CategoricalSerie &serie) {
+    std::vector<uint8_t> seen(serie.dictionary()->size(), 0);
+    CategoricalSerie result(serie.dictionary());
+    bool null_seen = false;
+    serie.visitCodes([&](const auto &codes) {
+        for (size_t i = 0; i < codes.size(); ++i) {
+            if (serie.isNull(i)) {
+                if (!null_seen) {
+                    result.addNull();
+                    null_seen = true;
+                }
+            } else if (!seen[codes[i]]) {
+                seen[codes[i]] = 1;
+                result.addCode(codes[i]);
+            }
+        }
+    });
+    return result;
+}
+
 template <typename T> auto bind_unique(ExecutionPolicy exec) {
     return [exec](const Serie<T> &serie) { return unique(serie, exec); };
 }
@@ -20,20 +20,13 @@
  * SOFTWARE.
  */
 
+#include <array>
 #include <dataframe/core/concat.h>
-#include <future>
-#include <thread>
+#include <dataframe/core/task_graph.h>
 #include <tuple>
 
 namespace df {
 
-// Helper for tuple creation from futures
-template <typename T, std::size_t... I>
-auto make_tuple_from_futures(std::vector<std::future<Serie<T>>> &futures,
-                             std::index_sequence<I...>) {
-    return std::make_tuple(futures[I].get()...);
-}
-
 /**
  * @brief Execute transformations on multiple Series in parallel.
  *
@@ -42,7 +35,12 @@ auto make_tuple_from_futures(std::vector<std::future<Serie<T>>> &futures,
  * - Two versions: one for transformations returning concatenated results, one
  * for tuple returns
  * - Type safety through static assertions
- * - Error handling through futures
+ * - Error handling: the first exception thrown by a transformation is
+ * rethrown
+ * - Scheduling on the shared TaskPool, without a thread created per call
+ * or a copy of the input Series (see core/task_graph.h)
+ * - Each task calls its own copy of the transformation, so a stateful
+ * (mutable) transformation is not shared between threads
  * - Resource management through RAII
  * - Performance testing for heavy computations
  *
@@ -61,23 +59,13 @@ auto make_tuple_from_futures(std::vector<std::future<Serie<T>>> &futures,
  */
 template <typename T, typename F>
 inline Serie<T> whenAll(F &&transform, const std::vector<Serie<T>> &series) {
-    std::vector<std::future<Serie<T>>> futures;
-    futures.reserve(series.size());
-
-    // Launch transformations in parallel
-    for (const auto &serie : series) {
-        futures.push_back(std::async(std::launch::async, [transform, serie]() {
-            return transform(serie);
-        }));
-    }
-
-    // Collect results
-    std::vector<Serie<T>> results;
-    results.reserve(futures.size());
-
-    for (auto &future : futures) {
-        results.push_back(future.get());
-    }
+    // The inputs are read in place and the results written in place: the
+    // call does not return before every task is done
+    std::vector<Serie<T>> results(series.size());
+    TaskPool::shared().parallel_for(series.size(), [&](size_t i) {
+        std::decay_t<F> task = transform;
+        results[i] = task(series[i]);
+    });
 
     return concat(results);
 }
@@ -97,18 +85,15 @@ inline auto whenAll(const Series &...series) {
     static_assert((std::is_same_v<Series, Serie<T>> && ...),
                   "All series must be of the same type Serie<T>");
 
-    std::vector<std::future<Serie<T>>> futures;
-    futures.reserve(sizeof...(series));
-
-    // Launch series operations in parallel
-    (futures.push_back(std::async(
-         std::launch::async,
-         [](const Serie<T> &s) { return Serie<T>(s.data()); }, series)),
-     ...);
+    constexpr size_t n = sizeof...(Series);
+    const std::array<const Serie<T> *, n> inputs{&series...};
+    std::array<Serie<T>, n> copies;
+    TaskPool::shared().parallel_for(
+        n, [&](size_t i) { copies[i] = *inputs[i]; });
 
-    // Create tuple from results
-    return make_tuple_from_futures<T>(
-        futures, std::make_index_sequence<sizeof...(Series)>{});
+    return std::apply(
+        [](auto &...copy) { return std::make_tuple(std::move(copy)...); },
+        copies);
 }
 
 /**
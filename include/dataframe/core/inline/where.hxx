@@ -113,6 +113,35 @@ auto where(const Serie<CondT> &condition, const ThenT &then_value,
     return Serie<ResultType>(std::move(result));
 }
 
+template <typename ThenT, typename ElseT>
+auto where(const Mask &condition, const Serie<ThenT> &then_serie,
+           const Serie<ElseT> &else_serie) {
+    if (condition.size() != then_serie.size() ||
+        condition.size() != else_serie.size()) {
+        throw std::runtime_error("All series must have the same size in where");
+    }
+
+    using ResultType = std::common_type_t<ThenT, ElseT>;
+    const auto &then_values = then_serie.data();
+    std::vector<ResultType> result(else_serie.data().begin(),
+                                   else_serie.data().end());
+    condition.forEachSet(
+        [&](size_t i) { result[i] = ResultType(then_values[i]); });
+
+    return Serie<ResultType>(std::move(result));
+}
+
+template <typename ThenT, typename ElseT>
+auto where(const Mask &condition, const ThenT &then_value,
+           const ElseT &else_value) {
+    using ResultType = std::common_type_t<ThenT, ElseT>;
+    std::vector<ResultType> result(condition.size(), ResultType(else_value));
+    const ResultType value(then_value);
+    condition.forEachSet([&](size_t i) { result[i] = value; });
+
+    return Serie<ResultType>(std::move(result));
+}
+
 // Pipeline support
 template <typename ThenT, typename ElseT> struct where_binder {
     const Serie<ThenT> &then_serie;
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/Dataframe.h>
+#include <dataframe/Serie.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace df {
+
+enum class JoinType {
+    INNER, // Rows whose key is in both Dataframes
+    LEFT,  // All the rows of the left Dataframe
+    OUTER  // All the rows of both Dataframes
+};
+
+/**
+ * @brief Matching row pairs of a join. A -1 index means that the row has no
+ * match on that side (left and outer joins).
+ */
+struct JoinIndices {
+    std::vector<int64_t> left;
+    std::vector<int64_t> right;
+
+    size_t size() const { return left.size(); }
+};
+
+/**
+ * @brief Compute the matching row pairs of two key Series.
+ *
+ * If both key Series are sorted, a sort-merge join is used. Otherwise the
+ * rows of `right` are hash-partitioned (radix on the high bits of the key
+ * hash) into tables built in parallel, and chunks of `left` probe them in
+ * parallel.
+ *
+ * The pairs follow the order of the left rows (for a given left row, the
+ * matching right rows are in increasing order). With JoinType::OUTER, the
+ * unmatched right rows are appended at the end, except for the sort-merge
+ * join where all rows are output in key order.
+ *
+ * @code
+ * df::Serie<int> a{1, 2, 2, 3};
+ * df::Serie<int> b{2, 3, 3, 4};
+ * auto idx = df::join_indices(a, b, df::JoinType::LEFT);
+ * // idx.left  = {0, 1, 2, 3, 3}
+ * // idx.right = {-1, 0, 0, 1, 2}
+ * @endcode
+ */
+template <typename K>
+JoinIndices join_indices(const Serie<K> &left, const Serie<K> &right,
+                         JoinType how = JoinType::INNER);
+
+/**
+ * @brief Matching row pairs of two CategoricalSerie, computed on the codes:
+ * the codes of `right` are translated once into the dictionary of `left`
+ * (nothing to do if they share it), then the right rows are bucketed by
+ * code. Null keys never match. Same output order as the join_indices above
+ * (unmatched right rows at the end with JoinType::OUTER).
+ */
+JoinIndices join_indices(const CategoricalSerie &left,
+                         const CategoricalSerie &right,
+                         JoinType how = JoinType::INNER);
+
+/**
+ * @brief Relational join of two Dataframes on a key column present in both.
+ *
+ * The result holds the key column `on` and all the other columns of both
+ * Dataframes, gathered from the matching rows (see join_indices). A column
+ * name present on both sides is suffixed with "_left" and "_right". Missing
+ * values (unmatched rows) are NaN for floating point columns and
+ * default-constructed values otherwise.
+ *
+ * Supported key types: bool, integers, float, double, std::string and
+ * CategoricalSerie (joined on the codes, see above).
+ *
+ * @code
+ * df::Dataframe wells;   // "well_id", "x", "y"
+ * df::Dataframe samples; // "well_id", "depth", "porosity"
+ * auto table = df::join(samples, wells, "well_id", df::JoinType::LEFT);
+ * // table: "well_id", "depth", "porosity", "x", "y"
+ * @endcode
+ *
+ * @throws std::runtime_error if `on` is missing, if its type differs on both
+ * sides or is not supported
+ */
+Dataframe join(const Dataframe &left, const Dataframe &right,
+               const std::string &on, JoinType how = JoinType::INNER);
+
+} // namespace df
+
+#include "inline/join.hxx"
@@ -21,95 +21,166 @@
  *
  */
 #pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <dataframe/Serie.h>
-#include <map>
+#include <dataframe/io/binary_serialization.h>
+#include <dataframe/utils/flat_hash.h>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
 #include <utility>
-#include <vector>
 
 namespace df {
 
-template <typename F> class Memoized {
-  public:
-    explicit Memoized(F f,
-                      std::chrono::seconds timeout = std::chrono::seconds{60})
-        : func(std::move(f)), cache_timeout(timeout) {}
-
-    template <typename T> Serie<T> operator()(const Serie<T> &s) const {
-        const auto key = make_key(s);
-
-        { // Scope for lock
-            std::shared_lock read_lock(mutex);
-            auto it = cache.find(key);
-            if (it != cache.end()) {
-                auto now = std::chrono::steady_clock::now();
-                if (now - it->second.timestamp < cache_timeout) {
-                    return std::any_cast<Serie<T>>(it->second.value);
-                }
-            }
-        }
+/**
+ * @brief Cheap identity of the content of a Serie, used as a cache key.
+ *
+ * - `version` is Serie::version(): equal versions mean equal content, in
+ *   O(1),
+ * - `sample` hashes the size and up to `samples` evenly spaced values (and
+ *   their validity), in O(samples). It is used to verify a cache hit.
+ */
+struct Fingerprint {
+    uint64_t version = 0;
+    uint64_t size = 0;
+    uint64_t sample = 0;
 
-        // If we get here, either:
-        // 1. The key wasn't in the cache
-        // 2. The cached value was expired
-        auto result = func(s);
+    bool operator==(const Fingerprint &other) const {
+        return version == other.version && size == other.size &&
+               sample == other.sample;
+    }
+};
 
-        { // Scope for lock
-            std::unique_lock write_lock(mutex);
-            cache[key] = CacheEntry{result, std::chrono::steady_clock::now()};
-            cleanup_expired_entries();
-        }
+template <typename T>
+Fingerprint fingerprint(const Serie<T> &serie, size_t samples = 64);
 
-        return result;
-    }
+/**
+ * @brief Hash of up to `samples` evenly spaced values (first and last
+ * included), of their validity and of the size
+ */
+template <typename T>
+uint64_t sampled_hash(const Serie<T> &serie, size_t samples = 64);
 
-    void clear_cache() {
-        std::unique_lock lock(mutex);
-        cache.clear();
-    }
+/**
+ * @brief Hash of every value and of the validity bitmap, in O(n)
+ */
+template <typename T> uint64_t content_hash(const Serie<T> &serie);
 
-    size_t cache_size() const {
-        std::shared_lock lock(mutex);
-        return cache.size();
-    }
+/**
+ * @brief How Memoized recognizes an input it has already seen
+ */
+enum class Verify {
+    // Key on Serie::version() only, O(1). Trusts that the Serie was not
+    // modified through a reference kept across calls.
+    None,
+    // Key on Serie::version(), and check the size and sampled_hash() of the
+    // input on a hit, O(samples). A mismatch recomputes.
+    Sampled,
+    // Key on content_hash(), O(n): distinct Series with the same values
+    // (copies made element by element, reloaded files...) share an entry.
+    // The size and sampled_hash() guard against hash collisions.
+    Content
+};
 
-    void set_timeout(std::chrono::seconds timeout) {
-        std::unique_lock lock(mutex);
-        cache_timeout = timeout;
-        cleanup_expired_entries();
-    }
+struct MemoizeOptions {
+    // Age after which an entry is recomputed (std::chrono::seconds::max():
+    // never)
+    std::chrono::seconds timeout{60};
+    // Bounds of the LRU cache. max_bytes = 0: no bound on the memory (see
+    // memoize_bytes() for what is counted)
+    size_t max_entries = 128;
+    size_t max_bytes = 0;
+    Verify verify = Verify::Sampled;
+    size_t samples = 64;
+    // If not empty, results of type Serie<U> are also written to this
+    // directory (binary format, see io/binary_serialization.h) and looked up
+    // there on a miss, by content_hash() of the input, so they survive
+    // across runs. Only inputs of a registered type (see type_id) are
+    // spilled. Use one directory per memoized function.
+    std::string spill_directory;
+};
+
+struct MemoizeStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t disk_hits = 0;
+    size_t evictions = 0;
+};
+
+/**
+ * @brief Approximate memory used by a cached result, for
+ * MemoizeOptions::max_bytes: the values (and validity) of a Serie, the
+ * object size otherwise
+ */
+template <typename R> size_t memoize_bytes(const R &result);
+
+/**
+ * @brief Cache the results of a function of one Serie.
+ *
+ * Entries are kept in LRU order, bounded by MemoizeOptions::max_entries and
+ * max_bytes, and keyed by the Serie::version() of the input (see Verify), so
+ * a hit does not read the whole input. Results are returned by shared
+ * ownership: a hit does not copy them.
+ *
+ * The function is called outside of the lock: two threads missing on the
+ * same input may both compute it.
+ */
+template <typename F> class Memoized {
+  public:
+    template <typename T>
+    using Result = std::decay_t<std::invoke_result_t<const F &, const Serie<T> &>>;
+
+    explicit Memoized(F f,
+                      std::chrono::seconds timeout = std::chrono::seconds{60});
+    Memoized(F f, const MemoizeOptions &options);
+
+    template <typename T>
+    std::shared_ptr<const Result<T>> operator()(const Serie<T> &s) const;
+
+    void clear_cache();
+    size_t cache_size() const;
+    size_t cache_bytes() const;
+    MemoizeStats stats() const;
+    void set_timeout(std::chrono::seconds timeout);
 
   private:
-    struct CacheEntry {
-        std::any value;
+    struct Entry {
+        uint64_t key;
+        std::type_index type;
+        uint64_t size;
+        uint64_t sample;
+        std::shared_ptr<const void> value;
+        size_t bytes;
         std::chrono::steady_clock::time_point timestamp;
     };
+    using Entries = std::list<Entry>;
 
-  private:
-    F func;
-    mutable std::unordered_map<size_t, CacheEntry> cache;
-    std::chrono::seconds cache_timeout;
-    // Allows multiple readers but single writer
-    mutable std::shared_mutex mutex;
-
-    template <typename T> size_t make_key(const Serie<T> &s) const {
-        size_t seed = 0;
-        s.forEach([&seed](const T &value) {
-            seed ^=
-                std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-        });
-        return seed;
-    }
+    bool expired(const Entry &entry,
+                 std::chrono::steady_clock::time_point now) const;
+    void erase(typename Entries::iterator it) const;
+    void insert(Entry entry) const;
 
-    void cleanup_expired_entries() const {
-        auto now = std::chrono::steady_clock::now();
-        for (auto it = cache.begin(); it != cache.end();) {
-            if (now - it->second.timestamp >= cache_timeout) {
-                it = cache.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
+    template <typename R>
+    std::shared_ptr<const R> load_spilled(uint64_t hash) const;
+    template <typename R>
+    void spill(uint64_t hash, const R &result) const;
+
+    F func;
+    MemoizeOptions options_;
+    // Most recently used first
+    mutable Entries entries_;
+    mutable std::unordered_map<uint64_t, typename Entries::iterator> index_;
+    mutable size_t bytes_ = 0;
+    mutable MemoizeStats stats_;
+    mutable std::mutex mutex;
 };
 
 template <typename F>
@@ -117,6 +188,10 @@ auto memoize(F &&f, std::chrono::seconds timeout = std::chrono::seconds{60}) {
     return Memoized<std::decay_t<F>>(std::forward<F>(f), timeout);
 }
 
+template <typename F> auto memoize(F &&f, const MemoizeOptions &options) {
+    return Memoized<std::decay_t<F>>(std::forward<F>(f), options);
+}
+
 /**
  * @brief Memoization is a key optimization technique in computational and
  * scientific computing, particularly valuable for expensive calculations that
@@ -167,30 +242,21 @@ class FaultAnalysis {
 ```
  *
  * Implementation Considerations:
- * - Cache Strategy
- * - Memory limits
- * Cache invalidation
- * Key generation
- * Thread Safety
- * Cache persistence
+ * - Cache Strategy: LRU, bounded in entries and bytes
+ * - Key generation: Serie::version(), verified by a sampled hash
+ * - Thread Safety
+ * - Cache persistence: MemoizeOptions::spill_directory
  *
  * Advanced Features:
 ```cpp
-template<typename F>
-class AdvancedMemoized {
-    F func;
-    mutable std::map<Key, Result> cache;
-    size_t max_cache_size;
-    std::chrono::seconds cache_lifetime;
-
-    void evict_old_entries() {
-        // LRU implementation
-    }
+df::MemoizeOptions options;
+options.max_entries = 16;
+options.max_bytes = 512 << 20;
+options.spill_directory = "cache/stress";
+auto stress = df::memoize(
+    [](const Serie<double>& depth) { return computeStress(depth); }, options);
 
-    bool is_valid(const CacheEntry& entry) {
-        // Check entry age
-    }
-};
+auto sigma = stress(depth); // std::shared_ptr<const Serie<Stress>>
 ```
  *
  * Application in Machine Learning:
@@ -212,7 +278,7 @@ void training_loop() {
  * Testing and Debugging Benefits:
  * - Deterministic behavior
  * - Performance profiling
- * - Cache hit/miss analysis
+ * - Cache hit/miss analysis (see Memoized::stats())
  *
  * The value of memoization increases with:
  * - Computation complexity
@@ -236,3 +302,5 @@ void training_loop() {
  */
 
 } // namespace df
+
+#include "inline/memoize.hxx"
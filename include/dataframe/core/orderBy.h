@@ -22,8 +22,12 @@
  */
 
 #pragma once
+#include <dataframe/Dataframe.h>
 #include <dataframe/Serie.h>
 #include <dataframe/core/ExecutionPolicy.h>
+#include <dataframe/core/sort.h>
+#include <string>
+#include <vector>
 
 namespace df {
 
@@ -80,6 +84,37 @@ namespace df {
     auto bind_orderBy(
         KeyFunc keyFn, bool ascending = true, ExecutionPolicy exec = ExecutionPolicy::SEQ);
 
+    /**
+     * @brief Stable multi-column sort of the rows of a Dataframe
+     *
+     * The rows are ordered by the first column, ties broken by the second
+     * one, and so on. The permutation is computed with one stable argsort
+     * per column, from the last column to the first one, then all the
+     * columns are gathered with it. NaN are placed last.
+     *
+     * @param columns Names of the scalar key columns (bool, integers, float,
+     * double, std::string or CategoricalSerie)
+     * @param orders Order of each key column (all ascending if empty)
+     *
+     * @code
+     * df::Dataframe samples; // "well", "depth", "porosity"
+     * auto sorted = df::orderBy(samples, {"well", "depth"},
+     *     {df::SortOrder::ASCENDING, df::SortOrder::DESCENDING});
+     * @endcode
+     *
+     * @throws std::runtime_error if a column is missing, has an unsupported
+     * type, or if orders and columns have different sizes
+     */
+    Dataframe orderBy(const Dataframe& dataframe, const std::vector<std::string>& columns,
+        const std::vector<SortOrder>& orders = {}, ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
+    /**
+     * @brief Stable permutation of the rows of a Dataframe used by
+     * orderBy(Dataframe, ...)
+     */
+    Serie<uint32_t> argsort(const Dataframe& dataframe, const std::vector<std::string>& columns,
+        const std::vector<SortOrder>& orders = {}, ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
 } // namespace df
 
 #include "inline/orderBy.hxx"
\ No newline at end of file
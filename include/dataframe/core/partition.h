@@ -22,6 +22,7 @@
  */
 
 #pragma once
+#include <dataframe/Mask.h>
 #include <dataframe/Serie.h>
 #include <utility>
 #include <vector>
@@ -33,22 +34,15 @@ namespace df {
      * This function takes a Serie and a predicate function, and returns a pair of Series:
      * - The first Serie contains all elements for which the predicate returns true.
      * - The second Serie contains all elements for which the predicate returns false.
+     * The predicate is evaluated only once per element, from several threads
+     * only with ExecutionPolicy::PAR.
      */
     template <typename T, typename F>
-    std::pair<Serie<T>, Serie<T>> partition(const Serie<T>& serie, F&& predicate)
+    std::pair<Serie<T>, Serie<T>> partition(
+        const Serie<T>& serie, F&& predicate, ExecutionPolicy exec = ExecutionPolicy::SEQ)
     {
-        std::vector<T> matches;
-        std::vector<T> non_matches;
-
-        for (size_t i = 0; i < serie.size(); ++i) {
-            if (predicate(serie[i], i)) {
-                matches.push_back(serie[i]);
-            } else {
-                non_matches.push_back(serie[i]);
-            }
-        }
-
-        return { Serie<T>(matches), Serie<T>(non_matches) };
+        const Mask mask = Mask::from(serie, predicate, exec);
+        return { mask.select(serie), (~mask).select(serie) };
     }
 
     // Helper function to create a bound partition operation
@@ -24,6 +24,7 @@
 #pragma once
 #include <dataframe/Serie.h>
 #include <dataframe/utils/meta.h>
+#include <functional>
 #include <utility>
 
 namespace df {
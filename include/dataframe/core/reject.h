@@ -13,6 +13,7 @@
  */
 
 #pragma once
+#include <dataframe/Mask.h>
 #include <dataframe/Serie.h>
 #include <dataframe/utils/utils.h>
 #include <vector>
@@ -54,12 +55,17 @@ namespace df {
      *
      * @param predicate Function that returns true for elements to be rejected
      * @param serie Input Serie
+     * @param exec ExecutionPolicy::PAR to call the predicate from several
+     * threads for large series
      * @return New Serie with rejected elements removed
      */
-    template <typename F, typename T> Serie<T> reject(F&& predicate, const Serie<T>& serie);
+    template <typename F, typename T>
+    Serie<T> reject(F&& predicate, const Serie<T>& serie,
+        ExecutionPolicy exec = ExecutionPolicy::SEQ);
 
     /**
      * Multi-series version that applies predicate to corresponding elements
+     * (sequentially)
      */
     template <typename F, typename T, typename... Args>
     Serie<T> reject(
@@ -22,13 +22,22 @@
  */
 
 #pragma once
-#include "execution_policy.h"
+#include <cstdint>
+#include <dataframe/CategoricalSerie.h>
 #include <dataframe/Serie.h>
+#include <dataframe/StringSerie.h>
+#include <dataframe/core/ExecutionPolicy.h>
 
 /**
  * @brief Sort a Serie in ascending or descending order
  *
  * Key features of this implementation:
+ * - Arithmetic types are sorted with a stable radix sort (8 bits per pass,
+ *   most significant byte first, small buckets finished with LSD passes),
+ *   split over several threads with ExecutionPolicy::PAR
+ * - Other types use a comparison sort (merged sorted chunks in parallel)
+ * - sort_by/argsort_by compute the keys once (decorate-sort-undecorate)
+ * - argsort returns the sorting permutation as a Serie<uint32_t>
  * - Supports both ascending and descending sort
  * - Allows custom comparison functions
  * - Maintains immutability (returns new Serie instead of modifying in place)
@@ -58,6 +67,9 @@
  * auto sorted5 = sort_nan(s2, SortOrder::ASCENDING, true);  // [NaN, NaN, 1, 2,
  * 5]
  *
+ * // Permutation sorting the Serie (stable)
+ * auto perm = argsort(s1);                        // [3, 1, 0, 2, 4]
+ *
  * // Pipeline usage
  * auto result = s1
  *     | bind_sort<double>(SortOrder::ASCENDING)
@@ -83,6 +95,53 @@ namespace df {
     Serie<T> sort_nan(const Serie<T>& serie, SortOrder order = SortOrder::ASCENDING,
         bool nan_first = false, ExecutionPolicy exec = ExecutionPolicy::SEQ);
 
+    /**
+     * @brief Stable permutation sorting the Serie: serie[perm[0]] is the
+     * smallest element (or the largest with SortOrder::DESCENDING). NaN are
+     * placed last, or first if nan_first, as with sort_nan.
+     * @throws std::runtime_error if the Serie has more than 2^32-1 elements
+     */
+    template <typename T>
+    Serie<uint32_t> argsort(const Serie<T>& serie, SortOrder order = SortOrder::ASCENDING,
+        bool nan_first = false, ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
+    /**
+     * @brief Stable permutation sorting the Serie by key_func(value). The
+     * keys are computed once.
+     */
+    template <typename T, typename KeyFunc>
+    Serie<uint32_t> argsort_by(const Serie<T>& serie, KeyFunc key_func,
+        SortOrder order = SortOrder::ASCENDING, ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
+    /**
+     * @brief Stable permutation sorting a StringSerie, comparing the values in
+     * place (nulls last)
+     * @throws std::runtime_error if the Serie has more than 2^32-1 elements
+     */
+    Serie<uint32_t> argsort(const StringSerie& serie, SortOrder order = SortOrder::ASCENDING,
+        ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
+    /**
+     * @brief Sorted copy of a StringSerie (nulls last)
+     */
+    StringSerie sort(const StringSerie& serie, SortOrder order = SortOrder::ASCENDING,
+        ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
+    /**
+     * @brief Stable permutation sorting a CategoricalSerie (nulls last). The
+     * distinct values are sorted once, then the rows are placed by a counting
+     * sort on the rank of their code.
+     */
+    Serie<uint32_t> argsort(const CategoricalSerie& serie,
+        SortOrder order = SortOrder::ASCENDING, ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
+    /**
+     * @brief Sorted copy of a CategoricalSerie (nulls last), sharing the
+     * dictionary
+     */
+    CategoricalSerie sort(const CategoricalSerie& serie, SortOrder order = SortOrder::ASCENDING,
+        ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
     // Bind functions for pipeline operations with parallel support
     template <typename T>
     auto bind_sort(
@@ -95,6 +154,10 @@ namespace df {
     auto bind_sort_by(KeyFunc key_func, SortOrder order = SortOrder::ASCENDING,
         ExecutionPolicy exec = ExecutionPolicy::SEQ);
 
+    template <typename T>
+    auto bind_argsort(SortOrder order = SortOrder::ASCENDING, bool nan_first = false,
+        ExecutionPolicy exec = ExecutionPolicy::SEQ);
+
 } // namespace df
 
 #include "inline/sort.hxx"
\ No newline at end of file
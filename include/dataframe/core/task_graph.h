@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace df {
+
+/**
+ * @brief Fixed set of worker threads fed by a FIFO queue.
+ *
+ * The threads are created once: scheduling many small parallel stages on the
+ * pool does not pay for a thread creation each time, as std::async does. A
+ * thread waiting for its tasks (parallel_for(), TaskGraph::run()) runs queued
+ * tasks meanwhile, so waits can be nested (a task running a graph) without
+ * exhausting the workers.
+ */
+class TaskPool {
+  public:
+    /**
+     * @param threads Number of workers (0: std::thread::hardware_concurrency)
+     */
+    explicit TaskPool(size_t threads = 0);
+    ~TaskPool();
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+
+    /**
+     * @brief Pool shared by whenAll() and TaskGraph (created on first use)
+     */
+    static TaskPool &shared();
+
+    size_t size() const { return workers_.size(); }
+
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Run one queued task on the calling thread
+     * @return false if the queue was empty
+     */
+    bool tryRunOne();
+
+    /**
+     * @brief Run f(i) for i in [0, n) on the pool and wait for all of them.
+     * The calling thread runs f(0).
+     * @throws the first exception thrown by f, once every call has returned
+     */
+    template <typename F> void parallel_for(size_t n, F &&f);
+
+    /**
+     * @brief Index of the calling thread among the workers of this pool, or
+     * size() for another thread
+     */
+    size_t workerIndex() const;
+
+  private:
+    void work(size_t index);
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+};
+
+/**
+ * @brief Timing of a node of a TaskGraph, in milliseconds since the start of
+ * TaskGraph::run()
+ */
+struct NodeTiming {
+    std::string name;
+    double start = 0;
+    double end = 0;
+    // Worker index in the pool (TaskPool::size() for the thread calling run())
+    size_t thread = 0;
+    // The node did not run because one of its inputs failed
+    bool skipped = false;
+
+    double duration() const { return end - start; }
+};
+
+/**
+ * @brief Directed acyclic graph of pipeline stages, run on a TaskPool.
+ *
+ * A node is a function of the results of other nodes (Series, Dataframes or
+ * any type). Results are held by std::shared_ptr<const R> and handed to the
+ * next stages by const reference: nothing is copied along an edge. A node is
+ * scheduled as soon as its inputs are computed, so independent branches
+ * (loading, interpolation, statistics...) overlap. Since the inputs of a
+ * node must be added before it, the graph cannot have cycles.
+ *
+ * @code
+ * df::TaskGraph graph;
+ * auto points = graph.add("load", [] { return df::io::read_csv("wells.csv"); });
+ * auto x = graph.add("x", [](const df::Dataframe& d) { return d.get<double>("x"); }, points);
+ * auto z = graph.add("z", [](const df::Dataframe& d) { return d.get<double>("z"); }, points);
+ * auto stats = graph.add("stats", [](const df::Serie<double>& z) { return df::stats::mean(z); }, z);
+ * auto grid = graph.add("grid", [](const df::Serie<double>& x, const df::Serie<double>& z) {
+ *     return interpolate(x, z);
+ * }, x, z);
+ *
+ * graph.run();
+ * double mean = *stats.get();
+ * graph.printTrace(std::cout);
+ * @endcode
+ */
+class TaskGraph {
+    template <typename T> struct Slot {
+        std::shared_ptr<const T> value;
+    };
+
+  public:
+    /**
+     * @brief Handle on the result of a node
+     */
+    template <typename T> class Node {
+      public:
+        using value_type = T;
+
+        Node() = default;
+        size_t id() const { return id_; }
+
+        /**
+         * @throws std::runtime_error if the graph was not run, or if the node
+         * failed or was skipped
+         */
+        std::shared_ptr<const T> get() const;
+
+      private:
+        friend class TaskGraph;
+        Node(size_t id, std::shared_ptr<Slot<T>> slot)
+            : id_(id), slot_(std::move(slot)) {}
+
+        size_t id_ = 0;
+        std::shared_ptr<Slot<T>> slot_;
+    };
+
+    explicit TaskGraph(TaskPool &pool = TaskPool::shared());
+
+    /**
+     * @brief Add a node computing f(inputs...), where each input is the
+     * (const) result of a node already in the graph
+     */
+    template <typename F, typename... Ts>
+    auto add(const std::string &name, F &&f, const Node<Ts> &...inputs)
+        -> Node<std::decay_t<std::invoke_result_t<F &, const Ts &...>>>;
+
+    /**
+     * @brief Add an existing value as a source node, without copying it
+     */
+    template <typename T>
+    Node<T> input(const std::string &name, std::shared_ptr<const T> value);
+
+    size_t size() const { return tasks_.size(); }
+
+    /**
+     * @brief Run every node, then wait for the graph to complete. Can be
+     * called again: every node is recomputed.
+     * @throws the first exception thrown by a node. Its dependents are
+     * skipped, the other branches still run.
+     */
+    void run();
+
+    /**
+     * @brief Timing of each node of the last run, in the order of addition
+     */
+    const std::vector<NodeTiming> &trace() const { return trace_; }
+
+    /**
+     * @brief One line per node of the last run: name, thread, start and
+     * duration (ms)
+     */
+    void printTrace(std::ostream &o) const;
+
+  private:
+    struct Task {
+        std::string name;
+        std::function<void()> run;
+        std::function<void()> reset;
+        std::vector<size_t> dependents;
+        size_t dependencies = 0;
+    };
+    struct RunState;
+
+    template <typename T> void check(const Node<T> &input) const;
+    size_t addTask(const std::string &name, std::function<void()> run,
+                   std::function<void()> reset,
+                   const std::vector<size_t> &inputs);
+    static void execute(const std::shared_ptr<RunState> &state, size_t i);
+
+    TaskPool &pool_;
+    std::vector<Task> tasks_;
+    std::vector<NodeTiming> trace_;
+};
+
+} // namespace df
+
+#include "inline/task_graph.hxx"
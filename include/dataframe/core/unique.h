@@ -22,7 +22,9 @@
  */
 
 #pragma once
+#include <dataframe/CategoricalSerie.h>
 #include <dataframe/Serie.h>
+#include <dataframe/StringSerie.h>
 #include <dataframe/core/ExecutionPolicy.h>
 
 namespace df {
@@ -51,6 +53,20 @@ namespace df {
     template <typename T>
     Serie<T> unique(const Serie<T>& serie, ExecutionPolicy exec = ExecutionPolicy::SEQ);
 
+    /**
+     * @brief Distinct values of a StringSerie, in the order of their first
+     * occurrence. The values are hashed and compared in place, without
+     * building a std::string per value. A null is kept once.
+     */
+    StringSerie unique(const StringSerie& serie);
+
+    /**
+     * @brief Distinct values of a CategoricalSerie, in the order of their
+     * first occurrence, sharing the dictionary. Only the codes are compared.
+     * A null is kept once.
+     */
+    CategoricalSerie unique(const CategoricalSerie& serie);
+
     /**
      * @brief Remove duplicates based on a key function
      *
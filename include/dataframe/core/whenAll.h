@@ -22,6 +22,7 @@
 
 #pragma once
 #include <dataframe/Serie.h>
+#include <dataframe/core/task_graph.h>
 
 namespace df {
 
@@ -33,7 +34,10 @@ namespace df {
      * - Two versions: one for transformations returning concatenated results, one
      * for tuple returns
      * - Type safety through static assertions
-     * - Error handling through futures
+     * - Error handling: the first exception thrown by a transformation is
+     * rethrown
+     * - Scheduling on the shared TaskPool, without a thread created per call
+     * or a copy of the input Series (see core/task_graph.h)
      * - Resource management through RAII
      * - Performance testing for heavy computations
      *
@@ -49,6 +53,8 @@ namespace df {
      * // Example usage without transformation:
      * auto [r1, r2] = df::whenAll(s1, s2);
      * @endcode
+     *
+     * For pipelines with several dependent stages, see TaskGraph.
      */
     template <typename T, typename F>
     Serie<T> whenAll(F&& transform, const std::vector<Serie<T>>& series);
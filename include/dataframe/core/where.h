@@ -22,6 +22,7 @@
  */
 
 #pragma once
+#include <dataframe/Mask.h>
 #include <dataframe/Serie.h>
 #include <type_traits>
 
@@ -67,6 +68,18 @@ namespace df {
     template <typename CondT, typename ThenT, typename ElseT>
     auto where(const Serie<CondT>& condition, const ThenT& then_value, const ElseT& else_value);
 
+    /**
+     * @brief where with a Mask as condition: the else values are copied, then
+     * the then values are written at the set bits only
+     * @throws std::runtime_error if the sizes differ
+     */
+    template <typename ThenT, typename ElseT>
+    auto where(const Mask& condition, const Serie<ThenT>& then_serie,
+        const Serie<ElseT>& else_serie);
+
+    template <typename ThenT, typename ElseT>
+    auto where(const Mask& condition, const ThenT& then_value, const ElseT& else_value);
+
     template <typename ThenT, typename ElseT>
     auto bind_where(const Serie<ThenT>& then_serie, const Serie<ElseT>& else_serie);
 
@@ -25,6 +25,7 @@
 #include <array>
 #include <cmath>
 #include <dataframe/Serie.h>
+#include <dataframe/core/parallel_map.h>
 #include <dataframe/geo/types.h>
 #include <dataframe/utils/utils.h>
 #include <stdexcept>
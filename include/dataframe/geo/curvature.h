@@ -24,6 +24,7 @@
 #pragma once
 #include <dataframe/Dataframe.h>
 #include <dataframe/Serie.h>
+#include <dataframe/geo/mesh/operators.h>
 #include <dataframe/geo/types.h>
 
 namespace df {
@@ -50,8 +51,9 @@ namespace df {
  * principal directions are the corresponding eigenvectors.
  * 
  * Computes discrete mean curvature using:
- * - Cotangent weights for edge contributions
- * - Voronoi area weights for vertices
+ * - The cotangent Laplacian: H = -(L x) . n / (2 A), positive on a sphere
+ *   whose triangles are oriented outward
+ * - Barycentric (lumped) vertex areas A
  * - Vertex normal computation using area-weighted face normals
  * 
  * Computes Gaussian curvature using:
@@ -63,12 +65,10 @@ namespace df {
  * - K1 = H + sqrt(H² - K)
  * - K2 = H - sqrt(H² - K)
  * 
- * Key algorithmic steps:
- * - Builds vertex and edge adjacency information
- * - Computes vertex normals from incident faces
- * - Calculates cotangent weights for the Laplacian
- * - Computes vertex areas using barycentric coordinates
- * - Handles boundary cases and degenerate geometry
+ * The adjacency, cotangent Laplacian, vertex areas and normals come from
+ * MeshOperators (see geo/mesh/operators.h), and each vertex is then
+ * processed in parallel. Pass a MeshOperators to reuse operators that are
+ * already cached.
  * 
  * @param vertices Vertex positions
  * @param triangles Triangle indices
@@ -77,6 +77,11 @@ namespace df {
 Dataframe surface_curvature(const Positions3 &vertices,
                             const Triangles &triangles);
 
+/**
+ * @brief Same as above, using (and filling) the operators cache
+ */
+Dataframe surface_curvature(const MeshOperators<3> &ops);
+
 } // namespace df
 
 #include "inline/curvature.hxx"
\ No newline at end of file
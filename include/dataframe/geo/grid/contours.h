@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/Serie.h>
+#include <dataframe/geo/grid/grid2d.h>
+#include <dataframe/geo/grid/grid3d.h>
+#include <dataframe/geo/mesh/contours.h>
+#include <dataframe/geo/mesh/mesh.h>
+#include <string>
+#include <vector>
+
+namespace df {
+
+    using grid::Grid2D;
+    using grid::Grid3D;
+
+    /**
+     * @brief Iso-contours of a scalar attribute sampled on a regular 2D grid
+     * (marching squares), without triangulating the grid.
+     *
+     * Each cell is handled on its own: an edge is cut where its two nodes
+     * are on both sides of the iso value, and the ambiguous saddle cells are
+     * resolved with the average of the four corners. Cells with a NaN
+     * corner are skipped. Rows of cells are processed in parallel: a first
+     * pass counts the segments of each row, so that the second pass writes
+     * them directly at their final position.
+     *
+     * Since a Mesh2D only holds triangles, the isolines are returned as
+     * segments (see the Mesh version of contours).
+     *
+     * @code
+     * df::Grid2D grid { { 0, 0 }, { 0.1, 0.1 }, { 100, 100 } };
+     * grid.attributes.add("temperature", temperature);
+     *
+     * auto segments = df::contours(grid, "temperature", 25.0);
+     * @endcode
+     */
+    Serie<IsoSegment<2>> contours(
+        const Grid2D& grid, const std::string& attributeName, double isoValue);
+
+    /**
+     * @brief Same as contours but using multiple iso values, in one pass over
+     * the cells. Segments are grouped by iso value (in the given order), then
+     * sorted by cell.
+     */
+    Serie<IsoSegment<2>> contours(const Grid2D& grid, const std::string& attributeName,
+        const std::vector<double>& isoValues);
+
+    Serie<IsoSegment<2>> contours(
+        const Grid2D& grid, const std::string& attributeName, const Serie<double>& isoValues);
+
+    /**
+     * @brief Iso-surface of a scalar attribute sampled on a regular 3D grid.
+     *
+     * Each cell is split into 6 tetrahedra along its main diagonal (the same
+     * split for all the cells), and each tetrahedron is contoured on its own
+     * (marching tetrahedra). Unlike marching cubes, there is no ambiguous
+     * case, and the surface is watertight. Vertices are created once per cut
+     * grid edge and shared by the adjacent triangles. Triangles are oriented
+     * so that their normals point toward decreasing values. Cells with a NaN
+     * corner are skipped.
+     *
+     * All the other attributes of the grid of type double, Vector2 or
+     * Vector3 are linearly interpolated onto the vertices of the returned
+     * mesh.
+     *
+     * The grid is processed by parallel slabs (ranges of k): a first pass
+     * counts the vertices and triangles of each row of cells, and the second
+     * pass writes them directly at their final position.
+     *
+     * @code
+     * df::Grid3D grid { { 0, 0, 0 }, { 0.1, 0.1, 0.1 }, { 100, 100, 100 } };
+     * grid.attributes.add("density", density);
+     * grid.attributes.add("velocity", velocity); // Serie<Vector3>
+     *
+     * auto surface = df::isosurface(grid, "density", 0.5);
+     * const auto& v = surface.vertexAttribute<Vector3>("velocity");
+     * @endcode
+     */
+    Mesh3D isosurface(const Grid3D& grid, const std::string& attributeName, double isoValue);
+
+} // namespace df
+
+#include "inline/contours.hxx"
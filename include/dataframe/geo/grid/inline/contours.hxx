@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/utils.h>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace df {
+    namespace detail {
+
+        inline const Serie<double>& grid_scalar_attribute(
+            const Dataframe& attributes, const std::string& name, size_t n)
+        {
+            if (!attributes.has<double>(name)) {
+                throw std::runtime_error(
+                    concat("Grid attribute '", name, "' of type double does not exist"));
+            }
+            const auto& values = attributes.get<double>(name);
+            if (values.size() != n) {
+                throw std::runtime_error(concat("Grid attribute '", name, "' has ", values.size(),
+                    " values, expected ", n));
+            }
+            return values;
+        }
+
+        // counts[r] <- sum of counts[0..r), and counts.back() <- total
+        inline uint64_t grid_exclusive_scan(std::vector<uint64_t>& counts)
+        {
+            uint64_t sum = 0;
+            for (size_t r = 0; r + 1 < counts.size(); ++r) {
+                const uint64_t c = counts[r];
+                counts[r] = sum;
+                sum += c;
+            }
+            counts.back() = sum;
+            return sum;
+        }
+
+        // ---------------------------------------------------------------
+        // Marching squares
+        // ---------------------------------------------------------------
+
+        // Corners of cell (i, j): c0 = (i, j), c1 = (i+1, j), c2 = (i+1, j+1)
+        // and c3 = (i, j+1). Edges: 0 = (c0, c1), 1 = (c1, c2), 2 = (c3, c2),
+        // 3 = (c0, c3). Each edge goes from its lower node, so that the two
+        // cells sharing it compute the same point.
+        inline int marching_squares_cell(
+            const std::array<double, 4>& c, double iso, std::array<std::array<int, 2>, 2>& segs)
+        {
+            int code = 0;
+            for (int n = 0; n < 4; ++n) {
+                code |= (c[n] >= iso) << n;
+            }
+            switch (code) {
+            case 1:
+            case 14:
+                segs[0] = { 3, 0 };
+                return 1;
+            case 2:
+            case 13:
+                segs[0] = { 0, 1 };
+                return 1;
+            case 3:
+            case 12:
+                segs[0] = { 3, 1 };
+                return 1;
+            case 4:
+            case 11:
+                segs[0] = { 1, 2 };
+                return 1;
+            case 6:
+            case 9:
+                segs[0] = { 0, 2 };
+                return 1;
+            case 7:
+            case 8:
+                segs[0] = { 3, 2 };
+                return 1;
+            case 5:
+            case 10: {
+                // Saddle: cut off the two corners that are not on the side of
+                // the cell center
+                const bool center = 0.25 * (c[0] + c[1] + c[2] + c[3]) >= iso;
+                if ((code == 5) == center) {
+                    segs = { { { 0, 1 }, { 2, 3 } } };
+                } else {
+                    segs = { { { 3, 0 }, { 1, 2 } } };
+                }
+                return 2;
+            }
+            default:
+                return 0;
+            }
+        }
+
+        inline Vector2 marching_squares_point(const Grid2D& grid, uint i, uint j,
+            const std::array<double, 4>& c, int edge, double iso)
+        {
+            static constexpr int from[4] = { 0, 1, 3, 0 };
+            static constexpr int to[4] = { 1, 2, 2, 3 };
+            static constexpr int dx[4] = { 0, 1, 1, 0 };
+            static constexpr int dy[4] = { 0, 0, 1, 1 };
+            const int a = from[edge], b = to[edge];
+            const double t = (iso - c[a]) / (c[b] - c[a]);
+            return { grid.origin[0] + (i + dx[a] + t * (dx[b] - dx[a])) * grid.spacing[0],
+                grid.origin[1] + (j + dy[a] + t * (dy[b] - dy[a])) * grid.spacing[1] };
+        }
+
+        // ---------------------------------------------------------------
+        // Marching tetrahedra
+        // ---------------------------------------------------------------
+
+        template <typename T> T lerp_value(const T& a, const T& b, double t)
+        {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return a + t * (b - a);
+            } else {
+                T r;
+                for (size_t d = 0; d < a.size(); ++d) {
+                    r[d] = a[d] + t * (b[d] - a[d]);
+                }
+                return r;
+            }
+        }
+
+        // Grid attributes of type T interpolated onto the iso-surface vertices
+        template <typename T> struct InterpolatedAttributes {
+            std::vector<std::string> names;
+            std::vector<const T*> sources;
+            std::vector<std::vector<T>> outputs;
+
+            void collect(const Dataframe& attributes, const std::string& skip, size_t n)
+            {
+                for (const auto& name : attributes.names()) {
+                    if (name != skip && attributes.has<T>(name)
+                        && attributes.get<T>(name).size() == n) {
+                        names.push_back(name);
+                        sources.push_back(attributes.get<T>(name).data().data());
+                    }
+                }
+            }
+
+            void resize(size_t n) { outputs.assign(names.size(), std::vector<T>(n)); }
+
+            void interpolate(size_t id, size_t a, size_t b, double t)
+            {
+                for (size_t s = 0; s < sources.size(); ++s) {
+                    outputs[s][id] = lerp_value(sources[s][a], sources[s][b], t);
+                }
+            }
+
+            template <size_t N> void addTo(Mesh<N>& mesh) const
+            {
+                for (size_t s = 0; s < names.size(); ++s) {
+                    mesh.addVertexAttribute(names[s], Serie<T>(outputs[s]));
+                }
+            }
+        };
+
+        // Cell corner m is node (i + (m & 1), j + (m >> 1 & 1), k + (m >> 2)).
+        // The cell is split into 6 tetrahedra around the diagonal (0, 7). For
+        // any two corners u < v of a tetrahedron, u is a subset of v, so the
+        // edge (u, v) is owned by the node of corner u, and its type u ^ v
+        // (1..7) gives its direction. Each node owns at most 7 edges.
+        struct MarchingTetrahedra {
+            const double* values;
+            double iso;
+            uint nx, ny, nz;
+            std::array<int, 6> signs; // see orientations()
+
+            static constexpr int tets[6][4] = { { 0, 1, 3, 7 }, { 0, 1, 5, 7 }, { 0, 2, 3, 7 },
+                { 0, 2, 6, 7 }, { 0, 4, 5, 7 }, { 0, 4, 6, 7 } };
+
+            using Edge = std::array<int, 2>;
+            using TriangleEdges = std::array<Edge, 3>;
+
+            size_t index(uint i, uint j, uint k) const
+            {
+                return i + static_cast<size_t>(nx) * (j + static_cast<size_t>(ny) * k);
+            }
+
+            // Range [lo, hi) of i along a row holding all its cut edges or
+            // cells (as in flying edges), so that the second pass skips the
+            // rest of the row
+            using Range = std::array<uint, 2>;
+
+            // Visit the cut edges owned by the nodes i in [lo, hi) of row
+            // (j, k), in vertex id order: f(i, type, a, b) with a, b the node
+            // indices
+            template <typename F> void for_each_row_edge(uint j, uint k, Range r, F&& f) const
+            {
+                size_t offset[8];
+                bool valid[8];
+                for (int m = 1; m < 8; ++m) {
+                    const uint dy = (m >> 1) & 1, dz = m >> 2;
+                    offset[m] = (m & 1) + nx * (dy + static_cast<size_t>(ny) * dz);
+                    valid[m] = j + dy < ny && k + dz < nz;
+                }
+                const size_t row = index(0, j, k);
+                for (uint i = r[0]; i < r[1]; ++i) {
+                    const size_t a = row + i;
+                    const double va = values[a];
+                    if (std::isnan(va)) {
+                        continue;
+                    }
+                    const bool inside = va >= iso;
+                    for (int m = 1; m < 8; ++m) {
+                        if (!valid[m] || ((m & 1) && i + 1 >= nx)) {
+                            continue;
+                        }
+                        const size_t b = a + offset[m];
+                        const double vb = values[b];
+                        if (!std::isnan(vb) && (vb >= iso) != inside) {
+                            f(i, m, a, b);
+                        }
+                    }
+                }
+            }
+
+            uint64_t row_vertices(uint j, uint k, Range& range) const
+            {
+                uint64_t count = 0;
+                range = { nx, 0 };
+                for_each_row_edge(j, k, { 0, nx }, [&](uint i, int, size_t, size_t) {
+                    range[0] = std::min(range[0], i);
+                    range[1] = i + 1;
+                    ++count;
+                });
+                return count;
+            }
+
+            // ids[8 * i + type] = vertex id of the edge, for the row (j, k)
+            void row_ids(
+                uint j, uint k, Range range, uint32_t first, std::vector<uint32_t>& ids) const
+            {
+                for_each_row_edge(j, k, range,
+                    [&](uint i, int m, size_t, size_t) { ids[8 * i + m] = first++; });
+            }
+
+            // Corner values and inside mask of a cell. False if the cell is
+            // not cut (or has a NaN corner).
+            bool cell(uint i, uint j, uint k, double (&c)[8], int& mask) const
+            {
+                mask = 0;
+                for (int m = 0; m < 8; ++m) {
+                    c[m] = values[index(i + (m & 1), j + ((m >> 1) & 1), k + (m >> 2))];
+                    if (std::isnan(c[m])) {
+                        return false;
+                    }
+                    mask |= (c[m] >= iso) << m;
+                }
+                return mask != 0 && mask != 255;
+            }
+
+            // Only the cells within the given range (see row_vertices) are
+            // tested
+            uint64_t row_triangles(uint j, uint k, Range candidates, Range& range) const
+            {
+                uint64_t count = 0;
+                double c[8];
+                int mask;
+                range = { nx, 0 };
+                for (uint i = candidates[0]; i < candidates[1]; ++i) {
+                    if (!cell(i, j, k, c, mask)) {
+                        continue;
+                    }
+                    range[0] = std::min(range[0], i);
+                    range[1] = i + 1;
+                    for (const auto& tet : tets) {
+                        int inside = 0;
+                        for (int q = 0; q < 4; ++q) {
+                            inside += (mask >> tet[q]) & 1;
+                        }
+                        count += inside == 2 ? 2 : (inside == 1 || inside == 3);
+                    }
+                }
+                return count;
+            }
+
+            // Sign of the permutation taking the corners of tetrahedron t to
+            // (a, b, c, d), times the orientation of the tetrahedron
+            int orientation(int t, int a, int b, int c, int d) const
+            {
+                int pos[4];
+                const int tuple[4] = { a, b, c, d };
+                for (int q = 0; q < 4; ++q) {
+                    for (int r = 0; r < 4; ++r) {
+                        if (tets[t][r] == tuple[q]) {
+                            pos[q] = r;
+                        }
+                    }
+                }
+                int sign = signs[t];
+                for (int q = 0; q < 4; ++q) {
+                    for (int r = q + 1; r < 4; ++r) {
+                        if (pos[q] > pos[r]) {
+                            sign = -sign;
+                        }
+                    }
+                }
+                return sign;
+            }
+
+            // Orientation of each tetrahedron: (0, a, a|b, 7) has the sign of
+            // the permutation (a, b, c) of the axes, flipped by each negative
+            // spacing
+            static std::array<int, 6> orientations(const Vector3& spacing)
+            {
+                const int flip = (spacing[0] < 0) ^ (spacing[1] < 0) ^ (spacing[2] < 0);
+                std::array<int, 6> result;
+                for (int t = 0; t < 6; ++t) {
+                    const int a = tets[t][1], b = tets[t][2] ^ a;
+                    // even permutations of (1, 2, 4)
+                    const bool even
+                        = (a == 1 && b == 2) || (a == 2 && b == 4) || (a == 4 && b == 1);
+                    result[t] = (even ? 1 : -1) * (flip ? -1 : 1);
+                }
+                return result;
+            }
+
+            static Edge edge(int u, int v) { return u < v ? Edge { u, v } : Edge { v, u }; }
+
+            // Visit the triangles of cell (i, j, k), in the same order as
+            // counted by row_triangles. Triangles are given as cell edges,
+            // oriented so that their normal points toward decreasing values.
+            // For a positively oriented (apex, a, b, c), the triangle cutting
+            // the edges (apex, a), (apex, b), (apex, c) has its normal pointing
+            // away from the apex.
+            template <typename F>
+            void for_each_cell_triangle(uint i, uint j, uint k, F&& emit) const
+            {
+                double c[8];
+                int mask;
+                if (!cell(i, j, k, c, mask)) {
+                    return;
+                }
+                for (int t = 0; t < 6; ++t) {
+                    int in[4], out[4], ni = 0, no = 0;
+                    for (int q = 0; q < 4; ++q) {
+                        if ((mask >> tets[t][q]) & 1) {
+                            in[ni++] = tets[t][q];
+                        } else {
+                            out[no++] = tets[t][q];
+                        }
+                    }
+                    if (ni == 0 || no == 0) {
+                        continue;
+                    }
+
+                    if (ni == 1 || no == 1) {
+                        const int apex = ni == 1 ? in[0] : out[0];
+                        const int* others = ni == 1 ? out : in;
+                        TriangleEdges tri { edge(apex, others[0]), edge(apex, others[1]),
+                            edge(apex, others[2]) };
+                        // Away from an inside apex, toward an outside one
+                        const int sign = orientation(t, apex, others[0], others[1], others[2]);
+                        if ((sign > 0) != (ni == 1)) {
+                            std::swap(tri[1], tri[2]);
+                        }
+                        emit(tri);
+                    } else {
+                        // Quad, in cyclic order. Its normal points from
+                        // (in[0], in[1]) to (out[0], out[1]) when this tuple
+                        // is positively oriented.
+                        std::array<Edge, 4> quad { edge(in[0], out[0]), edge(in[0], out[1]),
+                            edge(in[1], out[1]), edge(in[1], out[0]) };
+                        if (orientation(t, in[0], in[1], out[0], out[1]) < 0) {
+                            std::swap(quad[1], quad[3]);
+                        }
+                        emit(TriangleEdges { quad[0], quad[1], quad[2] });
+                        emit(TriangleEdges { quad[0], quad[2], quad[3] });
+                    }
+                }
+            }
+        };
+
+    } // namespace detail
+
+    inline Serie<IsoSegment<2>> contours(const Grid2D& grid, const std::string& attributeName,
+        const std::vector<double>& isoValues)
+    {
+        const auto& values
+            = detail::grid_scalar_attribute(grid.attributes, attributeName, grid.total_points());
+        const uint nx = grid.dimensions[0], ny = grid.dimensions[1];
+        if (nx < 2 || ny < 2 || isoValues.empty()) {
+            return Serie<IsoSegment<2>>();
+        }
+
+        const double* v = values.data().data();
+        const size_t rows = ny - 1;
+        const size_t nlevels = isoValues.size();
+
+        // f(level, i, corners, segments, n) for each cut cell of row j
+        auto for_each_cell = [&](uint j, auto&& f) {
+            std::array<std::array<int, 2>, 2> segs;
+            for (uint i = 0; i + 1 < nx; ++i) {
+                const size_t a = static_cast<size_t>(j) * nx + i;
+                const std::array<double, 4> c { v[a], v[a + 1], v[a + nx + 1], v[a + nx] };
+                if (std::isnan(c[0]) || std::isnan(c[1]) || std::isnan(c[2])
+                    || std::isnan(c[3])) {
+                    continue;
+                }
+                for (size_t l = 0; l < nlevels; ++l) {
+                    const int n = detail::marching_squares_cell(c, isoValues[l], segs);
+                    if (n > 0) {
+                        f(l, i, c, segs, n);
+                    }
+                }
+            }
+        };
+
+        // 1) Count, per (level, row of cells)
+        std::vector<uint64_t> offsets(nlevels * rows + 1, 0);
+        const size_t num_chunks
+            = std::min(rows, detail::get_optimal_threads(grid.total_points() * nlevels));
+        detail::parallel_for_chunks(rows, num_chunks, [&](size_t, size_t start, size_t end) {
+            for (size_t j = start; j < end; ++j) {
+                for_each_cell(static_cast<uint>(j), [&](size_t l, uint, const auto&, const auto&,
+                                                        int n) { offsets[l * rows + j] += n; });
+            }
+        });
+        const uint64_t total = detail::grid_exclusive_scan(offsets);
+
+        // 2) Fill, each row writes at its own offsets
+        std::vector<IsoSegment<2>> segments(total);
+        detail::parallel_for_chunks(rows, num_chunks, [&](size_t, size_t start, size_t end) {
+            std::vector<uint64_t> cursor(nlevels);
+            for (size_t j = start; j < end; ++j) {
+                for (size_t l = 0; l < nlevels; ++l) {
+                    cursor[l] = offsets[l * rows + j];
+                }
+                for_each_cell(static_cast<uint>(j),
+                    [&](size_t l, uint i, const std::array<double, 4>& c, const auto& segs, int n) {
+                        const double iso = isoValues[l];
+                        for (int s = 0; s < n; ++s) {
+                            auto& seg = segments[cursor[l]++];
+                            seg.p1 = detail::marching_squares_point(
+                                grid, i, static_cast<uint>(j), c, segs[s][0], iso);
+                            seg.p2 = detail::marching_squares_point(
+                                grid, i, static_cast<uint>(j), c, segs[s][1], iso);
+                            seg.value = iso;
+                        }
+                    });
+            }
+        });
+
+        return Serie<IsoSegment<2>>(segments);
+    }
+
+    inline Serie<IsoSegment<2>> contours(
+        const Grid2D& grid, const std::string& attributeName, double isoValue)
+    {
+        return contours(grid, attributeName, std::vector<double> { isoValue });
+    }
+
+    inline Serie<IsoSegment<2>> contours(
+        const Grid2D& grid, const std::string& attributeName, const Serie<double>& isoValues)
+    {
+        return contours(grid, attributeName, isoValues.asArray());
+    }
+
+    inline Mesh3D isosurface(const Grid3D& grid, const std::string& attributeName, double isoValue)
+    {
+        const size_t npoints = grid.total_points();
+        const auto& values = detail::grid_scalar_attribute(grid.attributes, attributeName, npoints);
+        const uint nx = grid.dimensions[0], ny = grid.dimensions[1], nz = grid.dimensions[2];
+        if (nx < 2 || ny < 2 || nz < 2) {
+            return Mesh3D();
+        }
+
+        const detail::MarchingTetrahedra mt { values.data().data(), isoValue, nx, ny, nz,
+            detail::MarchingTetrahedra::orientations(grid.spacing) };
+
+        // Vertices per row of nodes and triangles per row of cells, both
+        // indexed by j + ny * k
+        const size_t rows = static_cast<size_t>(ny) * nz;
+        std::vector<uint64_t> vertex_offsets(rows + 1, 0);
+        std::vector<uint64_t> triangle_offsets(rows + 1, 0);
+        std::vector<detail::MarchingTetrahedra::Range> vertex_ranges(rows, { 0, 0 });
+        std::vector<detail::MarchingTetrahedra::Range> cell_ranges(rows, { 0, 0 });
+
+        // 1) Count, by slabs of k. The cut cells of a row are within the
+        // ranges of its 4 rows of nodes.
+        const size_t num_chunks = std::min<size_t>(nz, detail::get_optimal_threads(npoints));
+        detail::parallel_for_chunks(nz, num_chunks, [&](size_t, size_t start, size_t end) {
+            for (uint k = start; k < end; ++k) {
+                for (uint j = 0; j < ny; ++j) {
+                    const size_t r = j + static_cast<size_t>(ny) * k;
+                    vertex_offsets[r] = mt.row_vertices(j, k, vertex_ranges[r]);
+                }
+            }
+        });
+        detail::parallel_for_chunks(nz, num_chunks, [&](size_t, size_t start, size_t end) {
+            for (uint k = start; k < end && k + 1 < nz; ++k) {
+                for (uint j = 0; j + 1 < ny; ++j) {
+                    const size_t r = j + static_cast<size_t>(ny) * k;
+                    detail::MarchingTetrahedra::Range candidates { nx, 0 };
+                    for (size_t rr : { r, r + 1, r + ny, r + ny + 1 }) {
+                        if (vertex_ranges[rr][0] < vertex_ranges[rr][1]) {
+                            candidates[0] = std::min(candidates[0], vertex_ranges[rr][0]);
+                            candidates[1] = std::max(candidates[1], vertex_ranges[rr][1]);
+                        }
+                    }
+                    candidates[0] = candidates[0] > 0 ? candidates[0] - 1 : 0;
+                    candidates[1] = std::min(candidates[1], nx - 1);
+                    triangle_offsets[r] = mt.row_triangles(j, k, candidates, cell_ranges[r]);
+                }
+            }
+        });
+        const uint64_t nvertices = detail::grid_exclusive_scan(vertex_offsets);
+        const uint64_t ntriangles = detail::grid_exclusive_scan(triangle_offsets);
+        if (nvertices > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error(
+                concat("isosurface: too many vertices (", nvertices, ") for 32 bits indices"));
+        }
+        if (ntriangles == 0) {
+            return Mesh3D();
+        }
+
+        detail::InterpolatedAttributes<double> scalars;
+        detail::InterpolatedAttributes<Vector2> vectors2;
+        detail::InterpolatedAttributes<Vector3> vectors3;
+        scalars.collect(grid.attributes, attributeName, npoints);
+        vectors2.collect(grid.attributes, attributeName, npoints);
+        vectors3.collect(grid.attributes, attributeName, npoints);
+        scalars.resize(nvertices);
+        vectors2.resize(nvertices);
+        vectors3.resize(nvertices);
+
+        // 2) Fill, by the same slabs
+        std::vector<Vector3> positions(nvertices);
+        std::vector<iVector3> triangles(ntriangles);
+        detail::parallel_for_chunks(nz, num_chunks, [&](size_t, size_t start, size_t end) {
+            const double* v = mt.values;
+            for (uint k = start; k < end; ++k) {
+                for (uint j = 0; j < ny; ++j) {
+                    const size_t r = j + static_cast<size_t>(ny) * k;
+                    size_t id = vertex_offsets[r];
+                    const Vector3 origin = grid.point_at(0, j, k);
+                    mt.for_each_row_edge(
+                        j, k, vertex_ranges[r], [&](uint i, int m, size_t a, size_t b) {
+                            const double t = (isoValue - v[a]) / (v[b] - v[a]);
+                            positions[id] = { origin[0] + (i + t * (m & 1)) * grid.spacing[0],
+                                origin[1] + t * ((m >> 1) & 1) * grid.spacing[1],
+                                origin[2] + t * (m >> 2) * grid.spacing[2] };
+                            scalars.interpolate(id, a, b, t);
+                            vectors2.interpolate(id, a, b, t);
+                            vectors3.interpolate(id, a, b, t);
+                            ++id;
+                        });
+                }
+            }
+
+            // Vertex ids of the 4 rows of nodes around a row of cells
+            // (j + dy, k + dz), indexed by dy + 2 * dz. Rows shared with the
+            // previous row of cells are kept.
+            std::array<std::vector<uint32_t>, 4> ids;
+            std::array<size_t, 4> loaded;
+            ids.fill(std::vector<uint32_t>(8 * static_cast<size_t>(nx)));
+            loaded.fill(rows);
+
+            for (uint k = start; k < end && k + 1 < nz; ++k) {
+                for (uint j = 0; j + 1 < ny; ++j) {
+                    const size_t r = j + static_cast<size_t>(ny) * k;
+                    const auto cells = cell_ranges[r];
+                    if (cells[0] >= cells[1]) {
+                        continue;
+                    }
+                    if (loaded[1] == r && loaded[3] == r + ny) {
+                        std::swap(ids[0], ids[1]);
+                        std::swap(ids[2], ids[3]);
+                        std::swap(loaded[0], loaded[1]);
+                        std::swap(loaded[2], loaded[3]);
+                    }
+                    for (int slot = 0; slot < 4; ++slot) {
+                        const size_t rr = r + (slot & 1) + static_cast<size_t>(ny) * (slot >> 1);
+                        if (loaded[slot] != rr) {
+                            mt.row_ids(j + (slot & 1), k + (slot >> 1), vertex_ranges[rr],
+                                static_cast<uint32_t>(vertex_offsets[rr]), ids[slot]);
+                            loaded[slot] = rr;
+                        }
+                    }
+                    size_t next = triangle_offsets[r];
+                    for (uint i = cells[0]; i < cells[1]; ++i) {
+                        mt.for_each_cell_triangle(i, j, k, [&](const auto& tri) {
+                            auto& out = triangles[next++];
+                            for (int q = 0; q < 3; ++q) {
+                                const int u = tri[q][0];
+                                const auto& row = ids[((u >> 1) & 1) + 2 * (u >> 2)];
+                                out[q] = row[8 * (i + (u & 1)) + (u ^ tri[q][1])];
+                            }
+                        });
+                    }
+                }
+            }
+        });
+
+        Mesh3D mesh { Serie<Vector3>(positions), Serie<iVector3>(triangles) };
+        scalars.addTo(mesh);
+        vectors2.addTo(mesh);
+        vectors3.addTo(mesh);
+        return mesh;
+    }
+
+} // namespace df
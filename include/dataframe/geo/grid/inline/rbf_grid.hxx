@@ -12,95 +12,249 @@
  * @return Serie of interpolated values
  */
 
-#include "grid/grid2d.h"
-#include "grid/grid3d.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/geo/interpolation/common.h>
+#include <dataframe/utils/flat_hash.h>
 #include <functional>
+#include <vector>
 
 namespace df {
 
-    template <typename T>
-    inline Serie<T> rbf_grid_2d(const Grid2D& grid, const Serie<T>& values,
-        const Serie<Vector2>& targets, RBFKernel kernel, double epsilon, uint support_radius)
-    {
-        if (values.size() != grid.total_points()) {
-            throw std::runtime_error("Values size does not match grid dimensions");
-        }
-
-        auto kernel_fn = get_kernel_function(kernel);
-        Serie<T> result(targets.size());
+    namespace detail {
 
-        // Precompute maximum distance for support radius
-        double max_support_dist = support_radius * std::max(grid.spacing[0], grid.spacing[1]);
-        max_support_dist *= max_support_dist; // Square it for comparison
+        // Regular grid, as seen by the stencil engine
+        template <size_t D> struct RBFGridGeometry {
+            std::array<double, D> origin;
+            std::array<double, D> spacing;
+            std::array<int, D> dimensions;
 
-// For each target point
-#pragma omp parallel for if (targets.size() > 1000)
-        for (size_t t = 0; t < targets.size(); ++t) {
-            const auto& target = targets[t];
-
-            // Find nearest grid point
-            int i0 = std::round((target[0] - grid.origin[0]) / grid.spacing[0]);
-            int j0 = std::round((target[1] - grid.origin[1]) / grid.spacing[1]);
-
-            // Collect nearby points within support radius
-            std::vector<Vector2> local_points;
-            std::vector<T> local_values;
+            size_t linear_index(const std::array<int, D>& node) const
+            {
+                size_t index = 0, stride = 1;
+                for (size_t d = 0; d < D; ++d) {
+                    index += static_cast<size_t>(node[d]) * stride;
+                    stride *= static_cast<size_t>(dimensions[d]);
+                }
+                return index;
+            }
+        };
+
+        // Bit set of the node offsets (within the (2r+1)^D box around the
+        // nearest node) used by a target
+        using StencilKey = std::vector<uint64_t>;
+
+        struct StencilKeyHash {
+            size_t operator()(const StencilKey& key) const
+            {
+                uint64_t h = key.size();
+                for (uint64_t word : key) {
+                    h = hash_mix(h ^ word);
+                }
+                return static_cast<size_t>(h);
+            }
+        };
+
+        // Factorized local interpolation matrix of one stencil shape
+        struct RBFStencil {
+            std::vector<uint32_t> offsets; // indices in the box
+            Eigen::LDLT<Eigen::MatrixXd> ldlt;
+        };
+
+        template <typename T, size_t D>
+        Serie<T> rbf_grid_stencils(const RBFGridGeometry<D>& grid, const Serie<T>& values,
+            const Serie<Vector<double, D>>& targets, RBFKernel kernel, double epsilon,
+            uint support_radius)
+        {
+            const auto kernel_fn = get_kernel_function(kernel);
+            const int radius = static_cast<int>(support_radius);
+            const int side = 2 * radius + 1;
+            size_t box = 1;
+            for (size_t d = 0; d < D; ++d) {
+                box *= static_cast<size_t>(side);
+            }
+            const size_t words = (box + 63) / 64;
+
+            double max_support_dist
+                = support_radius * *std::max_element(grid.spacing.begin(), grid.spacing.end());
+            max_support_dist *= max_support_dist;
+
+            // Offset (in nodes) of each box index
+            std::vector<std::array<int, D>> box_offsets(box);
+            for (size_t b = 0; b < box; ++b) {
+                size_t rest = b;
+                for (size_t d = 0; d < D; ++d) {
+                    box_offsets[b][d] = static_cast<int>(rest % side) - radius;
+                    rest /= side;
+                }
+            }
 
-            for (int j = std::max(0, j0 - support_radius);
-                j <= std::min(static_cast<int>(grid.dimensions[1] - 1), j0 + support_radius); ++j) {
-                for (int i = std::max(0, i0 - support_radius);
-                    i <= std::min(static_cast<int>(grid.dimensions[0] - 1), i0 + support_radius);
-                    ++i) {
+            auto nearest_node = [&](const Vector<double, D>& target) {
+                std::array<int, D> node;
+                for (size_t d = 0; d < D; ++d) {
+                    node[d] = static_cast<int>(
+                        std::round((target[d] - grid.origin[d]) / grid.spacing[d]));
+                }
+                return node;
+            };
 
-                    Vector2 point = grid.point_at(i, j);
-                    double dist_sq = distance_squared_2d(target, point);
+            auto node_point = [&](const std::array<int, D>& node, const std::array<int, D>& offset) {
+                Vector<double, D> p;
+                for (size_t d = 0; d < D; ++d) {
+                    p[d] = grid.origin[d] + (node[d] + offset[d]) * grid.spacing[d];
+                }
+                return p;
+            };
 
-                    if (dist_sq <= max_support_dist) {
-                        local_points.push_back(point);
-                        local_values.push_back(values[grid.linear_index(i, j)]);
+            auto distance2 = [](const Vector<double, D>& a, const Vector<double, D>& b) {
+                double r2 = 0;
+                for (size_t d = 0; d < D; ++d) {
+                    r2 += (a[d] - b[d]) * (a[d] - b[d]);
+                }
+                return r2;
+            };
+
+            // 1) Stencil shape of each target, deduplicated per chunk
+            const size_t n = targets.size();
+            const size_t num_chunks = get_optimal_threads(n);
+            std::vector<uint32_t> shape_of(n);
+            std::vector<std::vector<StencilKey>> chunk_keys(num_chunks);
+
+            parallel_for_chunks(n, num_chunks, [&](size_t chunk, size_t start, size_t end) {
+                FlatHashMap<StencilKey, uint32_t, StencilKeyHash> ids;
+                StencilKey key(words);
+                for (size_t t = start; t < end; ++t) {
+                    const auto node = nearest_node(targets[t]);
+                    std::fill(key.begin(), key.end(), 0);
+                    for (size_t b = 0; b < box; ++b) {
+                        bool inside = true;
+                        for (size_t d = 0; d < D; ++d) {
+                            const int i = node[d] + box_offsets[b][d];
+                            inside = inside && i >= 0 && i < grid.dimensions[d];
+                        }
+                        if (inside
+                            && distance2(targets[t], node_point(node, box_offsets[b]))
+                                <= max_support_dist) {
+                            key[b / 64] |= uint64_t(1) << (b % 64);
+                        }
+                    }
+                    auto [id, inserted] = ids.try_emplace(
+                        key, static_cast<uint32_t>(chunk_keys[chunk].size()));
+                    if (inserted) {
+                        chunk_keys[chunk].push_back(key);
                     }
+                    shape_of[t] = *id;
+                }
+            });
+
+            // 2) Global shape ids
+            FlatHashMap<StencilKey, uint32_t, StencilKeyHash> global_ids;
+            std::vector<StencilKey> keys;
+            std::vector<std::vector<uint32_t>> remap(num_chunks);
+            for (size_t c = 0; c < num_chunks; ++c) {
+                for (const auto& key : chunk_keys[c]) {
+                    auto [id, inserted]
+                        = global_ids.try_emplace(key, static_cast<uint32_t>(keys.size()));
+                    if (inserted) {
+                        keys.push_back(key);
+                    }
+                    remap[c].push_back(*id);
                 }
             }
 
-            // Local RBF interpolation
-            const size_t n = local_points.size();
-            if (n == 0) {
-                // Point is outside the grid - use nearest value
-                result[t] = values[grid.linear_index(
-                    std::clamp(i0, 0, static_cast<int>(grid.dimensions[0] - 1)),
-                    std::clamp(j0, 0, static_cast<int>(grid.dimensions[1] - 1)))];
-                continue;
-            }
+            // 3) Factorize each distinct shape once. The matrix only depends
+            // on the node offsets (translation invariance).
+            std::vector<RBFStencil> stencils(keys.size());
+            parallel_for_chunks(keys.size(), std::min(keys.size(), num_chunks),
+                [&](size_t, size_t start, size_t end) {
+                    for (size_t s = start; s < end; ++s) {
+                        auto& stencil = stencils[s];
+                        for (size_t b = 0; b < box; ++b) {
+                            if (keys[s][b / 64] >> (b % 64) & 1) {
+                                stencil.offsets.push_back(static_cast<uint32_t>(b));
+                            }
+                        }
+                        const size_t m = stencil.offsets.size();
+                        if (m == 0) {
+                            continue;
+                        }
+                        const std::array<int, D> origin {};
+                        Eigen::MatrixXd A(m, m);
+                        for (size_t i = 0; i < m; ++i) {
+                            const auto pi = node_point(origin, box_offsets[stencil.offsets[i]]);
+                            for (size_t j = 0; j < m; ++j) {
+                                const auto pj
+                                    = node_point(origin, box_offsets[stencil.offsets[j]]);
+                                A(i, j) = kernel_fn(std::sqrt(distance2(pi, pj)), epsilon);
+                            }
+                            A(i, i) += 1e-10; // Small regularization
+                        }
+                        stencil.ldlt.compute(A);
+                    }
+                });
+
+            // 4) Solve and evaluate every target
+            std::vector<T> out(n);
+            const auto& in = values.data();
+
+            parallel_for_chunks(n, num_chunks, [&](size_t chunk, size_t start, size_t end) {
+                Eigen::VectorXd b, weights;
+                for (size_t t = start; t < end; ++t) {
+                    const auto& target = targets[t];
+                    const auto node = nearest_node(target);
+                    const auto& stencil = stencils[remap[chunk][shape_of[t]]];
+                    const size_t m = stencil.offsets.size();
+
+                    if (m == 0) {
+                        // Point is outside the grid - use nearest value
+                        std::array<int, D> clamped;
+                        for (size_t d = 0; d < D; ++d) {
+                            clamped[d] = std::clamp(node[d], 0, grid.dimensions[d] - 1);
+                        }
+                        out[t] = in[grid.linear_index(clamped)];
+                        continue;
+                    }
 
-            Eigen::MatrixXd A(n, n);
-            Eigen::VectorXd b(n);
+                    b.resize(m);
+                    for (size_t i = 0; i < m; ++i) {
+                        std::array<int, D> p = node;
+                        for (size_t d = 0; d < D; ++d) {
+                            p[d] += box_offsets[stencil.offsets[i]][d];
+                        }
+                        b(i) = static_cast<double>(in[grid.linear_index(p)]);
+                    }
+                    weights = stencil.ldlt.solve(b);
 
-            // Build local interpolation matrix
-            for (size_t i = 0; i < n; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    double r = std::sqrt(distance_squared_2d(local_points[i], local_points[j]));
-                    A(i, j) = kernel_fn(r, epsilon);
+                    double sum = 0.0;
+                    for (size_t i = 0; i < m; ++i) {
+                        const double r = std::sqrt(
+                            distance2(target, node_point(node, box_offsets[stencil.offsets[i]])));
+                        sum += weights(i) * kernel_fn(r, epsilon);
+                    }
+                    out[t] = static_cast<T>(sum);
                 }
-                A(i, i) += 1e-10; // Small regularization
-                b(i) = static_cast<double>(local_values[i]);
-            }
+            });
 
-            // Solve local system
-            Eigen::VectorXd weights = A.ldlt().solve(b);
+            return Serie<T>(out);
+        }
 
-            // Compute interpolated value
-            double sum = 0.0;
-            for (size_t i = 0; i < n; ++i) {
-                double r = std::sqrt(distance_squared_2d(target, local_points[i]));
-                sum += weights(i) * kernel_fn(r, epsilon);
-            }
+    } // namespace detail
 
-            result[t] = static_cast<T>(sum);
+    template <typename T>
+    inline Serie<T> rbf_grid_2d(const Grid2D& grid, const Serie<T>& values,
+        const Serie<Vector2>& targets, RBFKernel kernel, double epsilon, uint support_radius)
+    {
+        if (values.size() != grid.total_points()) {
+            throw std::runtime_error("Values size does not match grid dimensions");
         }
 
-        return result;
+        detail::RBFGridGeometry<2> geometry { { grid.origin[0], grid.origin[1] },
+            { grid.spacing[0], grid.spacing[1] },
+            { static_cast<int>(grid.dimensions[0]), static_cast<int>(grid.dimensions[1]) } };
+        return detail::rbf_grid_stencils(geometry, values, targets, kernel, epsilon, support_radius);
     }
 
     template <typename T>
@@ -111,83 +265,11 @@ namespace df {
             throw std::runtime_error("Values size does not match grid dimensions");
         }
 
-        auto kernel_fn = get_kernel_function(kernel);
-        Serie<T> result(targets.size());
-
-        // Precompute maximum distance for support radius
-        double max_support_dist
-            = support_radius * std::max({ grid.spacing[0], grid.spacing[1], grid.spacing[2] });
-        max_support_dist *= max_support_dist;
-
-// For each target point
-#pragma omp parallel for if (targets.size() > 1000)
-        for (size_t t = 0; t < targets.size(); ++t) {
-            const auto& target = targets[t];
-
-            // Find nearest grid point
-            int i0 = std::round((target[0] - grid.origin[0]) / grid.spacing[0]);
-            int j0 = std::round((target[1] - grid.origin[1]) / grid.spacing[1]);
-            int k0 = std::round((target[2] - grid.origin[2]) / grid.spacing[2]);
-
-            // Collect nearby points within support radius
-            std::vector<Vector3> local_points;
-            std::vector<T> local_values;
-
-            for (int k = std::max(0, k0 - support_radius);
-                k <= std::min(static_cast<int>(grid.dimensions[2] - 1), k0 + support_radius); ++k) {
-                for (int j = std::max(0, j0 - support_radius);
-                    j <= std::min(static_cast<int>(grid.dimensions[1] - 1), j0 + support_radius);
-                    ++j) {
-                    for (int i = std::max(0, i0 - support_radius); i
-                        <= std::min(static_cast<int>(grid.dimensions[0] - 1), i0 + support_radius);
-                        ++i) {
-
-                        Vector3 point = grid.point_at(i, j, k);
-                        double dist_sq = distance_squared_3d(target, point);
-
-                        if (dist_sq <= max_support_dist) {
-                            local_points.push_back(point);
-                            local_values.push_back(values[grid.linear_index(i, j, k)]);
-                        }
-                    }
-                }
-            }
-
-            // Local RBF interpolation
-            const size_t n = local_points.size();
-            if (n == 0) {
-                // Point is outside the grid - use nearest value
-                result[t] = values[grid.linear_index(
-                    std::clamp(i0, 0, static_cast<int>(grid.dimensions[0] - 1)),
-                    std::clamp(j0, 0, static_cast<int>(grid.dimensions[1] - 1)),
-                    std::clamp(k0, 0, static_cast<int>(grid.dimensions[2] - 1)))];
-                continue;
-            }
-
-            Eigen::MatrixXd A(n, n);
-            Eigen::VectorXd b(n);
-
-            for (size_t i = 0; i < n; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    double r = std::sqrt(distance_squared_3d(local_points[i], local_points[j]));
-                    A(i, j) = kernel_fn(r, epsilon);
-                }
-                A(i, i) += 1e-10;
-                b(i) = static_cast<double>(local_values[i]);
-            }
-
-            Eigen::VectorXd weights = A.ldlt().solve(b);
-
-            double sum = 0.0;
-            for (size_t i = 0; i < n; ++i) {
-                double r = std::sqrt(distance_squared_3d(target, local_points[i]));
-                sum += weights(i) * kernel_fn(r, epsilon);
-            }
-
-            result[t] = static_cast<T>(sum);
-        }
-
-        return result;
+        detail::RBFGridGeometry<3> geometry { { grid.origin[0], grid.origin[1], grid.origin[2] },
+            { grid.spacing[0], grid.spacing[1], grid.spacing[2] },
+            { static_cast<int>(grid.dimensions[0]), static_cast<int>(grid.dimensions[1]),
+                static_cast<int>(grid.dimensions[2]) } };
+        return detail::rbf_grid_stencils(geometry, values, targets, kernel, epsilon, support_radius);
     }
 
-} // namespace df
\ No newline at end of file
+} // namespace df
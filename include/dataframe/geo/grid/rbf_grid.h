@@ -12,18 +12,28 @@
  * @return Serie of interpolated values
  */
 
-#include "rbf_kernels.h"
+#pragma once
 #include <dataframe/Serie.h>
+#include <dataframe/geo/grid/grid2d.h>
+#include <dataframe/geo/grid/grid3d.h>
+#include <dataframe/geo/interpolation/rbf_kernels.h>
 
 namespace df {
 
-    class Grid2D;
-    class Grid3D;
+    using grid::Grid2D;
+    using grid::Grid3D;
 
     /**
      * @brief RBF interpolation optimized for regular 2D grids
      * Similar to 3D version but for 2D grids
      *
+     * Each target is interpolated from the grid nodes around its nearest
+     * node that are within support_radius cells. On a regular grid, the
+     * local interpolation matrix only depends on the stencil shape (the set
+     * of node offsets), which is the same for all interior targets. Each
+     * distinct shape is factorized once, then every target costs two small
+     * triangular solves. Targets are processed in parallel.
+     *
      * @code
      * // Define a 2D grid
      * df::Grid2D grid {
@@ -58,7 +68,8 @@ namespace df {
 
     /**
      * @brief RBF interpolation optimized for regular 3D grids
-     * Similar to 2D version but for 3D grids
+     * Similar to 2D version but for 3D grids (same stencil factorization
+     * cache)
      */
     template <typename T>
     Serie<T> rbf_grid_3d(const Grid3D& grid, const Serie<T>& values, const Serie<Vector3>& targets,
@@ -67,12 +67,14 @@ namespace df {
             return Serie<double>();
         }
 
-        return triangles.map([&vertices](const auto& triangle, size_t) {
-            const auto& v1 = vertices[triangle[0]];
-            const auto& v2 = vertices[triangle[1]];
-            const auto& v3 = vertices[triangle[2]];
-            return detail::triangle_area_2d(v1, v2, v3);
-        });
+        return parallel_map(
+            [&vertices](const auto& triangle, size_t) {
+                const auto& v1 = vertices[triangle[0]];
+                const auto& v2 = vertices[triangle[1]];
+                const auto& v3 = vertices[triangle[2]];
+                return detail::triangle_area_2d(v1, v2, v3);
+            },
+            triangles);
     }
 
     // Overload for Vector3
@@ -83,12 +85,14 @@ namespace df {
             return Serie<double>();
         }
 
-        return triangles.map([&vertices](const auto& triangle, size_t) {
-            const auto& v1 = vertices[triangle[0]];
-            const auto& v2 = vertices[triangle[1]];
-            const auto& v3 = vertices[triangle[2]];
-            return detail::triangle_area_3d(v1, v2, v3);
-        });
+        return parallel_map(
+            [&vertices](const auto& triangle, size_t) {
+                const auto& v1 = vertices[triangle[0]];
+                const auto& v2 = vertices[triangle[1]];
+                const auto& v3 = vertices[triangle[2]];
+                return detail::triangle_area_3d(v1, v2, v3);
+            },
+            triangles);
     }
 
     // Binding functions for pipeline operations
@@ -29,10 +29,8 @@ inline Serie<double> insar(const Serie<Vector3> &u, const Vector3 &los) {
         return Serie<double>();
     }
 
-    Serie<double> result;
-    u.forEach([&](const Vector3 &disp, size_t) { result.add(dot(disp, los)); });
-
-    return result;
+    return parallel_map(
+        [&los](const Vector3 &disp, size_t) { return dot(disp, los); }, u);
 }
 
 inline Serie<double> fringes(const Serie<double> &insar, double fringeSpacing) {
@@ -40,14 +38,12 @@ inline Serie<double> fringes(const Serie<double> &insar, double fringeSpacing) {
         return Serie<double>();
     }
 
-    Serie<double> result;
-    insar.forEach([fringeSpacing, &result](double val, size_t) {
-        double frac = val / fringeSpacing - std::floor(val / fringeSpacing);
-        double fringe = std::abs(fringeSpacing * frac);
-        result.add(fringe);
-    });
-
-    return result;
+    return parallel_map(
+        [fringeSpacing](double val, size_t) {
+            double frac = val / fringeSpacing - std::floor(val / fringeSpacing);
+            return std::abs(fringeSpacing * frac);
+        },
+        insar);
 }
 
 } // namespace df
\ No newline at end of file
@@ -51,11 +51,13 @@ Serie<double> length(const Serie<Vector<double, N>> &vertices,
         return Serie<double>();
     }
 
-    return segments.map([&vertices](const auto &segment, size_t) {
-        const auto &v1 = vertices[segment[0]];
-        const auto &v2 = vertices[segment[1]];
-        return detail::segment_length<double, N>(v1, v2);
-    });
+    return parallel_map(
+        [&vertices](const auto &segment, size_t) {
+            const auto &v1 = vertices[segment[0]];
+            const auto &v2 = vertices[segment[1]];
+            return detail::segment_length<double, N>(v1, v2);
+        },
+        segments);
 }
 
 // Binding functions for pipeline operations
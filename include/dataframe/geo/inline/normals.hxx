@@ -82,13 +82,15 @@ Serie<Vector2> normals(const Serie<Vector2> &vertices,
         return Serie<Vector2>();
     }
 
-    return segments.map([&vertices](const auto &segment, size_t) {
-        // Get vertices for this segment
-        const auto &v1 = vertices[segment[0]];
-        const auto &v2 = vertices[segment[1]];
-
-        return detail::segment_normal<T>(v1, v2);
-    });
+    return parallel_map(
+        [&vertices](const auto &segment, size_t) {
+            // Get vertices for this segment
+            const auto &v1 = vertices[segment[0]];
+            const auto &v2 = vertices[segment[1]];
+
+            return detail::segment_normal<T>(v1, v2);
+        },
+        segments);
 }
 
 /**
@@ -104,14 +106,16 @@ Serie<Vector3> normals(const Serie<Vector3> &vertices,
         return Serie<Vector3>();
     }
 
-    return triangles.map([&vertices](const auto &triangle, size_t) {
-        // Get vertices for this triangle
-        const auto &v1 = vertices[triangle[0]];
-        const auto &v2 = vertices[triangle[1]];
-        const auto &v3 = vertices[triangle[2]];
+    return parallel_map(
+        [&vertices](const auto &triangle, size_t) {
+            // Get vertices for this triangle
+            const auto &v1 = vertices[triangle[0]];
+            const auto &v2 = vertices[triangle[1]];
+            const auto &v3 = vertices[triangle[2]];
 
-        return detail::triangle_normal<T>(v1, v2, v3);
-    });
+            return detail::triangle_normal<T>(v1, v2, v3);
+        },
+        triangles);
 }
 
 // Binding functions for pipeline operations
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <dataframe/core/parallel_map.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace df {
+
+    namespace detail {
+
+        // Number of triangles gathered at once into the SoA buffers
+        constexpr size_t triangle_block_size = 64;
+
+        template <size_t N> struct TriangleGeometryOutput {
+            std::vector<double> area;
+            std::vector<Vector<double, N>> centroid;
+            std::vector<Vector3> edge_lengths;
+            std::vector<Vector3> normal;
+            std::vector<uint8_t> degenerate;
+        };
+
+        // Process the triangles [start, start + m), m <= triangle_block_size
+        template <size_t N>
+        void triangle_geometry_block(const Serie<Vector<double, N>>& vertices,
+            const Triangles& triangles, double tolerance, size_t start, size_t m,
+            TriangleGeometryOutput<N>& out)
+        {
+            constexpr size_t B = triangle_block_size;
+            // p[c][d][t]: component d of corner c of triangle start + t
+            double p[3][N][B];
+            double e[3][N][B];
+            double l[3][B];
+            double cr[3][B];
+            double twice_area[B];
+
+            const size_t nv = vertices.size();
+            for (size_t t = 0; t < m; ++t) {
+                const auto& tri = triangles[start + t];
+                for (size_t c = 0; c < 3; ++c) {
+                    if (tri[c] >= nv) {
+                        throw std::out_of_range(concat("triangle_geometry: triangle ", start + t,
+                            " references vertex ", tri[c], " (", nv, " vertices)"));
+                    }
+                    const auto& v = vertices[tri[c]];
+                    for (size_t d = 0; d < N; ++d) {
+                        p[c][d][t] = v[d];
+                    }
+                }
+            }
+
+            // Edges v1 - v0, v2 - v1, v0 - v2 and their lengths
+            for (size_t c = 0; c < 3; ++c) {
+                const size_t c1 = (c + 1) % 3;
+                for (size_t t = 0; t < m; ++t) {
+                    l[c][t] = 0;
+                }
+                for (size_t d = 0; d < N; ++d) {
+                    for (size_t t = 0; t < m; ++t) {
+                        e[c][d][t] = p[c1][d][t] - p[c][d][t];
+                        l[c][t] += e[c][d][t] * e[c][d][t];
+                    }
+                }
+                for (size_t t = 0; t < m; ++t) {
+                    l[c][t] = std::sqrt(l[c][t]);
+                }
+            }
+
+            // (v1 - v0) x (v2 - v0) = -(e0 x e2)
+            if constexpr (N == 3) {
+                for (size_t t = 0; t < m; ++t) {
+                    cr[0][t] = e[0][2][t] * e[2][1][t] - e[0][1][t] * e[2][2][t];
+                    cr[1][t] = e[0][0][t] * e[2][2][t] - e[0][2][t] * e[2][0][t];
+                    cr[2][t] = e[0][1][t] * e[2][0][t] - e[0][0][t] * e[2][1][t];
+                    twice_area[t]
+                        = std::sqrt(cr[0][t] * cr[0][t] + cr[1][t] * cr[1][t] + cr[2][t] * cr[2][t]);
+                }
+            } else {
+                for (size_t t = 0; t < m; ++t) {
+                    twice_area[t] = std::abs(e[0][1][t] * e[2][0][t] - e[0][0][t] * e[2][1][t]);
+                }
+            }
+
+            for (size_t t = 0; t < m; ++t) {
+                const size_t i = start + t;
+                const double lmax = std::max({ l[0][t], l[1][t], l[2][t] });
+                const bool degenerate = twice_area[t] <= tolerance * lmax * lmax;
+
+                out.area[i] = 0.5 * twice_area[t];
+                out.edge_lengths[i] = Vector3 { l[0][t], l[1][t], l[2][t] };
+                out.degenerate[i] = degenerate ? 1 : 0;
+                for (size_t d = 0; d < N; ++d) {
+                    out.centroid[i][d] = (p[0][d][t] + p[1][d][t] + p[2][d][t]) / 3.0;
+                }
+                if constexpr (N == 3) {
+                    if (!degenerate) {
+                        const double inv = 1.0 / twice_area[t];
+                        out.normal[i] = Vector3 { cr[0][t] * inv, cr[1][t] * inv, cr[2][t] * inv };
+                    }
+                }
+            }
+        }
+
+    } // namespace detail
+
+    template <size_t N>
+    inline Dataframe triangle_geometry(
+        const Serie<Vector<double, N>>& vertices, const Triangles& triangles, double tolerance)
+    {
+        static_assert(N == 2 || N == 3, "triangle_geometry requires 2D or 3D vertices");
+
+        const size_t n = triangles.size();
+        detail::TriangleGeometryOutput<N> out;
+        out.area.resize(n);
+        out.centroid.resize(n);
+        out.edge_lengths.resize(n);
+        out.degenerate.resize(n);
+        if constexpr (N == 3) {
+            out.normal.resize(n);
+        }
+
+        const size_t num_blocks
+            = (n + detail::triangle_block_size - 1) / detail::triangle_block_size;
+        const size_t num_chunks = std::min(num_blocks, detail::get_optimal_threads(n));
+        detail::parallel_for_chunks(num_blocks, num_chunks, [&](size_t, size_t begin, size_t end) {
+            for (size_t b = begin; b < end; ++b) {
+                const size_t start = b * detail::triangle_block_size;
+                const size_t m = std::min(detail::triangle_block_size, n - start);
+                detail::triangle_geometry_block<N>(vertices, triangles, tolerance, start, m, out);
+            }
+        });
+
+        // Move the buffers into the Dataframe, without copying them
+        Dataframe result;
+        result.add("area", std::make_shared<Serie<double>>(std::move(out.area)));
+        result.add("centroid", std::make_shared<Serie<Vector<double, N>>>(std::move(out.centroid)));
+        result.add("edge_lengths", std::make_shared<Serie<Vector3>>(std::move(out.edge_lengths)));
+        if constexpr (N == 3) {
+            result.add("normal", std::make_shared<Serie<Vector3>>(std::move(out.normal)));
+        }
+        result.add("degenerate",
+            std::make_shared<Serie<bool>>(
+                std::vector<bool>(out.degenerate.begin(), out.degenerate.end())));
+        return result;
+    }
+
+    template <size_t N> inline auto bind_triangle_geometry(const Triangles& triangles, double tolerance)
+    {
+        return [&triangles, tolerance](const Serie<Vector<double, N>>& vertices) {
+            return triangle_geometry<N>(vertices, triangles, tolerance);
+        };
+    }
+
+} // namespace df
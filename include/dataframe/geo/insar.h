@@ -24,6 +24,7 @@
 #pragma once
 #include <cmath>
 #include <dataframe/Serie.h>
+#include <dataframe/core/parallel_map.h>
 #include <dataframe/geo/types.h>
 
 namespace df {
@@ -53,10 +53,9 @@ namespace df {
      * @endcode
      */
     template <typename T, size_t DIM>
-    Serie<T> idw(const Serie<std::array<T, DIM>>& points, const Serie<T>& values,
-        const Serie<std::array<T, DIM>>& targets, double power = 2.0, double smoothing = 1e-10)
-    {
-        return detail::idw_traits<T, DIM>::idw(points, values, targets, power, smoothing);
-    }
+    Serie<T> idw(const Serie<Vector<double, DIM>>& points, const Serie<T>& values,
+        const Serie<Vector<double, DIM>>& targets, double power = 2.0, double smoothing = 1e-10);
 
-} // namespace df
\ No newline at end of file
+} // namespace df
+
+#include "inline/idw.hxx"
\ No newline at end of file
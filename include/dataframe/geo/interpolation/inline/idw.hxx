@@ -22,7 +22,7 @@
  */
 
 #pragma once
-#include "common.h"
+#include "../common.h"
 #include <cmath>
 #include <vector>
 
@@ -114,7 +114,7 @@ namespace df {
 
         template <typename T> struct idw_traits<T, 2> {
             using type = Vector2;
-            Serie<T> idw(const Serie<type>& points, const Serie<T>& values,
+            static Serie<T> idw(const Serie<type>& points, const Serie<T>& values,
                 const Serie<type>& targets, double power = 2.0, double smoothing = 1e-10)
             {
                 return idw_2d(points, values, targets, power, smoothing);
@@ -123,7 +123,7 @@ namespace df {
 
         template <typename T> struct idw_traits<T, 3> {
             using type = Vector3;
-            Serie<T> idw(const Serie<type>& points, const Serie<T>& values,
+            static Serie<T> idw(const Serie<type>& points, const Serie<T>& values,
                 const Serie<type>& targets, double power = 2.0, double smoothing = 1e-10)
             {
                 return idw_3d(points, values, targets, power, smoothing);
@@ -132,4 +132,11 @@ namespace df {
 
     } // namespace detail
 
+    template <typename T, size_t DIM>
+    inline Serie<T> idw(const Serie<Vector<double, DIM>>& points, const Serie<T>& values,
+        const Serie<Vector<double, DIM>>& targets, double power, double smoothing)
+    {
+        return detail::idw_traits<T, DIM>::idw(points, values, targets, power, smoothing);
+    }
+
 } // namespace df
\ No newline at end of file
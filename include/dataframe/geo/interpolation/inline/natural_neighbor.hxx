@@ -21,213 +21,146 @@
  *
  */
 
-namespace df {
-
-#ifdef USE_CGAL
-
-    /**
-     * @brief Natural Neighbor interpolation for 2D points
-     *
-     * This implementation uses the Sibson's method which is based on the ratio of
-     * stolen areas when inserting a new point into the Voronoi diagram.
-     *
-     * The steps are:
-     * 1. Create Delaunay triangulation of input points
-     * 2. For each target point:
-     *    - Find the natural neighbors (points whose Voronoi cells will be affected)
-     *    - Calculate the areas of overlap between the new and old Voronoi cells
-     *    - Use these areas as weights for interpolation
-     */
-    template <typename T> class NaturalNeighborInterpolator {
-    private:
-        using K = CGAL::Exact_predicates_inexact_constructions_kernel;
-        using Point_2 = K::Point_2;
-        using DT = CGAL::Delaunay_triangulation_2<K>;
-        using Vertex_handle = DT::Vertex_handle;
-        using Polygon_2 = CGAL::Polygon_2<K>;
-
-        DT triangulation;
-        std::map<Vertex_handle, T> values_map;
-
-        /**
-         * @brief Calculate area of a polygon defined by points
-         */
-        double calculate_area(const std::vector<Point_2>& points) const
-        {
-            if (points.size() < 3)
-                return 0.0;
-
-            double area = 0.0;
-            for (size_t i = 0; i < points.size(); ++i) {
-                const Point_2& p1 = points[i];
-                const Point_2& p2 = points[(i + 1) % points.size()];
-                area += (p1.x() * p2.y() - p2.x() * p1.y());
-            }
-            return std::abs(area) / 2.0;
-        }
-
-        /**
-         * @brief Get the vertices of the Voronoi cell for a point
-         */
-        std::vector<Point_2> get_voronoi_cell(const Point_2& p, const Vertex_handle& v) const
-        {
-            std::vector<Point_2> cell;
-
-            // Get circulator of vertices around the point
-            auto start = triangulation.incident_vertices(v);
-            auto curr = start;
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
-            do {
-                if (triangulation.is_infinite(curr))
-                    continue;
-
-                // Get circumcenter (Voronoi vertex)
-                auto face = triangulation.dual(curr);
-                cell.push_back(face);
-
-            } while (++curr != start);
+namespace df {
 
-            return cell;
+    template <typename T>
+    inline NaturalNeighborInterpolator<T>::NaturalNeighborInterpolator(const Serie<Vector2>& points,
+        const Serie<T>& values, NaturalNeighborWeights method)
+        : triangulation_(points)
+        , points_(points.asArray())
+        , values_(values.asArray())
+        , method_(method)
+    {
+        if (points.size() != values.size()) {
+            throw std::runtime_error(concat("natural_neighbor: points (", points.size(),
+                ") and values (", values.size(), ") must have the same size"));
         }
 
-        /**
-         * @brief Calculate intersection area between two Voronoi cells
-         */
-        double calculate_intersection_area(
-            const std::vector<Point_2>& cell1, const std::vector<Point_2>& cell2) const
-        {
-            // Convert vector of points to Polygon_2
-            Polygon_2 polygon1;
-            Polygon_2 polygon2;
-
-            for (const auto& p : cell1)
-                polygon1.push_back(p);
-            for (const auto& p : cell2)
-                polygon2.push_back(p);
-
-            // Calculate intersection
-            auto result = CGAL::intersection(polygon1, polygon2);
-
-            if (result) {
-                if (const Polygon_2* poly = boost::get<Polygon_2>(&*result)) {
-                    std::vector<Point_2> intersection_points;
-                    for (auto v = poly->vertices_begin(); v != poly->vertices_end(); ++v) {
-                        intersection_points.push_back(*v);
-                    }
-                    return calculate_area(intersection_points);
-                }
+        // Average the values of duplicated points
+        const size_t n = points_.size();
+        std::vector<uint32_t> counts(n, 1);
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t r = triangulation_.representative(i);
+            if (r != i) {
+                values_[r] = values_[r] + values_[i];
+                ++counts[r];
             }
-            return 0.0;
         }
-
-    public:
-        /**
-         * @brief Initialize interpolator with input points and values
-         */
-        void initialize(const Serie<Vector2>& points, const Serie<T>& values)
-        {
-            if (points.size() != values.size()) {
-                throw std::runtime_error("Points and values must have same size");
+        for (size_t i = 0; i < n; ++i) {
+            if (counts[i] > 1) {
+                values_[i] = values_[i] * (1.0 / counts[i]);
             }
+        }
 
-            // Insert points into triangulation and store values
-            for (size_t i = 0; i < points.size(); ++i) {
-                const auto& p = points[i];
-                auto vh = triangulation.insert(Point_2(p[0], p[1]));
-                values_map[vh] = values[i];
-            }
+        if (!triangulation_.degenerate() || n == 0) {
+            return;
         }
 
-        /**
-         * @brief Interpolate value at a target point
-         */
-        T interpolate(const Vector2& target)
-        {
-            Point_2 query(target[0], target[1]);
-
-            // Find cell containing the target point
-            auto nearest = triangulation.nearest_vertex(query);
-            if (CGAL::squared_distance(nearest->point(), query) < 1e-10) {
-                return values_map.at(nearest);
+        // Collinear points (or a single location): sort them along their line
+        origin_ = points_[0];
+        for (const auto& p : points_) {
+            const Vector2 d = p - origin_;
+            if (d.norm() > 0) {
+                direction_ = d.normalized();
+                break;
             }
-
-            std::vector<std::pair<Vertex_handle, double>> weights;
-
-            // Insert point temporarily to find natural neighbors
-            auto vh = triangulation.insert(query);
-
-            // Get Voronoi cell of inserted point
-            auto new_cell = get_voronoi_cell(query, vh);
-            double total_area = calculate_area(new_cell);
-
-            // For each natural neighbor
-            auto start = triangulation.incident_vertices(vh);
-            auto curr = start;
-
-            do {
-                if (triangulation.is_infinite(curr))
-                    continue;
-
-                // Calculate stolen area
-                auto old_cell = get_voronoi_cell(curr->point(), curr);
-                double area = calculate_intersection_area(new_cell, old_cell);
-                weights.emplace_back(curr, area / total_area);
-
-            } while (++curr != start);
-
-            // Remove temporary point
-            triangulation.remove(vh);
-
-            // Calculate interpolated value
-            T result = T();
-            for (const auto& [neighbor, weight] : weights) {
-                result += values_map.at(neighbor) * weight;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (triangulation_.representative(i) == i) {
+                line_.emplace_back((points_[i] - origin_).dot(direction_), static_cast<uint32_t>(i));
             }
+        }
+        std::sort(line_.begin(), line_.end());
+    }
 
-            return result;
+    template <typename T> inline T NaturalNeighborInterpolator<T>::fill()
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::numeric_limits<T>::quiet_NaN();
+        } else {
+            return T {};
         }
+    }
 
-        /**
-         * @brief Interpolate values at multiple target points
-         */
-        Serie<T> interpolate(const Serie<Vector2>& targets)
-        {
-            Serie<T> result(targets.size());
+    template <typename T>
+    inline T NaturalNeighborInterpolator<T>::interpolateOnLine(const Vector2& target) const
+    {
+        const Vector2 d = target - origin_;
+        const double t = d.dot(direction_);
+        const double extent = std::max(line_.back().first - line_.front().first, 1.0);
+        const double tolerance = 1e-9 * extent;
+
+        const Vector2 offset = d - direction_ * t;
+        if (offset.norm() > tolerance || t < line_.front().first - tolerance
+            || t > line_.back().first + tolerance) {
+            return fill();
+        }
+        if (line_.size() == 1) {
+            return values_[line_[0].second];
+        }
 
-#pragma omp parallel for if (targets.size() > 1000)
-            for (size_t i = 0; i < targets.size(); ++i) {
-                result[i] = interpolate(targets[i]);
-            }
+        auto it = std::upper_bound(line_.begin(), line_.end(), std::make_pair(t, uint32_t(0)),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+        const size_t k = std::clamp<size_t>(it - line_.begin(), 1, line_.size() - 1);
+        const auto& [t0, i0] = line_[k - 1];
+        const auto& [t1, i1] = line_[k];
+        const double s = std::clamp((t - t0) / (t1 - t0), 0.0, 1.0);
+        return values_[i0] * (1.0 - s) + values_[i1] * s;
+    }
 
-            return result;
+    template <typename T>
+    inline T NaturalNeighborInterpolator<T>::interpolate(const Vector2& target, NaturalNeighbors& nn) const
+    {
+        if (triangulation_.degenerate()) {
+            return line_.empty() ? fill() : interpolateOnLine(target);
+        }
+        if (!triangulation_.naturalNeighbors(target, nn, method_)) {
+            return fill();
         }
-    };
+        T result = values_[nn.vertices[0]] * nn.weights[0];
+        for (size_t k = 1; k < nn.vertices.size(); ++k) {
+            result = result + values_[nn.vertices[k]] * nn.weights[k];
+        }
+        return result;
+    }
 
-    /**
-     * @brief Convenience function for natural neighbor interpolation
-     */
     template <typename T>
-    inline Serie<T> natural_neighbor_2d(
-        const Serie<Vector2>& points, const Serie<T>& values, const Serie<Vector2>& targets)
+    inline T NaturalNeighborInterpolator<T>::interpolate(const Vector2& target) const
     {
-        NaturalNeighborInterpolator<T> interpolator;
-        interpolator.initialize(points, values);
-        return interpolator.interpolate(targets);
+        NaturalNeighbors nn;
+        return interpolate(target, nn);
     }
 
-#else
-
-    /**
-     * @brief Natural neighbor interpolation. This function is empty as CGAL is not
-     * used
-     */
     template <typename T>
-    inline Serie<T> natural_neighbor_2d(
-        const Serie<Vector2>&, const Serie<T>&, const Serie<Vector2>&)
+    inline Serie<T> NaturalNeighborInterpolator<T>::interpolate(const Serie<Vector2>& targets) const
     {
-        return Serie<T>();
+        const size_t n = targets.size();
+        std::vector<T> result(n);
+        const auto& positions = targets.data();
+
+        // One walk state per chunk: each walk starts where the previous one
+        // ended
+        detail::parallel_for_chunks(
+            n, detail::get_optimal_threads(n), [&](size_t, size_t start, size_t end) {
+                NaturalNeighbors nn;
+                for (size_t i = start; i < end; ++i) {
+                    result[i] = interpolate(positions[i], nn);
+                }
+            });
+
+        return Serie<T>(std::move(result));
     }
 
-#endif
+    template <typename T>
+    inline Serie<T> natural_neighbor_2d(const Serie<Vector2>& points, const Serie<T>& values,
+        const Serie<Vector2>& targets, NaturalNeighborWeights method)
+    {
+        return NaturalNeighborInterpolator<T>(points, values, method).interpolate(targets);
+    }
 
-} // namespace df
\ No newline at end of file
+} // namespace df
@@ -22,53 +22,78 @@
  */
 
 #pragma once
-#ifdef USE_CGAL
-#include <CGAL/Delaunay_triangulation_2.h>
-#include <CGAL/Delaunay_triangulation_adaptation_policies_2.h>
-#include <CGAL/Delaunay_triangulation_adaptation_traits_2.h>
-#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
-#include <CGAL/Polygon_2.h>
-#include <CGAL/Voronoi_diagram_2.h>
-#include <CGAL/intersections.h>
-#endif
 #include <dataframe/Serie.h>
-#include <map>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/geo/mesh/delaunay.h>
 #include <vector>
 
 namespace df {
 
-#ifdef USE_CGAL
-
     /**
-     * @brief Natural Neighbor interpolation for 2D points. This function uses the
-     * CGAL library.
+     * @brief Natural neighbor interpolation of scattered 2D data.
+     *
+     * The Delaunay triangulation of the points (see Delaunay2D) is built once
+     * in the constructor and shared by all the queries. For each target, the
+     * natural neighbors are found by walking from the previous target's
+     * triangle, and weighted either by Sibson's stolen areas or by Laplace's
+     * (non-Sibsonian) ratios. Both reproduce linear functions exactly and
+     * interpolate the data. Batches of targets are split into chunks
+     * interpolated in parallel.
+     *
+     * Targets outside the convex hull of the points get NaN (floating point
+     * values) or T{}. Values at duplicated points are averaged. If all the
+     * points are collinear, the interpolation is linear along their line.
      *
-     * This implementation uses the Sibson's method which is based on the ratio of
-     * stolen areas when inserting a new point into the Voronoi diagram.
+     * T must support `T * double` and `T + T` (scalars, Vector2, Vector3...).
      *
-     * The steps are:
-     * 1. Create Delaunay triangulation of input points
-     * 2. For each target point:
-     *    - Find the natural neighbors (points whose Voronoi cells will be affected)
-     *    - Calculate the areas of overlap between the new and old Voronoi cells
-     *    - Use these areas as weights for interpolation
+     * @code
+     * df::NaturalNeighborInterpolator<double> nn(points, values);
+     * auto grid_values = nn.interpolate(grid_nodes);
+     * @endcode
      */
-    template <typename T>
-    Serie<T> natural_neighbor_2d(
-        const Serie<Vector2>& points, const Serie<T>& values, const Serie<Vector2>& targets);
+    template <typename T> class NaturalNeighborInterpolator {
+    public:
+        NaturalNeighborInterpolator(const Serie<Vector2>& points, const Serie<T>& values,
+            NaturalNeighborWeights method = NaturalNeighborWeights::Sibson);
+
+        /**
+         * @brief Interpolated value at one target
+         */
+        T interpolate(const Vector2& target) const;
 
-#else
+        /**
+         * @brief Interpolated values at many targets (in parallel). Consecutive
+         * targets should be close to each other (e.g. the nodes of a grid, row
+         * by row) for the point location to be fast.
+         */
+        Serie<T> interpolate(const Serie<Vector2>& targets) const;
+
+        const Delaunay2D& triangulation() const { return triangulation_; }
+
+    private:
+        T interpolate(const Vector2& target, NaturalNeighbors& nn) const;
+        T interpolateOnLine(const Vector2& target) const;
+        static T fill();
+
+        Delaunay2D triangulation_;
+        std::vector<Vector2> points_;
+        std::vector<T> values_; // averaged over duplicates, indexed by representative
+        NaturalNeighborWeights method_;
+
+        // Collinear points: positions along the line, sorted
+        std::vector<std::pair<double, uint32_t>> line_;
+        Vector2 origin_ { 0, 0 }, direction_ { 0, 0 };
+    };
 
     /**
-     * @brief Natural neighbor interpolation. This function is empty as CGAL is not
-     * used. Enable this feature by using `cmake -DUSE_CGAL=ON ..` in your
-     * `build`directory.
+     * @brief Natural neighbor interpolation of (points, values) at targets.
+     * @see NaturalNeighborInterpolator
      */
     template <typename T>
-    Serie<T> natural_neighbor_2d(const Serie<Vector2>&, const Serie<T>&, const Serie<Vector2>&);
-
-#endif
+    Serie<T> natural_neighbor_2d(const Serie<Vector2>& points, const Serie<T>& values,
+        const Serie<Vector2>& targets,
+        NaturalNeighborWeights method = NaturalNeighborWeights::Sibson);
 
 } // namespace df
 
-#include "inline/natural_neighbor.hxx"
\ No newline at end of file
+#include "inline/natural_neighbor.hxx"
@@ -37,7 +37,18 @@ namespace df {
         double value;
     };
 
+    /**
+     * @brief Polyline made of stitched IsoSegments. For a closed line, the
+     * last point is the first one.
+     */
+    template <size_t N> struct IsoLine {
+        std::vector<Vector<double, N>> points;
+        double value = 0;
+        bool closed = false;
+    };
+
     template <size_t N> std::ostream& operator<<(std::ostream& os, const IsoSegment<N>& seg);
+    template <size_t N> std::ostream& operator<<(std::ostream& os, const IsoLine<N>& line);
 
     /**
      * @brief Compute iso-contours for a given iso-value on a triangulated mesh
@@ -66,7 +77,12 @@ namespace df {
         const Mesh<N>& mesh, const std::string& attributeName, double isoValue);
 
     /**
-     * @brief Same as contours but using multiple iso values
+     * @brief Same as contours but using multiple iso values.
+     *
+     * All the iso values are handled in one parallel pass over the
+     * triangles: the levels crossed by a triangle are found by binary search
+     * in the sorted iso values. Segments are grouped by iso value (in the
+     * given order), and sorted by triangle index within a group.
      */
     template <size_t N>
     Serie<IsoSegment<N>> contours(const Mesh<N>& mesh, const std::string& attributeName,
@@ -79,6 +95,30 @@ namespace df {
     Serie<IsoSegment<N>> contours(
         const Mesh<N>& mesh, const std::string& attributeName, const Serie<double>& isoValues);
 
+    /**
+     * @brief Same as contours, but the segments are stitched into polylines
+     * (through the mesh edges they cut), one iso value per parallel task.
+     * Lines are grouped by iso value, in the given order.
+     *
+     * @code
+     * auto lines = isolines(mesh, "temperature", generateIsosByNumber(0, 100, 100));
+     * for (const auto& line : lines) {
+     *     // line.points, line.value, line.closed
+     * }
+     * @endcode
+     */
+    template <size_t N>
+    Serie<IsoLine<N>> isolines(
+        const Mesh<N>& mesh, const std::string& attributeName, double isoValue);
+
+    template <size_t N>
+    Serie<IsoLine<N>> isolines(const Mesh<N>& mesh, const std::string& attributeName,
+        const std::vector<double>& isoValues);
+
+    template <size_t N>
+    Serie<IsoLine<N>> isolines(
+        const Mesh<N>& mesh, const std::string& attributeName, const Serie<double>& isoValues);
+
     // -----------------------------------------------------------------------------
     // Helper functions
     // -----------------------------------------------------------------------------
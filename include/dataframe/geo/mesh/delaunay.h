@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <dataframe/Serie.h>
+#include <dataframe/geo/types.h>
+#include <limits>
+#include <vector>
+
+namespace df {
+
+    enum class NaturalNeighborWeights {
+        Sibson, // area stolen from each neighbor's Voronoi cell (C1 away from the data)
+        Laplace // Voronoi edge length over distance (non-Sibsonian, cheaper)
+    };
+
+    /**
+     * @brief Natural neighbors of a query point and their weights (summing to
+     * one). Also holds the state of the walk and scratch buffers: keep one per
+     * thread and reuse it for consecutive (nearby) queries.
+     */
+    struct NaturalNeighbors {
+        std::vector<uint32_t> vertices;
+        std::vector<double> weights;
+
+        // Triangle where the last walk ended (warm start of the next one)
+        uint32_t hint = 0;
+
+        // Scratch buffers
+        std::vector<uint32_t> cavity;
+        std::vector<std::array<uint32_t, 3>> boundary; // (a, b, cavity triangle)
+        std::vector<Vector2> polygon;
+    };
+
+    /**
+     * @brief 2D Delaunay triangulation, built once and queried many times.
+     *
+     * Incremental Bowyer-Watson insertion in Hilbert curve order (so that each
+     * point is located by a short walk from the previous one). The convex hull
+     * is closed by "ghost" triangles sharing a virtual vertex at infinity, so
+     * there is no super-triangle distorting the triangulation near the hull.
+     * Duplicated points are merged (see representative).
+     *
+     * Point location is a visibility walk starting from a hint triangle, which
+     * makes coherent queries (e.g. the nodes of a grid) almost O(1) each.
+     * The query methods are const and thread-safe.
+     *
+     * @code
+     * df::Delaunay2D dt(points);
+     * df::Mesh2D mesh(points, dt.triangles());
+     *
+     * df::NaturalNeighbors nn;
+     * if (dt.naturalNeighbors({0.5, 0.5}, nn)) {
+     *     for (size_t k = 0; k < nn.vertices.size(); ++k) { ... nn.weights[k] ... }
+     * }
+     * @endcode
+     */
+    class Delaunay2D {
+    public:
+        static constexpr uint32_t infinite = std::numeric_limits<uint32_t>::max();
+
+        Delaunay2D() = default;
+        explicit Delaunay2D(const Serie<Vector2>& points);
+
+        size_t vertexCount() const { return points_.size(); }
+
+        /**
+         * @brief True if the points are all collinear (or fewer than 3 distinct
+         * points): there is no triangle.
+         */
+        bool degenerate() const { return triangles_.empty(); }
+
+        /**
+         * @brief Finite triangles, counter-clockwise
+         */
+        Triangles triangles() const;
+
+        /**
+         * @brief Index of the point that point i was merged with (i itself if
+         * it is not a duplicate)
+         */
+        uint32_t representative(size_t i) const { return representative_[i]; }
+
+        /**
+         * @brief Natural neighbors of p. Returns false if p is outside the
+         * convex hull of the points (or if the triangulation is degenerate).
+         * On a data point, the weights are a single 1; on the hull boundary,
+         * they are linear along the hull edge.
+         */
+        bool naturalNeighbors(const Vector2& p, NaturalNeighbors& result,
+            NaturalNeighborWeights method = NaturalNeighborWeights::Sibson) const;
+
+        /**
+         * @brief Triangle containing p, found by walking from `hint`. Returns a
+         * ghost triangle (see isGhost) if p is outside the convex hull.
+         */
+        uint32_t locate(const Vector2& p, uint32_t hint = 0) const;
+
+        bool isGhost(uint32_t t) const { return triangles_[t].v[2] == infinite; }
+
+    private:
+        struct Triangle {
+            std::array<uint32_t, 3> v; // counter-clockwise; ghost: v[2] == infinite
+            std::array<uint32_t, 3> n; // n[i]: neighbor across the edge opposite to v[i]
+        };
+
+        bool inConflict(const Triangle& t, const Vector2& p) const;
+        void insert(uint32_t index, uint32_t& hint, std::vector<uint32_t>& cavity,
+            std::vector<std::array<uint32_t, 3>>& boundary, std::vector<uint32_t>& mark,
+            uint32_t& stamp);
+        void compact();
+
+        std::vector<Vector2> points_;
+        std::vector<uint32_t> representative_;
+        std::vector<Triangle> triangles_;
+        std::vector<uint32_t> free_;
+    };
+
+} // namespace df
+
+#include "inline/delaunay.hxx"
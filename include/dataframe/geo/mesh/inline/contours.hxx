@@ -21,6 +21,12 @@
  *
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/flat_hash.h>
+#include <iterator>
+
 namespace df {
 
 namespace detail {
@@ -66,104 +72,264 @@ inline std::ostream &operator<<(std::ostream &os, const IsoSegment<N> &seg) {
 }
 
 template <size_t N>
-inline Serie<IsoSegment<N>> contours(const Mesh<N> &mesh,
-                                     const std::string &attributeName,
-                                     double isovalue) {
-    const auto &values = mesh.template vertexAttribute<double>(attributeName);
-    const auto &vertices = mesh.vertices();
-    const auto &triangles = mesh.triangles();
+inline std::ostream &operator<<(std::ostream &os, const IsoLine<N> &line) {
+    os << "IsoLine(" << line.points.size() << " points, "
+       << (line.closed ? "closed" : "open") << "), value(" << line.value
+       << ")";
+    return os;
+}
 
-    // Store triangle indices and their codes
-    std::map<size_t, int> tri2code;
-    std::map<int, std::map<int, std::vector<size_t>>> connectivity;
+namespace detail {
 
-    // First pass: identify triangles crossed by isolines
-    // TODO: optimization using kdtree or something else
-    for (size_t i = 0; i < triangles.size(); ++i) {
-        const auto &tri = triangles[i];
+// Mesh edge (vmin, vmax) packed in 64 bits
+inline uint64_t contour_edge_key(uint32_t a, uint32_t b) {
+    return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+}
 
-        double p0 = values[tri[0]];
-        double p1 = values[tri[1]];
-        double p2 = values[tri[2]];
+/**
+ * Segments of all the iso-values, grouped by iso-value (in the given
+ * order), each group being sorted by triangle index. edges[i] holds the
+ * two mesh edges cut by segment i.
+ */
+template <size_t N> struct ContourSegments {
+    std::vector<IsoSegment<N>> segments;
+    std::vector<std::array<uint64_t, 2>> edges;
+    std::vector<size_t> offsets; // group k is [offsets[k], offsets[k+1])
+};
+
+/**
+ * One pass over the triangles for all the iso-values: the levels crossed by
+ * a triangle are found by binary search of its [min, max] range in the
+ * sorted levels. A first parallel pass counts the segments per (chunk,
+ * level), a second one writes them at their final position.
+ */
+template <size_t N>
+ContourSegments<N> contour_segments(const Mesh<N> &mesh,
+                                    const std::string &attributeName,
+                                    const std::vector<double> &isoValues,
+                                    bool withEdges) {
+    const auto &values = mesh.template vertexAttribute<double>(attributeName);
+    const auto &vertices = mesh.vertices();
+    const auto &triangles = mesh.triangles();
 
-        // Skip if values are outside bounds
-        double minVal = std::min({p0, p1, p2});
-        double maxVal = std::max({p0, p1, p2});
-        if (!detail::ok(p0, p1, p2, minVal, maxVal))
-            continue;
+    // Sorted unique levels, and the level of each iso-value
+    std::vector<double> levels;
+    for (double iso : isoValues) {
+        if (!std::isnan(iso)) {
+            levels.push_back(iso);
+        }
+    }
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    const size_t nlevels = levels.size();
+
+    constexpr size_t none = static_cast<size_t>(-1);
+    std::vector<std::vector<size_t>> isos_of_level(nlevels);
+    for (size_t k = 0; k < isoValues.size(); ++k) {
+        if (!std::isnan(isoValues[k])) {
+            const size_t level =
+                std::lower_bound(levels.begin(), levels.end(), isoValues[k]) -
+                levels.begin();
+            isos_of_level[level].push_back(k);
+        }
+    }
 
-        int t1 = (p0 >= isovalue) ? 1 : 0;
-        int t2 = (p1 >= isovalue) ? 1 : 0;
-        int t3 = (p2 >= isovalue) ? 1 : 0;
+    // Levels crossed by triangle t: [first, last). A triangle is crossed
+    // by L when min < L <= max (codes 1 to 6 of the lookup table).
+    auto crossed = [&](size_t t, size_t &first, size_t &last) {
+        const auto &tri = triangles[t];
+        const double p0 = values[tri[0]], p1 = values[tri[1]],
+                     p2 = values[tri[2]];
+        if (std::isnan(p0) || std::isnan(p1) || std::isnan(p2)) {
+            first = last = 0;
+            return;
+        }
+        const double mn = std::min({p0, p1, p2});
+        const double mx = std::max({p0, p1, p2});
+        first = std::upper_bound(levels.begin(), levels.end(), mn) -
+                levels.begin();
+        last = std::upper_bound(levels.begin() + first, levels.end(), mx) -
+               levels.begin();
+    };
 
-        int tri_code = t1 * 4 + t2 * 2 + t3;
+    const size_t ntri = triangles.size();
+    const size_t num_chunks = nlevels == 0 ? 1 : get_optimal_threads(ntri);
+
+    // 1) Count
+    std::vector<std::vector<size_t>> counts(num_chunks,
+                                            std::vector<size_t>(nlevels, 0));
+    parallel_for_chunks(ntri, num_chunks,
+                        [&](size_t chunk, size_t start, size_t end) {
+                            auto &count = counts[chunk];
+                            size_t first, last;
+                            for (size_t t = start; t < end; ++t) {
+                                crossed(t, first, last);
+                                for (size_t l = first; l < last; ++l) {
+                                    ++count[l];
+                                }
+                            }
+                        });
+
+    // Output layout: one group per iso-value, chunks in order within a group
+    std::vector<size_t> level_size(nlevels, 0);
+    for (size_t c = 0; c < num_chunks; ++c) {
+        for (size_t l = 0; l < nlevels; ++l) {
+            const size_t n = counts[c][l];
+            counts[c][l] = level_size[l]; // exclusive prefix over chunks
+            level_size[l] += n;
+        }
+    }
 
-        if (tri_code > 0 && tri_code < 7) {
-            tri2code[i] = tri_code;
-            std::array<int, 2> cut_edges = {detail::lookupTable0[tri_code][0],
-                                            detail::lookupTable0[tri_code][1]};
+    ContourSegments<N> result;
+    result.offsets.assign(isoValues.size() + 1, 0);
+    std::vector<size_t> level_of_iso(isoValues.size(), none);
+    for (size_t l = 0; l < nlevels; ++l) {
+        for (size_t k : isos_of_level[l]) {
+            level_of_iso[k] = l;
+        }
+    }
+    for (size_t k = 0; k < isoValues.size(); ++k) {
+        result.offsets[k + 1] =
+            result.offsets[k] +
+            (level_of_iso[k] == none ? 0 : level_size[level_of_iso[k]]);
+    }
+    result.segments.resize(result.offsets.back());
+    if (withEdges) {
+        result.edges.resize(result.offsets.back());
+    }
 
-            // Build connectivity
-            for (int e = 0; e < 2; ++e) {
-                int v0 = tri[cut_edges[e]];
-                int v1 = tri[(cut_edges[e] + 1) % 3];
+    // 2) Fill
+    parallel_for_chunks(
+        ntri, num_chunks, [&](size_t chunk, size_t start, size_t end) {
+            auto &cursor = counts[chunk];
+            size_t first, last;
+            for (size_t t = start; t < end; ++t) {
+                crossed(t, first, last);
+                const auto &tri = triangles[t];
+                for (size_t l = first; l < last; ++l) {
+                    const double iso = levels[l];
+                    const int code = (values[tri[0]] >= iso ? 4 : 0) +
+                                     (values[tri[1]] >= iso ? 2 : 0) +
+                                     (values[tri[2]] >= iso ? 1 : 0);
+
+                    // Both triangles sharing an edge interpolate it in the
+                    // same (vmin, vmax) order, so that the points match
+                    // exactly when stitching
+                    IsoSegment<N> segment;
+                    std::array<uint64_t, 2> keys;
+                    for (int e = 0; e < 2; ++e) {
+                        const int cut = lookupTable0[code][e];
+                        const uint32_t a = tri[cut], b = tri[(cut + 1) % 3];
+                        const uint32_t v0 = std::min(a, b), v1 = std::max(a, b);
+                        auto p = interpolateVertex(vertices[v0], vertices[v1],
+                                                   values[v0], values[v1], iso);
+                        (e == 0 ? segment.p1 : segment.p2) = p;
+                        keys[e] = contour_edge_key(v0, v1);
+                    }
+                    segment.value = iso;
+
+                    const size_t local = cursor[l]++;
+                    for (size_t k : isos_of_level[l]) {
+                        result.segments[result.offsets[k] + local] = segment;
+                        if (withEdges) {
+                            result.edges[result.offsets[k] + local] = keys;
+                        }
+                    }
+                }
+            }
+        });
 
-                int vmin = std::min(v0, v1);
-                int vmax = std::max(v0, v1);
+    return result;
+}
 
-                connectivity[vmin][vmax].push_back(i);
-            }
+/**
+ * Chain the segments [begin, end) of one iso-value into polylines, using a
+ * flat (edge key -> segments) hash table. Each cut edge is shared by at most
+ * two segments on a manifold mesh.
+ */
+template <size_t N>
+void stitch_segments(const ContourSegments<N> &cs, size_t begin, size_t end,
+                     double value, std::vector<IsoLine<N>> &lines) {
+    constexpr uint32_t none = static_cast<uint32_t>(-1);
+    const size_t n = end - begin;
+
+    FlatHashMap<uint64_t, std::array<uint32_t, 2>> edge_segments(n + 2);
+    for (size_t i = 0; i < n; ++i) {
+        for (uint64_t key : cs.edges[begin + i]) {
+            auto [slot, inserted] =
+                edge_segments.try_emplace(key, {none, none});
+            auto &s = *slot;
+            (s[0] == none ? s[0] : s[1]) = static_cast<uint32_t>(i);
         }
     }
 
-    Serie<IsoSegment<N>> segments;
-
-    // Extract connected components
-    while (!tri2code.empty()) {
-        std::vector<Vector<double, N>> isoline;
-        std::vector<double> values_t;
-
-        size_t first_tri = tri2code.begin()->first;
-        int code = tri2code[first_tri];
-        tri2code.erase(first_tri);
+    // The other segment sharing edge key with segment i
+    auto neighbor = [&](uint32_t i, uint64_t key) {
+        const auto &s = *edge_segments.find(key);
+        return s[0] == i ? s[1] : s[0];
+    };
 
-        if (code < 1 || code > 6)
+    std::vector<uint8_t> visited(n, 0);
+    for (uint32_t seed = 0; seed < n; ++seed) {
+        if (visited[seed]) {
             continue;
-
-        const auto &tri = triangles[first_tri];
-        std::array<int, 2> cut_edges = {detail::lookupTable0[code][0],
-                                        detail::lookupTable0[code][1]};
-
-        // Process first triangle
-        for (int e = 0; e < 2; ++e) {
-            int v0 = tri[cut_edges[e]];
-            int v1 = tri[(cut_edges[e] + 1) % 3];
-
-            Vector<double, N> p = detail::interpolateVertex(
-                vertices[v0], vertices[v1], values[v0], values[v1], isovalue);
-
-            isoline.push_back(p);
+        }
+        visited[seed] = 1;
+
+        // Walk from the seed through its edge `side`, collecting points
+        auto walk = [&](int side, std::vector<Vector<double, N>> &points) {
+            uint32_t current = seed;
+            uint64_t key = cs.edges[begin + seed][side];
+            while (true) {
+                const uint32_t next = neighbor(current, key);
+                if (next == none || visited[next]) {
+                    return next == seed;
+                }
+                visited[next] = 1;
+                const auto &edges = cs.edges[begin + next];
+                const auto &segment = cs.segments[begin + next];
+                const bool forward = edges[0] == key;
+                points.push_back(forward ? segment.p2 : segment.p1);
+                key = forward ? edges[1] : edges[0];
+                current = next;
+            }
+        };
+
+        IsoLine<N> line;
+        line.value = value;
+        std::vector<Vector<double, N>> after, before;
+        // A closed loop comes back to the seed, its last point being the
+        // first one
+        line.closed = walk(1, after);
+        if (!line.closed) {
+            walk(0, before);
         }
 
-        // Connect segments
-        segments.add({isoline[0], isoline[1], isovalue});
+        const auto &seed_segment = cs.segments[begin + seed];
+        line.points.reserve(before.size() + after.size() + 2);
+        line.points.insert(line.points.end(), before.rbegin(), before.rend());
+        line.points.push_back(seed_segment.p1);
+        line.points.push_back(seed_segment.p2);
+        line.points.insert(line.points.end(), after.begin(), after.end());
+        lines.push_back(std::move(line));
     }
+}
 
-    return segments;
+} // namespace detail
+
+template <size_t N>
+inline Serie<IsoSegment<N>> contours(const Mesh<N> &mesh,
+                                     const std::string &attributeName,
+                                     double isovalue) {
+    return contours(mesh, attributeName, std::vector<double>{isovalue});
 }
 
 template <size_t N>
 inline Serie<IsoSegment<N>> contours(const Mesh<N> &mesh,
                                      const std::string &attributeName,
                                      const std::vector<double> &isoValues) {
-    Serie<IsoSegment<N>> allSegments;
-    for (double isoValue : isoValues) {
-        auto segments = contours(mesh, attributeName, isoValue);
-        for (size_t i = 0; i < segments.size(); ++i) {
-            allSegments.add(segments[i]);
-        }
-    }
-    return allSegments;
+    auto cs = detail::contour_segments(mesh, attributeName, isoValues, false);
+    return Serie<IsoSegment<N>>(cs.segments);
 }
 
 template <size_t N>
@@ -173,6 +339,46 @@ Serie<IsoSegment<N>> contours(const Mesh<N> &mesh,
     return contours(mesh, attributeName, isoValues.asArray());
 }
 
+template <size_t N>
+inline Serie<IsoLine<N>> isolines(const Mesh<N> &mesh,
+                                  const std::string &attributeName,
+                                  const std::vector<double> &isoValues) {
+    auto cs = detail::contour_segments(mesh, attributeName, isoValues, true);
+
+    // One task per iso-value
+    const size_t nisos = isoValues.size();
+    std::vector<std::vector<IsoLine<N>>> lines(nisos);
+    const size_t num_chunks = std::min(
+        nisos, detail::get_optimal_threads(cs.segments.size()));
+    detail::parallel_for_chunks(
+        nisos, num_chunks, [&](size_t, size_t start, size_t end) {
+            for (size_t k = start; k < end; ++k) {
+                detail::stitch_segments(cs, cs.offsets[k], cs.offsets[k + 1],
+                                        isoValues[k], lines[k]);
+            }
+        });
+
+    std::vector<IsoLine<N>> all;
+    for (auto &l : lines) {
+        std::move(l.begin(), l.end(), std::back_inserter(all));
+    }
+    return Serie<IsoLine<N>>(all);
+}
+
+template <size_t N>
+inline Serie<IsoLine<N>> isolines(const Mesh<N> &mesh,
+                                  const std::string &attributeName,
+                                  double isoValue) {
+    return isolines(mesh, attributeName, std::vector<double>{isoValue});
+}
+
+template <size_t N>
+inline Serie<IsoLine<N>> isolines(const Mesh<N> &mesh,
+                                  const std::string &attributeName,
+                                  const Serie<double> &isoValues) {
+    return isolines(mesh, attributeName, isoValues.asArray());
+}
+
 // -------------------------------------------------
 // HELPERS
 
@@ -0,0 +1,512 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace df {
+
+    namespace detail {
+
+        inline double dt_orient(const Vector2& a, const Vector2& b, const Vector2& c)
+        {
+            return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+        }
+
+        // > 0 if d is strictly inside the circumcircle of the counter-clockwise
+        // triangle (a, b, c). Relative to d and in extended precision, which
+        // keeps the sign right for nearly cocircular points (e.g. grids).
+        inline double dt_incircle(const Vector2& a, const Vector2& b, const Vector2& c, const Vector2& d)
+        {
+            const long double adx = a[0] - d[0], ady = a[1] - d[1];
+            const long double bdx = b[0] - d[0], bdy = b[1] - d[1];
+            const long double cdx = c[0] - d[0], cdy = c[1] - d[1];
+            const long double det = (adx * adx + ady * ady) * (bdx * cdy - bdy * cdx)
+                + (bdx * bdx + bdy * bdy) * (cdx * ady - cdy * adx)
+                + (cdx * cdx + cdy * cdy) * (adx * bdy - ady * bdx);
+            return static_cast<double>(det);
+        }
+
+        inline Vector2 dt_circumcenter(const Vector2& a, const Vector2& b, const Vector2& c)
+        {
+            const double bx = b[0] - a[0], by = b[1] - a[1];
+            const double cx = c[0] - a[0], cy = c[1] - a[1];
+            const double d = 2.0 * (bx * cy - by * cx);
+            const double b2 = bx * bx + by * by;
+            const double c2 = cx * cx + cy * cy;
+            return Vector2 { a[0] + (cy * b2 - by * c2) / d, a[1] + (bx * c2 - cx * b2) / d };
+        }
+
+        inline bool dt_same(const Vector2& a, const Vector2& b) { return a[0] == b[0] && a[1] == b[1]; }
+
+        // Index of (x, y) along a Hilbert curve filling [0, 2^16)^2
+        inline uint64_t hilbert_index(uint32_t x, uint32_t y)
+        {
+            const uint32_t n = 1u << 16;
+            uint64_t d = 0;
+            for (uint32_t s = n / 2; s > 0; s /= 2) {
+                const uint32_t rx = (x & s) > 0 ? 1 : 0;
+                const uint32_t ry = (y & s) > 0 ? 1 : 0;
+                d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+                if (ry == 0) {
+                    if (rx == 1) {
+                        x = n - 1 - x;
+                        y = n - 1 - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return d;
+        }
+
+        constexpr uint32_t dt_dead = std::numeric_limits<uint32_t>::max() - 1;
+
+    } // namespace detail
+
+    inline Delaunay2D::Delaunay2D(const Serie<Vector2>& points)
+        : points_(points.asArray())
+        , representative_(points.size())
+    {
+        const size_t n = points_.size();
+        std::iota(representative_.begin(), representative_.end(), 0u);
+        if (n < 3) {
+            return;
+        }
+        if (n >= infinite - 1) {
+            throw std::runtime_error(concat("Delaunay2D: too many points (", n, ")"));
+        }
+
+        // Insertion order along a Hilbert curve
+        Vector2 lo = points_[0], hi = points_[0];
+        for (const auto& p : points_) {
+            for (size_t d = 0; d < 2; ++d) {
+                lo[d] = std::min(lo[d], p[d]);
+                hi[d] = std::max(hi[d], p[d]);
+            }
+        }
+        const double scale = 65535.0 / std::max({ hi[0] - lo[0], hi[1] - lo[1], 1e-300 });
+        std::vector<std::pair<uint64_t, uint32_t>> keys(n);
+        for (size_t i = 0; i < n; ++i) {
+            const auto x = static_cast<uint32_t>((points_[i][0] - lo[0]) * scale);
+            const auto y = static_cast<uint32_t>((points_[i][1] - lo[1]) * scale);
+            keys[i] = { detail::hilbert_index(x, y), static_cast<uint32_t>(i) };
+        }
+        std::sort(keys.begin(), keys.end());
+
+        // First triangle: first point, first different point, first point not
+        // collinear with them
+        const uint32_t a = keys[0].second;
+        uint32_t b = infinite, c = infinite;
+        for (const auto& [key, i] : keys) {
+            if (b == infinite) {
+                if (!detail::dt_same(points_[i], points_[a])) {
+                    b = i;
+                }
+            } else if (detail::dt_orient(points_[a], points_[b], points_[i]) != 0) {
+                c = i;
+                break;
+            }
+        }
+        if (c == infinite) {
+            return; // collinear
+        }
+        if (detail::dt_orient(points_[a], points_[b], points_[c]) < 0) {
+            std::swap(b, c);
+        }
+
+        // One finite triangle and the three ghosts around it
+        triangles_.push_back({ { a, b, c }, { 1, 2, 3 } });
+        triangles_.push_back({ { c, b, infinite }, { 3, 2, 0 } });
+        triangles_.push_back({ { a, c, infinite }, { 1, 3, 0 } });
+        triangles_.push_back({ { b, a, infinite }, { 2, 1, 0 } });
+
+        std::vector<uint32_t> cavity;
+        std::vector<std::array<uint32_t, 3>> boundary;
+        std::vector<uint32_t> mark;
+        uint32_t stamp = 0;
+        uint32_t hint = 0;
+        for (const auto& [key, i] : keys) {
+            if (i != a && i != b && i != c) {
+                insert(i, hint, cavity, boundary, mark, stamp);
+            }
+        }
+        compact();
+    }
+
+    inline bool Delaunay2D::inConflict(const Triangle& t, const Vector2& p) const
+    {
+        const auto& a = points_[t.v[0]];
+        const auto& b = points_[t.v[1]];
+        if (t.v[2] == infinite) {
+            // Ghost: p is beyond the hull edge (a, b), or on it
+            const double o = detail::dt_orient(a, b, p);
+            if (o != 0) {
+                return o > 0;
+            }
+            return (p[0] - a[0]) * (b[0] - a[0]) + (p[1] - a[1]) * (b[1] - a[1]) > 0
+                && (p[0] - b[0]) * (a[0] - b[0]) + (p[1] - b[1]) * (a[1] - b[1]) > 0;
+        }
+        return detail::dt_incircle(a, b, points_[t.v[2]], p) > 0;
+    }
+
+    inline uint32_t Delaunay2D::locate(const Vector2& p, uint32_t hint) const
+    {
+        uint32_t t = hint < triangles_.size() && triangles_[hint].v[0] != detail::dt_dead ? hint : 0;
+        if (isGhost(t)) {
+            t = triangles_[t].n[2];
+        }
+
+        // Visibility walk, the first edge tested being chosen pseudo-randomly
+        // so that the walk cannot cycle
+        uint32_t seed = 12345;
+        const size_t max_steps = 4 * triangles_.size() + 16;
+        for (size_t step = 0; step < max_steps; ++step) {
+            const auto& tri = triangles_[t];
+            seed = seed * 1103515245u + 12345u;
+            const uint32_t r = (seed >> 16) % 3;
+            bool moved = false;
+            for (uint32_t k = 0; k < 3; ++k) {
+                const uint32_t i = (r + k) % 3;
+                const auto& a = points_[tri.v[(i + 1) % 3]];
+                const auto& b = points_[tri.v[(i + 2) % 3]];
+                if (detail::dt_orient(a, b, p) < 0) {
+                    t = tri.n[i];
+                    moved = true;
+                    break;
+                }
+            }
+            if (!moved || isGhost(t)) {
+                return t;
+            }
+        }
+
+        // Numerical trouble: exhaustive search
+        for (uint32_t k = 0; k < triangles_.size(); ++k) {
+            const auto& tri = triangles_[k];
+            if (tri.v[0] == detail::dt_dead || tri.v[2] == infinite) {
+                continue;
+            }
+            if (detail::dt_orient(points_[tri.v[0]], points_[tri.v[1]], p) >= 0
+                && detail::dt_orient(points_[tri.v[1]], points_[tri.v[2]], p) >= 0
+                && detail::dt_orient(points_[tri.v[2]], points_[tri.v[0]], p) >= 0) {
+                return k;
+            }
+        }
+        for (uint32_t k = 0; k < triangles_.size(); ++k) {
+            if (triangles_[k].v[0] != detail::dt_dead && isGhost(k) && inConflict(triangles_[k], p)) {
+                return k;
+            }
+        }
+        return t;
+    }
+
+    inline void Delaunay2D::insert(uint32_t index, uint32_t& hint, std::vector<uint32_t>& cavity,
+        std::vector<std::array<uint32_t, 3>>& boundary, std::vector<uint32_t>& mark, uint32_t& stamp)
+    {
+        const Vector2& p = points_[index];
+        const uint32_t start = locate(p, hint);
+        for (uint32_t v : triangles_[start].v) {
+            if (v != infinite && detail::dt_same(points_[v], p)) {
+                representative_[index] = v;
+                hint = start;
+                return;
+            }
+        }
+
+        // Cavity: the triangles whose circumcircle contains p, connected to
+        // the one containing p
+        ++stamp;
+        mark.resize(triangles_.size(), 0);
+        cavity.assign(1, start);
+        mark[start] = stamp;
+        for (size_t k = 0; k < cavity.size(); ++k) {
+            for (uint32_t nb : triangles_[cavity[k]].n) {
+                if (mark[nb] != stamp && inConflict(triangles_[nb], p)) {
+                    mark[nb] = stamp;
+                    cavity.push_back(nb);
+                }
+            }
+        }
+
+        // Boundary edges (a, b, outside triangle), counter-clockwise. If
+        // rounding made an edge not visible from p, the cavity is grown past
+        // it, so that it stays star-shaped.
+        for (int pass = 0; pass < 16; ++pass) {
+            boundary.clear();
+            bool grown = false;
+            for (size_t k = 0; k < cavity.size(); ++k) {
+                const auto& tri = triangles_[cavity[k]];
+                for (uint32_t j = 0; j < 3; ++j) {
+                    const uint32_t nb = tri.n[j];
+                    if (mark[nb] == stamp) {
+                        continue;
+                    }
+                    const uint32_t a = tri.v[(j + 1) % 3];
+                    const uint32_t b = tri.v[(j + 2) % 3];
+                    if (a != infinite && b != infinite && !isGhost(nb)
+                        && detail::dt_orient(points_[a], points_[b], p) <= 0) {
+                        mark[nb] = stamp;
+                        cavity.push_back(nb);
+                        grown = true;
+                        continue;
+                    }
+                    boundary.push_back({ a, b, nb });
+                }
+            }
+            if (!grown) {
+                break;
+            }
+        }
+
+        // New triangles (a, b, p), reusing the slots of the cavity
+        const size_t m = boundary.size();
+        std::vector<uint32_t>& ids = cavity;
+        while (ids.size() < m) {
+            if (!free_.empty()) {
+                ids.push_back(free_.back());
+                free_.pop_back();
+            } else {
+                ids.push_back(static_cast<uint32_t>(triangles_.size()));
+                triangles_.push_back({});
+            }
+        }
+        for (size_t k = m; k < ids.size(); ++k) {
+            triangles_[ids[k]].v[0] = detail::dt_dead;
+            free_.push_back(ids[k]);
+        }
+
+        for (size_t k = 0; k < m; ++k) {
+            const auto [a, b, outside] = boundary[k];
+            Triangle& tri = triangles_[ids[k]];
+            tri.v = { a, b, index };
+            tri.n[2] = outside;
+            for (size_t l = 0; l < m; ++l) {
+                if (boundary[l][0] == b) {
+                    tri.n[0] = ids[l];
+                }
+                if (boundary[l][1] == a) {
+                    tri.n[1] = ids[l];
+                }
+            }
+            // The outside triangle now sees the new one across (b, a)
+            Triangle& out = triangles_[outside];
+            for (uint32_t j = 0; j < 3; ++j) {
+                if (out.v[(j + 1) % 3] == b && out.v[(j + 2) % 3] == a) {
+                    out.n[j] = ids[k];
+                }
+            }
+        }
+        for (size_t k = 0; k < m; ++k) {
+            Triangle& tri = triangles_[ids[k]];
+            // Ghosts keep the infinite vertex last
+            if (tri.v[0] == infinite) {
+                tri.v = { tri.v[1], tri.v[2], tri.v[0] };
+                tri.n = { tri.n[1], tri.n[2], tri.n[0] };
+            } else if (tri.v[1] == infinite) {
+                tri.v = { tri.v[2], tri.v[0], tri.v[1] };
+                tri.n = { tri.n[2], tri.n[0], tri.n[1] };
+            } else {
+                hint = ids[k];
+            }
+        }
+        ids.resize(m);
+    }
+
+    inline void Delaunay2D::compact()
+    {
+        if (free_.empty()) {
+            return;
+        }
+        std::vector<uint32_t> remap(triangles_.size(), infinite);
+        uint32_t count = 0;
+        for (size_t t = 0; t < triangles_.size(); ++t) {
+            if (triangles_[t].v[0] != detail::dt_dead) {
+                remap[t] = count++;
+            }
+        }
+        std::vector<Triangle> compacted;
+        compacted.reserve(count);
+        for (size_t t = 0; t < triangles_.size(); ++t) {
+            if (remap[t] != infinite) {
+                Triangle tri = triangles_[t];
+                for (auto& nb : tri.n) {
+                    nb = remap[nb];
+                }
+                compacted.push_back(tri);
+            }
+        }
+        triangles_.swap(compacted);
+        free_.clear();
+    }
+
+    inline Triangles Delaunay2D::triangles() const
+    {
+        std::vector<iVector3> result;
+        result.reserve(triangles_.size() / 2 + 1);
+        for (const auto& tri : triangles_) {
+            if (tri.v[2] != infinite && tri.v[0] != detail::dt_dead) {
+                result.push_back({ tri.v[0], tri.v[1], tri.v[2] });
+            }
+        }
+        return Triangles(std::move(result));
+    }
+
+    inline bool Delaunay2D::naturalNeighbors(
+        const Vector2& p, NaturalNeighbors& result, NaturalNeighborWeights method) const
+    {
+        result.vertices.clear();
+        result.weights.clear();
+        if (triangles_.empty()) {
+            return false;
+        }
+
+        const uint32_t t = locate(p, result.hint);
+        result.hint = t;
+        if (isGhost(t)) {
+            return false;
+        }
+        const Triangle& tri = triangles_[t];
+
+        // On a data point
+        for (uint32_t v : tri.v) {
+            if (detail::dt_same(points_[v], p)) {
+                result.vertices.push_back(v);
+                result.weights.push_back(1.0);
+                return true;
+            }
+        }
+
+        // On the hull: linear along the hull edge
+        for (uint32_t i = 0; i < 3; ++i) {
+            const uint32_t a = tri.v[(i + 1) % 3];
+            const uint32_t b = tri.v[(i + 2) % 3];
+            if (isGhost(tri.n[i]) && detail::dt_orient(points_[a], points_[b], p) == 0) {
+                const Vector2 ab = points_[b] - points_[a];
+                const double s = std::clamp((p - points_[a]).dot(ab) / ab.dot(ab), 0.0, 1.0);
+                result.vertices = { a, b };
+                result.weights = { 1.0 - s, s };
+                return true;
+            }
+        }
+
+        auto barycentric = [&]() {
+            const auto& a = points_[tri.v[0]];
+            const auto& b = points_[tri.v[1]];
+            const auto& c = points_[tri.v[2]];
+            const double area = detail::dt_orient(a, b, c);
+            result.vertices = { tri.v[0], tri.v[1], tri.v[2] };
+            result.weights = { detail::dt_orient(b, c, p) / area, detail::dt_orient(c, a, p) / area,
+                detail::dt_orient(a, b, p) / area };
+            return true;
+        };
+
+        // Cavity of p (finite triangles only: p is inside the hull)
+        auto& cavity = result.cavity;
+        auto inCavity = [&](uint32_t c) { return std::find(cavity.begin(), cavity.end(), c) != cavity.end(); };
+        cavity.assign(1, t);
+        for (size_t k = 0; k < cavity.size(); ++k) {
+            for (uint32_t nb : triangles_[cavity[k]].n) {
+                if (!isGhost(nb) && !inCavity(nb) && inConflict(triangles_[nb], p)) {
+                    cavity.push_back(nb);
+                }
+            }
+        }
+
+        // Boundary, as a counter-clockwise cycle of edges (a, b, cavity triangle)
+        auto& boundary = result.boundary;
+        boundary.clear();
+        for (uint32_t c : cavity) {
+            const auto& ct = triangles_[c];
+            for (uint32_t j = 0; j < 3; ++j) {
+                if (!inCavity(ct.n[j])) {
+                    boundary.push_back({ ct.v[(j + 1) % 3], ct.v[(j + 2) % 3], c });
+                }
+            }
+        }
+        const size_t m = boundary.size();
+        for (size_t k = 0; k + 1 < m; ++k) {
+            size_t next = k + 1;
+            while (next < m && boundary[next][0] != boundary[k][1]) {
+                ++next;
+            }
+            if (next == m) {
+                return barycentric();
+            }
+            std::swap(boundary[k + 1], boundary[next]);
+        }
+
+        double total = 0;
+        for (size_t k = 0; k < m; ++k) {
+            const auto& in = boundary[k]; // (u, v)
+            const auto& out = boundary[(k + 1) % m]; // (v, w)
+            const uint32_t v = in[1];
+            const Vector2 c_in = detail::dt_circumcenter(points_[in[0]], points_[v], p);
+            const Vector2 c_out = detail::dt_circumcenter(points_[v], points_[out[1]], p);
+
+            double w = 0;
+            if (method == NaturalNeighborWeights::Laplace) {
+                w = (c_in - c_out).norm() / (p - points_[v]).norm();
+            } else {
+                // Area stolen from v: new Voronoi vertex (v, w), old Voronoi
+                // vertices of the cavity triangles around v, new vertex (u, v)
+                auto& polygon = result.polygon;
+                polygon.assign(1, c_out);
+                uint32_t c = out[2];
+                for (size_t guard = 0;; ++guard) {
+                    const auto& ct = triangles_[c];
+                    polygon.push_back(
+                        detail::dt_circumcenter(points_[ct.v[0]], points_[ct.v[1]], points_[ct.v[2]]));
+                    if (c == in[2]) {
+                        break;
+                    }
+                    const uint32_t j = ct.v[0] == v ? 0 : (ct.v[1] == v ? 1 : 2);
+                    c = ct.n[(j + 1) % 3];
+                    if (guard > cavity.size() || !inCavity(c)) {
+                        return barycentric();
+                    }
+                }
+                polygon.push_back(c_in);
+                double area = 0;
+                for (size_t l = 0; l < polygon.size(); ++l) {
+                    const auto& p0 = polygon[l];
+                    const auto& p1 = polygon[(l + 1) % polygon.size()];
+                    area += p0[0] * p1[1] - p1[0] * p0[1];
+                }
+                w = 0.5 * std::abs(area);
+            }
+            result.vertices.push_back(v);
+            result.weights.push_back(w);
+            total += w;
+        }
+
+        if (!(total > 0) || !std::isfinite(total)) {
+            return barycentric();
+        }
+        for (auto& w : result.weights) {
+            w /= total;
+        }
+        return true;
+    }
+
+} // namespace df
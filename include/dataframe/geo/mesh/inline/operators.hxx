@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/utils.h>
+#include <stdexcept>
+
+namespace df {
+    namespace detail {
+
+        template <typename X, typename F>
+        const X& cached_operator(std::recursive_mutex& mutex, std::unique_ptr<X>& slot, F&& build)
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex);
+            if (!slot) {
+                slot = std::make_unique<X>(build());
+            }
+            return *slot;
+        }
+
+        // Run f(i) for i in [0, n), in parallel. cost is the total amount of
+        // work, used to choose the number of threads.
+        template <typename F> void mesh_parallel_for(size_t n, size_t cost, F&& f)
+        {
+            detail::parallel_for_chunks(n, std::min(n, detail::get_optimal_threads(cost)),
+                [&](size_t, size_t start, size_t end) {
+                    for (size_t i = start; i < end; ++i) {
+                        f(i);
+                    }
+                });
+        }
+
+        // |u x v| in 3D, signed (u x v).z in 2D
+        template <size_t N>
+        double cross_value(const Vector<double, N>& u, const Vector<double, N>& v)
+        {
+            if constexpr (N == 2) {
+                return u[0] * v[1] - u[1] * v[0];
+            } else {
+                return u.cross(v).norm();
+            }
+        }
+
+        // Cotangent of the angle between u and v (0 if degenerate)
+        template <size_t N>
+        double cot_angle(const Vector<double, N>& u, const Vector<double, N>& v)
+        {
+            const double s = std::abs(cross_value(u, v));
+            return s > 0 ? u.dot(v) / s : 0.0;
+        }
+
+        inline CSRMatrix vertex_triangle_incidence(size_t nv, const Triangles& triangles)
+        {
+            CSRMatrix inc;
+            inc.cols = triangles.size();
+            inc.offsets.assign(nv + 1, 0);
+            for (size_t t = 0; t < triangles.size(); ++t) {
+                for (uint v : triangles[t]) {
+                    if (v >= nv) {
+                        throw std::out_of_range(concat("Triangle ", t, " references vertex ", v,
+                            ", but there are only ", nv, " vertices"));
+                    }
+                    ++inc.offsets[v + 1];
+                }
+            }
+            for (size_t v = 0; v < nv; ++v) {
+                inc.offsets[v + 1] += inc.offsets[v];
+            }
+            inc.columns.resize(inc.offsets[nv]);
+            inc.values.assign(inc.offsets[nv], 1.0);
+            std::vector<size_t> cursor(inc.offsets.begin(), inc.offsets.end() - 1);
+            for (size_t t = 0; t < triangles.size(); ++t) {
+                for (uint v : triangles[t]) {
+                    inc.columns[cursor[v]++] = static_cast<uint32_t>(t);
+                }
+            }
+            return inc;
+        }
+
+        // Sparsity pattern of the Laplacian (the vertex itself and its
+        // neighbors, sorted), with zero values
+        inline CSRMatrix laplacian_pattern(const CSRMatrix& incidence, const Triangles& triangles)
+        {
+            const size_t nv = incidence.rows();
+            CSRMatrix A;
+            A.cols = nv;
+            A.offsets.assign(nv + 1, 0);
+
+            auto row = [&](size_t i, std::vector<uint32_t>& buffer) {
+                buffer.clear();
+                buffer.push_back(static_cast<uint32_t>(i));
+                for (size_t k = incidence.offsets[i]; k < incidence.offsets[i + 1]; ++k) {
+                    for (uint v : triangles[incidence.columns[k]]) {
+                        buffer.push_back(v);
+                    }
+                }
+                std::sort(buffer.begin(), buffer.end());
+                buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+            };
+
+            // 1) Row sizes, 2) rows written at their offsets
+            const size_t num_chunks
+                = std::min(nv, detail::get_optimal_threads(incidence.nonZeros()));
+            detail::parallel_for_chunks(nv, num_chunks, [&](size_t, size_t start, size_t end) {
+                std::vector<uint32_t> buffer;
+                for (size_t i = start; i < end; ++i) {
+                    row(i, buffer);
+                    A.offsets[i + 1] = buffer.size();
+                }
+            });
+            for (size_t i = 0; i < nv; ++i) {
+                A.offsets[i + 1] += A.offsets[i];
+            }
+            A.columns.resize(A.offsets[nv]);
+            A.values.assign(A.offsets[nv], 0.0);
+            detail::parallel_for_chunks(nv, num_chunks, [&](size_t, size_t start, size_t end) {
+                std::vector<uint32_t> buffer;
+                for (size_t i = start; i < end; ++i) {
+                    row(i, buffer);
+                    std::copy(buffer.begin(), buffer.end(), A.columns.begin() + A.offsets[i]);
+                }
+            });
+            return A;
+        }
+
+        inline double& csr_entry(CSRMatrix& A, size_t i, uint32_t j)
+        {
+            auto first = A.columns.begin() + A.offsets[i];
+            auto last = A.columns.begin() + A.offsets[i + 1];
+            return A.values[std::lower_bound(first, last, j) - A.columns.begin()];
+        }
+
+        // Diagonal <- minus the sum of the off-diagonal entries of the row
+        inline void set_laplacian_diagonal(CSRMatrix& A, size_t i)
+        {
+            double sum = 0;
+            for (size_t k = A.offsets[i]; k < A.offsets[i + 1]; ++k) {
+                if (A.columns[k] != i) {
+                    sum += A.values[k];
+                }
+            }
+            csr_entry(A, i, static_cast<uint32_t>(i)) = -sum;
+        }
+
+    } // namespace detail
+
+    template <size_t N>
+    MeshOperators<N>::MeshOperators(const Serie<VertexType>& vertices, const Triangles& triangles)
+        : vertices_(vertices)
+        , triangles_(triangles)
+    {
+    }
+
+    template <size_t N>
+    MeshOperators<N>::MeshOperators(const Mesh<N>& mesh)
+        : MeshOperators(mesh.vertices(), mesh.triangles())
+    {
+    }
+
+    template <size_t N> void MeshOperators<N>::invalidate()
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        cotan_.reset();
+        gradient_.reset();
+        mass_.reset();
+    }
+
+    template <size_t N> void MeshOperators<N>::invalidateTopology()
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        invalidate();
+        incidence_.reset();
+        uniform_.reset();
+    }
+
+    template <size_t N> const CSRMatrix& MeshOperators<N>::vertexTriangles() const
+    {
+        return detail::cached_operator(mutex_, incidence_, [&] {
+            return detail::vertex_triangle_incidence(vertices_.size(), triangles_);
+        });
+    }
+
+    template <size_t N> const CSRMatrix& MeshOperators<N>::uniformLaplacian() const
+    {
+        return detail::cached_operator(mutex_, uniform_, [&] {
+            CSRMatrix L = detail::laplacian_pattern(vertexTriangles(), triangles_);
+            detail::mesh_parallel_for(L.rows(), L.nonZeros(), [&](size_t i) {
+                for (size_t k = L.offsets[i]; k < L.offsets[i + 1]; ++k) {
+                    L.values[k] = L.columns[k] == i ? 0.0 : 1.0;
+                }
+                detail::set_laplacian_diagonal(L, i);
+            });
+            return L;
+        });
+    }
+
+    template <size_t N> const CSRMatrix& MeshOperators<N>::cotanLaplacian() const
+    {
+        return detail::cached_operator(mutex_, cotan_, [&] {
+            const CSRMatrix& inc = vertexTriangles();
+            CSRMatrix L = uniformLaplacian();
+            std::fill(L.values.begin(), L.values.end(), 0.0);
+
+            // Row i gathers, from each incident triangle (i, j, l), the
+            // cotangents of the angles opposite to the edges (i, j) and (i, l)
+            detail::mesh_parallel_for(L.rows(), L.nonZeros(), [&](size_t i) {
+                for (size_t k = inc.offsets[i]; k < inc.offsets[i + 1]; ++k) {
+                    const auto& tri = triangles_[inc.columns[k]];
+                    const int a = tri[0] == i ? 0 : (tri[1] == i ? 1 : 2);
+                    const uint j = tri[(a + 1) % 3], l = tri[(a + 2) % 3];
+                    const auto &pi = vertices_[i], &pj = vertices_[j], &pl = vertices_[l];
+                    detail::csr_entry(L, i, j) += 0.5 * detail::cot_angle(pi - pl, pj - pl);
+                    detail::csr_entry(L, i, l) += 0.5 * detail::cot_angle(pi - pj, pl - pj);
+                }
+                detail::set_laplacian_diagonal(L, i);
+            });
+            return L;
+        });
+    }
+
+    template <size_t N> const Serie<double>& MeshOperators<N>::massMatrix() const
+    {
+        return detail::cached_operator(mutex_, mass_, [&] {
+            const CSRMatrix& inc = vertexTriangles();
+            std::vector<double> mass(vertices_.size(), 0.0);
+            detail::mesh_parallel_for(mass.size(), inc.nonZeros(), [&](size_t i) {
+                double area = 0;
+                for (size_t k = inc.offsets[i]; k < inc.offsets[i + 1]; ++k) {
+                    const auto& tri = triangles_[inc.columns[k]];
+                    const int a = tri[0] == i ? 0 : (tri[1] == i ? 1 : 2);
+                    const auto& p = vertices_[i];
+                    const auto& q = vertices_[tri[(a + 1) % 3]];
+                    const auto& r = vertices_[tri[(a + 2) % 3]];
+                    const double t = 0.5 * std::abs(detail::cross_value(q - p, r - p));
+                    if ((q - p).dot(r - p) < 0) {
+                        area += 0.5 * t; // obtuse at p
+                    } else if ((p - q).dot(r - q) < 0 || (p - r).dot(q - r) < 0) {
+                        area += 0.25 * t; // obtuse elsewhere
+                    } else {
+                        // Voronoi region of p within the triangle
+                        area += ((r - p).normSquared() * detail::cot_angle(p - q, r - q)
+                                    + (q - p).normSquared() * detail::cot_angle(p - r, q - r))
+                            / 8.0;
+                    }
+                }
+                mass[i] = area;
+            });
+            return Serie<double>(mass);
+        });
+    }
+
+    template <size_t N> const CSRMatrix& MeshOperators<N>::gradientOperator() const
+    {
+        return detail::cached_operator(mutex_, gradient_, [&] {
+            const size_t nt = triangles_.size();
+            CSRMatrix G;
+            G.cols = vertices_.size();
+            G.offsets.resize(N * nt + 1);
+            G.columns.resize(3 * N * nt);
+            G.values.assign(3 * N * nt, 0.0);
+            for (size_t r = 0; r <= N * nt; ++r) {
+                G.offsets[r] = 3 * r;
+            }
+
+            // grad(phi_q) is orthogonal to the opposite edge, in the plane of
+            // the triangle, with norm 1 / height
+            detail::mesh_parallel_for(nt, 3 * N * nt, [&](size_t t) {
+                const auto& tri = triangles_[t];
+                const VertexType p[3]
+                    = { vertices_[tri[0]], vertices_[tri[1]], vertices_[tri[2]] };
+                const double twice_area = detail::cross_value(p[1] - p[0], p[2] - p[0]);
+                for (size_t d = 0; d < N; ++d) {
+                    for (int q = 0; q < 3; ++q) {
+                        G.columns[3 * (N * t + d) + q] = tri[q];
+                    }
+                }
+                if (twice_area == 0) {
+                    return;
+                }
+                for (int q = 0; q < 3; ++q) {
+                    const VertexType e = p[(q + 2) % 3] - p[(q + 1) % 3];
+                    VertexType g;
+                    if constexpr (N == 2) {
+                        g = VertexType { -e[1], e[0] } / twice_area;
+                    } else {
+                        const Vector3 n = (p[1] - p[0]).cross(p[2] - p[0]) / twice_area;
+                        g = n.cross(e) / twice_area;
+                    }
+                    for (size_t d = 0; d < N; ++d) {
+                        G.values[3 * (N * t + d) + q] = g[d];
+                    }
+                }
+            });
+            return G;
+        });
+    }
+
+    // ---------------------------------------------------------------
+
+    template <size_t N>
+    template <typename T>
+    Serie<T> MeshOperators<N>::laplacian(const Serie<T>& values, bool cotangent) const
+    {
+        return (cotangent ? cotanLaplacian() : uniformLaplacian()).multiply(values);
+    }
+
+    template <size_t N>
+    Serie<typename MeshOperators<N>::VertexType> MeshOperators<N>::gradient(
+        const Serie<double>& values) const
+    {
+        const auto g = gradientOperator().multiply(values);
+        std::vector<VertexType> result(triangles_.size());
+        for (size_t t = 0; t < result.size(); ++t) {
+            for (size_t d = 0; d < N; ++d) {
+                result[t][d] = g[N * t + d];
+            }
+        }
+        return Serie<VertexType>(result);
+    }
+
+    template <size_t N>
+    template <typename T>
+    Serie<T> MeshOperators<N>::smooth(
+        const Serie<T>& values, size_t iterations, double lambda, bool cotangent) const
+    {
+        const CSRMatrix& L = cotangent ? cotanLaplacian() : uniformLaplacian();
+        const Serie<double> diag = L.diagonal();
+        std::vector<T> x = values.asArray();
+        for (size_t it = 0; it < iterations; ++it) {
+            const Serie<T> Lx = L.multiply(Serie<T>(x));
+            detail::mesh_parallel_for(x.size(), x.size(), [&](size_t i) {
+                if (diag[i] != 0) {
+                    x[i] += Lx[i] * (-lambda / diag[i]);
+                }
+            });
+        }
+        return Serie<T>(x);
+    }
+
+    template <size_t N>
+    template <typename T>
+    Serie<T> MeshOperators<N>::diffuse(const Serie<T>& values, double dt, size_t steps) const
+    {
+        const CSRMatrix& L = cotanLaplacian();
+        const Serie<double>& mass = massMatrix();
+        std::vector<T> u = values.asArray();
+        for (size_t s = 0; s < steps; ++s) {
+            const Serie<T> Lu = L.multiply(Serie<T>(u));
+            detail::mesh_parallel_for(u.size(), u.size(), [&](size_t i) {
+                if (mass[i] > 0) {
+                    u[i] += Lu[i] * (dt / mass[i]);
+                }
+            });
+        }
+        return Serie<T>(u);
+    }
+
+    template <size_t N> Serie<Vector3> MeshOperators<N>::vertexNormals() const
+    {
+        static_assert(N == 3, "vertexNormals requires a 3D mesh");
+        const CSRMatrix& inc = vertexTriangles();
+        std::vector<Vector3> normals(vertices_.size());
+        detail::mesh_parallel_for(normals.size(), inc.nonZeros(), [&](size_t i) {
+            Vector3 n;
+            for (size_t k = inc.offsets[i]; k < inc.offsets[i + 1]; ++k) {
+                const auto& tri = triangles_[inc.columns[k]];
+                const auto& p0 = vertices_[tri[0]];
+                n += (vertices_[tri[1]] - p0).cross(vertices_[tri[2]] - p0);
+            }
+            const double length = n.norm();
+            normals[i] = length > 0 ? n / length : n;
+        });
+        return Serie<Vector3>(normals);
+    }
+
+    template <size_t N> Serie<double> MeshOperators<N>::meanCurvature() const
+    {
+        static_assert(N == 3, "meanCurvature requires a 3D mesh");
+        const auto Lx = cotanLaplacian().multiply(vertices_);
+        const auto normals = vertexNormals();
+        const auto& mass = massMatrix();
+        std::vector<double> H(vertices_.size(), 0.0);
+        detail::mesh_parallel_for(H.size(), H.size(), [&](size_t i) {
+            if (mass[i] > 0) {
+                H[i] = -Lx[i].dot(normals[i]) / (2.0 * mass[i]);
+            }
+        });
+        return Serie<double>(H);
+    }
+
+} // namespace df
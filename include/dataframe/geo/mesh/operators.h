@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/Serie.h>
+#include <dataframe/algebra/sparse.h>
+#include <dataframe/geo/mesh/mesh.h>
+#include <dataframe/geo/types.h>
+#include <memory>
+#include <mutex>
+
+namespace df {
+
+    /**
+     * @brief Discrete differential operators of a triangulated surface, in
+     * CSR form, assembled on first use and cached.
+     *
+     * - topology (depends on the triangles only): vertex/triangle incidence,
+     *   vertex adjacency and uniform (graph) Laplacian,
+     * - geometry (depends on the vertex positions too): cotangent Laplacian,
+     *   lumped mass matrix (vertex areas) and per-triangle gradient.
+     *
+     * Laplacians follow the convention (L x)_i = sum_j w_ij (x_j - x_i): the
+     * diagonal is minus the sum of the row. Cotangent weights are
+     * w_ij = (cot(alpha_ij) + cot(beta_ij)) / 2.
+     *
+     * The operators keep a reference to the vertices and triangles, which
+     * must outlive them. After moving the vertices, call invalidate(); after
+     * changing the triangles, call invalidateTopology().
+     *
+     * Assembly is parallel over the vertices (each row of a matrix is
+     * gathered from the incident triangles), and all the algorithms below
+     * are parallel sparse matrix-vector products over the cached operators.
+     * The getters are thread-safe.
+     *
+     * @code
+     * df::MeshOperators<3> ops(mesh);
+     * auto H = ops.meanCurvature();
+     * auto smoothed = ops.smooth(mesh.vertexAttribute<double>("noise"), 10);
+     * auto grad = ops.gradient(mesh.vertexAttribute<double>("temperature"));
+     *
+     * mesh.vertices() = ops.smooth(mesh.vertices(), 5); // moved vertices
+     * ops.invalidate();
+     * @endcode
+     */
+    template <size_t N> class MeshOperators {
+    public:
+        using VertexType = Vector<double, N>;
+
+        MeshOperators(const Serie<VertexType>& vertices, const Triangles& triangles);
+        explicit MeshOperators(const Mesh<N>& mesh);
+
+        // The references would dangle
+        MeshOperators(Serie<VertexType>&&, const Triangles&) = delete;
+        MeshOperators(const Serie<VertexType>&, Triangles&&) = delete;
+        MeshOperators(Serie<VertexType>&&, Triangles&&) = delete;
+        explicit MeshOperators(Mesh<N>&&) = delete;
+
+        const Serie<VertexType>& vertices() const { return vertices_; }
+        const Triangles& triangles() const { return triangles_; }
+
+        /**
+         * @brief Row v holds the triangles incident to vertex v (values are 1)
+         */
+        const CSRMatrix& vertexTriangles() const;
+
+        /**
+         * @brief (L x)_i = sum over the neighbors j of i of (x_j - x_i)
+         */
+        const CSRMatrix& uniformLaplacian() const;
+
+        /**
+         * @brief Cotangent Laplacian (without the inverse mass matrix)
+         */
+        const CSRMatrix& cotanLaplacian() const;
+
+        /**
+         * @brief Diagonal of the lumped mass matrix: mixed Voronoi area of
+         * each vertex (Meyer et al. 2003), falling back to a fraction of the
+         * triangle area for obtuse triangles. The areas sum to the mesh area.
+         */
+        const Serie<double>& massMatrix() const;
+
+        /**
+         * @brief Gradient of the linear (hat) basis functions: rows N * t + d
+         * give the d-th component of the gradient in triangle t
+         */
+        const CSRMatrix& gradientOperator() const;
+
+        /**
+         * @brief Drop the operators depending on the vertex positions
+         */
+        void invalidate();
+
+        /**
+         * @brief Drop all the operators
+         */
+        void invalidateTopology();
+
+        // ---------------------------------------------------------------
+
+        /**
+         * @brief L * values, with the cotangent or the uniform Laplacian
+         */
+        template <typename T>
+        Serie<T> laplacian(const Serie<T>& values, bool cotangent = true) const;
+
+        /**
+         * @brief Per-triangle gradient of a per-vertex scalar field
+         */
+        Serie<VertexType> gradient(const Serie<double>& values) const;
+
+        /**
+         * @brief Laplacian smoothing: each iteration moves every value toward
+         * the (uniform or cotangent weighted) average of its neighbors, by a
+         * factor lambda in ]0, 1]
+         */
+        template <typename T>
+        Serie<T> smooth(const Serie<T>& values, size_t iterations = 1, double lambda = 0.5,
+            bool cotangent = false) const;
+
+        /**
+         * @brief Explicit heat diffusion u <- u + dt M^-1 L u, with L the
+         * cotangent Laplacian and M the mass matrix. Stable for dt below about
+         * h^2 / 4 (h the smallest edge length).
+         */
+        template <typename T>
+        Serie<T> diffuse(const Serie<T>& values, double dt, size_t steps = 1) const;
+
+        /**
+         * @brief Area-weighted vertex normals (3D only)
+         */
+        Serie<Vector3> vertexNormals() const;
+
+        /**
+         * @brief Mean curvature H = -(L x) . n / (2 A) at each vertex, with
+         * the cotangent Laplacian L, the vertex normal n and the vertex area A
+         * (3D only). Positive on a sphere with outward normals.
+         */
+        Serie<double> meanCurvature() const;
+
+    private:
+        const Serie<VertexType>& vertices_;
+        const Triangles& triangles_;
+
+        mutable std::recursive_mutex mutex_;
+        mutable std::unique_ptr<CSRMatrix> incidence_;
+        mutable std::unique_ptr<CSRMatrix> uniform_;
+        mutable std::unique_ptr<CSRMatrix> cotan_;
+        mutable std::unique_ptr<CSRMatrix> gradient_;
+        mutable std::unique_ptr<Serie<double>> mass_;
+    };
+
+} // namespace df
+
+#include "inline/operators.hxx"
@@ -25,6 +25,7 @@
 #include <array>
 #include <cmath>
 #include <dataframe/Serie.h>
+#include <dataframe/core/parallel_map.h>
 #include <dataframe/utils/utils.h>
 #include <stdexcept>
 
@@ -45,6 +46,8 @@ Serie<Vector2> normals(const Serie<Vector2> &vertices,
  * @param vertices Serie of 3D vertices
  * @param triangles Serie of index triplets defining triangles
  * @return Serie of normalized normal vectors for each triangle
+ * @throws std::runtime_error for a degenerate triangle (see
+ * triangle_geometry to flag them instead)
  */
 template <typename T>
 Serie<Vector3> normals(const Serie<Vector3> &vertices,
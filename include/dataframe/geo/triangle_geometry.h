@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/Dataframe.h>
+#include <dataframe/Serie.h>
+#include <dataframe/geo/types.h>
+#include <dataframe/utils/utils.h>
+
+namespace df {
+
+    /**
+     * @brief Per-triangle geometry computed in a single fused pass.
+     *
+     * Returns a Dataframe with one row per triangle and the columns:
+     * - "area" (double),
+     * - "centroid" (Vector<double, N>),
+     * - "edge_lengths" (Vector3): |v1 - v0|, |v2 - v1| and |v0 - v2|,
+     * - "normal" (Vector3, 3D only): unit normal (right-hand rule on
+     *   v0, v1, v2), or a zero vector for a degenerate triangle,
+     * - "degenerate" (bool).
+     *
+     * A triangle is degenerate when twice its area is below
+     * `tolerance * l_max^2`, where l_max is its longest edge (i.e. when its
+     * vertices are collinear or repeated, up to a scale-invariant tolerance).
+     * Degenerate triangles are flagged, not reported by an exception.
+     *
+     * The triangles are processed in parallel, by blocks: the vertices of a
+     * block are gathered into component arrays (SoA) so that the arithmetic
+     * runs in plain vectorizable loops.
+     *
+     * @throws std::out_of_range if a triangle references a missing vertex
+     *
+     * @code
+     * auto geom = df::triangle_geometry(positions, triangles);
+     * auto areas = geom.get<double>("area");
+     * auto bad = geom.get<bool>("degenerate");
+     * @endcode
+     */
+    template <size_t N>
+    Dataframe triangle_geometry(const Serie<Vector<double, N>>& vertices,
+        const Triangles& triangles, double tolerance = 1e-10);
+
+    // Binding function for pipeline operations
+    template <size_t N>
+    auto bind_triangle_geometry(const Triangles& triangles, double tolerance = 1e-10);
+
+} // namespace df
+
+#include "inline/triangle_geometry.hxx"
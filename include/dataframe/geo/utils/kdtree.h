@@ -31,6 +31,16 @@ namespace df {
 
     class Node; // forward decl.
 
+    namespace detail {
+        template <size_t DIM> struct point_type;
+        template <> struct point_type<2> {
+            using type = Vector2;
+        };
+        template <> struct point_type<3> {
+            using type = Vector3;
+        };
+    } // namespace detail
+
     /**
      * @brief A k-dimensional tree implementation for spatial queries on Serie data
      * types
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <dataframe/utils/utils.h>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace df {
+
+inline Dictionary::Dictionary(const Dictionary &other)
+    : values_(other.values_) {
+    index_.reserve(values_.size());
+    for (size_t code = 0; code < values_.size(); ++code) {
+        index_.try_emplace(values_[code], static_cast<uint32_t>(code));
+    }
+}
+
+inline Dictionary &Dictionary::operator=(const Dictionary &other) {
+    if (this != &other) {
+        Dictionary copy(other);
+        values_.swap(copy.values_);
+        index_ = std::move(copy.index_);
+    }
+    return *this;
+}
+
+inline uint32_t Dictionary::encode(std::string_view value) {
+    if (const uint32_t *code = index_.find(value)) {
+        return *code;
+    }
+    if (values_.size() == std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Dictionary: too many values");
+    }
+    const auto code = static_cast<uint32_t>(values_.size());
+    values_.emplace_back(value);
+    index_.try_emplace(values_.back(), code);
+    return code;
+}
+
+inline const std::string &Dictionary::operator[](uint32_t code) const {
+    if (code >= values_.size()) {
+        throw std::out_of_range(concat("Code ", code,
+                                       " is out of bounds (max is ",
+                                       values_.size(), ") in Dictionary"));
+    }
+    return values_[code];
+}
+
+inline std::vector<uint32_t> Dictionary::ranks() const {
+    std::vector<uint32_t> order(values_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return values_[a] < values_[b];
+    });
+    std::vector<uint32_t> rank(values_.size());
+    for (size_t r = 0; r < order.size(); ++r) {
+        rank[order[r]] = static_cast<uint32_t>(r);
+    }
+    return rank;
+}
+
+// ----------------------------------------------------------
+
+inline CategoricalSerie::CategoricalSerie(
+    std::shared_ptr<Dictionary> dictionary)
+    : dictionary_(std::move(dictionary)) {
+    if (!dictionary_) {
+        dictionary_ = std::make_shared<Dictionary>();
+    }
+}
+
+inline CategoricalSerie::CategoricalSerie(
+    std::initializer_list<std::string_view> values)
+    : CategoricalSerie() {
+    reserve(values.size());
+    for (std::string_view value : values) {
+        add(value);
+    }
+}
+
+inline CategoricalSerie::CategoricalSerie(
+    const Serie<std::string> &serie, std::shared_ptr<Dictionary> dictionary)
+    : CategoricalSerie(std::move(dictionary)) {
+    reserve(serie.size());
+    for (size_t i = 0; i < serie.size(); ++i) {
+        if (serie.isNull(i)) {
+            addNull();
+        } else {
+            add(serie.data()[i]);
+        }
+    }
+}
+
+inline CategoricalSerie::CategoricalSerie(
+    const StringSerie &serie, std::shared_ptr<Dictionary> dictionary)
+    : CategoricalSerie(std::move(dictionary)) {
+    reserve(serie.size());
+    for (size_t i = 0; i < serie.size(); ++i) {
+        if (serie.isNull(i)) {
+            addNull();
+        } else {
+            add(serie.view(i));
+        }
+    }
+}
+
+inline size_t CategoricalSerie::size() const {
+    return visitCodes([](const auto &codes) { return codes.size(); });
+}
+
+inline void CategoricalSerie::reserve(size_t n) {
+    std::visit([n](auto &codes) { codes.reserve(n); }, codes_);
+}
+
+inline void CategoricalSerie::add(std::string_view value) {
+    addCode(dictionary_->encode(value));
+}
+
+inline void CategoricalSerie::addCode(uint32_t code) {
+    if (code >= dictionary_->size()) {
+        throw std::out_of_range(concat("Code ", code,
+                                       " is out of bounds (max is ",
+                                       dictionary_->size(),
+                                       ") in CategoricalSerie::addCode"));
+    }
+    widen(code);
+    std::visit(
+        [code](auto &codes) {
+            using C = typename std::decay_t<decltype(codes)>::value_type;
+            codes.push_back(static_cast<C>(code));
+        },
+        codes_);
+    if (!validity_.empty()) {
+        validity_.push_back(true);
+    }
+}
+
+inline void CategoricalSerie::addNull() {
+    if (validity_.empty()) {
+        validity_ = Mask(size(), true);
+    }
+    std::visit([](auto &codes) { codes.push_back(0); }, codes_);
+    validity_.push_back(false);
+}
+
+// Move the codes to a wider type if code does not fit in the current one
+inline void CategoricalSerie::widen(uint32_t code) {
+    auto convert = [this](const auto &codes, auto wider) {
+        using W = decltype(wider);
+        std::vector<W> result(codes.begin(), codes.end());
+        result.reserve(codes.capacity());
+        codes_ = std::move(result);
+    };
+    if (code > std::numeric_limits<uint8_t>::max() &&
+        std::holds_alternative<std::vector<uint8_t>>(codes_)) {
+        if (code > std::numeric_limits<uint16_t>::max()) {
+            convert(std::get<std::vector<uint8_t>>(codes_), uint32_t{});
+        } else {
+            convert(std::get<std::vector<uint8_t>>(codes_), uint16_t{});
+        }
+    } else if (code > std::numeric_limits<uint16_t>::max() &&
+               std::holds_alternative<std::vector<uint16_t>>(codes_)) {
+        convert(std::get<std::vector<uint16_t>>(codes_), uint32_t{});
+    }
+}
+
+inline const std::string &CategoricalSerie::operator[](size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range(concat("Index ", index,
+                                       " is out of bounds (max is ", size(),
+                                       ") in CategoricalSerie::operator[]"));
+    }
+    if (isNull(index)) {
+        static const std::string empty;
+        return empty;
+    }
+    return dictionary_->values()[code(index)];
+}
+
+inline uint32_t CategoricalSerie::code(size_t index) const {
+    return visitCodes([index](const auto &codes) {
+        return static_cast<uint32_t>(codes[index]);
+    });
+}
+
+inline Serie<uint32_t> CategoricalSerie::codes() const {
+    return visitCodes([](const auto &codes) {
+        return Serie<uint32_t>(
+            std::vector<uint32_t>(codes.begin(), codes.end()));
+    });
+}
+
+inline size_t CategoricalSerie::codeWidth() const {
+    return visitCodes([](const auto &codes) {
+        return sizeof(typename std::decay_t<decltype(codes)>::value_type);
+    });
+}
+
+inline bool CategoricalSerie::hasNulls() const { return nullCount() != 0; }
+
+inline size_t CategoricalSerie::nullCount() const {
+    return validity_.empty() ? 0 : validity_.size() - validity_.count();
+}
+
+inline bool CategoricalSerie::isNull(size_t index) const {
+    return !validity_.empty() && !validity_[index];
+}
+
+inline void CategoricalSerie::setValidity(const Mask &validity) {
+    if (!validity.empty() && validity.size() != size()) {
+        throw std::runtime_error(
+            concat("CategoricalSerie::setValidity: mask size (",
+                   validity.size(), ") differs from serie size (", size(),
+                   ")"));
+    }
+    validity_ = validity.all() ? Mask() : validity;
+}
+
+inline std::shared_ptr<SerieBase>
+CategoricalSerie::gather(const std::vector<int64_t> &indices) const {
+    const int64_t n = static_cast<int64_t>(size());
+    auto result = std::make_shared<CategoricalSerie>(dictionary_);
+    bool nulls = false;
+    visitCodes([&](const auto &codes) {
+        std::remove_cvref_t<decltype(codes)> gathered(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const int64_t index = indices[i];
+            if (index >= n) {
+                throw std::out_of_range(
+                    concat("Index ", index, " is out of bounds (max is ", n,
+                           ") in CategoricalSerie::gather"));
+            }
+            if (index < 0 || isNull(static_cast<size_t>(index))) {
+                nulls = true;
+            } else {
+                gathered[i] = codes[static_cast<size_t>(index)];
+            }
+        }
+        result->codes_ = std::move(gathered);
+    });
+    if (nulls) {
+        result->setValidity(Mask::generate(indices.size(), [&](size_t i) {
+            return indices[i] >= 0 &&
+                   !isNull(static_cast<size_t>(indices[i]));
+        }));
+    }
+    return result;
+}
+
+inline CategoricalSerie CategoricalSerie::select(const Mask &mask) const {
+    if (mask.size() != size()) {
+        throw std::runtime_error(
+            concat("CategoricalSerie::select: mask size (", mask.size(),
+                   ") differs from serie size (", size(), ")"));
+    }
+    CategoricalSerie result(dictionary_);
+    visitCodes([&](const auto &codes) {
+        std::remove_cvref_t<decltype(codes)> selected;
+        selected.reserve(mask.count());
+        mask.forEachSet([&](size_t i) { selected.push_back(codes[i]); });
+        result.codes_ = std::move(selected);
+    });
+    if (!validity_.empty()) {
+        Mask valid;
+        mask.forEachSet([&](size_t i) { valid.push_back(validity_[i]); });
+        result.setValidity(valid);
+    }
+    return result;
+}
+
+inline Serie<std::string> CategoricalSerie::toSerie() const {
+    std::vector<std::string> values;
+    values.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        values.push_back((*this)[i]);
+    }
+    Serie<std::string> result(std::move(values));
+    result.setValidity(validity_);
+    return result;
+}
+
+} // namespace df
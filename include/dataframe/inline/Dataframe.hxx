@@ -28,13 +28,80 @@
 
 namespace df {
 
+inline Dataframe::Dataframe(const Dataframe &other)
+    : series_(other.series_), version_(other.version_) {
+    reindex();
+}
+
+// Moving the map keeps its nodes, so the index stays valid
+inline Dataframe::Dataframe(Dataframe &&other) noexcept
+    : series_(std::move(other.series_)), index_(std::move(other.index_)),
+      version_(other.version_) {
+    other.series_.clear();
+    other.index_.clear();
+}
+
+inline Dataframe &Dataframe::operator=(const Dataframe &other) {
+    if (this != &other) {
+        series_ = other.series_;
+        version_ = nextVersion();
+        reindex();
+    }
+    return *this;
+}
+
+inline Dataframe &Dataframe::operator=(Dataframe &&other) noexcept {
+    if (this != &other) {
+        series_ = std::move(other.series_);
+        index_ = std::move(other.index_);
+        version_ = nextVersion();
+        other.series_.clear();
+        other.index_.clear();
+    }
+    return *this;
+}
+
+inline void Dataframe::reindex() {
+    index_.clear();
+    index_.reserve(series_.size());
+    for (auto &[name, info] : series_) {
+        index_.try_emplace(name, &info);
+    }
+}
+
+inline const Dataframe::SerieInfo *
+Dataframe::find(const std::string &name) const {
+    SerieInfo *const *info = index_.find(name);
+    return info ? *info : nullptr;
+}
+
+template <typename T>
+inline const std::shared_ptr<SerieBase> &
+Dataframe::checked(const std::string &name) const {
+    const SerieInfo *info = find(name);
+    if (!info) {
+        throw std::runtime_error(
+            concat("Serie '", name, "' does not exist in Dataframe"));
+    }
+    // The stored type is the dynamic type of the serie: when it matches, the
+    // static cast done by the callers is safe
+    if (info->type != std::type_index(typeid(Serie<T>))) {
+        throw std::runtime_error(concat(
+            "Type mismatch for Serie '", name, "': expected type '",
+            typeid(Serie<T>).name(), "' but got '", info->type.name(), "'"));
+    }
+    return info->data;
+}
+
 template <typename T>
 void Dataframe::add(const std::string &name, const Serie<T> &serie) {
-    if (has<T>(name)) {
+    if (has(name)) {
         throw std::runtime_error(
             concat("Serie with name '", name, "' already exists in Dataframe"));
     }
-    series_.emplace(name, SerieInfo(serie));
+    auto it = series_.emplace(name, SerieInfo(serie)).first;
+    index_.try_emplace(name, &it->second);
+    touch();
 }
 
 template <typename T>
@@ -42,90 +109,94 @@ void Dataframe::add(const std::string &name, const ArrayType<T> &array) {
     add(name, Serie<T>(array));
 }
 
+inline void Dataframe::add(const std::string &name,
+                           const std::shared_ptr<SerieBase> &serie) {
+    if (!serie) {
+        throw std::runtime_error(
+            concat("Cannot add a null Serie named '", name, "' in Dataframe"));
+    }
+    if (has(name)) {
+        throw std::runtime_error(
+            concat("Serie with name '", name, "' already exists in Dataframe"));
+    }
+    auto it = series_.emplace(name, SerieInfo(serie)).first;
+    index_.try_emplace(name, &it->second);
+    touch();
+}
+
 inline void Dataframe::remove(const std::string &name) {
     if (!has(name)) {
         throw std::runtime_error(
             concat("Serie '", name, "' does not exist in Dataframe"));
     }
     series_.erase(name);
+    reindex(); // the flat index does not support erasing
+    touch();
 }
 
 template <typename T>
 const Serie<T> &Dataframe::get(const std::string &name) const {
-    if (!has(name)) {
-        throw std::runtime_error(
-            concat("Serie '", name, "' does not exist in Dataframe"));
-    }
-
-    const auto &info = series_.at(name);
-    auto typed_ptr = std::dynamic_pointer_cast<Serie<T>>(info.data);
-
-    if (!typed_ptr) {
-        throw std::runtime_error(concat(
-            "Type mismatch for Serie '", name, "': expected type '",
-            typeid(Serie<T>).name(), "' but got '", info.type.name(), "'"));
-    }
-
-    return *typed_ptr;
+    return *std::static_pointer_cast<Serie<T>>(checked<T>(name));
 }
 
 template <typename T> Serie<T> &Dataframe::get(const std::string &name) {
-    // return const_cast<const Serie<T> &>(this->get(name));
-    if (!has(name)) {
+    return *std::static_pointer_cast<Serie<T>>(checked<T>(name));
+}
+
+inline const StringSerie &Dataframe::strings(const std::string &name) const {
+    const auto *serie = dynamic_cast<const StringSerie *>(&get(name));
+    if (!serie) {
         throw std::runtime_error(
-            concat("Serie '", name, "' does not exist in Dataframe"));
+            concat("Type mismatch for Serie '", name,
+                   "': expected type 'StringSerie' but got '",
+                   get(name).type(), "'"));
     }
+    return *serie;
+}
 
-    auto &info = series_.at(name);
-
-    // Option 1: Safe cast with runtime check
-    auto typed_ptr = std::dynamic_pointer_cast<Serie<T>>(info.data);
-    if (!typed_ptr) {
-        throw std::runtime_error(concat(
-            "Type mismatch for Serie '", name, "': expected type '",
-            typeid(Serie<T>).name(), "' but got '", info.type.name(), "'"));
+inline const CategoricalSerie &
+Dataframe::categorical(const std::string &name) const {
+    const auto *serie = dynamic_cast<const CategoricalSerie *>(&get(name));
+    if (!serie) {
+        throw std::runtime_error(
+            concat("Type mismatch for Serie '", name,
+                   "': expected type 'CategoricalSerie' but got '",
+                   get(name).type(), "'"));
     }
-    return *typed_ptr;
+    return *serie;
+}
 
-    // Option 2: Fast cast (use only if you're certain of the type)
-    // return *std::static_pointer_cast<Serie<T>>(info.data);
+template <typename T>
+ColumnHandle<T> Dataframe::handle(const std::string &name) const {
+    return ColumnHandle<T>(name,
+                           std::static_pointer_cast<Serie<T>>(checked<T>(name)));
 }
 
 inline std::type_index Dataframe::type(const std::string &name) const {
-    if (!has(name)) {
+    const SerieInfo *info = find(name);
+    if (!info) {
         throw std::runtime_error(
             concat("Serie '", name, "' does not exist in Dataframe"));
     }
-    return series_.at(name).type;
+    return info->type;
 }
 
 inline String Dataframe::type_name(const std::string &name) const {
-    if (!has(name)) {
+    const SerieInfo *info = find(name);
+    if (!info) {
         throw std::runtime_error(
             concat("Serie '", name, "' does not exist in Dataframe"));
     }
-    return series_.at(name).data.operator*().type();
+    return info->data->type();
 }
 
 inline bool Dataframe::has(const std::string &name) const {
-    return series_.find(name) != series_.end();
+    return find(name) != nullptr;
 }
 
 template <typename T> bool Dataframe::has(const std::string &name) const {
-    try {
-        // First check if the serie exists
-        if (!series_.contains(name)) {
-            return false;
-        }
-
-        // Get the stored type info
-        const auto &serieInfo = series_.at(name);
-
-        // Compare stored type with requested type
-        return serieInfo.type == std::type_index(typeid(Serie<T>));
-    } catch (const std::exception &) {
-        return false;
-    }
+    const SerieInfo *info = find(name);
+    return info && info->type == std::type_index(typeid(Serie<T>));
 }
 
 inline size_t Dataframe::size() const { return series_.size(); }
@@ -139,7 +210,45 @@ inline std::vector<std::string> Dataframe::names() const {
     return result;
 }
 
-inline void Dataframe::clear() { series_.clear(); }
+inline Dataframe Dataframe::filter_rows(const Mask &mask) const {
+    std::vector<std::pair<std::string, const SerieBase *>> columns;
+    columns.reserve(series_.size());
+    for (const auto &[name, info] : series_) {
+        if (info.data->size() != mask.size()) {
+            throw std::runtime_error(
+                concat("Dataframe::filter_rows: serie ", name, " has size ",
+                       info.data->size(), ", mask has size ", mask.size()));
+        }
+        columns.emplace_back(name, info.data.get());
+    }
+
+    const std::vector<size_t> kept = mask.indices();
+    const std::vector<int64_t> indices(kept.begin(), kept.end());
+
+    // One gather per column, the columns being shared among the threads
+    std::vector<std::shared_ptr<SerieBase>> gathered(columns.size());
+    const size_t num_chunks = std::min(
+        columns.size(),
+        detail::get_optimal_threads(indices.size() * columns.size()));
+    detail::parallel_for_chunks(
+        columns.size(), num_chunks, [&](size_t, size_t first, size_t last) {
+            for (size_t c = first; c < last; ++c) {
+                gathered[c] = columns[c].second->gather(indices);
+            }
+        });
+
+    Dataframe result;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        result.add(columns[c].first, gathered[c]);
+    }
+    return result;
+}
+
+inline void Dataframe::clear() {
+    series_.clear();
+    index_.clear();
+    touch();
+}
 
 // ---------------------------------------------------------
 // ------------------------ PRINT --------------------------
@@ -275,15 +384,12 @@ void Dataframe::printSerieDetails(std::ostream &os, const std::string &name,
         printSeriePreview(os, name, max_preview);
 
         // Print statistics for numeric types
-        const std::string type = type_name(name);
-        // std::cout << "===> type: " << type << std::endl;
-        if (type == "double") {
-            printNumericStats<double>(os, name, w_stats);
-        } else if (type == "int") {
-            printNumericStats<int>(os, name, w_stats);
-        } else if (type == "float") {
-            printNumericStats<float>(os, name, w_stats);
-        }
+        visit(*serie_info.data, [&](const auto &serie) {
+            using T = typename std::decay_t<decltype(serie)>::value_type;
+            if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+                printNumericStats<T>(os, name, w_stats);
+            }
+        });
         // else if (type.find("array")!=std::string::npos) {
         //     os << "(array values)\n";
         // } else if (type.find("vector")!=std::string::npos) {
@@ -333,24 +439,20 @@ void Dataframe::printSeriePreview(std::ostream &os, const std::string &name,
     const auto &serie_info = series_.at(name);
     size_t preview_size = std::min(serie_info.data->size(), max_preview);
 
-    if (type_name(name) == "double") {
-        printNumericPreview<double>(os, name, preview_size);
-    } else if (type_name(name) == "float") {
-        printNumericPreview<float>(os, name, preview_size);
-    } else if (type_name(name) == "int") {
-        printNumericPreview<int>(os, name, preview_size);
-    } else if (type_name(name) == "std::string") {
-        const auto &serie = get<std::string>(name);
-        for (size_t i = 0; i < preview_size; ++i) {
-            os << "\"" << serie[i] << "\"";
-            if (i < preview_size - 1)
-                os << ", ";
+    visit(*serie_info.data, [&](const auto &serie) {
+        using T = typename std::decay_t<decltype(serie)>::value_type;
+        if constexpr (std::is_arithmetic_v<T>) {
+            printNumericPreview<T>(os, name, preview_size);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            for (size_t i = 0; i < preview_size; ++i) {
+                os << "\"" << serie[i] << "\"";
+                if (i < preview_size - 1)
+                    os << ", ";
+            }
+        } else {
+            os << "(" << serie.type() << " values)";
         }
-    } else if (type_name(name).find("vector") != std::string::npos) {
-        os << "(vector values)";
-    } else if (type_name(name).find("array") != std::string::npos) {
-        os << "(array values)";
-    }
+    });
     os << "\n";
 }
 
@@ -359,10 +461,10 @@ void Dataframe::printNumericPreview(std::ostream &os, const std::string &name,
                                     size_t preview_size) const {
     const auto &serie = get<T>(name);
     for (size_t i = 0; i < preview_size; ++i) {
-        os << detail::format_number(serie[i]);
+        os << detail::format_number(serie.data()[i]);
         if (i < preview_size - 1)
             os << ", ";
     }
 }
 
-} // namespace df
\ No newline at end of file
+} // namespace df
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#include <bit>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/utils.h>
+#include <functional>
+#include <stdexcept>
+
+namespace df {
+
+inline Mask::Mask(size_t size, bool value)
+    : words_((size + WORD_BITS - 1) / WORD_BITS, value ? ~Word{0} : Word{0}),
+      size_(size) {
+    clearTail();
+}
+
+inline Mask::Mask(std::initializer_list<bool> values) : Mask(values.size()) {
+    size_t i = 0;
+    for (bool value : values) {
+        words_[i / WORD_BITS] |= Word{value} << (i % WORD_BITS);
+        ++i;
+    }
+}
+
+inline Mask::Mask(const Serie<bool> &serie)
+    : Mask(generate(serie.size(),
+                    [&values = serie.data()](size_t i) { return values[i]; })) {}
+
+template <typename F>
+Mask Mask::generate(size_t size, F &&bit, ExecutionPolicy exec) {
+    Mask mask(size);
+    const size_t num_words = mask.words_.size();
+    const size_t num_chunks =
+        exec == ExecutionPolicy::SEQ ? 1 : detail::get_optimal_threads(size);
+    // Each chunk owns whole words: no two threads write into the same word
+    detail::parallel_for_chunks(
+        num_words, num_chunks,
+        [&](size_t, size_t first, size_t last) {
+            for (size_t w = first; w < last; ++w) {
+                const size_t base = w * WORD_BITS;
+                const size_t end = std::min(base + WORD_BITS, size);
+                Word word = 0;
+                for (size_t i = base; i < end; ++i) {
+                    word |= Word{static_cast<bool>(bit(i))} << (i - base);
+                }
+                mask.words_[w] = word;
+            }
+        });
+    return mask;
+}
+
+inline Mask Mask::fromWords(std::vector<Word> words, size_t size) {
+    if (words.size() != (size + WORD_BITS - 1) / WORD_BITS) {
+        throw std::runtime_error(concat("Mask::fromWords: ", words.size(),
+                                        " words for a size of ", size));
+    }
+    Mask mask;
+    mask.words_ = std::move(words);
+    mask.size_ = size;
+    mask.clearTail();
+    return mask;
+}
+
+template <typename T, typename P>
+Mask Mask::from(const Serie<T> &serie, P &&predicate, ExecutionPolicy exec) {
+    const auto &values = serie.data();
+    if constexpr (std::is_invocable_v<P, const T &, size_t>) {
+        return generate(
+            values.size(), [&](size_t i) { return predicate(values[i], i); },
+            exec);
+    } else {
+        return generate(
+            values.size(), [&](size_t i) { return predicate(values[i]); },
+            exec);
+    }
+}
+
+inline bool Mask::test(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range(concat("Index ", index,
+                                       " is out of bounds (max is ", size_,
+                                       ") in Mask::test"));
+    }
+    return (*this)[index];
+}
+
+inline void Mask::push_back(bool value) {
+    if (size_ % WORD_BITS == 0) {
+        words_.push_back(0);
+    }
+    words_.back() |= Word{value} << (size_ % WORD_BITS);
+    ++size_;
+}
+
+inline void Mask::set(size_t index, bool value) {
+    if (index >= size_) {
+        throw std::out_of_range(concat("Index ", index,
+                                       " is out of bounds (max is ", size_,
+                                       ") in Mask::set"));
+    }
+    const Word bit = Word{1} << (index % WORD_BITS);
+    if (value) {
+        words_[index / WORD_BITS] |= bit;
+    } else {
+        words_[index / WORD_BITS] &= ~bit;
+    }
+}
+
+inline size_t Mask::count() const {
+    size_t n = 0;
+    for (Word w : words_) {
+        n += static_cast<size_t>(std::popcount(w));
+    }
+    return n;
+}
+
+inline bool Mask::any() const {
+    for (Word w : words_) {
+        if (w != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline Mask Mask::operator~() const {
+    Mask result(*this);
+    for (Word &w : result.words_) {
+        w = ~w;
+    }
+    result.clearTail();
+    return result;
+}
+
+inline void Mask::checkSize(const Mask &other, const char *op) const {
+    if (other.size_ != size_) {
+        throw std::runtime_error(concat("Mask size mismatch in operator", op,
+                                        " (", size_, " vs ", other.size_,
+                                        ")"));
+    }
+}
+
+inline Mask &Mask::operator&=(const Mask &other) {
+    checkSize(other, "&");
+    for (size_t w = 0; w < words_.size(); ++w) {
+        words_[w] &= other.words_[w];
+    }
+    return *this;
+}
+
+inline Mask &Mask::operator|=(const Mask &other) {
+    checkSize(other, "|");
+    for (size_t w = 0; w < words_.size(); ++w) {
+        words_[w] |= other.words_[w];
+    }
+    return *this;
+}
+
+inline Mask &Mask::operator^=(const Mask &other) {
+    checkSize(other, "^");
+    for (size_t w = 0; w < words_.size(); ++w) {
+        words_[w] ^= other.words_[w];
+    }
+    return *this;
+}
+
+template <typename F> void Mask::forEachSet(F &&callback) const {
+    for (size_t w = 0; w < words_.size(); ++w) {
+        Word word = words_[w];
+        while (word != 0) {
+            callback(w * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+            word &= word - 1; // clear the lowest set bit
+        }
+    }
+}
+
+inline std::vector<size_t> Mask::indices() const {
+    std::vector<size_t> result;
+    result.reserve(count());
+    forEachSet([&](size_t i) { result.push_back(i); });
+    return result;
+}
+
+inline Serie<bool> Mask::toSerie() const {
+    std::vector<bool> values(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        values[i] = (*this)[i];
+    }
+    return Serie<bool>(std::move(values));
+}
+
+template <typename T> Serie<T> Mask::select(const Serie<T> &serie) const {
+    if (serie.size() != size_) {
+        throw std::runtime_error(concat("Mask::select: mask size (", size_,
+                                        ") differs from serie size (",
+                                        serie.size(), ")"));
+    }
+
+    Serie<T> result = compact(serie.data());
+    if (!serie.validity().empty()) {
+        const Mask &valid = serie.validity();
+        Mask kept;
+        forEachSet([&](size_t i) { kept.push_back(valid[i]); });
+        result.setValidity(kept);
+    }
+    return result;
+}
+
+template <typename T>
+Serie<T> Mask::compact(const std::vector<T> &values) const {
+    const size_t num_chunks = detail::get_optimal_threads(size_);
+    auto serial = [&] {
+        std::vector<T> result;
+        result.reserve(count());
+        forEachSet([&](size_t i) { result.push_back(values[i]); });
+        return Serie<T>(std::move(result));
+    };
+
+    // Scattering into a std::vector<bool> from several threads is a race
+    if constexpr (std::is_same_v<T, bool> ||
+                  !std::is_default_constructible_v<T>) {
+        return serial();
+    } else if (num_chunks <= 1) {
+        return serial();
+    } else {
+        // Same chunking in both passes: chunk c covers the same words
+        std::vector<size_t> offsets(num_chunks + 1, 0);
+        detail::parallel_for_chunks(
+            words_.size(), num_chunks, [&](size_t c, size_t first, size_t last) {
+                size_t n = 0;
+                for (size_t w = first; w < last; ++w) {
+                    n += static_cast<size_t>(std::popcount(words_[w]));
+                }
+                offsets[c + 1] = n;
+            });
+        for (size_t c = 0; c < num_chunks; ++c) {
+            offsets[c + 1] += offsets[c];
+        }
+
+        std::vector<T> result(offsets[num_chunks]);
+        detail::parallel_for_chunks(
+            words_.size(), num_chunks, [&](size_t c, size_t first, size_t last) {
+                size_t out = offsets[c];
+                for (size_t w = first; w < last; ++w) {
+                    Word word = words_[w];
+                    while (word != 0) {
+                        const size_t i =
+                            w * WORD_BITS +
+                            static_cast<size_t>(std::countr_zero(word));
+                        result[out++] = values[i];
+                        word &= word - 1;
+                    }
+                }
+            });
+        return Serie<T>(std::move(result));
+    }
+}
+
+inline void Mask::clearTail() {
+    const size_t used = size_ % WORD_BITS;
+    if (used != 0) {
+        words_.back() &= (Word{1} << used) - 1;
+    }
+}
+
+// ----------------------------------------------------------------
+
+namespace detail {
+
+template <typename T, typename U, typename Op>
+Mask compare_scalar(const Serie<T> &serie, U value, Op op) {
+    const auto &values = serie.data();
+    return Mask::generate(values.size(),
+                          [&](size_t i) { return op(values[i], value); });
+}
+
+template <typename T, typename U, typename Op>
+Mask compare_series(const Serie<T> &a, const Serie<U> &b, Op op,
+                    const char *name) {
+    if (a.size() != b.size()) {
+        throw std::runtime_error(concat("Serie size mismatch in operator",
+                                        name, " (", a.size(), " vs ",
+                                        b.size(), ")"));
+    }
+    const auto &x = a.data();
+    const auto &y = b.data();
+    return Mask::generate(x.size(), [&](size_t i) { return op(x[i], y[i]); });
+}
+
+} // namespace detail
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<(const Serie<T> &serie, U value) {
+    return detail::compare_scalar(serie, value, std::less<>{});
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<=(const Serie<T> &serie, U value) {
+    return detail::compare_scalar(serie, value, std::less_equal<>{});
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>(const Serie<T> &serie, U value) {
+    return detail::compare_scalar(serie, value, std::greater<>{});
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>=(const Serie<T> &serie, U value) {
+    return detail::compare_scalar(serie, value, std::greater_equal<>{});
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator==(const Serie<T> &serie, U value) {
+    return detail::compare_scalar(serie, value, std::equal_to<>{});
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator!=(const Serie<T> &serie, U value) {
+    return detail::compare_scalar(serie, value, std::not_equal_to<>{});
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<(const Serie<T> &a, const Serie<U> &b) {
+    return detail::compare_series(a, b, std::less<>{}, "<");
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator<=(const Serie<T> &a, const Serie<U> &b) {
+    return detail::compare_series(a, b, std::less_equal<>{}, "<=");
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>(const Serie<T> &a, const Serie<U> &b) {
+    return detail::compare_series(a, b, std::greater<>{}, ">");
+}
+
+template <typename T, typename U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+Mask operator>=(const Serie<T> &a, const Serie<U> &b) {
+    return detail::compare_series(a, b, std::greater_equal<>{}, ">=");
+}
+
+} // namespace df
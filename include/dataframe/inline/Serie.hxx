@@ -23,6 +23,8 @@
 
 #include "../utils/demangle.h"
 #include "../utils/utils.h"
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <regex>
@@ -35,40 +37,86 @@ namespace df {
     {
         std::string result = name;
 
-        // List of the substitutions to clean the name
-        static const std::vector<std::pair<std::string, std::string>> substitutions = {
-            { "std::__1::", "std::" }, // Enlève le __1 de l'espace de nom std
-            { "std::vector<", "vector<" }, // Simplifie std::vector
-            { "std::array<", "array<" }, // Simplifie std::array
-            { ", std::allocator<[^>]+>>", ">" }, // Enlève l'allocator
-            { ", std::allocator<[^>]+>", ">" }, // Enlève l'allocator (cas simple)
-            { "ul", "" }, { "std::basic_string<char>", "string" }, // Simplifie basic_string
-            { "std::basic_string<char, std::char_traits<char>>",
-                "string" }, // Autre forme de string
+        // List of the substitutions to clean the name (compiled once)
+        static const std::vector<std::pair<std::regex, std::string>> substitutions = {
+            { std::regex("std::__1::"), "std::" }, // Enlève le __1 de l'espace de nom std
+            { std::regex("std::__cxx11::"), "std::" },
+            { std::regex("std::basic_string<char, std::char_traits<char>, std::allocator<char> ?>"),
+                "string" },
+            { std::regex("std::basic_string<char, std::char_traits<char> ?>"), "string" },
+            { std::regex("std::basic_string<char>"), "string" }, // Simplifie basic_string
+            { std::regex("std::vector<"), "vector<" }, // Simplifie std::vector
+            { std::regex("std::array<"), "array<" }, // Simplifie std::array
+            { std::regex(", std::allocator<[^>]+> ?>"), ">" }, // Enlève l'allocator
+            { std::regex("([0-9])ul\\b"), "$1" }, // Suffixe des tailles (3ul)
         };
 
         // Apply every substitution
         for (const auto& [pattern, replacement] : substitutions) {
-            result = std::regex_replace(result, std::regex(pattern), replacement);
+            result = std::regex_replace(result, pattern, replacement);
         }
 
         return result;
     }
 
+    /**
+     * @brief Readable name of T: the registered name for the column types
+     * (see utils/type_registry.h), otherwise the cleaned demangled name,
+     * computed once per type.
+     */
     template <typename T> inline std::string type_name()
     {
-        const char* mangled = typeid(T).name();
-        // int status = 0;
-        // std::unique_ptr<char, void (*)(void *)> demangled(
-        //     abi::__cxa_demangle(mangled, nullptr, nullptr, &status), std::free);
-        // return cleanup_type_name(status == 0 ? demangled.get() : mangled);
-        return cleanup_type_name(utils::demangle(mangled));
+        if constexpr (type_id<T> >= 0) {
+            return std::string(type_label<T>());
+        } else {
+            static const std::string name = cleanup_type_name(utils::demangle(typeid(T).name()));
+            return name;
+        }
+    }
+
+    namespace detail {
+        template <typename F, typename... Ts>
+        inline bool visit_column(const SerieBase& serie, F& f, type_list<Ts...>)
+        {
+            using Call = void (*)(const SerieBase&, F&);
+            static constexpr Call table[] = { [](const SerieBase& s, F& g) {
+                g(static_cast<const Serie<Ts>&>(s));
+            }... };
+            const int id = serie.typeId();
+            if (id < 0) {
+                return false;
+            }
+            table[id](serie, f);
+            return true;
+        }
+    } // namespace detail
+
+    template <typename F> inline bool visit(const SerieBase& serie, F&& f)
+    {
+        return detail::visit_column(serie, f, column_types {});
+    }
+
+    // ------------------------------------------------
+
+    inline uint64_t detail::SerieVersion::get() const
+    {
+        uint64_t value = load();
+        if (value == 0) {
+            static std::atomic<uint64_t> counter { 0 };
+            const uint64_t fresh = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+            // Another thread may have drawn one meanwhile: keep it
+            if (value_.compare_exchange_strong(value, fresh, std::memory_order_relaxed)) {
+                value = fresh;
+            }
+        }
+        return value;
     }
 
     // ------------------------------------------------
 
     template <typename T> inline typename Serie<T>::iterator Serie<T>::begin()
     {
+        version_.touch();
         return data_.begin();
     }
 
@@ -82,7 +130,11 @@ namespace df {
         return data_.cbegin();
     }
 
-    template <typename T> inline typename Serie<T>::iterator Serie<T>::end() { return data_.end(); }
+    template <typename T> inline typename Serie<T>::iterator Serie<T>::end()
+    {
+        version_.touch();
+        return data_.end();
+    }
 
     template <typename T> inline typename Serie<T>::const_iterator Serie<T>::end() const
     {
@@ -96,16 +148,21 @@ namespace df {
 
     template <typename T> inline void Serie<T>::reserve(size_t n) { data_.reserve(n); }
 
-    template <typename T> inline void Serie<T>::add(const T& value) { data_.push_back(value); }
-
-    template <typename T> inline Serie<T>::Serie(const ArrayType& values)
+    template <typename T> inline void Serie<T>::add(const T& value)
     {
-        data_.reserve(values.size());
-        for (const auto& v : values) {
-            data_.push_back(v);
+        version_.touch();
+        data_.push_back(value);
+        if (!validity_.empty()) {
+            validity_.push_back(true);
         }
     }
 
+    template <typename T>
+    inline Serie<T>::Serie(const ArrayType& values)
+        : data_(values)
+    {
+    }
+
     template <typename T> inline Serie<T>::Serie(const std::initializer_list<T>& values)
     {
         data_.reserve(values.size());
@@ -146,22 +203,25 @@ namespace df {
                 result.data_.push_back(static_cast<U>(value));
             }
         }
+        result.setValidity(validity_);
 
         return result;
     }
 
     template <typename T> inline std::string Serie<T>::type() const { return type_name<T>(); }
 
-    template <typename T> inline T& Serie<T>::operator[](size_t index)
+    template <typename T> inline typename Serie<T>::reference Serie<T>::operator[](size_t index)
     {
         if (index >= data_.size()) {
             throw std::out_of_range(concat("Index ", index, " is out of bounds (max is ",
                 data_.size(), ") in Serie::operator[]"));
         }
+        version_.touch();
         return data_[index];
     }
 
-    template <typename T> inline const T& Serie<T>::operator[](size_t index) const
+    template <typename T>
+    inline typename Serie<T>::const_reference Serie<T>::operator[](size_t index) const
     {
         if (index >= data_.size()) {
             throw std::out_of_range(concat("Index ", index, " is out of bounds (max is ",
@@ -176,11 +236,50 @@ namespace df {
             throw std::out_of_range(concat("Index ", index, " is out of bounds (max is ",
                 data_.size(), ") in Serie::set"));
         }
+        version_.touch();
         data_[index] = value;
     }
 
     template <typename T> inline size_t Serie<T>::size() const { return data_.size(); }
 
+    template <typename T>
+    inline std::shared_ptr<SerieBase> Serie<T>::gather(const std::vector<int64_t>& indices) const
+    {
+        if constexpr (!std::is_default_constructible_v<T>) {
+            throw std::runtime_error(
+                concat("Serie::gather: type ", type(), " is not default constructible"));
+        } else {
+            T missing {};
+            if constexpr (std::is_floating_point_v<T>) {
+                missing = std::numeric_limits<T>::quiet_NaN();
+            }
+
+            auto result = std::make_shared<Serie<T>>();
+            auto& out = result->data_;
+            out.reserve(indices.size());
+            const int64_t n = static_cast<int64_t>(data_.size());
+            bool nulls = false;
+            for (int64_t index : indices) {
+                if (index < 0) {
+                    out.push_back(missing);
+                    nulls = true;
+                } else if (index < n) {
+                    out.push_back(data_[static_cast<size_t>(index)]);
+                    nulls = nulls || isNull(static_cast<size_t>(index));
+                } else {
+                    throw std::out_of_range(concat("Index ", index,
+                        " is out of bounds (max is ", data_.size(), ") in Serie::gather"));
+                }
+            }
+            if (nulls) {
+                result->validity_ = Mask::generate(indices.size(), [&](size_t i) {
+                    return indices[i] >= 0 && isValid(static_cast<size_t>(indices[i]));
+                });
+            }
+            return result;
+        }
+    }
+
     template <typename T> template <typename F> inline void Serie<T>::forEach(F&& callback) const
     {
         if constexpr (std::is_invocable_v<F, const T&, size_t>) {
@@ -210,7 +309,9 @@ namespace df {
             for (size_t i = 0; i < data_.size(); ++i) {
                 result[i] = callback(data_[i], i);
             }
-            return Serie<ResultType>(result);
+            Serie<ResultType> serie(std::move(result));
+            serie.setValidity(validity_);
+            return serie;
         } else if constexpr (std::is_invocable_v<F, const T&>) {
             using ResultType = decltype(callback(data_[0]));
             std::vector<ResultType> result(data_.size());
@@ -218,7 +319,9 @@ namespace df {
             for (size_t i = 0; i < data_.size(); ++i) {
                 result[i] = callback(data_[i]);
             }
-            return Serie<ResultType>(result);
+            Serie<ResultType> serie(std::move(result));
+            serie.setValidity(validity_);
+            return serie;
         } else {
             static_assert(
                 std::is_invocable_v<F, const T&> || std::is_invocable_v<F, const T&, size_t>,
@@ -251,6 +354,74 @@ namespace df {
         }
     }
 
+    // ------------------------------------------------
+
+    template <typename T> inline T Serie<T>::missingValue()
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::numeric_limits<T>::quiet_NaN();
+        } else {
+            return T {};
+        }
+    }
+
+    template <typename T> inline bool Serie<T>::hasNulls() const { return nullCount() != 0; }
+
+    template <typename T> inline size_t Serie<T>::nullCount() const
+    {
+        return validity_.empty() ? 0 : validity_.size() - validity_.count();
+    }
+
+    template <typename T> inline bool Serie<T>::isNull(size_t index) const
+    {
+        return !validity_.empty() && !validity_[index];
+    }
+
+    template <typename T> inline void Serie<T>::setNull(size_t index, bool null)
+    {
+        if (index >= data_.size()) {
+            throw std::out_of_range(concat("Index ", index, " is out of bounds (max is ",
+                data_.size(), ") in Serie::setNull"));
+        }
+        version_.touch();
+        if (validity_.empty()) {
+            if (!null) {
+                return;
+            }
+            validity_ = Mask(data_.size(), true);
+        }
+        validity_.set(index, !null);
+        if (null) {
+            data_[index] = missingValue();
+        }
+    }
+
+    template <typename T> inline void Serie<T>::addNull()
+    {
+        version_.touch();
+        if (validity_.empty()) {
+            validity_ = Mask(data_.size(), true);
+        }
+        data_.push_back(missingValue());
+        validity_.push_back(false);
+    }
+
+    template <typename T> inline void Serie<T>::setValidity(const Mask& validity)
+    {
+        if (!validity.empty() && validity.size() != data_.size()) {
+            throw std::runtime_error(concat("Serie::setValidity: mask size (", validity.size(),
+                ") differs from serie size (", data_.size(), ")"));
+        }
+        version_.touch();
+        // No bitmap when every value is valid
+        validity_ = validity.all() ? Mask() : validity;
+    }
+
+    template <typename T> inline Serie<T> Serie<T>::dropNulls() const
+    {
+        return hasNulls() ? validity_.select(*this) : *this;
+    }
+
 } // namespace df
 
 // -----------------------------------------------
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#include <dataframe/utils/utils.h>
+#include <functional>
+#include <stdexcept>
+
+namespace df {
+
+inline StringSerie::StringSerie(std::initializer_list<std::string_view> values) {
+    size_t bytes = 0;
+    for (std::string_view value : values) {
+        bytes += value.size();
+    }
+    reserve(values.size(), bytes);
+    for (std::string_view value : values) {
+        add(value);
+    }
+}
+
+inline StringSerie::StringSerie(const Serie<std::string> &serie) {
+    const auto &values = serie.data();
+    size_t bytes = 0;
+    for (const auto &value : values) {
+        bytes += value.size();
+    }
+    reserve(values.size(), bytes);
+    for (const auto &value : values) {
+        add(value);
+    }
+    validity_ = serie.validity();
+}
+
+inline void StringSerie::reserve(size_t n, size_t bytes) {
+    offsets_.reserve(n + 1);
+    bytes_.reserve(bytes);
+}
+
+inline void StringSerie::add(std::string_view value) {
+    bytes_.insert(bytes_.end(), value.begin(), value.end());
+    offsets_.push_back(bytes_.size());
+    if (!validity_.empty()) {
+        validity_.push_back(true);
+    }
+}
+
+inline void StringSerie::addNull() {
+    if (validity_.empty()) {
+        validity_ = Mask(size(), true);
+    }
+    offsets_.push_back(bytes_.size());
+    validity_.push_back(false);
+}
+
+inline std::string_view StringSerie::operator[](size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range(concat("Index ", index,
+                                       " is out of bounds (max is ", size(),
+                                       ") in StringSerie::operator[]"));
+    }
+    return view(index);
+}
+
+inline bool StringSerie::hasNulls() const { return nullCount() != 0; }
+
+inline size_t StringSerie::nullCount() const {
+    return validity_.empty() ? 0 : validity_.size() - validity_.count();
+}
+
+inline bool StringSerie::isNull(size_t index) const {
+    return !validity_.empty() && !validity_[index];
+}
+
+inline void StringSerie::setValidity(const Mask &validity) {
+    if (!validity.empty() && validity.size() != size()) {
+        throw std::runtime_error(concat("StringSerie::setValidity: mask size (",
+                                        validity.size(),
+                                        ") differs from serie size (", size(),
+                                        ")"));
+    }
+    validity_ = validity.all() ? Mask() : validity;
+}
+
+inline std::shared_ptr<SerieBase>
+StringSerie::gather(const std::vector<int64_t> &indices) const {
+    const int64_t n = static_cast<int64_t>(size());
+    size_t bytes = 0;
+    for (int64_t index : indices) {
+        if (index >= n) {
+            throw std::out_of_range(concat("Index ", index,
+                                           " is out of bounds (max is ", n,
+                                           ") in StringSerie::gather"));
+        }
+        if (index >= 0) {
+            bytes += view(static_cast<size_t>(index)).size();
+        }
+    }
+
+    auto result = std::make_shared<StringSerie>();
+    result->reserve(indices.size(), bytes);
+    for (int64_t index : indices) {
+        if (index < 0 || isNull(static_cast<size_t>(index))) {
+            result->addNull();
+        } else {
+            result->add(view(static_cast<size_t>(index)));
+        }
+    }
+    return result;
+}
+
+inline StringSerie StringSerie::select(const Mask &mask) const {
+    if (mask.size() != size()) {
+        throw std::runtime_error(concat("StringSerie::select: mask size (",
+                                        mask.size(),
+                                        ") differs from serie size (", size(),
+                                        ")"));
+    }
+    size_t bytes = 0;
+    mask.forEachSet([&](size_t i) { bytes += view(i).size(); });
+
+    StringSerie result;
+    result.reserve(mask.count(), bytes);
+    mask.forEachSet([&](size_t i) {
+        if (isNull(i)) {
+            result.addNull();
+        } else {
+            result.add(view(i));
+        }
+    });
+    return result;
+}
+
+inline Serie<std::string> StringSerie::toSerie() const {
+    std::vector<std::string> values;
+    values.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        values.emplace_back(view(i));
+    }
+    Serie<std::string> result(std::move(values));
+    result.setValidity(validity_);
+    return result;
+}
+
+template <typename F> inline void StringSerie::forEach(F &&callback) const {
+    for (size_t i = 0; i < size(); ++i) {
+        if constexpr (std::is_invocable_v<F, std::string_view, size_t>) {
+            callback(view(i), i);
+        } else {
+            callback(view(i));
+        }
+    }
+}
+
+inline size_t StringSerie::hash(size_t index) const {
+    return std::hash<std::string_view>{}(view(index));
+}
+
+inline int StringSerie::compare(size_t i, size_t j) const {
+    return view(i).compare(view(j));
+}
+
+} // namespace df
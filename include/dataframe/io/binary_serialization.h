@@ -24,6 +24,7 @@
 #pragma once
 #include <cstdint>
 #include <dataframe/Serie.h>
+#include <dataframe/StringSerie.h>
 #include <fstream>
 #include <functional>
 #include <memory>
@@ -118,6 +119,23 @@ namespace df {
         template <typename T> bool save(const Serie<T>& serie, const std::string&);
         template <typename T> bool save(const Serie<T>& serie, std::ostream& os);
 
+        /**
+         * @brief Serialize a StringSerie, in the format of a Serie<std::string>
+         * (it can be read back by load<std::string>() or load_strings())
+         */
+        bool save(const StringSerie& serie, const std::string& filename);
+        bool save(const StringSerie& serie, std::ostream& os);
+
+        /**
+         * @brief Deserialize a Serie<std::string> file directly into a
+         * StringSerie, without one allocation per value
+         *
+         * @throws std::runtime_error If the file cannot be opened or read
+         * @throws std::runtime_error If the file does not contain strings
+         */
+        StringSerie load_strings(const std::string& filename);
+        StringSerie load_strings(std::istream& is);
+
         /**
          * @brief Deserialize a Serie from a binary file with explicit type
          *
@@ -24,6 +24,8 @@
 #pragma once
 #include <dataframe/Dataframe.h>
 #include <dataframe/Serie.h>
+#include <map>
+#include <memory>
 
 namespace df {
     namespace io {
@@ -42,6 +44,16 @@ namespace df {
             bool skip_empty_lines = true;
             std::string null_value = "NA";
             size_t skip_rows = 0;
+            // Read the string columns as StringSerie (one contiguous byte
+            // buffer per column) instead of Serie<std::string>
+            bool string_arena = false;
+            // Read the string columns with at most max_categories distinct
+            // values as CategoricalSerie (0: never)
+            size_t max_categories = 0;
+            // Dictionary of some columns, by name. These columns are always
+            // read as CategoricalSerie, and their dictionary is extended: the
+            // files read with the same options share the codes
+            std::map<std::string, std::shared_ptr<Dictionary>> dictionaries {};
         };
 
         /**
@@ -54,7 +66,10 @@ namespace df {
          * Supported column types and their corresponding Serie types:
          * - Integer values -> Serie<int64_t>
          * - Floating-point values -> Serie<double>
-         * - Text/Mixed values -> Serie<std::string>
+         * - Text/Mixed values -> Serie<std::string>, or StringSerie if
+         *   options.string_arena is set
+         * - Low-cardinality text (options.max_categories) and the columns of
+         *   options.dictionaries -> CategoricalSerie
          *
          * @param filename Path to the CSV file to read
          * @param options Configuration options for CSV parsing (optional)
@@ -66,6 +81,10 @@ namespace df {
          *         - CSV parsing fails
          *         - Column type detection fails
          *
+         * @note Empty fields and fields equal to options.null_value give
+         * nulls (see Serie::validity()) in the numeric columns. In the string
+         * columns, only options.null_value does.
+         *
          * @note Type detection is performed by analyzing all values in each column:
          *       - If all values can be parsed as integers -> int64_t
          *       - If all values can be parsed as numbers but some have decimals ->
@@ -118,7 +137,8 @@ namespace df {
          *         - Writing operation fails
          *
          * @note
-         * - Empty values in string Series are written as the specified null_value
+         * - Null values, and empty values in string Series, are written as the
+         * specified null_value
          * - String values containing the delimiter, quotes, or newlines are
          * automatically quoted
          * - Quotes within string values are escaped by doubling them
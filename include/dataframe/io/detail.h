@@ -22,8 +22,11 @@
  */
 
 #pragma once
+#include <dataframe/CategoricalSerie.h>
 #include <dataframe/Serie.h>
+#include <dataframe/StringSerie.h>
 #include <dataframe/types.h>
+#include <charconv>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -39,10 +42,21 @@ namespace df {
             std::vector<std::string> split_line(
                 const std::string& line, char delimiter, char quote);
 
-            template <typename T> Serie<T> parse_column(const std::vector<std::string>& values);
+            // Parse the raw fields of a column. Empty values (and null_value)
+            // give nulls, except for strings where only null_value does
+            template <typename T>
+            Serie<T> parse_column(const StringSerie& values, const std::string& null_value = "");
 
-            std::type_index infer_column_type(
-                const std::vector<std::string>& values, bool all_double = false);
+            StringSerie parse_strings(const StringSerie& values, const std::string& null_value = "");
+
+            // Encode the values with dictionary. Returns nullptr if the
+            // dictionary would exceed max_categories values (0: no limit)
+            std::shared_ptr<CategoricalSerie> parse_categories(const StringSerie& values,
+                const std::string& null_value, std::shared_ptr<Dictionary> dictionary,
+                size_t max_categories = 0);
+
+            std::type_index infer_column_type(const StringSerie& values, bool all_double = false,
+                const std::string& null_value = "");
 
             template <typename T> std::string format_value(const T& value);
 
@@ -37,8 +37,8 @@ namespace detail {
 // Magic number for endian detection
 constexpr uint32_t ENDIAN_MAGIC = 0x01020304;
 
-// File format version
-constexpr uint32_t CURRENT_VERSION = 2;
+// File format version. Version 3 adds the validity bitmap after the values
+constexpr uint32_t CURRENT_VERSION = 3;
 
 // File header signature ("DFSR" in ASCII)
 constexpr uint32_t FILE_SIGNATURE = 0x44465352;
@@ -240,6 +240,31 @@ inline void write_value(std::ostream &ofs, T value, bool swap_needed) {
     ofs.write(reinterpret_cast<const char *>(&value), sizeof(T));
 }
 
+// Validity section (version 3+): a uint8_t flag, followed by the words of the
+// validity bitmap if the Serie has nulls
+inline void write_validity(std::ostream &os, const Mask &validity) {
+    write_value<uint8_t>(os, validity.empty() ? 0 : 1, false);
+    for (uint64_t word : validity.words()) {
+        write_value(os, word, false);
+    }
+}
+
+inline Mask read_validity(std::istream &is, const FileHeader &header,
+                          bool swap_needed) {
+    if (header.version < 3 || read_value<uint8_t>(is, swap_needed) == 0) {
+        return Mask();
+    }
+    std::vector<uint64_t> words((header.elements + Mask::WORD_BITS - 1) /
+                                Mask::WORD_BITS);
+    for (auto &word : words) {
+        word = read_value<uint64_t>(is, swap_needed);
+    }
+    if (!is) {
+        throw std::runtime_error("Invalid file format: truncated validity");
+    }
+    return Mask::fromWords(std::move(words), header.elements);
+}
+
 // Write standard array with potential endian conversion
 template <typename T, size_t N>
 inline void write_array(std::ofstream &ofs, const std::array<T, N> &arr,
@@ -426,6 +451,9 @@ class SerieFactory {
     void registerBuiltinTypes();
 
     std::vector<std::unique_ptr<SerieCreator>> creators_;
+    // Creator of each built-in TypeCode: the type code in the header selects
+    // it directly, without trying the creators one by one
+    std::array<const SerieCreator *, 256> builtins_{};
 };
 
 // =========================================================================
@@ -465,10 +493,106 @@ inline bool save(const Serie<T> &serie, std::ostream &os) {
     for (size_t i = 0; i < serie.size(); ++i) {
         detail::serializer<T>::write(os, serie[i], false);
     }
+    detail::write_validity(os, serie.validity());
 
     return os.good();
 }
 
+inline bool save(const StringSerie &serie, const std::string &filename) {
+    std::ofstream ofs(filename, std::ios::binary);
+    if (!ofs) {
+        throw std::runtime_error("Failed to open file for writing: " +
+                                 filename);
+    }
+    return save(serie, ofs);
+}
+
+inline bool save(const StringSerie &serie, std::ostream &os) {
+    // Same layout as a Serie<std::string>
+    detail::FileHeader header;
+    header.signature = detail::FILE_SIGNATURE;
+    header.version = detail::CURRENT_VERSION;
+    header.endian_check = detail::ENDIAN_MAGIC;
+    header.elements = serie.size();
+    header.type_code = static_cast<uint8_t>(detail::TypeCode::String);
+
+    std::string type_name = detail::TypeNameRegistry::getName<std::string>();
+    header.type_hash = detail::get_type_hash(typeid(std::string));
+    header.type_name_size = type_name.size();
+
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    os.write(type_name.data(), type_name.size());
+
+    for (size_t i = 0; i < serie.size(); ++i) {
+        const std::string_view value = serie.view(i);
+        detail::write_value<uint64_t>(os, value.size(), false);
+        os.write(value.data(), value.size());
+    }
+    detail::write_validity(os, serie.validity());
+
+    return os.good();
+}
+
+inline StringSerie load_strings(const std::string &filename) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs) {
+        throw std::runtime_error("Failed to open file for reading: " +
+                                 filename);
+    }
+    return load_strings(ifs);
+}
+
+inline StringSerie load_strings(std::istream &is) {
+    detail::FileHeader header;
+    is.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+    if (header.signature != detail::FILE_SIGNATURE) {
+        throw std::runtime_error("Invalid file format: incorrect signature");
+    }
+    if (header.version > detail::CURRENT_VERSION) {
+        throw std::runtime_error(
+            "File was created with a newer version of the library");
+    }
+
+    bool swap_needed =
+        (header.endian_check == detail::ENDIAN_MAGIC) !=
+        detail::is_little_endian();
+    if (swap_needed) {
+        header.elements = detail::swap_endian(header.elements);
+        header.type_hash = detail::swap_endian(header.type_hash);
+        header.type_name_size = detail::swap_endian(header.type_name_size);
+    }
+
+    std::string type_name(header.type_name_size, '\0');
+    if (header.type_name_size > 0) {
+        is.read(&type_name[0], header.type_name_size);
+    }
+
+    if (header.type_code != static_cast<uint8_t>(detail::TypeCode::String)) {
+        std::string msg = "Type mismatch: file does not contain strings";
+        if (!type_name.empty()) {
+            msg += " (file type: " + type_name + ")";
+        }
+        throw std::runtime_error(msg);
+    }
+
+    // The values are read in one reused buffer and appended to the arena
+    StringSerie serie;
+    serie.reserve(header.elements);
+    std::string buffer;
+    for (size_t i = 0; i < header.elements; ++i) {
+        const uint64_t size = detail::read_value<uint64_t>(is, swap_needed);
+        buffer.resize(size);
+        is.read(buffer.data(), size);
+        if (!is) {
+            throw std::runtime_error("Invalid file format: truncated data");
+        }
+        serie.add(buffer);
+    }
+    serie.setValidity(detail::read_validity(is, header, swap_needed));
+    return serie;
+}
+
 template <typename T> Serie<T> inline load(const std::string &filename) {
     std::ifstream ifs(filename, std::ios::binary);
     if (!ifs) {
@@ -537,7 +661,9 @@ template <typename T> Serie<T> inline load(std::istream &is) {
         data.push_back(detail::serializer<T>::read(is, swap_needed));
     }
 
-    return Serie<T>(data);
+    Serie<T> serie(std::move(data));
+    serie.setValidity(detail::read_validity(is, header, swap_needed));
+    return serie;
 }
 
 inline std::shared_ptr<SerieBase> load(std::istream &is) {
@@ -692,7 +818,9 @@ TypedSerieCreator<T>::create(std::istream &is, const detail::FileHeader &header,
         data.push_back(detail::serializer<T>::read(is, swap_needed));
     }
 
-    return std::make_shared<Serie<T>>(data);
+    auto serie = std::make_shared<Serie<T>>(std::move(data));
+    serie->setValidity(detail::read_validity(is, header, swap_needed));
+    return serie;
 }
 
 template <typename T>
@@ -734,7 +862,9 @@ CustomSerieCreator<T>::create(std::istream &is,
         data.push_back(readFunc_(is, swap_needed));
     }
 
-    return std::make_shared<Serie<T>>(data);
+    auto serie = std::make_shared<Serie<T>>(std::move(data));
+    serie->setValidity(detail::read_validity(is, header, swap_needed));
+    return serie;
 }
 
 template <typename T>
@@ -768,6 +898,13 @@ inline std::shared_ptr<SerieBase>
 SerieFactory::createSerie(std::istream &is, const detail::FileHeader &header,
                           bool swap_needed,
                           const std::string &type_name) const {
+    if (header.type_code !=
+        static_cast<uint8_t>(detail::TypeCode::Custom)) {
+        if (const SerieCreator *creator = builtins_[header.type_code]) {
+            return creator->create(is, header, swap_needed);
+        }
+    }
+
     // Find the appropriate creator based on type name or hash
     for (const auto &creator : creators_) {
         if (creator->canHandle(type_name, header.type_hash)) {
@@ -780,6 +917,10 @@ SerieFactory::createSerie(std::istream &is, const detail::FileHeader &header,
 
 template <typename T> void SerieFactory::registerType() {
     creators_.push_back(std::make_unique<TypedSerieCreator<T>>());
+    constexpr auto code = detail::get_type_code<T>();
+    if constexpr (code != detail::TypeCode::Custom) {
+        builtins_[static_cast<uint8_t>(code)] = creators_.back().get();
+    }
 }
 
 template <typename T>
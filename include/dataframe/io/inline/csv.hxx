@@ -24,6 +24,7 @@
 #include "../detail.h"
 #include <dataframe/types.h>
 #include <fstream>
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -40,7 +41,8 @@ inline Dataframe read_csv(const std::string &filename,
     Dataframe df;
     std::string line;
     std::vector<std::string> headers;
-    std::map<std::string, std::vector<std::string>> columns;
+    // Raw fields, one arena per column (no allocation per field)
+    std::map<std::string, StringSerie> columns;
 
     // Skip initial rows
     for (size_t i = 0; i < options.skip_rows; ++i) {
@@ -84,22 +86,46 @@ inline Dataframe read_csv(const std::string &filename,
 
         // Store fields in columns
         for (size_t i = 0; i < std::min(headers.size(), fields.size()); ++i) {
-            columns[headers[i]].push_back(
-                fields[i] == options.null_value ? "" : fields[i]);
+            columns[headers[i]].add(fields[i]);
         }
     }
 
     // Convert columns to Series
     for (const auto &header : headers) {
         const auto &values = columns[header];
-        auto type = detail::infer_column_type(values, options.all_double);
+        auto dictionary = options.dictionaries.find(header);
+        if (dictionary != options.dictionaries.end()) {
+            df.add(header, detail::parse_categories(values, options.null_value,
+                                                    dictionary->second));
+            continue;
+        }
+
+        auto type = detail::infer_column_type(values, options.all_double,
+                                              options.null_value);
 
         if (type == typeid(int64_t)) {
-            df.add(header, detail::parse_column<int64_t>(values));
+            df.add(header,
+                   detail::parse_column<int64_t>(values, options.null_value));
         } else if (type == typeid(double)) {
-            df.add(header, detail::parse_column<double>(values));
+            df.add(header,
+                   detail::parse_column<double>(values, options.null_value));
         } else {
-            df.add(header, detail::parse_column<std::string>(values));
+            std::shared_ptr<CategoricalSerie> categories;
+            if (options.max_categories > 0) {
+                categories = detail::parse_categories(
+                    values, options.null_value, std::make_shared<Dictionary>(),
+                    options.max_categories);
+            }
+            if (categories) {
+                df.add(header, categories);
+            } else if (options.string_arena) {
+                df.add(header, std::make_shared<StringSerie>(
+                                   detail::parse_strings(values,
+                                                         options.null_value)));
+            } else {
+                df.add(header, detail::parse_column<std::string>(
+                                   values, options.null_value));
+            }
         }
     }
 
@@ -126,26 +152,67 @@ inline void write_csv(const Dataframe &df, std::ostream &os,
     // Get number of rows from first serie
     size_t num_rows = df.begin()->second.data->size();
 
+    // Resolve the columns once, not per cell
+    std::vector<std::function<void(size_t)>> writers;
+    for (const auto &serie_pair : df) {
+        std::function<void(size_t)> writer = [](size_t) {};
+        if (const auto *strings =
+                dynamic_cast<const StringSerie *>(serie_pair.second.data.get())) {
+            writer = [&os, &options, strings](size_t row) {
+                const std::string_view value = strings->view(row);
+                os << (value.empty() || strings->isNull(row)
+                           ? options.null_value
+                           : detail::format_value(std::string(value)));
+            };
+            writers.push_back(std::move(writer));
+            continue;
+        }
+        if (const auto *categories = dynamic_cast<const CategoricalSerie *>(
+                serie_pair.second.data.get())) {
+            // Each distinct value is formatted once
+            std::vector<std::string> formatted;
+            for (const auto &value : categories->dictionary()->values()) {
+                formatted.push_back(value.empty() ? options.null_value
+                                                  : detail::format_value(value));
+            }
+            writer = [&os, &options, categories,
+                      formatted = std::move(formatted)](size_t row) {
+                os << (categories->isNull(row)
+                           ? options.null_value
+                           : formatted[categories->code(row)]);
+            };
+            writers.push_back(std::move(writer));
+            continue;
+        }
+        visit(*serie_pair.second.data, [&](const auto &serie) {
+            using T = typename std::decay_t<decltype(serie)>::value_type;
+            if constexpr (std::is_same_v<T, std::string>) {
+                writer = [&os, &options, &serie](size_t row) {
+                    const std::string &value = serie.data()[row];
+                    os << (value.empty() || serie.isNull(row)
+                               ? options.null_value
+                               : detail::format_value(value));
+                };
+            } else if constexpr (std::is_same_v<T, int64_t> ||
+                                 std::is_same_v<T, double>) {
+                writer = [&os, &options, &serie](size_t row) {
+                    if (serie.isNull(row)) {
+                        os << options.null_value;
+                    } else {
+                        os << detail::format_value(serie.data()[row]);
+                    }
+                };
+            }
+        });
+        writers.push_back(std::move(writer));
+    }
+
     // Write data rows
     for (size_t row = 0; row < num_rows; ++row) {
-        bool first = true;
-        for (const auto &serie_pair : df) {
-            if (!first)
+        for (size_t c = 0; c < writers.size(); ++c) {
+            if (c > 0)
                 os << options.delimiter;
-
-            const auto &name = serie_pair.first;
-            const auto &serie_type = df.type(name);
-
-            if (serie_type == typeid(Serie<int64_t>)) {
-                os << detail::format_value(df.get<int64_t>(name)[row]);
-            } else if (serie_type == typeid(Serie<double>)) {
-                os << detail::format_value(df.get<double>(name)[row]);
-            } else if (serie_type == typeid(Serie<std::string>)) {
-                std::string value = df.get<std::string>(name)[row];
-                os << (value.empty() ? options.null_value
-                                     : detail::format_value(value));
-            }
-            first = false;
+            writers[c](row);
         }
         os << '\n';
     }
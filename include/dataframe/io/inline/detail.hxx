@@ -54,21 +54,39 @@ inline std::vector<std::string> split_line(const std::string &line,
     return fields;
 }
 
+// Number at the beginning of text (a leading '+' is accepted, as with
+// std::stod)
 template <typename T>
-inline Serie<T> parse_column(const std::vector<std::string> &values) {
+inline bool parse_number(std::string_view text, T &value, bool whole = true) {
+    if (!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    const char *last = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), last, value);
+    return ec == std::errc() && (!whole || ptr == last);
+}
+
+template <typename T>
+inline Serie<T> parse_column(const StringSerie &values,
+                             const std::string &null_value) {
     Serie<T> serie;
     serie.reserve(values.size());
 
-    for (const auto &value : values) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        const std::string_view value = values.view(i);
+        const bool null = !null_value.empty() && value == null_value;
         if constexpr (std::is_same_v<T, std::string>) {
-            serie.add(value);
+            if (null) {
+                serie.addNull();
+            } else {
+                serie.add(std::string(value));
+            }
         } else if constexpr (std::is_arithmetic_v<T>) {
-            if (value.empty()) {
-                serie.add(T{});
+            if (value.empty() || null) {
+                serie.addNull();
             } else {
-                std::istringstream iss(value);
-                T parsed_value;
-                iss >> parsed_value;
+                T parsed_value{};
+                parse_number(value, parsed_value, false);
                 serie.add(parsed_value);
             }
         }
@@ -76,8 +94,44 @@ inline Serie<T> parse_column(const std::vector<std::string> &values) {
     return serie;
 }
 
-inline std::type_index
-infer_column_type(const std::vector<std::string> &values, bool all_double) {
+inline StringSerie parse_strings(const StringSerie &values,
+                                 const std::string &null_value) {
+    StringSerie serie;
+    serie.reserve(values.size(), values.bytes().size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        const std::string_view value = values.view(i);
+        if (!null_value.empty() && value == null_value) {
+            serie.addNull();
+        } else {
+            serie.add(value);
+        }
+    }
+    return serie;
+}
+
+inline std::shared_ptr<CategoricalSerie>
+parse_categories(const StringSerie &values, const std::string &null_value,
+                 std::shared_ptr<Dictionary> dictionary,
+                 size_t max_categories) {
+    auto serie = std::make_shared<CategoricalSerie>(dictionary);
+    serie->reserve(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        const std::string_view value = values.view(i);
+        if (!null_value.empty() && value == null_value) {
+            serie->addNull();
+            continue;
+        }
+        serie->add(value);
+        if (max_categories > 0 && dictionary->size() > max_categories) {
+            return nullptr;
+        }
+    }
+    return serie;
+}
+
+inline std::type_index infer_column_type(const StringSerie &values,
+                                         bool all_double,
+                                         const std::string &null_value) {
     bool could_be_int = true;
     bool could_be_double = true;
 
@@ -85,23 +139,19 @@ infer_column_type(const std::vector<std::string> &values, bool all_double) {
         return typeid(double);
     }
 
-    for (const auto &value : values) {
-        if (value.empty())
+    for (size_t i = 0; i < values.size(); ++i) {
+        const std::string_view value = values.view(i);
+        if (value.empty() || (!null_value.empty() && value == null_value))
             continue;
 
-        try {
-            std::size_t pos;
-            std::stoll(value, &pos);
-            if (pos != value.length())
-                could_be_int = false;
-        } catch (...) {
-            could_be_int = false;
+        if (could_be_int) {
+            int64_t parsed;
+            could_be_int = parse_number(value, parsed);
         }
 
         if (!could_be_int) {
-            try {
-                std::stod(value);
-            } catch (...) {
+            double parsed;
+            if (!parse_number(value, parsed, false)) {
                 could_be_double = false;
                 break;
             }
@@ -25,6 +25,7 @@
 #include "../nlohmann/json.hpp"
 #include <dataframe/types.h>
 #include <fstream>
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -66,7 +67,7 @@ inline bool is_numeric_array(const std::vector<nlohmann::json> &values,
 }
 } // namespace detail
 
-inline Dataframe read_json(const std::string &filename) {
+inline Dataframe read_json(const std::string &filename, bool string_arena) {
     std::ifstream file(filename);
     if (!file) {
         throw std::runtime_error("Cannot open file: " + filename);
@@ -100,6 +101,14 @@ inline Dataframe read_json(const std::string &filename) {
         // Check if all values are strings
         if (std::all_of(values.begin(), values.end(),
                         [](const auto &v) { return v.is_string(); })) {
+            if (string_arena) {
+                auto serie = std::make_shared<StringSerie>();
+                for (const auto &value : values) {
+                    serie->add(value.get_ref<const std::string &>());
+                }
+                df.add(key, serie);
+                continue;
+            }
             Serie<std::string> serie;
             serie.reserve(values.size());
             for (const auto &value : values) {
@@ -161,21 +170,43 @@ void write_json(const Dataframe &df, std::ostream &file, bool pretty) {
     nlohmann::json j = nlohmann::json::array();
     size_t num_rows = df.begin()->second.data->size();
 
+    // Resolve the columns once, not per cell
+    std::vector<std::function<void(nlohmann::json &, size_t)>> writers;
+    for (const auto &serie_pair : df) {
+        const auto &name = serie_pair.first;
+        if (const auto *strings =
+                dynamic_cast<const StringSerie *>(serie_pair.second.data.get())) {
+            writers.push_back([&name, strings](nlohmann::json &obj, size_t row) {
+                obj[name] = strings->view(row);
+            });
+            continue;
+        }
+        if (const auto *categories = dynamic_cast<const CategoricalSerie *>(
+                serie_pair.second.data.get())) {
+            writers.push_back(
+                [&name, categories](nlohmann::json &obj, size_t row) {
+                    obj[name] = (*categories)[row];
+                });
+            continue;
+        }
+        visit(*serie_pair.second.data, [&](const auto &serie) {
+            using T = typename std::decay_t<decltype(serie)>::value_type;
+            if constexpr (std::is_same_v<T, int64_t> ||
+                          std::is_same_v<T, double> ||
+                          std::is_same_v<T, std::string>) {
+                writers.push_back(
+                    [&name, &serie](nlohmann::json &obj, size_t row) {
+                        obj[name] = serie.data()[row];
+                    });
+            }
+        });
+    }
+
     // Create array of objects format
     for (size_t row = 0; row < num_rows; ++row) {
         nlohmann::json row_obj;
-
-        for (const auto &serie_pair : df) {
-            const auto &name = serie_pair.first;
-            const auto &serie_type = df.type(name);
-
-            if (serie_type == typeid(Serie<int64_t>)) {
-                row_obj[name] = df.get<int64_t>(name)[row];
-            } else if (serie_type == typeid(Serie<double>)) {
-                row_obj[name] = df.get<double>(name)[row];
-            } else if (serie_type == typeid(Serie<std::string>)) {
-                row_obj[name] = df.get<std::string>(name)[row];
-            }
+        for (const auto &write : writers) {
+            write(row_obj, row);
         }
         j.push_back(row_obj);
     }
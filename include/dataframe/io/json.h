@@ -46,6 +46,8 @@ namespace df {
          * json.dump())
          *
          * @param filename Path to the JSON file to read
+         * @param string_arena Read the string columns as StringSerie instead of
+         * Serie<std::string>
          *
          * @return Dataframe containing the data from the JSON file
          *
@@ -73,7 +75,7 @@ namespace df {
          *     std::cerr << "Error reading JSON: " << e.what() << std::endl;
          * }
          */
-        Dataframe read_json(const std::string& filename);
+        Dataframe read_json(const std::string& filename, bool string_arena = false);
 
         /**
          * @brief Writes a Dataframe to a JSON file
@@ -34,9 +34,9 @@ template <typename T> class NanInterpolator {
         // Create a copy of the input serie
         std::vector<T> result(serie.data());
 
-        // Find spans of NaN values
+        // Find spans of NaN or null values
         std::vector<std::pair<size_t, size_t>> nan_spans;
-        find_nan_spans(result, nan_spans);
+        find_nan_spans(result, serie.validity(), nan_spans);
 
         // Process each span based on chosen method
         for (const auto &span : nan_spans) {
@@ -48,12 +48,14 @@ template <typename T> class NanInterpolator {
 
   private:
     static void find_nan_spans(const std::vector<T> &data,
+                               const Mask &validity,
                                std::vector<std::pair<size_t, size_t>> &spans) {
         size_t start = 0;
         bool in_span = false;
+        const bool has_validity = !validity.empty();
 
         for (size_t i = 0; i < data.size(); ++i) {
-            if (std::isnan(data[i])) {
+            if (std::isnan(data[i]) || (has_validity && !validity[i])) {
                 if (!in_span) {
                     start = i;
                     in_span = true;
@@ -114,10 +116,22 @@ template <typename T> class NanInterpolator {
         T start_val = *before;
         T end_val = *after;
         size_t steps = end - start + 2;
-        T step_size = (end_val - start_val) / static_cast<T>(steps);
 
-        for (size_t i = 0; i <= (end - start); ++i) {
-            data[start + i] = start_val + step_size * static_cast<T>(i + 1);
+        if constexpr (std::is_integral_v<T>) {
+            // Interpolate in double precision, then round
+            const double step_size =
+                (static_cast<double>(end_val) - static_cast<double>(start_val)) /
+                static_cast<double>(steps);
+            for (size_t i = 0; i <= (end - start); ++i) {
+                data[start + i] = static_cast<T>(
+                    std::llround(static_cast<double>(start_val) +
+                                 step_size * static_cast<double>(i + 1)));
+            }
+        } else {
+            T step_size = (end_val - start_val) / static_cast<T>(steps);
+            for (size_t i = 0; i <= (end - start); ++i) {
+                data[start + i] = start_val + step_size * static_cast<T>(i + 1);
+            }
         }
     }
 
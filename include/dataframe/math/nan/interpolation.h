@@ -37,7 +37,11 @@ enum class FillMethod {
     MEAN      // Use mean of neighboring valid values
 };
 
-// Helper function
+/**
+ * @brief Fill the NaN and the null values (see Serie::validity()). The
+ * result has no null. Integer series are interpolated in double precision,
+ * then rounded.
+ */
 template <typename T>
 Serie<T> interpolate(const Serie<T> &serie,
                      FillMethod method = FillMethod::LINEAR);
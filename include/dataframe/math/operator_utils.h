@@ -133,9 +133,16 @@ template <typename Op> struct operation {
             throw std::runtime_error("Series must have the same size");
         }
 
-        return serie1.map([&serie2](const T &value, size_t i) {
+        // A null in either operand gives a null (map keeps those of serie1)
+        auto result = serie1.map([&serie2](const T &value, size_t i) {
             return details::apply_op(value, serie2[i], Op{});
         });
+        if (!serie2.validity().empty()) {
+            result.setValidity(serie1.validity().empty()
+                                   ? serie2.validity()
+                                   : serie1.validity() & serie2.validity());
+        }
+        return result;
     }
 };
 
@@ -18,6 +18,7 @@
 #include <dataframe/core/map.h>
 #include <dataframe/core/pipe.h>
 #include <dataframe/core/reduce.h>
+#include <dataframe/core/unique.h>
 #include <dataframe/stats/stats.h>
 #include <functional>
 #include <iostream>
@@ -112,13 +113,7 @@ Lime::generate_perturbed_samples(const df::Dataframe &instance,
 
         if (is_categorical) {
             // For categorical features, sample values from the training data
-            auto all_values = training_data_.get<std::string>(feature);
-            std::vector<std::string> unique_values(all_values.data().begin(),
-                                                   all_values.data().end());
-            std::sort(unique_values.begin(), unique_values.end());
-            unique_values.erase(
-                std::unique(unique_values.begin(), unique_values.end()),
-                unique_values.end());
+            const auto &unique_values = training_categories(feature);
 
             std::vector<std::string> sampled_values;
             sampled_values.reserve(num_samples);
@@ -167,6 +162,31 @@ Lime::generate_perturbed_samples(const df::Dataframe &instance,
     return samples;
 }
 
+inline const std::vector<std::string> &
+Lime::training_categories(const std::string &feature) {
+    auto it = categories_.find(feature);
+    if (it != categories_.end()) {
+        return it->second;
+    }
+
+    // Distinct codes first, then only the distinct values are sorted
+    const auto *encoded =
+        dynamic_cast<const df::CategoricalSerie *>(&training_data_.get(feature));
+    const df::CategoricalSerie distinct =
+        encoded ? df::unique(*encoded)
+                : df::unique(df::CategoricalSerie(
+                      training_data_.get<std::string>(feature)));
+
+    std::vector<std::string> values;
+    values.reserve(distinct.size());
+    for (size_t i = 0; i < distinct.size(); ++i) {
+        values.push_back(distinct[i]);
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return categories_[feature] = std::move(values);
+}
+
 inline df::Serie<double>
 Lime::calculate_sample_weights(const df::Dataframe &perturbed_samples,
                                const df::Dataframe &original_instance) {
@@ -182,11 +202,10 @@ Lime::calculate_sample_weights(const df::Dataframe &perturbed_samples,
         df::Dataframe sample_df;
 
         for (const auto &name : perturbed_samples.names()) {
-            if (perturbed_samples.type_name(name) == "Serie<double>") {
+            if (perturbed_samples.has<double>(name)) {
                 auto value = perturbed_samples.get<double>(name)[i];
                 sample_df.add(name, df::Serie<double>{value});
-            } else if (perturbed_samples.type_name(name) ==
-                       "Serie<std::string>") {
+            } else if (perturbed_samples.has<std::string>(name)) {
                 auto value = perturbed_samples.get<std::string>(name)[i];
                 sample_df.add(name, df::Serie<std::string>{value});
             }
@@ -206,7 +225,7 @@ inline double Lime::calculate_distance(const df::Dataframe &instance1,
     double squared_distance = 0.0;
 
     for (const auto &feature : instance1.names()) {
-        if (instance1.type_name(feature) == "Serie<double>") {
+        if (instance1.has<double>(feature)) {
             // For numerical features, use squared difference normalized by
             // variance
             double val1 = instance1.get<double>(feature)[0];
@@ -223,7 +242,7 @@ inline double Lime::calculate_distance(const df::Dataframe &instance1,
             } else {
                 squared_distance += (val1 - val2) * (val1 - val2);
             }
-        } else if (instance1.type_name(feature) == "Serie<std::string>") {
+        } else if (instance1.has<std::string>(feature)) {
             // For categorical features, use a simple 0/1 distance
             std::string val1 = instance1.get<std::string>(feature)[0];
             std::string val2 = instance2.get<std::string>(feature)[0];
@@ -251,32 +270,35 @@ Lime::fit_interpretable_model(const df::Dataframe &perturbed_samples,
         if (categorical_features_.find(feature) !=
             categorical_features_.end()) {
             // For categorical features, create binary features for each unique
-            // value
-            auto values = perturbed_samples.get<std::string>(feature);
-
-            // Get unique values
-            std::set<std::string> unique_values;
-            for (size_t i = 0; i < values.size(); ++i) {
-                unique_values.insert(values[i]);
-            }
+            // value. The values are encoded once, and compared by code.
+            const df::CategoricalSerie values(
+                perturbed_samples.get<std::string>(feature));
+            const auto &dictionary = values.dictionary()->values();
+
+            // Codes of the unique values, sorted by value
+            std::vector<uint32_t> unique_codes(dictionary.size());
+            std::iota(unique_codes.begin(), unique_codes.end(), 0);
+            std::sort(unique_codes.begin(), unique_codes.end(),
+                      [&](uint32_t a, uint32_t b) {
+                          return dictionary[a] < dictionary[b];
+                      });
 
             // Create binary features for each value except one (to avoid
             // collinearity)
             std::vector<std::string> binary_feature_names;
             std::vector<std::vector<double>> binary_features;
 
-            auto unique_values_vec = std::vector<std::string>(
-                unique_values.begin(), unique_values.end());
-            if (!unique_values_vec.empty()) {
+            if (!unique_codes.empty()) {
                 // Skip the last value to avoid perfect collinearity
-                for (size_t j = 0; j < unique_values_vec.size() - 1; ++j) {
-                    std::string value = unique_values_vec[j];
-                    std::string binary_feature_name = feature + "=" + value;
+                for (size_t j = 0; j < unique_codes.size() - 1; ++j) {
+                    const uint32_t code = unique_codes[j];
+                    std::string binary_feature_name =
+                        feature + "=" + dictionary[code];
                     binary_feature_names.push_back(binary_feature_name);
 
                     std::vector<double> binary_feature(values.size(), 0.0);
                     for (size_t i = 0; i < values.size(); ++i) {
-                        if (values[i] == value) {
+                        if (values.code(i) == code) {
                             binary_feature[i] = 1.0;
                         }
                     }
@@ -548,12 +548,12 @@ RandomForest::extractFeatures(const df::Dataframe &data,
         std::type_index target_type = data.type(target_column);
 
         // Check if target is a string type
-        if (target_type == typeid(df::Serie<std::string>)) {
+        if (isCategorical(data, target_column)) {
             has_string_target_ = true;
 
             // Get string target
-            const df::Serie<std::string> &string_target =
-                data.get<std::string>(target_column);
+            const df::CategoricalSerie string_target =
+                categoricalColumn(data, target_column);
             num_samples = string_target.size();
 
             // Encode the target
@@ -599,10 +599,10 @@ RandomForest::extractFeatures(const df::Dataframe &data,
 
         std::type_index feature_type = data.type(col_name);
 
-        if (feature_type == typeid(df::Serie<std::string>)) {
+        if (isCategorical(data, col_name)) {
             // Handle string feature
-            const df::Serie<std::string> &string_feature =
-                data.get<std::string>(col_name);
+            const df::CategoricalSerie string_feature =
+                categoricalColumn(data, col_name);
 
             // Create and fit encoder for this feature
             df::LabelEncoder encoder;
@@ -639,6 +639,22 @@ RandomForest::extractFeatures(const df::Dataframe &data,
     return {features, target};
 }
 
+inline bool RandomForest::isCategorical(const df::Dataframe &data,
+                                        const std::string &name) {
+    const std::type_index type = data.type(name);
+    return type == typeid(df::Serie<std::string>) ||
+           type == typeid(df::CategoricalSerie);
+}
+
+inline df::CategoricalSerie
+RandomForest::categoricalColumn(const df::Dataframe &data,
+                                const std::string &name) {
+    if (data.type(name) == typeid(df::CategoricalSerie)) {
+        return data.categorical(name);
+    }
+    return df::CategoricalSerie(data.get<std::string>(name));
+}
+
 // Helper method to extract features for prediction (no target column)
 inline std::vector<std::vector<double>>
 RandomForest::extractFeaturesForPrediction(const df::Dataframe &data) const {
@@ -661,10 +677,10 @@ RandomForest::extractFeaturesForPrediction(const df::Dataframe &data) const {
 
         std::type_index feature_type = data.type(col_name);
 
-        if (feature_type == typeid(df::Serie<std::string>)) {
+        if (isCategorical(data, col_name)) {
             // Handle string feature
-            const df::Serie<std::string> &string_feature =
-                data.get<std::string>(col_name);
+            const df::CategoricalSerie string_feature =
+                categoricalColumn(data, col_name);
 
             if (!size_initialized) {
                 num_samples = string_feature.size();
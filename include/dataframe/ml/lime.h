@@ -15,6 +15,7 @@
 #pragma once
 #include <dataframe/Dataframe.h>
 #include <dataframe/Serie.h>
+#include <map>
 #include <set>
 #include <random>
 
@@ -110,6 +111,12 @@ class Lime {
     double kernel_width_;
     bool verbose_;
     std::mt19937 rng_;
+    // Sorted distinct training values of the categorical features, computed
+    // once
+    std::map<std::string, std::vector<std::string>> categories_;
+
+    const std::vector<std::string> &
+    training_categories(const std::string &feature);
 
     /**
      * @brief Generate perturbed samples around an instance
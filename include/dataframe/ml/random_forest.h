@@ -148,6 +148,12 @@ class RandomForest {
     std::vector<std::vector<double>>
     extractFeaturesForPrediction(const df::Dataframe &) const;
 
+    // Serie<std::string> or CategoricalSerie column, as a CategoricalSerie
+    // (the label encoders work on its codes)
+    static bool isCategorical(const df::Dataframe &, const std::string &);
+    static df::CategoricalSerie categoricalColumn(const df::Dataframe &,
+                                                  const std::string &);
+
     template <typename T>
     std::vector<double> convertToDoubleVector(const std::vector<T> &) const;
 
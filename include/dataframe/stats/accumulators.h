@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/Serie.h>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Streaming (incremental) statistics accumulators.
+ *
+ * Every accumulator follows the same protocol, so that the same code works for
+ * in-memory Series, chunked data (see core/chunk.h) and data streamed from
+ * disk or sensors:
+ * - `add(value)` feeds one sample,
+ * - `add(serie)` feeds a whole chunk,
+ * - `merge(other)` combines two partial accumulators (e.g. one per thread),
+ * - accessors (`mean()`, `variance()`, `quantile()`...) finalize the result.
+ *
+ * @code
+ * // Chunk by chunk (e.g. while reading a file larger than RAM)
+ * df::stats::Moments<double> m;
+ * while (reader.next(chunk)) {
+ *     m.add(chunk);
+ * }
+ * double v = m.variance();
+ *
+ * // In-memory, in parallel
+ * auto h = df::stats::parallel_accumulate(values, df::stats::Histogram<double>(10, 0.0, 1.0));
+ *
+ * // Pipe, with or without chunking
+ * auto m1 = values | df::stats::bind_accumulate(df::stats::Moments<double>());
+ * auto m2 = values | df::bind_chunk<double>(4096)
+ *                  | df::stats::bind_accumulate(df::stats::Moments<double>());
+ * @endcode
+ */
+
+namespace df {
+    namespace stats {
+
+        /**
+         * @brief Mergeable first four central moments (count, mean, variance,
+         * skewness, kurtosis) of a scalar stream.
+         *
+         * Uses Welford/Pébay updates, so the result is numerically stable and
+         * independent of the way the data was chunked.
+         */
+        template <typename T = double> class Moments {
+        public:
+            using value_type = T;
+
+            void add(const T& value);
+            void add(const Serie<T>& chunk);
+            void merge(const Moments& other);
+
+            size_t count() const { return n_; }
+            double mean() const;
+            /** Same convention as stats::variance (sample variance by default) */
+            double variance(bool population = false) const;
+            double std_dev(bool population = false) const;
+            double skewness() const;
+            /** Excess kurtosis (0 for a normal distribution) */
+            double kurtosis() const;
+
+        private:
+            size_t n_ = 0;
+            double mean_ = 0;
+            double m2_ = 0;
+            double m3_ = 0;
+            double m4_ = 0;
+        };
+
+        /**
+         * @brief Mergeable minimum and maximum of a scalar stream. NaN values are
+         * ignored.
+         */
+        template <typename T = double> class MinMax {
+        public:
+            using value_type = T;
+
+            void add(const T& value);
+            void add(const Serie<T>& chunk);
+            void merge(const MinMax& other);
+
+            size_t count() const { return n_; }
+            T min() const;
+            T max() const;
+
+        private:
+            size_t n_ = 0;
+            T min_ {};
+            T max_ {};
+        };
+
+        /**
+         * @brief Mergeable covariance matrix of N variables.
+         *
+         * Samples are either array-like (std::array, Vector, ...) of size N, or
+         * are given as N separate Series of the same length.
+         *
+         * @code
+         * df::stats::CovarianceMatrix<2> cov;
+         * cov.add(x, y);                      // two columns of the same chunk
+         * double c = cov.covariance(0, 1);    // same as stats::covariance(x, y)
+         * double r = cov.correlation(0, 1);
+         * @endcode
+         */
+        template <size_t N> class CovarianceMatrix {
+        public:
+            using Matrix = std::array<std::array<double, N>, N>;
+
+            template <typename V> void add(const V& sample);
+            template <typename V> void add(const Serie<V>& chunk);
+            template <typename T, typename U, typename... Ts>
+            void add(const Serie<T>& first, const Serie<U>& second, const Serie<Ts>&... rest);
+            void merge(const CovarianceMatrix& other);
+
+            size_t count() const { return n_; }
+            double mean(size_t i) const;
+            /** Same convention as stats::covariance (population by default) */
+            double covariance(size_t i, size_t j, bool population = true) const;
+            double correlation(size_t i, size_t j) const;
+            Matrix matrix(bool population = true) const;
+
+        private:
+            size_t n_ = 0;
+            std::array<double, N> mean_ {};
+            Matrix comoment_ {};
+        };
+
+        /**
+         * @brief Mergeable fixed-range histogram.
+         *
+         * Binning follows stats::bins: values below min go in the first bin and
+         * values above max in the last one (infinities included). NaN values
+         * are skipped, and not counted. Two histograms can only be merged if
+         * they share the same layout.
+         */
+        template <typename T = double> class Histogram {
+        public:
+            using value_type = T;
+
+            Histogram(uint nb, T min, T max);
+
+            void add(const T& value);
+            void add(const Serie<T>& chunk);
+            void merge(const Histogram& other);
+
+            size_t count() const { return n_; }
+            uint nbBins() const { return static_cast<uint>(counts_.size()); }
+            Serie<size_t> counts() const { return Serie<size_t>(counts_); }
+
+        private:
+            T min_;
+            T max_;
+            size_t n_ = 0;
+            std::vector<size_t> counts_;
+        };
+
+        /**
+         * @brief Mergeable approximate quantiles (KLL-like compactor sketch).
+         *
+         * Memory is O(k log(n/k)). As long as fewer than k samples have been
+         * seen, quantiles are exact and identical to stats::quantile. Beyond
+         * that, the rank error is roughly O(1/k).
+         */
+        template <typename T = double> class QuantileSketch {
+        public:
+            using value_type = T;
+
+            explicit QuantileSketch(size_t k = 256);
+
+            void add(const T& value);
+            void add(const Serie<T>& chunk);
+            void merge(const QuantileSketch& other);
+
+            size_t count() const { return n_; }
+            /** Number of samples actually retained by the sketch */
+            size_t retained() const;
+            double quantile(double q) const;
+            double median() const { return quantile(0.5); }
+
+        private:
+            void compress();
+
+            size_t k_;
+            size_t n_ = 0;
+            bool toggle_ = false;
+            double min_ = 0;
+            double max_ = 0;
+            std::vector<std::vector<double>> levels_;
+        };
+
+        /**
+         * @brief Mergeable distinct-count sketch (HyperLogLog).
+         *
+         * The relative standard error is about 1.04 / sqrt(2^precision), i.e.
+         * ~1.6% with the default precision of 12 (4 KiB of registers).
+         */
+        template <typename T = double> class DistinctCount {
+        public:
+            using value_type = T;
+
+            explicit DistinctCount(uint precision = 12);
+
+            void add(const T& value);
+            void add(const Serie<T>& chunk);
+            void merge(const DistinctCount& other);
+
+            size_t count() const { return n_; }
+            double estimate() const;
+
+        private:
+            uint p_;
+            size_t n_ = 0;
+            std::vector<uint8_t> registers_;
+        };
+
+        // ------------------------------------------------------------------
+
+        /**
+         * @brief Feed a whole Serie into an accumulator and return it
+         * @code
+         * auto m = df::stats::accumulate(values, df::stats::Moments<double>());
+         * @endcode
+         */
+        template <typename Acc, typename T> Acc accumulate(const Serie<T>& serie, Acc acc = Acc {});
+
+        /**
+         * @brief Feed a sequence of chunks (e.g. the result of df::chunk) into an
+         * accumulator and return it
+         */
+        template <typename Acc, typename T>
+        Acc accumulate(const std::vector<Serie<T>>& chunks, Acc acc = Acc {});
+
+        /**
+         * @brief Feed a sequence of multi-Serie chunks (e.g. the result of
+         * df::chunk(size, x, y)) into an accumulator and return it
+         */
+        template <typename Acc, typename... Ts>
+        Acc accumulate(const std::vector<std::tuple<Serie<Ts>...>>& chunks, Acc acc = Acc {});
+
+        /**
+         * @brief Accumulate a Serie in parallel: each thread fills a copy of the
+         * prototype accumulator, and the partial results are merged in order.
+         */
+        template <typename Acc, typename T>
+        Acc parallel_accumulate(const Serie<T>& serie, const Acc& prototype = Acc {});
+
+        /**
+         * @brief Pipe version of accumulate. Works on a Serie, on a vector of
+         * chunks and on a vector of multi-Serie chunks.
+         */
+        template <typename Acc> auto bind_accumulate(Acc prototype = Acc {});
+
+    } // namespace stats
+} // namespace df
+
+#include "inline/accumulators.hxx"
@@ -0,0 +1,692 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/stats/bins.h>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace df {
+    namespace stats {
+
+        namespace detail {
+
+            // splitmix64 finalizer: spreads the bits of std::hash (which is
+            // the identity for integers with libstdc++)
+            inline uint64_t mix_hash(uint64_t h)
+            {
+                h += 0x9e3779b97f4a7c15ULL;
+                h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+                return h ^ (h >> 31);
+            }
+
+            template <typename T> inline bool is_nan_value(const T& value)
+            {
+                if constexpr (std::is_floating_point_v<T>) {
+                    return std::isnan(value);
+                } else {
+                    return false;
+                }
+            }
+
+        } // namespace detail
+
+        // ------------------------------------------------------------------
+        //                              Moments
+        // ------------------------------------------------------------------
+
+        template <typename T> inline void Moments<T>::add(const T& value)
+        {
+            static_assert(std::is_arithmetic_v<T>, "Moments only works with arithmetic types");
+
+            const double x = static_cast<double>(value);
+            const double n1 = static_cast<double>(n_);
+            ++n_;
+            const double n = static_cast<double>(n_);
+
+            const double delta = x - mean_;
+            const double delta_n = delta / n;
+            const double delta_n2 = delta_n * delta_n;
+            const double term1 = delta * delta_n * n1;
+
+            mean_ += delta_n;
+            m4_ += term1 * delta_n2 * (n * n - 3 * n + 3) + 6 * delta_n2 * m2_ - 4 * delta_n * m3_;
+            m3_ += term1 * delta_n * (n - 2) - 3 * delta_n * m2_;
+            m2_ += term1;
+        }
+
+        template <typename T> inline void Moments<T>::add(const Serie<T>& chunk)
+        {
+            for (const auto& v : chunk.data()) {
+                add(v);
+            }
+        }
+
+        template <typename T> inline void Moments<T>::merge(const Moments& other)
+        {
+            if (other.n_ == 0) {
+                return;
+            }
+            if (n_ == 0) {
+                *this = other;
+                return;
+            }
+
+            const double na = static_cast<double>(n_);
+            const double nb = static_cast<double>(other.n_);
+            const double n = na + nb;
+            const double delta = other.mean_ - mean_;
+            const double delta2 = delta * delta;
+            const double delta3 = delta2 * delta;
+            const double delta4 = delta2 * delta2;
+
+            const double m2 = m2_ + other.m2_ + delta2 * na * nb / n;
+            const double m3 = m3_ + other.m3_ + delta3 * na * nb * (na - nb) / (n * n)
+                + 3 * delta * (na * other.m2_ - nb * m2_) / n;
+            const double m4 = m4_ + other.m4_
+                + delta4 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+                + 6 * delta2 * (na * na * other.m2_ + nb * nb * m2_) / (n * n)
+                + 4 * delta * (na * other.m3_ - nb * m3_) / n;
+
+            mean_ += delta * nb / n;
+            m2_ = m2;
+            m3_ = m3;
+            m4_ = m4;
+            n_ += other.n_;
+        }
+
+        template <typename T> inline double Moments<T>::mean() const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate mean of an empty accumulator");
+            }
+            return mean_;
+        }
+
+        template <typename T> inline double Moments<T>::variance(bool population) const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate variance of an empty accumulator");
+            }
+            if (n_ == 1) {
+                return 0.0;
+            }
+            return m2_ / (population ? n_ : n_ - 1);
+        }
+
+        template <typename T> inline double Moments<T>::std_dev(bool population) const
+        {
+            return std::sqrt(variance(population));
+        }
+
+        template <typename T> inline double Moments<T>::skewness() const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate skewness of an empty accumulator");
+            }
+            if (m2_ == 0) {
+                return 0.0;
+            }
+            return std::sqrt(static_cast<double>(n_)) * m3_ / std::pow(m2_, 1.5);
+        }
+
+        template <typename T> inline double Moments<T>::kurtosis() const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate kurtosis of an empty accumulator");
+            }
+            if (m2_ == 0) {
+                return 0.0;
+            }
+            return static_cast<double>(n_) * m4_ / (m2_ * m2_) - 3.0;
+        }
+
+        // ------------------------------------------------------------------
+        //                              MinMax
+        // ------------------------------------------------------------------
+
+        template <typename T> inline void MinMax<T>::add(const T& value)
+        {
+            if (detail::is_nan_value(value)) {
+                return;
+            }
+            if (n_ == 0) {
+                min_ = value;
+                max_ = value;
+            } else {
+                min_ = std::min(min_, value);
+                max_ = std::max(max_, value);
+            }
+            ++n_;
+        }
+
+        template <typename T> inline void MinMax<T>::add(const Serie<T>& chunk)
+        {
+            for (const auto& v : chunk.data()) {
+                add(v);
+            }
+        }
+
+        template <typename T> inline void MinMax<T>::merge(const MinMax& other)
+        {
+            if (other.n_ == 0) {
+                return;
+            }
+            if (n_ == 0) {
+                *this = other;
+                return;
+            }
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+            n_ += other.n_;
+        }
+
+        template <typename T> inline T MinMax<T>::min() const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate min of an empty accumulator");
+            }
+            return min_;
+        }
+
+        template <typename T> inline T MinMax<T>::max() const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate max of an empty accumulator");
+            }
+            return max_;
+        }
+
+        // ------------------------------------------------------------------
+        //                          CovarianceMatrix
+        // ------------------------------------------------------------------
+
+        template <size_t N>
+        template <typename V>
+        inline void CovarianceMatrix<N>::add(const V& sample)
+        {
+            ++n_;
+            const double n = static_cast<double>(n_);
+
+            std::array<double, N> delta;
+            for (size_t i = 0; i < N; ++i) {
+                delta[i] = static_cast<double>(sample[i]) - mean_[i];
+                mean_[i] += delta[i] / n;
+            }
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    comoment_[i][j] += delta[i] * (static_cast<double>(sample[j]) - mean_[j]);
+                }
+            }
+        }
+
+        template <size_t N>
+        template <typename V>
+        inline void CovarianceMatrix<N>::add(const Serie<V>& chunk)
+        {
+            for (const auto& v : chunk.data()) {
+                add(v);
+            }
+        }
+
+        template <size_t N>
+        template <typename T, typename U, typename... Ts>
+        inline void CovarianceMatrix<N>::add(
+            const Serie<T>& first, const Serie<U>& second, const Serie<Ts>&... rest)
+        {
+            static_assert(sizeof...(Ts) + 2 == N, "The number of Series must match N");
+
+            const size_t size = first.size();
+            if (second.size() != size || !((rest.size() == size) && ...)) {
+                throw std::runtime_error("All series must have the same size for CovarianceMatrix");
+            }
+
+            for (size_t i = 0; i < size; ++i) {
+                add(std::array<double, N> { static_cast<double>(first[i]),
+                    static_cast<double>(second[i]), static_cast<double>(rest[i])... });
+            }
+        }
+
+        template <size_t N> inline void CovarianceMatrix<N>::merge(const CovarianceMatrix& other)
+        {
+            if (other.n_ == 0) {
+                return;
+            }
+            if (n_ == 0) {
+                *this = other;
+                return;
+            }
+
+            const double na = static_cast<double>(n_);
+            const double nb = static_cast<double>(other.n_);
+            const double n = na + nb;
+
+            std::array<double, N> delta;
+            for (size_t i = 0; i < N; ++i) {
+                delta[i] = other.mean_[i] - mean_[i];
+            }
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    comoment_[i][j] += other.comoment_[i][j] + delta[i] * delta[j] * na * nb / n;
+                }
+                mean_[i] += delta[i] * nb / n;
+            }
+            n_ += other.n_;
+        }
+
+        template <size_t N> inline double CovarianceMatrix<N>::mean(size_t i) const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate mean of an empty accumulator");
+            }
+            return mean_.at(i);
+        }
+
+        template <size_t N>
+        inline double CovarianceMatrix<N>::covariance(size_t i, size_t j, bool population) const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate covariance of an empty accumulator");
+            }
+            if (n_ == 1) {
+                return 0.0;
+            }
+            return comoment_.at(i).at(j) / (population ? n_ : n_ - 1);
+        }
+
+        template <size_t N>
+        inline double CovarianceMatrix<N>::correlation(size_t i, size_t j) const
+        {
+            const double var_i = covariance(i, i);
+            const double var_j = covariance(j, j);
+            if (var_i == 0 || var_j == 0) {
+                throw std::runtime_error("Standard deviation is zero, correlation is undefined");
+            }
+            return covariance(i, j) / std::sqrt(var_i * var_j);
+        }
+
+        template <size_t N>
+        inline typename CovarianceMatrix<N>::Matrix CovarianceMatrix<N>::matrix(
+            bool population) const
+        {
+            Matrix result;
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    result[i][j] = covariance(i, j, population);
+                }
+            }
+            return result;
+        }
+
+        // ------------------------------------------------------------------
+        //                              Histogram
+        // ------------------------------------------------------------------
+
+        template <typename T>
+        inline Histogram<T>::Histogram(uint nb, T min, T max)
+            : min_(min)
+            , max_(max)
+        {
+            static_assert(std::is_arithmetic<T>::value, "Binning only works with arithmetic types");
+
+            if (nb == 0) {
+                throw std::invalid_argument("Number of bins must be greater than 0");
+            }
+            if (min >= max) {
+                throw std::invalid_argument("min must be less than max");
+            }
+            counts_.assign(nb, 0);
+        }
+
+        template <typename T> inline void Histogram<T>::add(const T& value)
+        {
+            if (detail::is_nan_value(value)) {
+                return;
+            }
+            counts_[detail::get_bin_index(value, min_, max_, counts_.size())]++;
+            ++n_;
+        }
+
+        template <typename T> inline void Histogram<T>::add(const Serie<T>& chunk)
+        {
+            for (const auto& v : chunk.data()) {
+                add(v);
+            }
+        }
+
+        template <typename T> inline void Histogram<T>::merge(const Histogram& other)
+        {
+            if (other.counts_.size() != counts_.size() || other.min_ != min_
+                || other.max_ != max_) {
+                throw std::invalid_argument("Cannot merge histograms with different layouts");
+            }
+            for (size_t i = 0; i < counts_.size(); ++i) {
+                counts_[i] += other.counts_[i];
+            }
+            n_ += other.n_;
+        }
+
+        // ------------------------------------------------------------------
+        //                            QuantileSketch
+        // ------------------------------------------------------------------
+
+        template <typename T>
+        inline QuantileSketch<T>::QuantileSketch(size_t k)
+            : k_(k)
+            , levels_(1)
+        {
+            static_assert(std::is_arithmetic_v<T>, "QuantileSketch only works with arithmetic types");
+
+            if (k < 2) {
+                throw std::invalid_argument("QuantileSketch capacity must be at least 2");
+            }
+            levels_[0].reserve(k);
+        }
+
+        template <typename T> inline void QuantileSketch<T>::add(const T& value)
+        {
+            const double x = static_cast<double>(value);
+            if (n_ == 0) {
+                min_ = x;
+                max_ = x;
+            } else {
+                min_ = std::min(min_, x);
+                max_ = std::max(max_, x);
+            }
+            ++n_;
+
+            levels_[0].push_back(x);
+            if (levels_[0].size() >= k_) {
+                compress();
+            }
+        }
+
+        template <typename T> inline void QuantileSketch<T>::add(const Serie<T>& chunk)
+        {
+            for (const auto& v : chunk.data()) {
+                add(v);
+            }
+        }
+
+        template <typename T> inline void QuantileSketch<T>::merge(const QuantileSketch& other)
+        {
+            if (other.n_ == 0) {
+                return;
+            }
+            if (n_ == 0) {
+                min_ = other.min_;
+                max_ = other.max_;
+            } else {
+                min_ = std::min(min_, other.min_);
+                max_ = std::max(max_, other.max_);
+            }
+            n_ += other.n_;
+
+            if (levels_.size() < other.levels_.size()) {
+                levels_.resize(other.levels_.size());
+            }
+            for (size_t h = 0; h < other.levels_.size(); ++h) {
+                levels_[h].insert(
+                    levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+            }
+            compress();
+        }
+
+        // Every item of level h stands for 2^h samples. A full level is sorted
+        // and every other item (alternating the offset to avoid a systematic
+        // bias) is promoted to the next level. An odd item stays in place so
+        // that the total weight is always n_.
+        template <typename T> inline void QuantileSketch<T>::compress()
+        {
+            for (size_t h = 0; h < levels_.size(); ++h) {
+                if (levels_[h].size() < k_) {
+                    continue;
+                }
+                if (h + 1 == levels_.size()) {
+                    levels_.emplace_back();
+                }
+
+                auto& level = levels_[h];
+                auto& next = levels_[h + 1];
+                std::sort(level.begin(), level.end());
+
+                const bool odd = level.size() % 2 == 1;
+                const double leftover = odd ? level.back() : 0.0;
+                if (odd) {
+                    level.pop_back();
+                }
+
+                const size_t offset = toggle_ ? 1 : 0;
+                toggle_ = !toggle_;
+                for (size_t i = offset; i < level.size(); i += 2) {
+                    next.push_back(level[i]);
+                }
+
+                level.clear();
+                if (odd) {
+                    level.push_back(leftover);
+                }
+            }
+        }
+
+        template <typename T> inline size_t QuantileSketch<T>::retained() const
+        {
+            size_t total = 0;
+            for (const auto& level : levels_) {
+                total += level.size();
+            }
+            return total;
+        }
+
+        template <typename T> inline double QuantileSketch<T>::quantile(double q) const
+        {
+            if (n_ == 0) {
+                throw std::runtime_error("Cannot calculate quantile of an empty accumulator");
+            }
+            if (q < 0.0 || q > 1.0) {
+                throw std::runtime_error("Quantile value must be between 0 and 1");
+            }
+            if (q == 0.0) {
+                return min_;
+            }
+            if (q == 1.0) {
+                return max_;
+            }
+
+            // Nothing has been compacted yet: exact, same interpolation as
+            // stats::quantile
+            if (levels_.size() == 1) {
+                auto data = levels_[0];
+                std::sort(data.begin(), data.end());
+                const size_t size = data.size();
+                if (size == 1) {
+                    return data[0];
+                }
+                double pos = q * (size - 1);
+                size_t idx_lower = static_cast<size_t>(pos);
+                size_t idx_upper = std::min(idx_lower + 1, size - 1);
+                double weight = pos - idx_lower;
+                return data[idx_lower] * (1.0 - weight) + data[idx_upper] * weight;
+            }
+
+            std::vector<std::pair<double, size_t>> items;
+            items.reserve(retained());
+            for (size_t h = 0; h < levels_.size(); ++h) {
+                const size_t weight = size_t { 1 } << h;
+                for (double v : levels_[h]) {
+                    items.emplace_back(v, weight);
+                }
+            }
+            std::sort(items.begin(), items.end());
+
+            const double target = q * static_cast<double>(n_ - 1);
+            double cumulative = 0;
+            for (const auto& [value, weight] : items) {
+                cumulative += static_cast<double>(weight);
+                if (target < cumulative) {
+                    return value;
+                }
+            }
+            return items.back().first;
+        }
+
+        // ------------------------------------------------------------------
+        //                            DistinctCount
+        // ------------------------------------------------------------------
+
+        template <typename T>
+        inline DistinctCount<T>::DistinctCount(uint precision)
+            : p_(precision)
+        {
+            if (precision < 4 || precision > 18) {
+                throw std::invalid_argument("DistinctCount precision must be in [4, 18]");
+            }
+            registers_.assign(size_t { 1 } << p_, 0);
+        }
+
+        template <typename T> inline void DistinctCount<T>::add(const T& value)
+        {
+            const uint64_t h = detail::mix_hash(static_cast<uint64_t>(std::hash<T> {}(value)));
+            const size_t index = static_cast<size_t>(h >> (64 - p_));
+            const uint64_t w = h << p_;
+            const uint8_t rank
+                = static_cast<uint8_t>(w == 0 ? 64 - p_ + 1 : std::countl_zero(w) + 1);
+            registers_[index] = std::max(registers_[index], rank);
+            ++n_;
+        }
+
+        template <typename T> inline void DistinctCount<T>::add(const Serie<T>& chunk)
+        {
+            for (const auto& v : chunk.data()) {
+                add(v);
+            }
+        }
+
+        template <typename T> inline void DistinctCount<T>::merge(const DistinctCount& other)
+        {
+            if (other.p_ != p_) {
+                throw std::invalid_argument("Cannot merge DistinctCount with different precisions");
+            }
+            for (size_t i = 0; i < registers_.size(); ++i) {
+                registers_[i] = std::max(registers_[i], other.registers_[i]);
+            }
+            n_ += other.n_;
+        }
+
+        template <typename T> inline double DistinctCount<T>::estimate() const
+        {
+            const double m = static_cast<double>(registers_.size());
+            double alpha;
+            switch (registers_.size()) {
+            case 16:
+                alpha = 0.673;
+                break;
+            case 32:
+                alpha = 0.697;
+                break;
+            case 64:
+                alpha = 0.709;
+                break;
+            default:
+                alpha = 0.7213 / (1.0 + 1.079 / m);
+            }
+
+            double sum = 0;
+            size_t zeros = 0;
+            for (uint8_t r : registers_) {
+                sum += std::ldexp(1.0, -static_cast<int>(r));
+                if (r == 0) {
+                    ++zeros;
+                }
+            }
+
+            const double raw = alpha * m * m / sum;
+            if (raw <= 2.5 * m && zeros > 0) {
+                // Small range correction (linear counting)
+                return m * std::log(m / static_cast<double>(zeros));
+            }
+            return raw;
+        }
+
+        // ------------------------------------------------------------------
+        //                          Generic helpers
+        // ------------------------------------------------------------------
+
+        template <typename Acc, typename T> inline Acc accumulate(const Serie<T>& serie, Acc acc)
+        {
+            acc.add(serie);
+            return acc;
+        }
+
+        template <typename Acc, typename T>
+        inline Acc accumulate(const std::vector<Serie<T>>& chunks, Acc acc)
+        {
+            for (const auto& chunk : chunks) {
+                acc.add(chunk);
+            }
+            return acc;
+        }
+
+        template <typename Acc, typename... Ts>
+        inline Acc accumulate(const std::vector<std::tuple<Serie<Ts>...>>& chunks, Acc acc)
+        {
+            for (const auto& chunk : chunks) {
+                std::apply([&acc](const auto&... series) { acc.add(series...); }, chunk);
+            }
+            return acc;
+        }
+
+        template <typename Acc, typename T>
+        inline Acc parallel_accumulate(const Serie<T>& serie, const Acc& prototype)
+        {
+            const size_t size = serie.size();
+            const size_t num_chunks = size < 1000 ? 1 : df::detail::get_optimal_threads(size);
+            const auto& data = serie.data();
+
+            std::vector<Acc> partials(num_chunks, prototype);
+            df::detail::parallel_for_chunks(
+                size, num_chunks, [&](size_t chunk, size_t start, size_t end) {
+                    for (size_t i = start; i < end; ++i) {
+                        partials[chunk].add(data[i]);
+                    }
+                });
+
+            Acc result = partials[0];
+            for (size_t i = 1; i < partials.size(); ++i) {
+                result.merge(partials[i]);
+            }
+            return result;
+        }
+
+        template <typename Acc> inline auto bind_accumulate(Acc prototype)
+        {
+            return [prototype](const auto& input) { return accumulate(input, prototype); };
+        }
+
+    } // namespace stats
+} // namespace df
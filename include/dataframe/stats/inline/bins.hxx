@@ -45,8 +45,13 @@ size_t get_bin_index(T value, T min_val, T max_val, size_t num_bins) {
     if (value >= max_val)
         return num_bins - 1;
 
-    const T bin_width = (max_val - min_val) / num_bins;
-    return static_cast<size_t>((value - min_val) / bin_width);
+    // In double: an integral bin width truncates, and is 0 if num_bins is
+    // larger than the range
+    const double bin_width =
+        (static_cast<double>(max_val) - static_cast<double>(min_val)) / num_bins;
+    const size_t index = static_cast<size_t>(
+        (static_cast<double>(value) - static_cast<double>(min_val)) / bin_width);
+    return std::min(index, num_bins - 1);
 }
 
 } // namespace detail
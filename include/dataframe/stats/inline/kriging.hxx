@@ -26,40 +26,11 @@ inline std::pair<Serie<double>, Serie<double>>
 calculate_experimental_variogram(const Serie<Vec> &positions,
                                  const Serie<T> &values, double lag_distance,
                                  size_t n_lags) {
-    std::vector<std::vector<double>> bins(n_lags);
-    std::vector<double> distances(n_lags, 0.0);
-
-    // Calculate squared differences for each pair of points
-    for (size_t i = 0; i < positions.size(); ++i) {
-        for (size_t j = i + 1; j < positions.size(); ++j) {
-            double dist = 0.0;
-            for (size_t k = 0; k < std::tuple_size<Vec>::value; ++k) {
-                double diff = positions[i][k] - positions[j][k];
-                dist += diff * diff;
-            }
-            dist = std::sqrt(dist);
-
-            size_t bin = static_cast<size_t>(dist / lag_distance);
-            if (bin < n_lags) {
-                double val_diff = values[i] - values[j];
-                bins[bin].push_back(0.5 * val_diff * val_diff);
-                distances[bin] += dist;
-            }
-        }
-    }
-
-    // Calculate average variogram values for each bin
-    std::vector<double> variogram(n_lags, 0.0);
-    for (size_t i = 0; i < n_lags; ++i) {
-        if (!bins[i].empty()) {
-            variogram[i] =
-                std::accumulate(bins[i].begin(), bins[i].end(), 0.0) /
-                bins[i].size();
-            distances[i] /= bins[i].size();
-        }
-    }
-
-    return {Serie<double>(distances), Serie<double>(variogram)};
+    VariogramOptions options;
+    options.lag_distance = lag_distance;
+    options.n_lags = n_lags;
+    auto variogram = experimental_variogram(positions, values, options);
+    return {variogram.distances, variogram.values};
 }
 
 /**
@@ -12,6 +12,7 @@
  * all copies or substantial portions of the Software.
  */
 
+#include <dataframe/stats/rolling.h>
 #include <dataframe/utils/meta.h>
 #include <dataframe/utils/utils.h>
 #include <numeric>
@@ -23,48 +24,7 @@ namespace stats {
 
 namespace detail {
 
-// Helper for scalar types
-template <typename T,
-          typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
-inline T compute_window_avg(const std::vector<T> &values, size_t start,
-                            size_t count) {
-    T sum = T{};
-    for (size_t i = 0; i < count; ++i) {
-        sum += values[start + i];
-    }
-    return sum / static_cast<T>(count);
-}
-
-// Helper for array/vector types using std::array
-template <typename T,
-          typename std::enable_if_t<details::is_array_like_v<T>, int> = 0>
-inline T compute_window_avg(const std::vector<T> &values, size_t start,
-                            size_t count) {
-    using ElementType = typename T::value_type;
-    constexpr size_t N = std::tuple_size_v<T>;
-
-    // Initialize result array with zeros
-    T result{};
-    for (size_t j = 0; j < N; ++j) {
-        result[j] = ElementType{};
-    }
-
-    // Sum the window elements
-    for (size_t i = 0; i < count; ++i) {
-        for (size_t j = 0; j < N; ++j) {
-            result[j] += values[start + i][j];
-        }
-    }
-
-    // Divide by count
-    for (size_t j = 0; j < N; ++j) {
-        result[j] /= static_cast<ElementType>(count);
-    }
-
-    return result;
-}
-
-// Generic sliding window implementation
+// Trailing running-sum window (O(n), see stats/rolling.h)
 template <typename T>
 inline Serie<T> sliding_window_avg(const Serie<T> &serie, size_t window_size) {
     if (serie.empty()) {
@@ -81,22 +41,7 @@ inline Serie<T> sliding_window_avg(const Serie<T> &serie, size_t window_size) {
         return serie; // Return a copy of the input serie
     }
 
-    const size_t n = serie.size();
-    std::vector<T> result(n);
-    const auto &values = serie.data();
-
-    // Process each position
-    for (size_t i = 0; i < n; ++i) {
-        // Calculate window bounds
-        size_t window_start =
-            (i >= window_size - 1) ? i - (window_size - 1) : 0;
-        size_t window_count = i - window_start + 1;
-
-        // Compute average for this window
-        result[i] = compute_window_avg(values, window_start, window_count);
-    }
-
-    return Serie<T>(result);
+    return rolling_mean(serie, window_size, WindowAlignment::TRAILING);
 }
 
 } // namespace detail
@@ -0,0 +1,723 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/meta.h>
+#include <deque>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+
+namespace df {
+    namespace stats {
+
+        namespace detail {
+
+            // ----------------------------------------------------------
+            // Component access: scalars are seen as 1-component arrays
+            // ----------------------------------------------------------
+
+            template <typename T>
+            inline constexpr size_t rolling_dim = details::array_dimension<T>::value;
+
+            template <typename T> inline double rolling_component(const T& value, size_t j)
+            {
+                if constexpr (details::is_array_like_v<T>) {
+                    return static_cast<double>(value[j]);
+                } else {
+                    return static_cast<double>(value);
+                }
+            }
+
+            // Result type of the statistics that are always computed in double
+            // (variance, quantile...), same as stats::variance
+            template <typename T>
+            using rolling_real_t = std::conditional_t<details::is_array_like_v<T>,
+                std::array<double, rolling_dim<T>>, double>;
+
+            template <typename R, size_t N>
+            inline R rolling_make(const std::array<double, N>& components)
+            {
+                if constexpr (details::is_array_like_v<R>) {
+                    using ElementType = typename details::array_element<R>::type;
+                    R result {};
+                    for (size_t j = 0; j < N; ++j) {
+                        result[j] = static_cast<ElementType>(components[j]);
+                    }
+                    return result;
+                } else {
+                    return static_cast<R>(components[0]);
+                }
+            }
+
+            // ----------------------------------------------------------
+            //                        Window bounds
+            // ----------------------------------------------------------
+
+            // Each window is a half-open range [lo, hi) of sample indices.
+            // Both lo and hi are non-decreasing with i, which is what makes
+            // the incremental kernels below possible.
+
+            class CountWindowBounds {
+            public:
+                CountWindowBounds(size_t n, size_t window, WindowAlignment align)
+                    : n_(n)
+                    , before_(align == WindowAlignment::TRAILING ? window - 1 : window / 2)
+                    , after_(align == WindowAlignment::TRAILING ? 0 : (window - 1) / 2)
+                {
+                }
+
+                std::pair<size_t, size_t> operator()(size_t i)
+                {
+                    size_t lo = i >= before_ ? i - before_ : 0;
+                    size_t hi = std::min(n_, i + after_ + 1);
+                    return { lo, hi };
+                }
+
+            private:
+                size_t n_;
+                size_t before_;
+                size_t after_;
+            };
+
+            class TimeWindowBounds {
+            public:
+                TimeWindowBounds(const std::vector<double>& times, double span, WindowAlignment align)
+                    : t_(times)
+                    , before_(align == WindowAlignment::TRAILING ? span : span / 2)
+                    , after_(align == WindowAlignment::TRAILING ? 0 : span / 2)
+                    , trailing_(align == WindowAlignment::TRAILING)
+                {
+                }
+
+                // The first call positions the cursors with a binary search,
+                // the next ones (with increasing i) only move them forward
+                std::pair<size_t, size_t> operator()(size_t i)
+                {
+                    const double from = t_[i] - before_;
+                    const double to = t_[i] + after_;
+                    auto outside = [&](double t) { return trailing_ ? t <= from : t < from; };
+
+                    if (!started_) {
+                        lo_ = trailing_
+                            ? std::upper_bound(t_.begin(), t_.end(), from) - t_.begin()
+                            : std::lower_bound(t_.begin(), t_.end(), from) - t_.begin();
+                        hi_ = std::upper_bound(t_.begin(), t_.end(), to) - t_.begin();
+                        started_ = true;
+                    } else {
+                        while (lo_ < t_.size() && outside(t_[lo_])) {
+                            ++lo_;
+                        }
+                        while (hi_ < t_.size() && t_[hi_] <= to) {
+                            ++hi_;
+                        }
+                    }
+                    return { lo_, hi_ };
+                }
+
+            private:
+                const std::vector<double>& t_;
+                double before_;
+                double after_;
+                bool trailing_;
+                bool started_ = false;
+                size_t lo_ = 0;
+                size_t hi_ = 0;
+            };
+
+            // ----------------------------------------------------------
+            //                           Kernels
+            // ----------------------------------------------------------
+
+            // Every kernel exposes push(i) (add sample i, indices increasing),
+            // pop(i) (remove sample i, always the oldest one), clear() and
+            // value().
+
+            // Non-finite values of a window, kept out of the running sums: a
+            // NaN or an Inf added then subtracted would spoil every later
+            // window. The window value is the one a direct computation gives.
+            struct NonFinite {
+                size_t nan = 0;
+                size_t pos_inf = 0;
+                size_t neg_inf = 0;
+
+                // Returns false (and counts x) if x is not finite
+                bool add(double x, int sign)
+                {
+                    if (std::isfinite(x)) {
+                        return true;
+                    }
+                    size_t& n = std::isnan(x) ? nan : (x > 0 ? pos_inf : neg_inf);
+                    n = sign > 0 ? n + 1 : n - 1;
+                    return false;
+                }
+
+                bool any() const { return nan + pos_inf + neg_inf != 0; }
+
+                // Sum of the window: NaN, +Inf or -Inf
+                double sum() const
+                {
+                    if (nan != 0 || (pos_inf != 0 && neg_inf != 0)) {
+                        return std::numeric_limits<double>::quiet_NaN();
+                    }
+                    return pos_inf != 0 ? std::numeric_limits<double>::infinity()
+                                        : -std::numeric_limits<double>::infinity();
+                }
+            };
+
+            template <typename T> class RollingSum {
+            public:
+                static constexpr size_t N = rolling_dim<T>;
+                using result_type = T;
+
+                explicit RollingSum(const std::vector<T>& data)
+                    : data_(data)
+                {
+                }
+
+                void push(size_t i)
+                {
+                    for (size_t j = 0; j < N; ++j) {
+                        const double x = rolling_component(data_[i], j);
+                        if (nonfinite_[j].add(x, 1)) {
+                            accumulate(j, x);
+                        }
+                    }
+                    ++count_;
+                }
+
+                void pop(size_t i)
+                {
+                    for (size_t j = 0; j < N; ++j) {
+                        const double x = rolling_component(data_[i], j);
+                        if (nonfinite_[j].add(x, -1)) {
+                            accumulate(j, -x);
+                        }
+                    }
+                    --count_;
+                }
+
+                void clear()
+                {
+                    sum_.fill(0);
+                    compensation_.fill(0);
+                    nonfinite_.fill(NonFinite {});
+                    count_ = 0;
+                }
+
+                T value() const
+                {
+                    std::array<double, N> mean;
+                    for (size_t j = 0; j < N; ++j) {
+                        mean[j] = nonfinite_[j].any()
+                            ? nonfinite_[j].sum()
+                            : (sum_[j] + compensation_[j]) / static_cast<double>(count_);
+                    }
+                    return rolling_make<T>(mean);
+                }
+
+            private:
+                // Neumaier summation, so that adding and removing millions of
+                // samples does not drift
+                void accumulate(size_t j, double x)
+                {
+                    const double t = sum_[j] + x;
+                    if (std::abs(sum_[j]) >= std::abs(x)) {
+                        compensation_[j] += (sum_[j] - t) + x;
+                    } else {
+                        compensation_[j] += (x - t) + sum_[j];
+                    }
+                    sum_[j] = t;
+                }
+
+                const std::vector<T>& data_;
+                std::array<double, N> sum_ {};
+                std::array<double, N> compensation_ {};
+                std::array<NonFinite, N> nonfinite_ {};
+                size_t count_ = 0;
+            };
+
+            // Welford updates over the finite values of each component. A
+            // window holding a non-finite value has a NaN variance.
+            template <typename T> class RollingVariance {
+            public:
+                static constexpr size_t N = rolling_dim<T>;
+                using result_type = rolling_real_t<T>;
+
+                RollingVariance(const std::vector<T>& data, bool population)
+                    : data_(data)
+                    , population_(population)
+                {
+                }
+
+                void push(size_t i)
+                {
+                    for (size_t j = 0; j < N; ++j) {
+                        const double x = rolling_component(data_[i], j);
+                        if (!nonfinite_[j].add(x, 1)) {
+                            continue;
+                        }
+                        const double n = static_cast<double>(++count_[j]);
+                        const double delta = x - mean_[j];
+                        mean_[j] += delta / n;
+                        m2_[j] += delta * (x - mean_[j]);
+                    }
+                }
+
+                void pop(size_t i)
+                {
+                    for (size_t j = 0; j < N; ++j) {
+                        const double x = rolling_component(data_[i], j);
+                        if (!nonfinite_[j].add(x, -1)) {
+                            continue;
+                        }
+                        if (count_[j] <= 1) {
+                            mean_[j] = 0;
+                            m2_[j] = 0;
+                            count_[j] = 0;
+                            continue;
+                        }
+                        const double n = static_cast<double>(--count_[j]);
+                        const double delta = x - mean_[j];
+                        mean_[j] -= delta / n;
+                        m2_[j] = std::max(0.0, m2_[j] - delta * (x - mean_[j]));
+                    }
+                }
+
+                void clear()
+                {
+                    mean_.fill(0);
+                    m2_.fill(0);
+                    count_.fill(0);
+                    nonfinite_.fill(NonFinite {});
+                }
+
+                result_type value() const
+                {
+                    std::array<double, N> var {};
+                    for (size_t j = 0; j < N; ++j) {
+                        if (nonfinite_[j].any()) {
+                            var[j] = std::numeric_limits<double>::quiet_NaN();
+                        } else if (count_[j] > 1) {
+                            const double divisor
+                                = static_cast<double>(population_ ? count_[j] : count_[j] - 1);
+                            var[j] = m2_[j] / divisor;
+                        }
+                    }
+                    return rolling_make<result_type>(var);
+                }
+
+            private:
+                const std::vector<T>& data_;
+                bool population_;
+                std::array<double, N> mean_ {};
+                std::array<double, N> m2_ {};
+                std::array<size_t, N> count_ {};
+                std::array<NonFinite, N> nonfinite_ {};
+            };
+
+            // Monotonic deque of indices: the front is always the extremum
+            template <typename T, typename Compare> class RollingExtremum {
+            public:
+                static constexpr size_t N = rolling_dim<T>;
+                using result_type = T;
+
+                explicit RollingExtremum(const std::vector<T>& data)
+                    : data_(data)
+                {
+                }
+
+                void push(size_t i)
+                {
+                    Compare better;
+                    for (size_t j = 0; j < N; ++j) {
+                        const double x = rolling_component(data_[i], j);
+                        auto& q = deques_[j];
+                        while (!q.empty() && !better(rolling_component(data_[q.back()], j), x)) {
+                            q.pop_back();
+                        }
+                        q.push_back(i);
+                    }
+                }
+
+                void pop(size_t i)
+                {
+                    for (auto& q : deques_) {
+                        if (!q.empty() && q.front() == i) {
+                            q.pop_front();
+                        }
+                    }
+                }
+
+                void clear()
+                {
+                    for (auto& q : deques_) {
+                        q.clear();
+                    }
+                }
+
+                T value() const
+                {
+                    if constexpr (details::is_array_like_v<T>) {
+                        T result {};
+                        for (size_t j = 0; j < N; ++j) {
+                            result[j] = data_[deques_[j].front()][j];
+                        }
+                        return result;
+                    } else {
+                        return data_[deques_[0].front()];
+                    }
+                }
+
+            private:
+                const std::vector<T>& data_;
+                std::array<std::deque<size_t>, N> deques_;
+            };
+
+            // Two ordered multisets: `lower` holds the k+1 smallest values of
+            // the window (k = floor(q * (count - 1))), `upper` the others. The
+            // quantile interpolates between max(lower) and min(upper). NaN
+            // values are skipped (they have no place in the ordering), so each
+            // component counts its own samples; a window of NaN gives NaN.
+            template <typename T> class RollingQuantile {
+            public:
+                static constexpr size_t N = rolling_dim<T>;
+                using result_type = rolling_real_t<T>;
+
+                RollingQuantile(const std::vector<T>& data, double q)
+                    : data_(data)
+                    , q_(q)
+                {
+                }
+
+                void push(size_t i)
+                {
+                    for (size_t j = 0; j < N; ++j) {
+                        const double x = rolling_component(data_[i], j);
+                        if (std::isnan(x)) {
+                            continue;
+                        }
+                        auto& h = halves_[j];
+                        ++h.count;
+                        if (!h.lower.empty() && x <= *h.lower.rbegin()) {
+                            h.lower.insert(x);
+                        } else {
+                            h.upper.insert(x);
+                        }
+                        rebalance(h);
+                    }
+                }
+
+                void pop(size_t i)
+                {
+                    for (size_t j = 0; j < N; ++j) {
+                        const double x = rolling_component(data_[i], j);
+                        if (std::isnan(x)) {
+                            continue;
+                        }
+                        auto& h = halves_[j];
+                        --h.count;
+                        if (!h.lower.empty() && x <= *h.lower.rbegin()) {
+                            h.lower.erase(h.lower.find(x));
+                        } else {
+                            h.upper.erase(h.upper.find(x));
+                        }
+                        rebalance(h);
+                    }
+                }
+
+                void clear()
+                {
+                    for (auto& h : halves_) {
+                        h.lower.clear();
+                        h.upper.clear();
+                        h.count = 0;
+                    }
+                }
+
+                result_type value() const
+                {
+                    std::array<double, N> result;
+                    for (size_t j = 0; j < N; ++j) {
+                        const auto& h = halves_[j];
+                        if (h.count == 0) {
+                            result[j] = std::numeric_limits<double>::quiet_NaN();
+                            continue;
+                        }
+                        const double pos = q_ * static_cast<double>(h.count - 1);
+                        const double weight = pos - std::floor(pos);
+                        const double below = *h.lower.rbegin();
+                        const double above = h.upper.empty() ? below : *h.upper.begin();
+                        result[j] = below * (1.0 - weight) + above * weight;
+                    }
+                    return rolling_make<result_type>(result);
+                }
+
+            private:
+                struct Halves {
+                    std::multiset<double> lower;
+                    std::multiset<double> upper;
+                    size_t count = 0;
+                };
+
+                void rebalance(Halves& h)
+                {
+                    const size_t target = h.count == 0
+                        ? 0
+                        : static_cast<size_t>(q_ * static_cast<double>(h.count - 1)) + 1;
+                    while (h.lower.size() > target) {
+                        auto it = std::prev(h.lower.end());
+                        h.upper.insert(*it);
+                        h.lower.erase(it);
+                    }
+                    while (h.lower.size() < target && !h.upper.empty()) {
+                        auto it = h.upper.begin();
+                        h.lower.insert(*it);
+                        h.upper.erase(it);
+                    }
+                }
+
+                const std::vector<T>& data_;
+                double q_;
+                std::array<Halves, N> halves_;
+            };
+
+            // ----------------------------------------------------------
+            //                            Driver
+            // ----------------------------------------------------------
+
+            // Compute the outputs [start, end) with a fresh kernel. Samples
+            // before `start` that belong to its window are re-read, which is
+            // the overlap between consecutive parallel chunks.
+            template <typename Kernel, typename Bounds, typename R>
+            inline void rolling_sweep(
+                Kernel kernel, Bounds bounds, size_t start, size_t end, std::vector<R>& out)
+            {
+                size_t cur_lo = 0;
+                size_t cur_hi = 0;
+                bool first = true;
+                for (size_t i = start; i < end; ++i) {
+                    auto [lo, hi] = bounds(i);
+                    if (first || lo >= cur_hi) {
+                        kernel.clear();
+                        cur_lo = cur_hi = lo;
+                        first = false;
+                    }
+                    while (cur_hi < hi) {
+                        kernel.push(cur_hi++);
+                    }
+                    while (cur_lo < lo) {
+                        kernel.pop(cur_lo++);
+                    }
+                    out[i] = kernel.value();
+                }
+            }
+
+            template <typename T, typename W, typename MakeKernel>
+            inline auto rolling_apply(const Serie<T>& serie, const W& window,
+                WindowAlignment align, MakeKernel&& make_kernel)
+            {
+                using Kernel = std::decay_t<decltype(make_kernel(serie.data()))>;
+                using R = typename Kernel::result_type;
+
+                if (serie.empty()) {
+                    throw std::runtime_error("Cannot compute rolling statistics on empty serie");
+                }
+
+                const size_t n = serie.size();
+                const auto& data = serie.data();
+                std::vector<R> result(n);
+
+                const size_t num_chunks = n < 1000 ? 1 : df::detail::get_optimal_threads(n);
+
+                if constexpr (std::is_same_v<W, TimeWindow>) {
+                    if (window.times == nullptr || window.times->size() != n) {
+                        throw std::runtime_error(
+                            "Timestamps must have the same size as the serie in rolling window");
+                    }
+                    if (!(window.span > 0)) {
+                        throw std::runtime_error("Time window span must be greater than zero");
+                    }
+                    const auto& times = window.times->data();
+                    if (!std::is_sorted(times.begin(), times.end())) {
+                        throw std::runtime_error("Timestamps must be non-decreasing");
+                    }
+
+                    df::detail::parallel_for_chunks(
+                        n, num_chunks, [&](size_t, size_t start, size_t end) {
+                            rolling_sweep(make_kernel(data),
+                                TimeWindowBounds(times, window.span, align), start, end, result);
+                        });
+                } else {
+                    static_assert(std::is_integral_v<W>,
+                        "Window must be a number of samples or a TimeWindow");
+                    if (window <= 0) {
+                        throw std::runtime_error("Window size must be greater than zero");
+                    }
+
+                    df::detail::parallel_for_chunks(
+                        n, num_chunks, [&](size_t, size_t start, size_t end) {
+                            rolling_sweep(make_kernel(data),
+                                CountWindowBounds(n, static_cast<size_t>(window), align), start,
+                                end, result);
+                        });
+                }
+
+                return Serie<R>(result);
+            }
+
+        } // namespace detail
+
+        // ------------------------------------------------------------------
+
+        template <typename T, typename W>
+        inline Serie<T> rolling_mean(const Serie<T>& serie, const W& window, WindowAlignment align)
+        {
+            return detail::rolling_apply(serie, window, align,
+                [](const std::vector<T>& data) { return detail::RollingSum<T>(data); });
+        }
+
+        template <typename T, typename W>
+        inline auto rolling_variance(
+            const Serie<T>& serie, const W& window, bool population, WindowAlignment align)
+        {
+            return detail::rolling_apply(serie, window, align, [population](const std::vector<T>& data) {
+                return detail::RollingVariance<T>(data, population);
+            });
+        }
+
+        template <typename T, typename W>
+        inline auto rolling_std(
+            const Serie<T>& serie, const W& window, bool population, WindowAlignment align)
+        {
+            auto var = rolling_variance(serie, window, population, align);
+            return var.map([](const auto& v) {
+                if constexpr (details::is_array_like_v<std::decay_t<decltype(v)>>) {
+                    auto result = v;
+                    for (auto& x : result) {
+                        x = std::sqrt(x);
+                    }
+                    return result;
+                } else {
+                    return std::sqrt(v);
+                }
+            });
+        }
+
+        template <typename T, typename W>
+        inline Serie<T> rolling_min(const Serie<T>& serie, const W& window, WindowAlignment align)
+        {
+            return detail::rolling_apply(serie, window, align, [](const std::vector<T>& data) {
+                return detail::RollingExtremum<T, std::less<double>>(data);
+            });
+        }
+
+        template <typename T, typename W>
+        inline Serie<T> rolling_max(const Serie<T>& serie, const W& window, WindowAlignment align)
+        {
+            return detail::rolling_apply(serie, window, align, [](const std::vector<T>& data) {
+                return detail::RollingExtremum<T, std::greater<double>>(data);
+            });
+        }
+
+        template <typename T, typename W>
+        inline auto rolling_quantile(
+            const Serie<T>& serie, const W& window, double q, WindowAlignment align)
+        {
+            if (q < 0.0 || q > 1.0) {
+                throw std::runtime_error("Quantile value must be between 0 and 1");
+            }
+            return detail::rolling_apply(serie, window, align, [q](const std::vector<T>& data) {
+                return detail::RollingQuantile<T>(data, q);
+            });
+        }
+
+        template <typename T, typename W>
+        inline auto rolling_median(const Serie<T>& serie, const W& window, WindowAlignment align)
+        {
+            return rolling_quantile(serie, window, 0.5, align);
+        }
+
+        // ------------------------------------------------------------------
+
+        template <typename T, typename W>
+        inline auto bind_rolling_mean(const W& window, WindowAlignment align)
+        {
+            return [window, align](const Serie<T>& serie) {
+                return rolling_mean(serie, window, align);
+            };
+        }
+
+        template <typename T, typename W>
+        inline auto bind_rolling_variance(const W& window, bool population, WindowAlignment align)
+        {
+            return [window, population, align](const Serie<T>& serie) {
+                return rolling_variance(serie, window, population, align);
+            };
+        }
+
+        template <typename T, typename W>
+        inline auto bind_rolling_std(const W& window, bool population, WindowAlignment align)
+        {
+            return [window, population, align](const Serie<T>& serie) {
+                return rolling_std(serie, window, population, align);
+            };
+        }
+
+        template <typename T, typename W>
+        inline auto bind_rolling_min(const W& window, WindowAlignment align)
+        {
+            return [window, align](const Serie<T>& serie) {
+                return rolling_min(serie, window, align);
+            };
+        }
+
+        template <typename T, typename W>
+        inline auto bind_rolling_max(const W& window, WindowAlignment align)
+        {
+            return [window, align](const Serie<T>& serie) {
+                return rolling_max(serie, window, align);
+            };
+        }
+
+        template <typename T, typename W>
+        inline auto bind_rolling_quantile(const W& window, double q, WindowAlignment align)
+        {
+            return [window, q, align](const Serie<T>& serie) {
+                return rolling_quantile(serie, window, q, align);
+            };
+        }
+
+        template <typename T, typename W>
+        inline auto bind_rolling_median(const W& window, WindowAlignment align)
+        {
+            return [window, align](const Serie<T>& serie) {
+                return rolling_median(serie, window, align);
+            };
+        }
+
+    } // namespace stats
+} // namespace df
@@ -88,7 +88,11 @@ inline T compute_avg_impl(
 
 } // namespace detail
 
+// Nulls are skipped
 template <typename T> inline T avg(const Serie<T> &serie) {
+    if (serie.hasNulls()) {
+        return detail::compute_avg_impl(serie.dropNulls());
+    }
     return detail::compute_avg_impl(serie);
 }
 
@@ -109,8 +113,10 @@ template <typename T> inline T mean(const Serie<T> &serie) {
     return avg(serie);
 }
 
+namespace detail {
+
 template <typename T>
-inline auto variance(const Serie<T> &serie, bool population) {
+inline auto variance_impl(const Serie<T> &serie, bool population) {
     if (serie.empty()) {
         throw std::runtime_error("Cannot calculate variance of an empty Serie");
     }
@@ -179,6 +185,17 @@ inline auto variance(const Serie<T> &serie, bool population) {
     }
 }
 
+} // namespace detail
+
+// Nulls are skipped
+template <typename T>
+inline auto variance(const Serie<T> &serie, bool population) {
+    if (serie.hasNulls()) {
+        return detail::variance_impl(serie.dropNulls(), population);
+    }
+    return detail::variance_impl(serie, population);
+}
+
 template <typename T>
 inline auto std_dev(const Serie<T> &serie, bool population) {
     if (serie.empty()) {
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/utils/utils.h>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace df {
+    namespace stats {
+
+        namespace detail {
+
+            constexpr size_t variogram_batches = 16;
+
+            // Samples bucketed in a uniform grid. The points and values are
+            // copied in cell order, so that the samples of a cell are
+            // contiguous: cell c holds [offsets[c], offsets[c + 1]).
+            template <size_t D> struct VariogramGrid {
+                std::array<double, D> origin {};
+                std::array<size_t, D> dims {};
+                double cell_size = 1;
+                std::vector<size_t> offsets;
+                std::vector<std::array<double, D>> points;
+                std::vector<double> values;
+                std::vector<size_t> rank; // sample index -> position in cell order
+
+                template <typename Vec> std::array<size_t, D> cellOf(const Vec& p) const
+                {
+                    std::array<size_t, D> c;
+                    for (size_t d = 0; d < D; ++d) {
+                        c[d] = std::min(dims[d] - 1,
+                            static_cast<size_t>(std::max(0.0, (p[d] - origin[d]) / cell_size)));
+                    }
+                    return c;
+                }
+
+                size_t linear(const std::array<size_t, D>& c) const
+                {
+                    size_t id = 0;
+                    for (size_t d = D; d-- > 0;) {
+                        id = id * dims[d] + c[d];
+                    }
+                    return id;
+                }
+            };
+
+            // Cells are at least `range` wide (so only the neighboring cells
+            // can hold samples in range), and enlarged until there are no
+            // more cells than samples.
+            template <size_t D, typename Vec, typename T>
+            VariogramGrid<D> variogram_grid(
+                const Serie<Vec>& positions, const Serie<T>& values, double range)
+            {
+                const size_t n = positions.size();
+                VariogramGrid<D> grid;
+                std::array<double, D> hi;
+                for (size_t d = 0; d < D; ++d) {
+                    grid.origin[d] = hi[d] = n > 0 ? positions[0][d] : 0.0;
+                }
+                for (size_t i = 1; i < n; ++i) {
+                    for (size_t d = 0; d < D; ++d) {
+                        grid.origin[d] = std::min(grid.origin[d], positions[i][d]);
+                        hi[d] = std::max(hi[d], positions[i][d]);
+                    }
+                }
+
+                grid.cell_size = range;
+                while (true) {
+                    double cells = 1;
+                    for (size_t d = 0; d < D; ++d) {
+                        grid.dims[d]
+                            = static_cast<size_t>((hi[d] - grid.origin[d]) / grid.cell_size) + 1;
+                        cells *= static_cast<double>(grid.dims[d]);
+                    }
+                    if (cells <= static_cast<double>(std::max<size_t>(n, 1))) {
+                        break;
+                    }
+                    grid.cell_size *= 2;
+                }
+
+                size_t ncells = 1;
+                for (size_t d = 0; d < D; ++d) {
+                    ncells *= grid.dims[d];
+                }
+                std::vector<size_t> cell(n);
+                grid.offsets.assign(ncells + 1, 0);
+                for (size_t i = 0; i < n; ++i) {
+                    cell[i] = grid.linear(grid.cellOf(positions[i]));
+                    ++grid.offsets[cell[i] + 1];
+                }
+                std::partial_sum(grid.offsets.begin(), grid.offsets.end(), grid.offsets.begin());
+                grid.points.resize(n);
+                grid.values.resize(n);
+                grid.rank.resize(n);
+                std::vector<size_t> fill(grid.offsets.begin(), grid.offsets.end() - 1);
+                for (size_t i = 0; i < n; ++i) {
+                    const size_t k = fill[cell[i]]++;
+                    for (size_t d = 0; d < D; ++d) {
+                        grid.points[k][d] = positions[i][d];
+                    }
+                    grid.values[k] = static_cast<double>(values[i]);
+                    grid.rank[i] = k;
+                }
+                return grid;
+            }
+
+            // Per-batch, per-lag sums
+            struct VariogramSums {
+                std::vector<double> gamma;
+                std::vector<double> distance;
+                std::vector<uint64_t> count;
+
+                explicit VariogramSums(size_t size)
+                    : gamma(size, 0.0)
+                    , distance(size, 0.0)
+                    , count(size, 0)
+                {
+                }
+
+                void merge(const VariogramSums& other)
+                {
+                    for (size_t k = 0; k < gamma.size(); ++k) {
+                        gamma[k] += other.gamma[k];
+                        distance[k] += other.distance[k];
+                        count[k] += other.count[k];
+                    }
+                }
+            };
+
+        } // namespace detail
+
+        template <typename Vec, typename T>
+        inline ExperimentalVariogram experimental_variogram(
+            const Serie<Vec>& positions, const Serie<T>& values, const VariogramOptions& options)
+        {
+            static_assert(std::is_arithmetic_v<T>, "experimental_variogram requires arithmetic values");
+            constexpr size_t D = std::tuple_size<Vec>::value;
+            static_assert(D == 2 || D == 3, "experimental_variogram requires 2D or 3D positions");
+
+            if (positions.size() != values.size()) {
+                throw std::runtime_error(concat("experimental_variogram: ", positions.size(),
+                    " positions for ", values.size(), " values"));
+            }
+            if (!(options.lag_distance > 0) || options.n_lags == 0) {
+                throw std::runtime_error(
+                    "experimental_variogram: lag_distance must be > 0 and n_lags > 0");
+            }
+
+            const size_t n = positions.size();
+            const size_t n_lags = options.n_lags;
+            const double range = options.lag_distance * static_cast<double>(n_lags);
+            const size_t B = detail::variogram_batches;
+
+            // Direction (unit vector) and minimal squared cosine
+            std::array<double, D> direction {};
+            double direction_norm = 0;
+            for (size_t d = 0; d < D; ++d) {
+                direction[d] = options.direction[d];
+                direction_norm += direction[d] * direction[d];
+            }
+            const bool directional = direction_norm > 0;
+            if (directional) {
+                direction_norm = std::sqrt(direction_norm);
+                for (size_t d = 0; d < D; ++d) {
+                    direction[d] /= direction_norm;
+                }
+            }
+            const double cos_tolerance = std::cos(options.angle_tolerance);
+            const double cos2 = cos_tolerance * cos_tolerance;
+
+            const auto grid = detail::variogram_grid<D>(positions, values, range);
+
+            // Anchors, as positions in cell order: all the samples (each pair
+            // is visited once), or a random subset (all the pairs of each
+            // anchor are visited)
+            const bool sampled = options.sample_size > 0 && options.sample_size < n;
+            std::vector<size_t> anchors(n);
+            std::iota(anchors.begin(), anchors.end(), size_t { 0 });
+            if (sampled) {
+                std::mt19937_64 rng(options.seed);
+                for (size_t k = 0; k < options.sample_size; ++k) {
+                    std::uniform_int_distribution<size_t> pick(k, n - 1);
+                    std::swap(anchors[k], anchors[pick(rng)]);
+                }
+                anchors.resize(options.sample_size);
+                for (auto& a : anchors) {
+                    a = grid.rank[a];
+                }
+            }
+
+            const double range2 = range * range;
+
+            const size_t num_chunks
+                = std::min(anchors.size(), df::detail::get_optimal_threads(anchors.size()));
+            std::vector<detail::VariogramSums> partial(
+                std::max<size_t>(num_chunks, 1), detail::VariogramSums(B * n_lags));
+
+            df::detail::parallel_for_chunks(
+                anchors.size(), num_chunks, [&](size_t chunk, size_t start, size_t end) {
+                    auto& sums = partial[chunk];
+                    for (size_t a = start; a < end; ++a) {
+                        const size_t i = anchors[a];
+                        const size_t batch = (a % B) * n_lags;
+                        const auto& pi = grid.points[i];
+                        const double vi = grid.values[i];
+                        const auto c = grid.cellOf(pi);
+
+                        std::array<size_t, D> lo, hi;
+                        for (size_t d = 0; d < D; ++d) {
+                            lo[d] = c[d] > 0 ? c[d] - 1 : 0;
+                            hi[d] = std::min(grid.dims[d] - 1, c[d] + 1);
+                        }
+
+                        std::array<size_t, D> cc = lo;
+                        while (true) {
+                            const size_t cell = grid.linear(cc);
+                            size_t first = grid.offsets[cell];
+                            if (!sampled) {
+                                first = std::max(first, i + 1);
+                            }
+                            for (size_t j = first; j < grid.offsets[cell + 1]; ++j) {
+                                if (j == i) {
+                                    continue;
+                                }
+                                const auto& pj = grid.points[j];
+                                double d2 = 0;
+                                double proj = 0;
+                                for (size_t d = 0; d < D; ++d) {
+                                    const double h = pj[d] - pi[d];
+                                    d2 += h * h;
+                                    proj += h * direction[d];
+                                }
+                                if (d2 >= range2 || (directional && proj * proj < cos2 * d2)) {
+                                    continue;
+                                }
+                                const double dist = std::sqrt(d2);
+                                const size_t lag = std::min(
+                                    n_lags - 1, static_cast<size_t>(dist / options.lag_distance));
+                                const double dv = vi - grid.values[j];
+                                sums.gamma[batch + lag] += 0.5 * dv * dv;
+                                sums.distance[batch + lag] += dist;
+                                ++sums.count[batch + lag];
+                            }
+
+                            // Next neighboring cell
+                            size_t d = 0;
+                            while (d < D && cc[d] == hi[d]) {
+                                cc[d] = lo[d];
+                                ++d;
+                            }
+                            if (d == D) {
+                                break;
+                            }
+                            ++cc[d];
+                        }
+                    }
+                });
+
+            for (size_t k = 1; k < partial.size(); ++k) {
+                partial[0].merge(partial[k]);
+            }
+            const auto& sums = partial[0];
+
+            std::vector<double> distances(n_lags, 0.0), gammas(n_lags, 0.0), errors(n_lags, 0.0);
+            std::vector<uint64_t> counts(n_lags, 0);
+            for (size_t lag = 0; lag < n_lags; ++lag) {
+                double gamma = 0, distance = 0;
+                uint64_t count = 0;
+                size_t used = 0;
+                for (size_t b = 0; b < B; ++b) {
+                    gamma += sums.gamma[b * n_lags + lag];
+                    distance += sums.distance[b * n_lags + lag];
+                    count += sums.count[b * n_lags + lag];
+                    used += sums.count[b * n_lags + lag] > 0 ? 1 : 0;
+                }
+                if (count == 0) {
+                    continue;
+                }
+                counts[lag] = count;
+                gammas[lag] = gamma / static_cast<double>(count);
+                distances[lag] = distance / static_cast<double>(count);
+
+                // Variance of a ratio estimator from the batch means
+                if (used > 1) {
+                    double var = 0;
+                    for (size_t b = 0; b < B; ++b) {
+                        const uint64_t cb = sums.count[b * n_lags + lag];
+                        if (cb > 0) {
+                            const double w = static_cast<double>(cb) / static_cast<double>(count);
+                            const double mean = sums.gamma[b * n_lags + lag] / static_cast<double>(cb);
+                            var += w * w * (mean - gammas[lag]) * (mean - gammas[lag]);
+                        }
+                    }
+                    errors[lag] = std::sqrt(var * static_cast<double>(used) / static_cast<double>(used - 1));
+                }
+            }
+
+            return { Serie<double>(std::move(distances)), Serie<double>(std::move(gammas)),
+                Serie<uint64_t>(std::move(counts)), Serie<double>(std::move(errors)) };
+        }
+
+    } // namespace stats
+} // namespace df
@@ -14,6 +14,7 @@
 
 #pragma once
 #include <dataframe/Serie.h>
+#include <dataframe/stats/variogram.h>
 
 /**
  * @brief kriging implementation:
@@ -71,6 +72,7 @@ double variogram_model(double distance, const VariogramParams &params);
  * @param lag_distance Distance interval for binning
  * @param n_lags Number of lag intervals
  * @return Pair of Series: distances and variogram values
+ * @see experimental_variogram for directional and subsampled variograms
  */
 template <typename Vec, typename T>
 std::pair<Serie<double>, Serie<double>>
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <dataframe/Serie.h>
+
+/**
+ * @brief Rolling-window statistics.
+ *
+ * All the functions below run in O(n) (O(n log w) for median/quantile),
+ * whatever the window size w:
+ * - mean: compensated running sum,
+ * - variance/std: Welford add/remove updates,
+ * - min/max: monotonic deque,
+ * - median/quantile: two balanced ordered sets (lower/upper halves).
+ *
+ * Windows are either a number of samples (`size_t`) or a time span over a
+ * non-decreasing Serie of timestamps (see time_window). They are either
+ * trailing (the current sample and the previous ones) or centered on the
+ * current sample. At the boundaries, the statistics are computed on the
+ * available samples only.
+ *
+ * Scalar and array-like (std::array, Vector...) element types are supported,
+ * array types being processed component-wise. Large Series are split in
+ * chunks processed in parallel, each chunk re-reading the samples that
+ * overlap with the previous one.
+ *
+ * @code
+ * df::Serie<double> trace = ...;
+ * auto m   = df::stats::rolling_mean(trace, 10000);
+ * auto sd  = df::stats::rolling_std(trace, 10000, df::stats::WindowAlignment::CENTERED);
+ * auto mx  = df::stats::rolling_max(trace, 500);
+ * auto med = df::stats::rolling_median(trace, 101, df::stats::WindowAlignment::CENTERED);
+ *
+ * // Time-based window of 2.5 seconds
+ * df::Serie<double> t = ...;
+ * auto mt = df::stats::rolling_mean(trace, df::stats::time_window(t, 2.5));
+ *
+ * // In a pipeline
+ * auto r = trace | df::stats::bind_rolling_min<double>(100);
+ * @endcode
+ */
+
+namespace df {
+    namespace stats {
+
+        enum class WindowAlignment {
+            TRAILING, // [i - w + 1, i]
+            CENTERED // [i - w/2, i + (w-1)/2]
+        };
+
+        /**
+         * @brief Time-based window descriptor.
+         * The timestamps must be non-decreasing and outlive the rolling call.
+         * A trailing window covers (t_i - span, t_i], a centered one covers
+         * [t_i - span/2, t_i + span/2].
+         */
+        struct TimeWindow {
+            const Serie<double>* times;
+            double span;
+        };
+
+        inline TimeWindow time_window(const Serie<double>& times, double span)
+        {
+            return TimeWindow { &times, span };
+        }
+
+        /**
+         * @brief Rolling mean. Returns a Serie of the same element type. A
+         * window holding NaN or Inf values gets NaN or Inf, as a direct
+         * computation would; the next windows are not affected.
+         * @param window Number of samples (size_t) or a TimeWindow
+         * @throws std::runtime_error if the serie is empty or the window is zero
+         */
+        template <typename T, typename W>
+        Serie<T> rolling_mean(const Serie<T>& serie, const W& window,
+            WindowAlignment align = WindowAlignment::TRAILING);
+
+        /**
+         * @brief Rolling variance. Returns Serie<double> for scalar types and
+         * Serie<std::array<double, N>> for array types (same as stats::variance).
+         * A window holding NaN or Inf values gets NaN.
+         */
+        template <typename T, typename W>
+        auto rolling_variance(const Serie<T>& serie, const W& window, bool population = false,
+            WindowAlignment align = WindowAlignment::TRAILING);
+
+        /**
+         * @brief Rolling standard deviation (square root of rolling_variance)
+         */
+        template <typename T, typename W>
+        auto rolling_std(const Serie<T>& serie, const W& window, bool population = false,
+            WindowAlignment align = WindowAlignment::TRAILING);
+
+        /**
+         * @brief Rolling minimum (component-wise for array types)
+         */
+        template <typename T, typename W>
+        Serie<T> rolling_min(const Serie<T>& serie, const W& window,
+            WindowAlignment align = WindowAlignment::TRAILING);
+
+        /**
+         * @brief Rolling maximum (component-wise for array types)
+         */
+        template <typename T, typename W>
+        Serie<T> rolling_max(const Serie<T>& serie, const W& window,
+            WindowAlignment align = WindowAlignment::TRAILING);
+
+        /**
+         * @brief Rolling quantile, with the same linear interpolation as
+         * stats::quantile. Returns Serie<double> for scalar types and
+         * Serie<std::array<double, N>> for array types. NaN values are
+         * ignored, and a window without other values gives NaN.
+         * @throws std::runtime_error if q is outside [0,1]
+         */
+        template <typename T, typename W>
+        auto rolling_quantile(const Serie<T>& serie, const W& window, double q,
+            WindowAlignment align = WindowAlignment::TRAILING);
+
+        /**
+         * @brief Rolling median (rolling_quantile with q = 0.5)
+         */
+        template <typename T, typename W>
+        auto rolling_median(const Serie<T>& serie, const W& window,
+            WindowAlignment align = WindowAlignment::TRAILING);
+
+        // Helper functions for pipeline operations
+
+        template <typename T, typename W>
+        auto bind_rolling_mean(const W& window, WindowAlignment align = WindowAlignment::TRAILING);
+        template <typename T, typename W>
+        auto bind_rolling_variance(const W& window, bool population = false,
+            WindowAlignment align = WindowAlignment::TRAILING);
+        template <typename T, typename W>
+        auto bind_rolling_std(const W& window, bool population = false,
+            WindowAlignment align = WindowAlignment::TRAILING);
+        template <typename T, typename W>
+        auto bind_rolling_min(const W& window, WindowAlignment align = WindowAlignment::TRAILING);
+        template <typename T, typename W>
+        auto bind_rolling_max(const W& window, WindowAlignment align = WindowAlignment::TRAILING);
+        template <typename T, typename W>
+        auto bind_rolling_quantile(
+            const W& window, double q, WindowAlignment align = WindowAlignment::TRAILING);
+        template <typename T, typename W>
+        auto bind_rolling_median(const W& window, WindowAlignment align = WindowAlignment::TRAILING);
+
+    } // namespace stats
+} // namespace df
+
+#include "inline/rolling.hxx"
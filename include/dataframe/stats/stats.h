@@ -31,6 +31,7 @@ namespace stats {
 /**
  * Compute arithmetic average of a Serie
  * Works with scalar types and array types (vectors, matrices)
+ * Null values (see Serie::validity()) are skipped
  *
  * @param serie Input Serie
  * @return Average value (same type as input elements)
@@ -47,7 +48,8 @@ template <typename T> Serie<T> avg_serie(const Serie<T> &serie);
 /**
  * @brief Calculate the mean (average) of a Serie
  *
- * This function computes the arithmetic mean of all elements in the Serie.
+ * This function computes the arithmetic mean of all elements in the Serie,
+ * skipping the null values (see Serie::validity()).
  * It works with both scalar types and array types (vectors, matrices).
  *
  * @tparam T Type of elements in the Serie
@@ -71,8 +73,8 @@ template <typename T> T mean(const Serie<T> &serie);
 /**
  * @brief Calculate the variance of a Serie
  *
- * This function computes the variance of all elements in the Serie.
- * If the Serie contains only a single element, the variance is defined as 0.
+ * This function computes the variance of all elements in the Serie, skipping
+ * the null values. If the Serie contains only a single element, the variance is defined as 0.
  *
  * @tparam T Type of elements in the Serie
  * @param serie Input Serie
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <dataframe/Serie.h>
+#include <dataframe/geo/types.h>
+
+/**
+ * @brief Experimental (semi-)variogram of scattered samples.
+ *
+ * For every pair (i, j) of samples closer than `n_lags * lag_distance`,
+ * gamma_ij = (v_i - v_j)^2 / 2 is accumulated in the lag
+ * floor(|p_i - p_j| / lag_distance). Each lag reports the mean pair distance,
+ * the mean gamma (semivariance) and the number of pairs.
+ *
+ * - Only the pairs in range are visited: the samples are bucketed in a
+ *   uniform grid with cells at least as large as the maximum range, and each
+ *   sample is only compared to the samples of its neighboring cells.
+ * - The samples are processed in parallel, each thread accumulating sums
+ *   and counts per lag (no per-pair storage).
+ * - Directional variograms only keep the pairs whose separation vector is
+ *   within `angle_tolerance` of `direction` (in both senses).
+ * - For large datasets, `sample_size` anchors are drawn at random and only
+ *   the pairs involving an anchor are used (Monte-Carlo subsampling). Every
+ *   pair in range has the same probability to be drawn, so the estimate is
+ *   unbiased.
+ *
+ * The uncertainty of each semivariance is given as a standard error: the
+ * anchors are dealt into 16 batches, and the error is estimated from the
+ * spread of the per-batch semivariances.
+ *
+ * @code
+ * df::stats::VariogramOptions options;
+ * options.lag_distance = 50;
+ * options.n_lags = 20;
+ * options.direction = {1, 1, 0};          // N45 directional variogram
+ * options.angle_tolerance = M_PI / 8;
+ * options.sample_size = 20000;            // Monte-Carlo on 1M samples
+ * auto vario = df::stats::experimental_variogram(positions, porosity, options);
+ * // 95% confidence interval of the first lag
+ * double lo = vario.values[0] - 1.96 * vario.std_errors[0];
+ * @endcode
+ */
+
+namespace df {
+    namespace stats {
+
+        struct VariogramOptions {
+            double lag_distance = 1.0;
+            size_t n_lags = 10;
+            // Zero vector: omnidirectional variogram. For 2D positions, only
+            // the first two components are used.
+            Vector3 direction { 0, 0, 0 };
+            double angle_tolerance = 0.39269908169872414; // pi / 8
+            // 0: use all the samples, otherwise number of random anchors
+            size_t sample_size = 0;
+            uint64_t seed = 42;
+        };
+
+        struct ExperimentalVariogram {
+            Serie<double> distances; // mean pair distance per lag (0 if empty)
+            Serie<double> values; // semivariance per lag (0 if empty)
+            Serie<uint64_t> counts; // number of pairs per lag
+            Serie<double> std_errors; // standard error of the semivariance
+        };
+
+        /**
+         * @brief Experimental variogram (see above)
+         * @param positions Serie of Vector2 or Vector3
+         * @param values Serie of arithmetic values
+         * @throws std::runtime_error if the Series have different sizes, or
+         * if lag_distance <= 0 or n_lags == 0
+         */
+        template <typename Vec, typename T>
+        ExperimentalVariogram experimental_variogram(
+            const Serie<Vec>& positions, const Serie<T>& values, const VariogramOptions& options);
+
+    } // namespace stats
+} // namespace df
+
+#include "inline/variogram.hxx"
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace df {
+
+    /**
+     * @brief splitmix64 finalizer.
+     *
+     * std::hash is the identity for integers with libstdc++, which clusters
+     * badly in a power-of-two open-addressing table. Mixing the bits fixes it.
+     */
+    inline uint64_t hash_mix(uint64_t h)
+    {
+        h += 0x9e3779b97f4a7c15ULL;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    /**
+     * @brief Minimal open-addressing (linear probing) hash map.
+     *
+     * Keys and values are stored in flat arrays, without one heap allocation
+     * per entry as in std::unordered_map. Erasing is not supported: the map is
+     * meant to be built, queried and thrown away (grouping, joins, indices).
+     *
+     * @code
+     * df::FlatHashMap<int, uint32_t> ids;
+     * auto [id, inserted] = ids.try_emplace(42, 0);
+     * if (const uint32_t* found = ids.find(42)) { ... }
+     * @endcode
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>> class FlatHashMap {
+    public:
+        explicit FlatHashMap(size_t expected = 0) { reserve(expected); }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        /**
+         * @brief Insert (key, value) if key is not present.
+         * @return A pointer to the stored value, and whether it was inserted
+         */
+        std::pair<V*, bool> try_emplace(const K& key, const V& value)
+        {
+            if ((size_ + 1) * 2 > full_.size()) {
+                rehash(full_.empty() ? 16 : full_.size() * 2);
+            }
+            size_t i = slot(key);
+            if (full_[i]) {
+                return { &values_[i], false };
+            }
+            full_[i] = 1;
+            keys_[i] = key;
+            values_[i] = value;
+            ++size_;
+            return { &values_[i], true };
+        }
+
+        V* find(const K& key)
+        {
+            if (size_ == 0) {
+                return nullptr;
+            }
+            size_t i = slot(key);
+            return full_[i] ? &values_[i] : nullptr;
+        }
+
+        const V* find(const K& key) const { return const_cast<FlatHashMap*>(this)->find(key); }
+
+        bool contains(const K& key) const { return find(key) != nullptr; }
+
+        /**
+         * @brief Make room for n entries without rehashing (max load factor 0.5)
+         */
+        void reserve(size_t n)
+        {
+            size_t capacity = 16;
+            while (capacity < n * 2) {
+                capacity *= 2;
+            }
+            if (capacity > full_.size()) {
+                rehash(capacity);
+            }
+        }
+
+        void clear()
+        {
+            keys_.clear();
+            values_.clear();
+            full_.clear();
+            size_ = 0;
+        }
+
+        /**
+         * @brief Iterate over all the (key, value) pairs, in no particular order
+         */
+        template <typename F> void forEach(F&& callback) const
+        {
+            for (size_t i = 0; i < full_.size(); ++i) {
+                if (full_[i]) {
+                    callback(keys_[i], values_[i]);
+                }
+            }
+        }
+
+    private:
+        // Slot holding key, or the empty slot where it would be inserted
+        size_t slot(const K& key) const
+        {
+            const size_t mask = full_.size() - 1;
+            size_t i = static_cast<size_t>(hash_mix(static_cast<uint64_t>(Hash {}(key)))) & mask;
+            while (full_[i] && !(keys_[i] == key)) {
+                i = (i + 1) & mask;
+            }
+            return i;
+        }
+
+        void rehash(size_t capacity)
+        {
+            std::vector<K> keys(capacity);
+            std::vector<V> values(capacity);
+            std::vector<uint8_t> full(capacity, 0);
+            keys.swap(keys_);
+            values.swap(values_);
+            full.swap(full_);
+            size_ = 0;
+            for (size_t i = 0; i < full.size(); ++i) {
+                if (full[i]) {
+                    size_t j = slot(keys[i]);
+                    full_[j] = 1;
+                    keys_[j] = std::move(keys[i]);
+                    values_[j] = std::move(values[i]);
+                    ++size_;
+                }
+            }
+        }
+
+        std::vector<K> keys_;
+        std::vector<V> values_;
+        std::vector<uint8_t> full_;
+        size_t size_ = 0;
+    };
+
+} // namespace df
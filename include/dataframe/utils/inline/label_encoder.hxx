@@ -71,6 +71,77 @@ LabelEncoder::fit_transform(const df::Serie<std::string> &serie) {
     return transform(serie);
 }
 
+inline LabelEncoder &LabelEncoder::fit(const df::CategoricalSerie &serie) {
+    string_to_id_.clear();
+    id_to_string_.clear();
+
+    // Distinct codes in the order of their first occurrence
+    std::vector<uint8_t> seen(serie.dictionary()->size(), 0);
+    bool null_seen = false;
+    size_t next_id = 0;
+    auto insert = [&](const std::string &value) {
+        if (string_to_id_.emplace(value, next_id).second) {
+            id_to_string_[next_id++] = value;
+        }
+    };
+    for (size_t i = 0; i < serie.size(); ++i) {
+        if (serie.isNull(i)) {
+            if (!null_seen) {
+                null_seen = true;
+                insert(std::string());
+            }
+        } else if (!seen[serie.code(i)]) {
+            seen[serie.code(i)] = 1;
+            insert(serie[i]);
+        }
+    }
+
+    fitted_ = true;
+    return *this;
+}
+
+inline df::Serie<double>
+LabelEncoder::transform(const df::CategoricalSerie &serie) const {
+    if (!fitted_) {
+        throw std::runtime_error(
+            "LabelEncoder must be fitted before transform");
+    }
+
+    // Id of each code, resolved on first use (-1: not resolved yet)
+    const auto &values = serie.dictionary()->values();
+    std::vector<double> ids(values.size(), -1.0);
+    auto id_of = [this](const std::string &value) {
+        auto it = string_to_id_.find(value);
+        if (it == string_to_id_.end()) {
+            throw std::runtime_error("Unknown category encountered: " + value);
+        }
+        return static_cast<double>(it->second);
+    };
+
+    std::vector<double> encoded(serie.size());
+    serie.visitCodes([&](const auto &codes) {
+        for (size_t i = 0; i < codes.size(); ++i) {
+            if (serie.isNull(i)) {
+                encoded[i] = id_of(std::string());
+                continue;
+            }
+            double &id = ids[codes[i]];
+            if (id < 0) {
+                id = id_of(values[codes[i]]);
+            }
+            encoded[i] = id;
+        }
+    });
+
+    return df::Serie<double>(encoded);
+}
+
+inline df::Serie<double>
+LabelEncoder::fit_transform(const df::CategoricalSerie &serie) {
+    fit(serie);
+    return transform(serie);
+}
+
 inline df::Serie<std::string>
 LabelEncoder::inverse_transform(const df::Serie<double> &serie) const {
     if (!fitted_) {
@@ -13,6 +13,7 @@
  */
 
 #pragma once
+#include <dataframe/CategoricalSerie.h>
 #include <dataframe/Serie.h>
 #include <map>
 
@@ -55,6 +56,15 @@ class LabelEncoder {
      */
     df::Serie<double> fit_transform(const df::Serie<std::string> &serie);
 
+    /**
+     * @brief Same as above for a dictionary-encoded Serie: each distinct
+     * code is looked up once, then the rows are mapped through a table
+     * indexed by code. A null reads as an empty string.
+     */
+    LabelEncoder &fit(const df::CategoricalSerie &serie);
+    df::Serie<double> transform(const df::CategoricalSerie &serie) const;
+    df::Serie<double> fit_transform(const df::CategoricalSerie &serie);
+
     /**
      * @brief Convert numeric IDs back to their original string values
      * @param serie Serie<double> containing the IDs to convert
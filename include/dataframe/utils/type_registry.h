@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <dataframe/types.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace df {
+
+    template <typename... Ts> struct type_list {
+        static constexpr size_t size = sizeof...(Ts);
+    };
+
+    /**
+     * @brief The column types known by the library. The position of a type in
+     * this list is its id (see type_id), used to dispatch on the type of a
+     * type-erased column with a jump table (see visit) rather than with a
+     * chain of typeid comparisons.
+     *
+     * Columns of other types still work everywhere; they just have no id and
+     * are skipped by visit.
+     */
+    using column_types = type_list<bool, char, signed char, unsigned char, short,
+        unsigned short, int, unsigned int, long, unsigned long, long long, unsigned long long,
+        float, double, std::string, Vector2, Vector3, Vector4, Vector6, iVector2, iVector3,
+        iVector4, iVector6, SMatrix2D, SMatrix3D, SMatrix4D, Matrix2D, Matrix3D, Matrix4D>;
+
+    /**
+     * @brief Names of the column types, in the order of column_types
+     */
+    inline constexpr std::string_view column_type_names[] = { "bool", "char", "signed char",
+        "unsigned char", "short", "unsigned short", "int", "unsigned int", "long",
+        "unsigned long", "long long", "unsigned long long", "float", "double", "string",
+        "df::Vector<double, 2>", "df::Vector<double, 3>", "df::Vector<double, 4>",
+        "df::Vector<double, 6>", "array<unsigned int, 2>", "array<unsigned int, 3>",
+        "array<unsigned int, 4>", "array<unsigned int, 6>", "df::SymmetricMatrix<double, 2>",
+        "df::SymmetricMatrix<double, 3>", "df::SymmetricMatrix<double, 4>",
+        "df::FullMatrix<double, 2>", "df::FullMatrix<double, 3>", "df::FullMatrix<double, 4>" };
+
+    static_assert(std::size(column_type_names) == column_types::size);
+
+    namespace detail {
+        template <typename T, typename... Ts> constexpr int index_of()
+        {
+            constexpr bool same[] = { std::is_same_v<T, Ts>... };
+            for (size_t i = 0; i < sizeof...(Ts); ++i) {
+                if (same[i]) {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+
+        template <typename T, typename List> struct type_id_in;
+        template <typename T, typename... Ts> struct type_id_in<T, type_list<Ts...>> {
+            static constexpr int value = index_of<T, Ts...>();
+        };
+    } // namespace detail
+
+    /**
+     * @brief Id of T in column_types, or -1 if T is not a registered type
+     */
+    template <typename T>
+    inline constexpr int type_id = detail::type_id_in<T, column_types>::value;
+
+    /**
+     * @brief Name of a registered type, or an empty string_view
+     */
+    template <typename T> constexpr std::string_view type_label()
+    {
+        if constexpr (type_id<T> >= 0) {
+            return column_type_names[type_id<T>];
+        } else {
+            return {};
+        }
+    }
+
+} // namespace df
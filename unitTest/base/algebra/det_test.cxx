@@ -91,4 +91,51 @@ TEST(determinant, error_cases) {
         std::vector<double>({1.0}), 1e-10);
 }
 
-RUN_TESTS()
\ No newline at end of file
+TEST(determinant, batched) {
+    MSG("Testing batched determinants up to 8x8");
+
+    // Permuted upper triangular matrices: det = sign * product of diagonal
+    std::vector<FullMatrix<double, 5>> matrices(100);
+    std::vector<double> expected(100);
+    for (size_t k = 0; k < matrices.size(); ++k) {
+        FullMatrix<double, 5> U;
+        double product = 1.0;
+        for (size_t i = 0; i < 5; ++i) {
+            for (size_t j = 0; j < 5; ++j) {
+                U(i, j) = j < i ? 0.0 : (i == j ? 1.0 + 0.1 * static_cast<double>(k + i)
+                                               : static_cast<double>(i + j) * 0.3);
+            }
+            product *= U(i, i);
+        }
+        // Swap rows 0 and (k % 4) + 1
+        const size_t r = k % 4 + 1;
+        for (size_t j = 0; j < 5; ++j) {
+            std::swap(U(0, j), U(r, j));
+        }
+        matrices[k] = U;
+        expected[k] = -product;
+    }
+
+    auto result = det(Serie<FullMatrix<double, 5>>(matrices));
+    EXPECT_ARRAY_NEAR(result.asArray(), expected, 1e-9);
+
+    Serie<FullMatrix<double, 4>> m4 { { 4.0, -1.0, 2.0, 1.0, -1.0, 6.0, -2.0, 0.0, 2.0, -2.0, 5.0,
+        -1.0, 1.0, 0.0, -1.0, 3.0 } };
+    EXPECT_NEAR(det(m4)[0], m4[0].determinant(), 1e-10);
+}
+
+TEST(determinant, unbatched) {
+    MSG("Testing determinants outside of the batched kernels");
+
+    // Integral values
+    Serie<FullMatrix<int, 3>> mi { { 2, 0, 1, 1, 3, 0, 0, 1, 4 } };
+    EXPECT_EQ(det(mi)[0], 25);
+    Serie<FullMatrix<int, 2>> m2 { { 3, 1, 2, 4 } };
+    EXPECT_EQ(det(m2)[0], 10);
+
+    // Larger than 8x8: processed one by one, not implemented by FullMatrix
+    Serie<FullMatrix<double, 9>> m9 { FullMatrix<double, 9>::Identity() };
+    EXPECT_THROW(det(m9), std::runtime_error);
+}
+
+RUN_TESTS()
@@ -104,6 +104,81 @@ TEST(eigen_analysis, matrix3x3)
     // }
 }
 
+TEST(eigen_analysis, analytic)
+{
+    MSG("Testing batched closed-form solvers against Jacobi");
+
+    // Random matrices, plus diagonal, repeated and nearly repeated eigenvalues
+    uint64_t seed = 12345;
+    auto rnd = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(seed >> 11) / 9007199254740992.0 * 2.0 - 1.0;
+    };
+
+    std::vector<SMatrix3D> m3 { { 1, 0, 0, 1, 0, 1 }, { 2, 0, 0, 3, 0, 4 },
+        { 2, 1, 1, 2, 1, 2 }, { 0, 0, 0, 0, 0, 0 }, { 1, 1e-9, 0, 1, 0, 1 + 1e-9 } };
+    std::vector<SMatrix2D> m2 { { 1, 0, 1 }, { 2, 0, 3 }, { 0, 0, 0 }, { 4, 1, 3 } };
+    for (size_t i = 0; i < 5000; ++i) {
+        const double s = std::pow(10.0, 3 * rnd());
+        m3.push_back({ s * rnd(), s * rnd(), s * rnd(), s * rnd(), s * rnd(), s * rnd() });
+        m2.push_back({ s * rnd(), s * rnd(), s * rnd() });
+    }
+
+    auto scale_of = [](const auto& A) {
+        double scale = 1e-300;
+        for (double a : A.data()) {
+            scale = std::max(scale, std::abs(a));
+        }
+        return scale;
+    };
+
+    // Jacobi with a tight tolerance as the reference
+    auto check = [&](const auto& mats, const auto& systems) {
+        for (size_t i = 0; i < mats.size(); ++i) {
+            const auto& A = mats[i];
+            const auto& [values, V] = systems[i];
+            constexpr size_t N = std::tuple_size_v<std::decay_t<decltype(values)>>;
+            const double scale = scale_of(A);
+            const auto ref = jacobi_symmetric_eigen(A, 1e-15 * scale).first;
+            for (size_t k = 0; k < N; ++k) {
+                EXPECT_NEAR(values[k], ref[k], 1e-10 * scale);
+                // A v = lambda v, |v| = 1
+                double norm = 0;
+                for (size_t r = 0; r < N; ++r) {
+                    double av = 0;
+                    for (size_t c = 0; c < N; ++c) {
+                        av += A(r, c) * V(c, k);
+                    }
+                    EXPECT_NEAR(av, values[k] * V(r, k), 1e-8 * scale);
+                    norm += V(r, k) * V(r, k);
+                }
+                EXPECT_NEAR(norm, 1.0, 1e-10);
+            }
+        }
+    };
+
+    const Serie<SMatrix3D> s3(m3);
+    const Serie<SMatrix2D> s2(m2);
+    check(m3, eigenSystemAnalytic(s3));
+    check(m2, eigenSystemAnalytic(s2));
+
+    // Sorted in descending order, and the same as the Jacobi solver
+    auto values = eigenValues(s3);
+    for (size_t i = 0; i < s3.size(); ++i) {
+        const double scale = scale_of(m3[i]);
+        const auto ref = jacobi_symmetric_eigen(m3[i], 1e-15 * scale).first;
+        EXPECT_TRUE(values[i][0] >= values[i][1] && values[i][1] >= values[i][2]);
+        expect_near(values[i], ref, 1e-10 * scale);
+    }
+
+    // Same eigenvectors as the Jacobi solver for 2x2
+    auto v2 = eigenVectorsAnalytic(Serie<SMatrix2D> { { 4.0, 1.0, 3.0 } });
+    expect_near(v2[0].col(0), std::array { 0.850651, 0.525731 }, 1e-5);
+    expect_near(v2[0].col(1), std::array { -0.525731, 0.850651 }, 1e-5);
+
+    EXPECT_EQ(eigenValuesAnalytic(Serie<SMatrix3D>()).size(), 0);
+}
+
 // TEST(eigen_analysis, matrix4x4) {
 //     MSG("Testing 4x4 symmetric matrix eigen decomposition");
 
@@ -317,4 +317,84 @@ TEST(inverse, special_cases)
     EXPECT_ARRAY_NEAR(result_diag_3x3[0], std::vector<double>({ 0.5, 0, 0, 0.5, 0, 0.5 }), 1e-10);
 }
 
-RUN_TESTS()
\ No newline at end of file
+TEST(inverse, batched)
+{
+    MSG("Testing batched inverses up to 8x8");
+
+    uint64_t seed = 11;
+    auto rnd = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(seed >> 11) / 9007199254740992.0 * 2.0 - 1.0;
+    };
+
+    // A A^-1 = I
+    auto check = [](const auto& A, const auto& R) {
+        constexpr size_t N = std::decay_t<decltype(A[0])>::dim();
+        for (size_t k = 0; k < A.size(); ++k) {
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    double sum = 0.0;
+                    for (size_t p = 0; p < N; ++p) {
+                        sum += A[k](i, p) * R[k](p, j);
+                    }
+                    EXPECT_NEAR(sum, i == j ? 1.0 : 0.0, 1e-9);
+                }
+            }
+        }
+    };
+
+    std::vector<Matrix3D> m3(3000);
+    std::vector<FullMatrix<double, 6>> m6(3000);
+    std::vector<SymmetricMatrix<double, 8>> s8(3000);
+    for (size_t k = 0; k < m3.size(); ++k) {
+        for (auto& v : m3[k].data()) {
+            v = rnd();
+        }
+        for (auto& v : m6[k].data()) {
+            v = rnd();
+        }
+        for (auto& v : s8[k].data()) {
+            v = rnd();
+        }
+        for (size_t i = 0; i < 3; ++i) {
+            m3[k](i, i) += 3.0;
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            m6[k](i, i) += 6.0;
+        }
+        for (size_t i = 0; i < 8; ++i) {
+            s8[k](i, i) += i % 2 == 0 ? 8.0 : -8.0;
+        }
+    }
+
+    Serie<Matrix3D> A3(m3);
+    Serie<FullMatrix<double, 6>> A6(m6);
+    Serie<SymmetricMatrix<double, 8>> S8(s8);
+    check(A3, inv(A3));
+    check(A6, inv(A6));
+    check(S8, inv(S8));
+
+    // Small but well-conditioned matrices are not singular
+    Serie<Matrix3D> small { { 1e-6, 0, 0, 0, 1e-6, 0, 0, 0, 1e-6 } };
+    EXPECT_NEAR(inv(small)[0](1, 1), 1e6, 1e-4);
+
+    Serie<FullMatrix<double, 5>> singular(1);
+    EXPECT_THROW(inv(singular), std::runtime_error);
+}
+
+TEST(inverse, unbatched)
+{
+    MSG("Testing inverses outside of the batched kernels");
+
+    // Integral values
+    Serie<FullMatrix<int, 2>> mi { { 2, 0, 0, 1 } };
+    auto ri = inv(mi);
+    EXPECT_EQ(ri[0](0, 0), 0); // integer division, as FullMatrix::inverse
+    EXPECT_EQ(ri[0](1, 1), 1);
+
+    // Larger than 8x8: processed one by one, not implemented by FullMatrix
+    Serie<FullMatrix<double, 9>> m9 { FullMatrix<double, 9>::Identity() };
+    EXPECT_THROW(inv(m9), std::runtime_error);
+}
+
+RUN_TESTS()
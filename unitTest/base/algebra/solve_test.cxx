@@ -14,6 +14,15 @@
 #include "../../TEST.h"
 #include <dataframe/algebra/solve.h>
 
+namespace {
+    // Deterministic pseudo-random values in [-1, 1]
+    double rnd(uint64_t& seed)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(seed >> 11) / 9007199254740992.0 * 2.0 - 1.0;
+    }
+} // namespace
+
 TEST(solve, simple_2x2) {
     // Create a 2x2 system:
     // 2x + y = 1
@@ -90,4 +99,80 @@ TEST(solve, pipe_operator) {
     EXPECT_NEAR(x[1], 0.6, 1e-10);
 }
 
+TEST(solve, batched) {
+    MSG("Testing batched per-element solves");
+
+    // Residual |A x - b| of every system
+    auto check = [](const auto &A, const auto &b, const auto &x) {
+        constexpr size_t N = std::decay_t<decltype(b[0])>::static_size;
+        for (size_t k = 0; k < A.size(); ++k) {
+            for (size_t i = 0; i < N; ++i) {
+                double sum = 0.0;
+                for (size_t j = 0; j < N; ++j) {
+                    sum += A[k](i, j) * x[k][j];
+                }
+                EXPECT_NEAR(sum, b[k][i], 1e-9);
+            }
+        }
+    };
+
+    uint64_t seed = 7;
+    const size_t n = 5000;
+    std::vector<df::FullMatrix<double, 3>> a3(n);
+    std::vector<df::SymmetricMatrix<double, 6>> s6(n);
+    std::vector<df::FullMatrix<double, 8>> a8(n);
+    std::vector<df::Vector<double, 3>> b3(n);
+    std::vector<df::Vector<double, 6>> b6(n);
+    std::vector<df::Vector<double, 8>> b8(n);
+    for (size_t k = 0; k < n; ++k) {
+        for (auto &v : a3[k].data()) {
+            v = rnd(seed);
+        }
+        for (auto &v : a8[k].data()) {
+            v = rnd(seed);
+        }
+        for (size_t i = 0; i < 8; ++i) {
+            a8[k](i, i) += 4.0;
+        }
+        // Positive definite for even k, indefinite for odd k
+        for (size_t i = 0; i < 6; ++i) {
+            for (size_t j = i; j < 6; ++j) {
+                s6[k](i, j) = 0.5 * rnd(seed);
+            }
+            s6[k](i, i) = (k % 2 == 0 || i % 2 == 0) ? 4.0 : -4.0;
+        }
+        for (auto &v : b3[k]) {
+            v = rnd(seed);
+        }
+        for (auto &v : b6[k]) {
+            v = rnd(seed);
+        }
+        for (auto &v : b8[k]) {
+            v = rnd(seed);
+        }
+    }
+
+    df::Serie<df::FullMatrix<double, 3>> A3(a3);
+    df::Serie<df::SymmetricMatrix<double, 6>> S6(s6);
+    df::Serie<df::FullMatrix<double, 8>> A8(a8);
+    df::Serie<df::Vector<double, 3>> B3(b3);
+    df::Serie<df::Vector<double, 6>> B6(b6);
+    df::Serie<df::Vector<double, 8>> B8(b8);
+    check(A3, B3, df::solve(A3, B3));
+    check(S6, B6, df::solve(S6, B6));
+    check(A8, B8, df::solve(A8, B8));
+
+    // Pivoting is required here
+    df::Serie<df::FullMatrix<double, 2>> P{{0.0, 1.0, 1.0, 0.0}};
+    df::Serie<df::Vector<double, 2>> pb{{2.0, 3.0}};
+    auto px = df::solve(P, pb);
+    EXPECT_NEAR(px[0][0], 3.0, 1e-14);
+    EXPECT_NEAR(px[0][1], 2.0, 1e-14);
+
+    df::Serie<df::FullMatrix<double, 2>> singular{{1.0, 2.0, 2.0, 4.0}};
+    EXPECT_THROW(df::solve(singular, pb), std::runtime_error);
+    EXPECT_THROW(df::solve(A3, df::Serie<df::Vector<double, 3>>(3)),
+                 std::invalid_argument);
+}
+
 RUN_TESTS();
\ No newline at end of file
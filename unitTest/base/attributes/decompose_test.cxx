@@ -78,4 +78,42 @@ TEST(Decompose, matrices)
     }
 }
 
+TEST(Decompose, catalog)
+{
+    df::Serie<Vector3> positions = { { 1, 2, 3 }, { 4, 5, 6 } };
+    df::Serie<df::Stress3D> stresses = { { 1, 2, 3, 4, 5, 6 }, { 7, 8, 9, 10, 11, 12 } };
+
+    df::Dataframe dataframe;
+    dataframe.add("P", positions);
+    dataframe.add("S", stresses);
+
+    df::attributes::Manager manager(dataframe);
+    manager.addDecomposer(df::attributes::Components());
+
+    auto Scalar = df::attributes::DecompDimension::Scalar;
+    CHECK(manager.hasAttribute(Scalar, "Py"));
+    CHECK(manager.hasAttribute(Scalar, "Syz"));
+    CHECK(!manager.hasAttribute(Scalar, "Qx"));
+    CHECK(manager.source(Scalar, "Sxy") == "S");
+
+    const auto& py = manager.component("Py");
+    EXPECT_ARRAY_EQ(py.asArray(), std::vector<double>({ 2, 5 }));
+    CHECK(&manager.component("Py") == &py); // served from the cache
+    EXPECT_ARRAY_EQ(manager.getSerie<double>("Sxy").asArray(), std::vector<double>({ 2, 8 }));
+    EXPECT_THROW(manager.component("Qx"), std::runtime_error);
+
+    // The catalog follows the Dataframe
+    dataframe.add("Q", df::Serie<Vector3>({ { 7, 8, 9 } }));
+    CHECK(manager.hasAttribute(Scalar, "Qx"));
+    dataframe.remove("S");
+    CHECK(!manager.hasAttribute(Scalar, "Sxy"));
+    EXPECT_ARRAY_EQ(manager.component("Px").asArray(), std::vector<double>({ 1, 4 }));
+
+    // Coordinates only decompose vector columns
+    df::attributes::Manager coords(dataframe);
+    coords.addDecomposer(df::attributes::Coordinates());
+    CHECK(coords.hasAttribute(Scalar, "P_z"));
+    EXPECT_ARRAY_EQ(coords.component("Q_y").asArray(), std::vector<double>({ 8 }));
+}
+
 RUN_TESTS();
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "../TEST.h"
+#include <dataframe/CategoricalSerie.h>
+#include <dataframe/Dataframe.h>
+#include <dataframe/core/groupBy.h>
+#include <dataframe/core/join.h>
+#include <dataframe/core/orderBy.h>
+#include <dataframe/core/sort.h>
+#include <dataframe/core/unique.h>
+#include <dataframe/utils/label_encoder.h>
+
+using namespace df;
+
+TEST(categoricalSerie, basic) {
+    CategoricalSerie city{"Paris", "Lyon", "Paris", "Nice"};
+    EXPECT_EQ(city.size(), 4);
+    EXPECT_EQ(city.dictionary()->size(), 3);
+    EXPECT_EQ(city.code(0), 0);
+    EXPECT_EQ(city.code(2), 0);
+    EXPECT_EQ(city.code(3), 2);
+    EXPECT_STREQ(city[1], "Lyon");
+    EXPECT_EQ(city.codeWidth(), 1);
+    EXPECT_THROW(city[4], std::out_of_range);
+    EXPECT_THROW(city.addCode(3), std::out_of_range);
+
+    city.addNull();
+    EXPECT_EQ(city.nullCount(), 1);
+    EXPECT_TRUE(city[4].empty());
+
+    Serie<std::string> decoded = city.toSerie();
+    EXPECT_STREQ(decoded[3], "Nice");
+    EXPECT_TRUE(decoded.isNull(4));
+
+    // Shared dictionary: same codes
+    CategoricalSerie other(city.dictionary());
+    other.add("Nice");
+    other.add("Lille");
+    EXPECT_EQ(other.code(0), 2);
+    EXPECT_EQ(city.dictionary()->size(), 4);
+}
+
+TEST(categoricalSerie, widen) {
+    CategoricalSerie s;
+    for (int i = 0; i < 300; ++i) {
+        s.add(std::to_string(i));
+    }
+    EXPECT_EQ(s.codeWidth(), 2);
+    EXPECT_EQ(s.code(299), 299);
+    EXPECT_STREQ(s[255], "255");
+    EXPECT_STREQ(s[3], "3");
+}
+
+TEST(categoricalSerie, gather_select) {
+    CategoricalSerie s{"a", "b", "c", "b"};
+    auto gathered =
+        std::dynamic_pointer_cast<CategoricalSerie>(s.gather({3, -1, 0}));
+    EXPECT_TRUE(gathered != nullptr);
+    EXPECT_TRUE(gathered->dictionary() == s.dictionary());
+    EXPECT_STREQ((*gathered)[0], "b");
+    EXPECT_TRUE(gathered->isNull(1));
+    EXPECT_STREQ((*gathered)[2], "a");
+
+    auto selected = gathered->select(Mask{false, true, true});
+    EXPECT_EQ(selected.size(), 2);
+    EXPECT_TRUE(selected.isNull(0));
+    EXPECT_STREQ(selected[1], "a");
+}
+
+TEST(categoricalSerie, sort_unique) {
+    CategoricalSerie s{"pear", "apple", "fig", "apple"};
+    s.addNull();
+
+    EXPECT_ARRAY_EQ(argsort(s).data(), std::vector<uint32_t>({1, 3, 2, 0, 4}));
+    auto sorted = sort(s, SortOrder::DESCENDING);
+    EXPECT_STREQ(sorted[0], "pear");
+    EXPECT_STREQ(sorted[3], "apple");
+    EXPECT_TRUE(sorted.isNull(4));
+
+    auto distinct = unique(s);
+    EXPECT_EQ(distinct.size(), 4);
+    EXPECT_STREQ(distinct[2], "fig");
+    EXPECT_TRUE(distinct.isNull(3));
+}
+
+TEST(categoricalSerie, groupBy) {
+    CategoricalSerie city{"Paris", "Lyon", "Paris", "Nice", "Lyon"};
+    Serie<double> price{10, 20, 30, 40, 50};
+
+    auto result = groupBy(city).agg(price, agg::count(), agg::sum());
+    EXPECT_ARRAY_EQ(result.get<std::string>("key").data(),
+                    std::vector<std::string>({"Lyon", "Nice", "Paris"}));
+    EXPECT_ARRAY_EQ(result.get<uint32_t>("count").data(),
+                    std::vector<uint32_t>({2, 1, 2}));
+    EXPECT_ARRAY_EQ(result.get<double>("sum").data(),
+                    std::vector<double>({70, 40, 40}));
+
+    // Same groups as the string keys
+    auto strings = groupBy(city.toSerie());
+    EXPECT_ARRAY_EQ(groupBy(city).groupIds(), strings.groupIds());
+}
+
+TEST(categoricalSerie, orderBy) {
+    Dataframe frame;
+    frame.add("city", std::make_shared<CategoricalSerie>(
+                          CategoricalSerie{"Paris", "Lyon", "Paris", "Nice"}));
+    frame.add("price", Serie<double>{4, 3, 2, 1});
+
+    auto sorted = orderBy(frame, {"city", "price"});
+    EXPECT_ARRAY_EQ(sorted.get<double>("price").data(),
+                    std::vector<double>({3, 1, 2, 4}));
+    EXPECT_STREQ(sorted.categorical("city")[3], "Paris");
+}
+
+TEST(categoricalSerie, join) {
+    CategoricalSerie a{"x", "y", "y", "z"};
+    CategoricalSerie b{"y", "w", "x", "y"};
+
+    // Different dictionaries
+    auto idx = join_indices(a, b, JoinType::LEFT);
+    EXPECT_ARRAY_EQ(idx.left, std::vector<int64_t>({0, 1, 1, 2, 2, 3}));
+    EXPECT_ARRAY_EQ(idx.right, std::vector<int64_t>({2, 0, 3, 0, 3, -1}));
+
+    // Same result as the string keys
+    auto strings = join_indices(a.toSerie(), b.toSerie(), JoinType::OUTER);
+    auto codes = join_indices(a, b, JoinType::OUTER);
+    EXPECT_ARRAY_EQ(codes.left, strings.left);
+    EXPECT_ARRAY_EQ(codes.right, strings.right);
+
+    Dataframe left;
+    left.add("key", std::make_shared<CategoricalSerie>(a));
+    left.add("u", Serie<int>{1, 2, 3, 4});
+    Dataframe right;
+    right.add("key", std::make_shared<CategoricalSerie>(b));
+    right.add("v", Serie<int>{10, 20, 30, 40});
+
+    auto table = join(left, right, "key", JoinType::OUTER);
+    const auto &keys = table.categorical("key");
+    EXPECT_EQ(keys.size(), 7);
+    EXPECT_STREQ(keys[6], "w");
+    EXPECT_EQ(left.categorical("key").dictionary()->size(), 3);
+    EXPECT_ARRAY_EQ(table.get<int>("v").data(),
+                    std::vector<int>({30, 10, 40, 10, 40, 0, 20}));
+}
+
+TEST(categoricalSerie, labelEncoder) {
+    Serie<std::string> labels{"b", "a", "b", "c"};
+    LabelEncoder strings;
+    LabelEncoder codes;
+    EXPECT_ARRAY_EQ(codes.fit_transform(CategoricalSerie(labels)).data(),
+                    strings.fit_transform(labels).data());
+    EXPECT_THROW(codes.transform(CategoricalSerie{"d"}), std::runtime_error);
+}
+
+RUN_TESTS();
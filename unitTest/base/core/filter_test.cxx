@@ -18,6 +18,7 @@
 #include <dataframe/core/pipe.h>
 #include <dataframe/core/map.h>
 #include <cmath>
+#include <thread>
 
 TEST(Filter, BasicFiltering) {
     auto series = df::Serie<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
@@ -159,4 +160,51 @@ TEST(Filter, PipeUsage) {
     EXPECT_ARRAY_EQ(multi_filter.data(), std::vector<int>({6, 8, 10}));
 }
 
+TEST(Filter, LargeSeries) {
+    // Large enough to be compacted by several threads
+    const size_t n = 100003;
+    auto values = df::Serie<int>(std::vector<int>(n));
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<int>(i);
+    }
+
+    auto result = df::filter([](int x, size_t) { return x % 7 == 3; }, values);
+    EXPECT_EQ(result.size(), (n - 3 + 6) / 7);
+    bool ordered = true;
+    for (size_t i = 0; i < result.size(); ++i) {
+        ordered = ordered && result[i] == static_cast<int>(7 * i + 3);
+    }
+    EXPECT_TRUE(ordered);
+
+    // The predicate is only called from other threads when asked for
+    const auto caller = std::this_thread::get_id();
+    size_t calls = 0;
+    auto seq = df::filter(
+        [&](int x, size_t) {
+            calls += std::this_thread::get_id() == caller;
+            return x % 7 == 3;
+        },
+        values);
+    EXPECT_EQ(calls, n);
+    EXPECT_ARRAY_EQ(seq.asArray(), result.asArray());
+
+    auto par = df::filter([](int x, size_t) { return x % 7 == 3; }, values,
+                          df::ExecutionPolicy::PAR);
+    EXPECT_ARRAY_EQ(par.asArray(), result.asArray());
+}
+
+TEST(Filter, Select) {
+    auto x = df::Serie<double>{0.5, 2.0, 0.1, 0.9, -1.0};
+    auto y = df::Serie<double>{0.5, 0.5, 0.8, 3.0, 0.2};
+    auto id = df::Serie<int>{10, 20, 30, 40, 50};
+
+    auto inside = (x >= 0.0) & (x <= 1.0) & (y >= 0.0) & (y <= 1.0);
+    auto [px, py, pid] = df::select(inside, x, y, id);
+    EXPECT_ARRAY_EQ(px.data(), std::vector<double>({0.5, 0.1}));
+    EXPECT_ARRAY_EQ(py.data(), std::vector<double>({0.5, 0.8}));
+    EXPECT_ARRAY_EQ(pid.data(), std::vector<int>({10, 30}));
+
+    EXPECT_THROW(df::select(inside, df::Serie<int>{1, 2}), std::runtime_error);
+}
+
 RUN_TESTS()
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <dataframe/Serie.h>
+#include <dataframe/core/groupBy.h>
+#include <dataframe/stats/accumulators.h>
+#include <limits>
+#include <string>
+
+TEST(GroupByAgg, StringKeys) {
+    df::Serie<std::string> city{"Paris", "Lyon", "Paris", "Nice", "Lyon"};
+    df::Serie<double> price{10, 20, 30, 40, 50};
+
+    auto g = df::groupBy(city);
+    EXPECT_EQ(g.size(), 3);
+    EXPECT_ARRAY_EQ(g.counts().asArray(), std::vector<uint32_t>({2, 1, 2}));
+
+    auto result = g.agg(price, df::agg::count(), df::agg::sum(),
+                        df::agg::mean(), df::agg::min(), df::agg::max());
+    EXPECT_ARRAY_EQ(result.get<std::string>("key").asArray(),
+                    std::vector<std::string>({"Lyon", "Nice", "Paris"}));
+    EXPECT_ARRAY_EQ(result.get<uint32_t>("count").asArray(),
+                    std::vector<uint32_t>({2, 1, 2}));
+    EXPECT_ARRAY_EQ(result.get<double>("sum").asArray(),
+                    std::vector<double>({70, 40, 40}));
+    EXPECT_ARRAY_EQ(result.get<double>("mean").asArray(),
+                    std::vector<double>({35, 40, 20}));
+    EXPECT_ARRAY_EQ(result.get<double>("min").asArray(),
+                    std::vector<double>({20, 40, 10}));
+    EXPECT_ARRAY_EQ(result.get<double>("max").asArray(),
+                    std::vector<double>({50, 40, 30}));
+
+    EXPECT_THROW(g.agg(df::Serie<double>{1, 2}, df::agg::sum()),
+                 std::runtime_error);
+}
+
+TEST(GroupByAgg, CustomAndAccumulator) {
+    df::Serie<int> zone{3, 1, 3, 1, 2};
+    df::Serie<double> depth{1, 2, 3, 4, 5};
+
+    auto result = df::groupBy(zone).agg(
+        depth,
+        df::agg::custom(
+            "sum2", 0.0, [](double &acc, double v) { acc += v * v; },
+            [](double &acc, double other) { acc += other; }),
+        df::agg::accumulate("var", df::stats::Moments<double>(),
+                            [](const auto &m) { return m.variance(true); }));
+
+    EXPECT_ARRAY_EQ(result.get<int>("key").asArray(),
+                    std::vector<int>({1, 2, 3}));
+    EXPECT_ARRAY_EQ(result.get<double>("sum2").asArray(),
+                    std::vector<double>({20, 25, 10}));
+    EXPECT_ARRAY_NEAR(result.get<double>("var").asArray(),
+                      std::vector<double>({1, 0, 1}), 1e-12);
+}
+
+// Compare the dense (small integer range), hashed (large range) and
+// parallel paths against the std::map based groupBy
+TEST(GroupByAgg, LargeInputs) {
+    const size_t n = 100000;
+    for (int64_t spread : {int64_t{37}, int64_t{1} << 40}) {
+        df::Serie<int64_t> keys(n);
+        df::Serie<int> values(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = static_cast<int64_t>((i * 7919) % 1009) * (spread / 37 + 1) -
+                      500;
+            values[i] = static_cast<int>(i % 97) - 40;
+        }
+
+        auto expected =
+            df::groupBy(values, [&](int, size_t i) { return keys[i]; });
+        auto result = df::groupBy(keys).agg(values, df::agg::sum(),
+                                            df::agg::count(), df::agg::max());
+
+        const auto &k = result.get<int64_t>("key");
+        const auto &sum = result.get<int64_t>("sum");
+        const auto &count = result.get<uint32_t>("count");
+        const auto &max = result.get<int>("max");
+        EXPECT_EQ(k.size(), expected.size());
+
+        size_t g = 0;
+        for (const auto &[key, group] : expected) {
+            EXPECT_EQ(k[g], key);
+            EXPECT_EQ(count[g], group.size());
+            int64_t s = 0;
+            int m = group[0];
+            for (int v : group.asArray()) {
+                s += v;
+                m = std::max(m, v);
+            }
+            EXPECT_EQ(sum[g], s);
+            EXPECT_EQ(max[g], m);
+            ++g;
+        }
+    }
+}
+
+TEST(GroupByAgg, Empty) {
+    auto result = df::groupBy(df::Serie<int>()).agg(df::Serie<double>(),
+                                                    df::agg::mean());
+    EXPECT_EQ(result.get<int>("key").size(), 0);
+    EXPECT_EQ(result.get<double>("mean").size(), 0);
+}
+
+TEST(GroupByAgg, Nulls) {
+    df::Serie<int> zone{1, 2, 1, 2, 1};
+    df::Serie<int64_t> depth{10, 20, 30, 40, 50};
+    depth.setNull(2);
+    depth.setNull(3);
+
+    auto result = df::groupBy(zone).agg(depth, df::agg::count(),
+                                        df::agg::sum(), df::agg::max());
+    EXPECT_ARRAY_EQ(result.get<uint32_t>("count").asArray(),
+                    std::vector<uint32_t>({2, 1}));
+    EXPECT_ARRAY_EQ(result.get<int64_t>("sum").asArray(),
+                    std::vector<int64_t>({60, 20}));
+    EXPECT_ARRAY_EQ(result.get<int64_t>("max").asArray(),
+                    std::vector<int64_t>({50, 20}));
+}
+
+TEST(GroupByAgg, ExtremeIntegerKeys) {
+    // Key ranges wider than 2^63 must not take the dense path
+    const int64_t lo = std::numeric_limits<int64_t>::min();
+    const int64_t hi = std::numeric_limits<int64_t>::max();
+    auto g = df::groupBy(df::Serie<int64_t>{hi, 3, lo, 3});
+    EXPECT_ARRAY_EQ(g.keys().asArray(), std::vector<int64_t>({lo, 3, hi}));
+    EXPECT_ARRAY_EQ(g.counts().asArray(), std::vector<uint32_t>({1, 2, 1}));
+
+    const uint64_t big = std::numeric_limits<uint64_t>::max();
+    auto u = df::groupBy(df::Serie<uint64_t>{big, 0, big - 1, big});
+    EXPECT_ARRAY_EQ(u.keys().asArray(),
+                    std::vector<uint64_t>({0, big - 1, big}));
+    EXPECT_ARRAY_EQ(u.counts().asArray(), std::vector<uint32_t>({1, 1, 2}));
+
+    // Narrow ranges near the limits still use the dense path
+    auto near = df::groupBy(df::Serie<int64_t>{lo + 2, lo, lo + 2});
+    EXPECT_ARRAY_EQ(near.keys().asArray(), std::vector<int64_t>({lo, lo + 2}));
+    auto top = df::groupBy(df::Serie<uint64_t>{big, big - 3, big});
+    EXPECT_ARRAY_EQ(top.keys().asArray(),
+                    std::vector<uint64_t>({big - 3, big}));
+    EXPECT_ARRAY_EQ(top.counts().asArray(), std::vector<uint32_t>({1, 2}));
+}
+
+RUN_TESTS()
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <dataframe/Dataframe.h>
+#include <dataframe/core/join.h>
+#include <map>
+#include <string>
+
+TEST(Join, SortMerge) {
+    // Sorted keys
+    df::Serie<int> a{1, 2, 2, 3};
+    df::Serie<int> b{2, 3, 3, 4};
+
+    auto inner = df::join_indices(a, b);
+    EXPECT_ARRAY_EQ(inner.left, std::vector<int64_t>({1, 2, 3, 3}));
+    EXPECT_ARRAY_EQ(inner.right, std::vector<int64_t>({0, 0, 1, 2}));
+
+    auto left = df::join_indices(a, b, df::JoinType::LEFT);
+    EXPECT_ARRAY_EQ(left.left, std::vector<int64_t>({0, 1, 2, 3, 3}));
+    EXPECT_ARRAY_EQ(left.right, std::vector<int64_t>({-1, 0, 0, 1, 2}));
+
+    auto outer = df::join_indices(a, b, df::JoinType::OUTER);
+    EXPECT_ARRAY_EQ(outer.left, std::vector<int64_t>({0, 1, 2, 3, 3, -1}));
+    EXPECT_ARRAY_EQ(outer.right, std::vector<int64_t>({-1, 0, 0, 1, 2, 3}));
+}
+
+TEST(Join, Hash) {
+    // Unsorted keys
+    df::Serie<std::string> a{"c", "a", "b", "a"};
+    df::Serie<std::string> b{"a", "d", "c", "a"};
+
+    auto inner = df::join_indices(a, b);
+    EXPECT_ARRAY_EQ(inner.left, std::vector<int64_t>({0, 1, 1, 3, 3}));
+    EXPECT_ARRAY_EQ(inner.right, std::vector<int64_t>({2, 0, 3, 0, 3}));
+
+    auto outer = df::join_indices(a, b, df::JoinType::OUTER);
+    EXPECT_ARRAY_EQ(outer.left, std::vector<int64_t>({0, 1, 1, 2, 3, 3, -1}));
+    EXPECT_ARRAY_EQ(outer.right, std::vector<int64_t>({2, 0, 3, -1, 0, 3, 1}));
+}
+
+TEST(Join, Dataframes) {
+    df::Dataframe samples;
+    samples.add("well", df::Serie<int>{7, 3, 7, 9});
+    samples.add("depth", df::Serie<double>{10, 20, 30, 40});
+    samples.add("name", df::Serie<std::string>{"s1", "s2", "s3", "s4"});
+
+    df::Dataframe wells;
+    wells.add("well", df::Serie<int>{3, 7, 5});
+    wells.add("x", df::Serie<double>{0.5, 1.5, 2.5});
+    wells.add("name", df::Serie<std::string>{"w3", "w7", "w5"});
+
+    auto table = df::join(samples, wells, "well", df::JoinType::LEFT);
+    EXPECT_EQ(table.size(), 5);
+    EXPECT_ARRAY_EQ(table.get<int>("well").asArray(),
+                    std::vector<int>({7, 3, 7, 9}));
+    EXPECT_ARRAY_EQ(table.get<double>("depth").asArray(),
+                    std::vector<double>({10, 20, 30, 40}));
+    const auto &x = table.get<double>("x");
+    EXPECT_EQ(x[0], 1.5);
+    EXPECT_EQ(x[1], 0.5);
+    EXPECT_EQ(x[2], 1.5);
+    EXPECT_TRUE(std::isnan(x[3]));
+    EXPECT_ARRAY_EQ(table.get<std::string>("name_right").asArray(),
+                    std::vector<std::string>({"w7", "w3", "w7", ""}));
+    EXPECT_ARRAY_EQ(table.get<std::string>("name_left").asArray(),
+                    std::vector<std::string>({"s1", "s2", "s3", "s4"}));
+
+    auto outer = df::join(samples, wells, "well", df::JoinType::OUTER);
+    EXPECT_ARRAY_EQ(outer.get<int>("well").asArray(),
+                    std::vector<int>({7, 3, 7, 9, 5}));
+
+    df::Dataframe other;
+    other.add("well", df::Serie<double>{1, 2});
+    EXPECT_THROW(df::join(samples, other, "well"), std::runtime_error);
+    EXPECT_THROW(df::join(samples, wells, "depth"), std::runtime_error);
+}
+
+TEST(Join, Large) {
+    // Compared with a std::multimap based join (hash path, parallel when
+    // several cores are available)
+    const size_t n = 200000;
+    df::Serie<int64_t> a(n), b(n / 2);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<int64_t>((i * 7919) % 150000);
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        b[i] = static_cast<int64_t>((i * 104729) % 120000) + 30000;
+    }
+
+    std::multimap<int64_t, int64_t> lookup;
+    for (size_t j = 0; j < b.size(); ++j) {
+        lookup.emplace(b[j], static_cast<int64_t>(j));
+    }
+    std::vector<int64_t> el, er;
+    for (size_t i = 0; i < n; ++i) {
+        auto [lo, hi] = lookup.equal_range(a[i]);
+        if (lo == hi) {
+            el.push_back(static_cast<int64_t>(i));
+            er.push_back(-1);
+        }
+        for (auto it = lo; it != hi; ++it) {
+            el.push_back(static_cast<int64_t>(i));
+            er.push_back(it->second);
+        }
+    }
+
+    auto idx = df::join_indices(a, b, df::JoinType::LEFT);
+    EXPECT_EQ(idx.size(), el.size());
+    EXPECT_TRUE(idx.left == el);
+    EXPECT_TRUE(idx.right == er);
+}
+
+RUN_TESTS()
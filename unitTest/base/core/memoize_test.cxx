@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../../TEST.h"
+#include <dataframe/Serie.h>
+#include <dataframe/core/memoize.h>
+#include <filesystem>
+
+TEST(memoize, version) {
+    df::Serie<double> s{1.0, 2.0, 3.0};
+    const uint64_t v = s.version();
+    EXPECT_NOT_EQ(v, uint64_t(0));
+    EXPECT_EQ(s.version(), v);
+
+    df::Serie<double> copy = s;
+    EXPECT_EQ(copy.version(), v);
+
+    copy.set(0, 10.0);
+    EXPECT_NOT_EQ(copy.version(), v);
+    EXPECT_EQ(s.version(), v);
+
+    s[1] = 5.0;
+    EXPECT_NOT_EQ(s.version(), v);
+
+    df::Serie<double> same{1.0, 2.0, 3.0};
+    df::Serie<double> other{1.0, 2.0, 3.0};
+    EXPECT_NOT_EQ(same.version(), other.version());
+    EXPECT_EQ(df::content_hash(same), df::content_hash(other));
+    EXPECT_EQ(df::sampled_hash(same), df::sampled_hash(other));
+
+    other.setNull(2);
+    EXPECT_NOT_EQ(df::content_hash(same), df::content_hash(other));
+}
+
+TEST(memoize, hits) {
+    int calls = 0;
+    auto twice = df::memoize([&calls](const df::Serie<double> &s) {
+        ++calls;
+        return s.map([](double x) { return 2 * x; });
+    });
+
+    df::Serie<double> s{1.0, 2.0, 3.0};
+    auto r1 = twice(s);
+    auto r2 = twice(s);
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(r1 == r2); // shared, not copied
+    EXPECT_EQ((*r1)[2], 6.0);
+
+    // A copy keeps the version
+    df::Serie<double> copy = s;
+    twice(copy);
+    EXPECT_EQ(calls, 1);
+
+    s.set(0, 4.0);
+    auto r3 = twice(s);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ((*r3)[0], 8.0);
+    EXPECT_EQ((*r1)[0], 2.0);
+
+    // Another result type from the same function object
+    auto count = df::memoize([](const df::Serie<int> &s) { return s.size(); });
+    EXPECT_EQ(*count(df::Serie<int>{1, 2}), size_t(2));
+
+    auto stats = twice.stats();
+    EXPECT_EQ(stats.hits, size_t(2));
+    EXPECT_EQ(stats.misses, size_t(2));
+}
+
+TEST(memoize, verify) {
+    int calls = 0;
+    auto sum = [&calls](const df::Serie<double> &s) {
+        ++calls;
+        return s.reduce([](double acc, double x) { return acc + x; }, 0.0);
+    };
+
+    // Modified through a reference taken before the first call: the
+    // version does not see it, the sampled hash does
+    df::Serie<double> s{1.0, 2.0, 3.0};
+    double &first = s[0];
+    df::Memoized<decltype(sum)> sampled(sum, df::MemoizeOptions{});
+    EXPECT_EQ(*sampled(s), 6.0);
+    first = 2.0;
+    EXPECT_EQ(*sampled(s), 7.0);
+    EXPECT_EQ(calls, 2);
+
+    // Distinct Series with equal values share an entry when keyed by content
+    df::MemoizeOptions options;
+    options.verify = df::Verify::Content;
+    auto by_content = df::memoize(sum, options);
+    calls = 0;
+    by_content(df::Serie<double>{1.0, 2.0});
+    by_content(df::Serie<double>{1.0, 2.0});
+    by_content(df::Serie<double>{1.0, 3.0});
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(memoize, lru) {
+    df::MemoizeOptions options;
+    options.max_entries = 2;
+    auto square = df::memoize(
+        [](const df::Serie<double> &s) {
+            return s.map([](double x) { return x * x; });
+        },
+        options);
+
+    df::Serie<double> a{1.0}, b{2.0}, c{3.0};
+    square(a);
+    square(b);
+    square(a); // a is now the most recently used
+    square(c); // evicts b
+    EXPECT_EQ(square.cache_size(), size_t(2));
+    EXPECT_EQ(square.stats().evictions, size_t(1));
+
+    auto before = square.stats().misses;
+    square(a);
+    EXPECT_EQ(square.stats().misses, before);
+    square(b);
+    EXPECT_EQ(square.stats().misses, before + 1);
+
+    // Bounded in bytes: 1000 doubles do not fit in 4 KB
+    options.max_entries = 100;
+    options.max_bytes = 4096;
+    auto bounded = df::memoize(
+        [](const df::Serie<double> &s) { return df::Serie<double>(s.size(), 1.0); },
+        options);
+    df::Serie<double> small(100, 0.0), large(1000, 0.0);
+    bounded(small);
+    bounded(large);
+    EXPECT_EQ(bounded.cache_size(), size_t(1));
+    EXPECT_TRUE(bounded.cache_bytes() <= options.max_bytes);
+}
+
+TEST(memoize, spill) {
+    const auto directory =
+        std::filesystem::temp_directory_path() / "df_memoize_test";
+    std::filesystem::remove_all(directory);
+
+    int calls = 0;
+    auto f = [&calls](const df::Serie<double> &s) {
+        ++calls;
+        return s.map([](double x) { return x + 1; });
+    };
+    df::MemoizeOptions options;
+    options.spill_directory = directory.string();
+
+    {
+        auto first = df::memoize(f, options);
+        first(df::Serie<double>{1.0, 2.0});
+    }
+
+    // A new cache (as in another run) finds the result on disk
+    auto second = df::memoize(f, options);
+    auto result = second(df::Serie<double>{1.0, 2.0});
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(second.stats().disk_hits, size_t(1));
+    EXPECT_EQ((*result)[1], 3.0);
+
+    // The file name only depends on the content and on the registry id of
+    // the input type, not on typeid (which may change between runs)
+    const uint64_t hash = df::detail::hash_combine(
+        df::content_hash(df::Serie<double>{1.0, 2.0}),
+        static_cast<uint64_t>(df::type_id<double> + 1));
+    EXPECT_TRUE(std::filesystem::exists(directory /
+                                        (std::to_string(hash) + ".bin")));
+
+    std::filesystem::remove_all(directory);
+}
+
+RUN_TESTS();
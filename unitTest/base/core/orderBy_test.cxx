@@ -210,5 +210,31 @@ TEST(OrderBy, VectorsAndArrays) {
     }
 }
 
+TEST(OrderBy, DataframeMultiColumn) {
+    df::Dataframe samples;
+    samples.add("well", df::Serie<std::string>{"B", "A", "B", "A", "C", "A"});
+    samples.add("depth", df::Serie<double>{10, 30, 5, 10, 1, 30});
+    samples.add("id", df::Serie<int>{0, 1, 2, 3, 4, 5});
+
+    // Well ascending, depth descending, ties kept in input order
+    auto sorted =
+        df::orderBy(samples, {"well", "depth"},
+                    {df::SortOrder::ASCENDING, df::SortOrder::DESCENDING});
+    EXPECT_ARRAY_EQ(sorted.get<int>("id").asArray(),
+                    std::vector<int>({1, 5, 3, 0, 2, 4}));
+    EXPECT_ARRAY_EQ(sorted.get<std::string>("well").asArray(),
+                    std::vector<std::string>({"A", "A", "A", "B", "B", "C"}));
+    EXPECT_ARRAY_EQ(sorted.get<double>("depth").asArray(),
+                    std::vector<double>({30, 30, 10, 10, 5, 1}));
+
+    auto perm = df::argsort(samples, {"depth"});
+    EXPECT_ARRAY_EQ(perm.asArray(), std::vector<uint32_t>({4, 2, 0, 3, 1, 5}));
+
+    EXPECT_THROW(df::orderBy(samples, {"missing"}), std::runtime_error);
+    EXPECT_THROW(df::orderBy(samples, {"well"}, {df::SortOrder::ASCENDING,
+                                                 df::SortOrder::ASCENDING}),
+                 std::runtime_error);
+}
+
 // Main function to run all tests
 RUN_TESTS()
\ No newline at end of file
@@ -30,6 +30,13 @@ TEST(Split, BasicSplit) {
     // Check odd numbers
     EXPECT_EQ(odds.size(), 5);
     COMPARE_SERIE_VECTOR(odds, {1, 3, 5, 7, 9});
+
+    // Same split with the predicate evaluated in parallel
+    auto [par_evens, par_odds] = df::partition(
+        numbers, [](int value, size_t) { return value % 2 == 0; },
+        df::ExecutionPolicy::PAR);
+    COMPARE_SERIE_VECTOR(par_evens, {2, 4, 6, 8, 10});
+    COMPARE_SERIE_VECTOR(par_odds, {1, 3, 5, 7, 9});
 }
 
 TEST(Split, EmptySerie) {
@@ -39,6 +39,11 @@ TEST(reject, basic) {
     Serie<double> mixed{-2.0, -1.0, 0.0, 1.0, 2.0};
     auto positives = reject([](double x, size_t) { return x < 0; }, mixed);
     EXPECT_ARRAY_EQ(positives.asArray(), std::vector<double>({0.0, 1.0, 2.0}));
+
+    // Predicate evaluated in parallel
+    auto par = reject([](int x, size_t) { return x % 2 == 0; }, numbers,
+                      ExecutionPolicy::PAR);
+    EXPECT_ARRAY_EQ(par.asArray(), std::vector<int>({1, 3, 5, 7, 9}));
 }
 
 TEST(reject, predicates) {
@@ -182,6 +182,77 @@ TEST(Sort, StabilityTest) {
     EXPECT_EQ(result[3].value, "third");
 }
 
+TEST(Sort, Argsort) {
+    auto serie = Serie<double>({5.0, std::nan(""), 2.0, 8.0, 2.0, -1.0});
+
+    auto perm = argsort(serie);
+    EXPECT_ARRAY_EQ(perm.asArray(), std::vector<uint32_t>({5, 2, 4, 0, 3, 1}));
+
+    auto desc = argsort(serie, SortOrder::DESCENDING);
+    EXPECT_ARRAY_EQ(desc.asArray(), std::vector<uint32_t>({3, 0, 2, 4, 5, 1}));
+
+    auto nan_first = argsort(serie, SortOrder::ASCENDING, true);
+    EXPECT_ARRAY_EQ(nan_first.asArray(),
+                    std::vector<uint32_t>({1, 5, 2, 4, 0, 3}));
+
+    auto ints = Serie<int>({3, -7, 0, 3, -2, 1000000});
+    EXPECT_ARRAY_EQ(argsort(ints).asArray(),
+                    std::vector<uint32_t>({1, 4, 2, 0, 3, 5}));
+    EXPECT_ARRAY_EQ(sort(ints, SortOrder::DESCENDING).asArray(),
+                    std::vector<int>({1000000, 3, 3, 0, -2, -7}));
+
+    auto words = Serie<std::string>({"pear", "fig", "apple", "fig"});
+    EXPECT_ARRAY_EQ(argsort(words).asArray(),
+                    std::vector<uint32_t>({2, 1, 3, 0}));
+
+    auto by_abs = argsort_by(Serie<int>({-3, 1, 2, -1}),
+                             [](int v) { return std::abs(v); });
+    EXPECT_ARRAY_EQ(by_abs.asArray(), std::vector<uint32_t>({1, 3, 2, 0}));
+}
+
+TEST(Sort, RadixMatchesStdSort) {
+    // Parallel radix sort (when several cores are available) against
+    // std::sort, including negative zeros, infinities and NaN
+    const size_t size = 300'000;
+    auto serie = RANDOM<double>(size, -1e6, 1e6);
+    serie[10] = -0.0;
+    serie[20] = std::numeric_limits<double>::infinity();
+    serie[30] = -std::numeric_limits<double>::infinity();
+    serie[40] = std::nan("");
+
+    auto result = sort_nan(serie, SortOrder::ASCENDING, false,
+                           ExecutionPolicy::PAR);
+    std::vector<double> expected(serie.data());
+    std::sort(expected.begin(), expected.end(), [](double a, double b) {
+        return !std::isnan(a) && (std::isnan(b) || a < b);
+    });
+    for (size_t i = 0; i + 1 < size; ++i) {
+        EXPECT_EQ(result[i], expected[i]);
+    }
+    EXPECT_TRUE(std::isnan(result[size - 1]));
+
+    auto ints = serie.map([](double v) {
+        return std::isnan(v) || std::isinf(v) ? int64_t{0}
+                                              : static_cast<int64_t>(v * 1e6);
+    });
+    auto perm = argsort(ints, SortOrder::DESCENDING, false,
+                        ExecutionPolicy::PAR);
+    for (size_t i = 1; i < size; ++i) {
+        EXPECT_TRUE(ints[perm[i - 1]] > ints[perm[i]] ||
+                    (ints[perm[i - 1]] == ints[perm[i]] &&
+                     perm[i - 1] < perm[i]));
+    }
+
+    // bool values are packed in words: chunks must not share one
+    auto flags = serie.map([](double v) { return v > 0; });
+    auto sorted_flags = sort(flags, SortOrder::ASCENDING, ExecutionPolicy::PAR);
+    const size_t falses = size - flags.reduce(
+        [](size_t acc, bool v) { return acc + (v ? 1 : 0); }, size_t{0});
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(sorted_flags[i], i >= falses);
+    }
+}
+
 // ========================= LARGE SERIES =========================
 
 TEST(SortPerformance, LargeSerie_BasicSort) {
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../../TEST.h"
+#include <atomic>
+#include <dataframe/Dataframe.h>
+#include <dataframe/Serie.h>
+#include <dataframe/core/task_graph.h>
+#include <sstream>
+
+TEST(task_graph, pipeline) {
+    df::TaskGraph graph;
+    auto data = graph.add("load", [] {
+        df::Dataframe d;
+        d.add("x", df::Serie<double>{1.0, 2.0, 3.0});
+        d.add("z", df::Serie<double>{10.0, 20.0, 30.0});
+        return d;
+    });
+    auto x = graph.add(
+        "x", [](const df::Dataframe &d) { return d.get<double>("x"); }, data);
+    auto z = graph.add(
+        "z", [](const df::Dataframe &d) { return d.get<double>("z"); }, data);
+    auto dot = graph.add(
+        "dot",
+        [](const df::Serie<double> &x, const df::Serie<double> &z) {
+            double sum = 0;
+            for (size_t i = 0; i < x.size(); ++i) {
+                sum += x[i] * z[i];
+            }
+            return sum;
+        },
+        x, z);
+
+    EXPECT_EQ(graph.size(), size_t(4));
+    EXPECT_THROW(dot.get(), std::runtime_error);
+
+    graph.run();
+    EXPECT_EQ(*dot.get(), 140.0);
+    EXPECT_EQ(x.get()->size(), size_t(3));
+
+    const auto &trace = graph.trace();
+    EXPECT_EQ(trace.size(), size_t(4));
+    EXPECT_STREQ(trace[3].name.c_str(), "dot");
+    // A node starts after its inputs are done
+    EXPECT_GE(trace[3].start, trace[1].end);
+    EXPECT_GE(trace[3].start, trace[2].end);
+
+    std::ostringstream out;
+    graph.printTrace(out);
+    EXPECT_TRUE(out.str().find("dot") != std::string::npos);
+}
+
+TEST(task_graph, shared_results) {
+    // The input is not copied, and every stage reads the same object
+    auto serie = std::make_shared<const df::Serie<int>>(df::Serie<int>{1, 2, 3});
+    df::TaskGraph graph;
+    auto in = graph.input("serie", serie);
+    std::atomic<int> same{0};
+    for (int i = 0; i < 4; ++i) {
+        graph.add(
+            "check",
+            [&same, serie](const df::Serie<int> &s) {
+                same += (&s == serie.get());
+                return 0;
+            },
+            in);
+    }
+    graph.run();
+    EXPECT_EQ(same.load(), 4);
+    EXPECT_TRUE(in.get() == serie);
+}
+
+TEST(task_graph, overlap) {
+    // Independent branches run at the same time on the pool
+    df::TaskPool pool(4);
+    df::TaskGraph graph(pool);
+    std::atomic<int> running{0}, peak{0};
+    auto branch = [&] {
+        int now = ++running;
+        int expected = peak.load();
+        while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        --running;
+        return 1;
+    };
+    auto a = graph.add("a", branch);
+    auto b = graph.add("b", branch);
+    auto c = graph.add("c", branch);
+    auto sum = graph.add(
+        "sum", [](int a, int b, int c) { return a + b + c; }, a, b, c);
+    graph.run();
+    EXPECT_EQ(*sum.get(), 3);
+    EXPECT_GE(peak.load(), 2);
+}
+
+TEST(task_graph, errors) {
+    df::TaskGraph graph;
+    auto bad = graph.add("bad", []() -> int {
+        throw std::runtime_error("failed");
+    });
+    auto after = graph.add("after", [](int v) { return v + 1; }, bad);
+    auto other = graph.add("other", [] { return 2; });
+
+    EXPECT_THROW(graph.run(), std::runtime_error);
+    EXPECT_TRUE(graph.trace()[1].skipped);
+    EXPECT_THROW(after.get(), std::runtime_error);
+    EXPECT_EQ(*other.get(), 2);
+
+    df::TaskGraph graph2;
+    EXPECT_THROW(graph2.add("foreign", [](int v) { return v; }, other),
+                 std::invalid_argument);
+}
+
+TEST(task_graph, pool) {
+    df::TaskPool pool(2);
+    std::vector<int> values(100, 0);
+    pool.parallel_for(values.size(), [&](size_t i) { values[i] = int(i); });
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], int(i));
+    }
+
+    // Nested waits do not deadlock
+    std::atomic<int> count{0};
+    pool.parallel_for(4, [&](size_t) {
+        pool.parallel_for(4, [&](size_t) { ++count; });
+    });
+    EXPECT_EQ(count.load(), 16);
+
+    EXPECT_THROW(pool.parallel_for(3,
+                                   [](size_t i) {
+                                       if (i == 2) {
+                                           throw std::runtime_error("failed");
+                                       }
+                                   }),
+                 std::runtime_error);
+}
+
+RUN_TESTS();
@@ -42,6 +42,22 @@ TEST(whenAll, with_transformation) {
     EXPECT_TRUE(result[3] == 8.0); // 4.0 * 2
 }
 
+TEST(whenAll, stateful_transformation) {
+    // Each task calls its own copy: the state is not shared between threads
+    std::vector<df::Serie<double>> series(8, df::Serie<double>{1.0, 2.0});
+    auto result = df::whenAll(
+        [calls = 0](const df::Serie<double> &s) mutable {
+            ++calls;
+            return s.map([calls](double x, size_t) { return x * calls; });
+        },
+        series);
+
+    EXPECT_TRUE(result.size() == 16);
+    for (size_t i = 0; i < result.size(); ++i) {
+        EXPECT_TRUE(result[i] == (i % 2 == 0 ? 1.0 : 2.0));
+    }
+}
+
 TEST(whenAll, without_transformation) {
     df::Serie<int> s1{1, 2, 3};
     df::Serie<int> s2{4, 5, 6};
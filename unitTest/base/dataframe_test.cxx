@@ -158,4 +158,67 @@ TEST(dataframe, basic_operations) {
     EXPECT_TRUE(df.names().empty());
 }
 
+TEST(dataframe, handles) {
+    MSG("Testing Dataframe column handles");
+
+    df::Dataframe df;
+    df.add("a", df::Serie<double>{1.0, 2.0, 3.0});
+    df.add("b", df::Serie<int>{4, 5});
+
+    auto a = df.handle<double>("a");
+    EXPECT_TRUE(static_cast<bool>(a));
+    EXPECT_EQ(a.name(), "a");
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(a[2], 3.0);
+    EXPECT_TRUE(&a.serie() == &df.get<double>("a"));
+
+    EXPECT_THROW(df.handle<int>("a"), std::runtime_error);
+    EXPECT_THROW(df.handle<double>("c"), std::runtime_error);
+
+    // A name is unique whatever the type
+    EXPECT_THROW(df.add("a", df::Serie<int>{1}), std::runtime_error);
+
+    // The handle shares the serie with the Dataframe
+    df.remove("a");
+    EXPECT_FALSE(df.has("a"));
+    EXPECT_EQ(a[0], 1.0);
+
+    // Copies and moves keep a valid index
+    for (int i = 0; i < 100; ++i) {
+        df.add("c" + std::to_string(i), df::Serie<int>{i});
+    }
+    df::Dataframe copy = df;
+    df.remove("c42");
+    EXPECT_TRUE(copy.has<int>("c42"));
+    EXPECT_EQ(copy.get<int>("c99")[0], 99);
+    df::Dataframe moved = std::move(copy);
+    EXPECT_EQ(moved.get<int>("c42")[0], 42);
+    EXPECT_EQ(moved.size(), 101);
+    copy = moved;
+    EXPECT_EQ(copy.get<int>("b")[1], 5);
+}
+
+TEST(dataframe, filter_rows) {
+    MSG("Testing Dataframe row selection with a Mask");
+
+    df::Dataframe df;
+    df.add("z", df::Serie<double>{-10.0, -2000.0, -500.0, -3000.0});
+    df.add("id", df::Serie<int>{1, 2, 3, 4});
+    df.add("name", df::Serie<std::string>{"a", "b", "c", "d"});
+    df.add("n", df::Serie<Vector3>{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 1}});
+
+    auto deep = df.filter_rows(df.get<double>("z") < -1000.0);
+    EXPECT_EQ(deep.size(), 4);
+    EXPECT_ARRAY_EQ(deep.get<double>("z").data(),
+                    std::vector<double>({-2000.0, -3000.0}));
+    EXPECT_ARRAY_EQ(deep.get<int>("id").data(), std::vector<int>({2, 4}));
+    EXPECT_EQ(deep.get<std::string>("name")[1], "d");
+    EXPECT_ARRAY_EQ(deep.get<Vector3>("n")[0], Vector3({0, 1, 0}));
+
+    EXPECT_EQ(df.filter_rows(df::Mask(4, false)).get<int>("id").size(), 0);
+
+    df.add("short", df::Serie<int>{1, 2});
+    EXPECT_THROW(df.filter_rows(df::Mask(4, true)), std::runtime_error);
+}
+
 RUN_TESTS();
\ No newline at end of file
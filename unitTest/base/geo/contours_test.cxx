@@ -22,6 +22,7 @@
  */
 
 #include "../../TEST.h"
+#include <functional>
 #include <dataframe/geo/mesh/contours.h>
 #include <dataframe/geo/mesh/mesh.h>
 #include <dataframe/core/pipe.h>
@@ -172,6 +173,102 @@ TEST(contours, grid_mesh) {
     }
 }
 
+namespace {
+    // nx x ny cells over [0,1]^2, two triangles per cell
+    Mesh2D grid_mesh(int nx, int ny, const std::function<double(double, double)>& field)
+    {
+        Serie<Vector2> vertices;
+        Triangles triangles;
+        Serie<double> values;
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                const double x = static_cast<double>(i) / nx;
+                const double y = static_cast<double>(j) / ny;
+                vertices.add({ x, y });
+                values.add(field(x, y));
+            }
+        }
+        for (int j = 0; j < ny; ++j) {
+            for (int i = 0; i < nx; ++i) {
+                uint v0 = j * (nx + 1) + i;
+                uint v1 = v0 + 1;
+                uint v2 = v0 + (nx + 1);
+                uint v3 = v2 + 1;
+                triangles.add({ v0, v1, v2 });
+                triangles.add({ v1, v3, v2 });
+            }
+        }
+        Mesh2D mesh(vertices, triangles);
+        mesh.addVertexAttribute("field", values);
+        return mesh;
+    }
+} // namespace
+
+TEST(contours, multi_level_single_pass) {
+    auto mesh = grid_mesh(150, 120, [](double x, double y) {
+        return std::sin(7.0 * x) * std::cos(5.0 * y) + x;
+    });
+
+    // Unsorted, duplicated and out-of-range iso values
+    std::vector<double> isos = { 0.5, -0.25, 3.0, 0.0, 0.5, 1.25 };
+    auto all = contours(mesh, "field", isos);
+
+    size_t offset = 0;
+    for (double iso : isos) {
+        // Brute-force: one segment per crossed triangle, in triangle order
+        const auto& values = mesh.vertexAttribute<double>("field");
+        std::vector<size_t> crossed;
+        for (size_t t = 0; t < mesh.triangles().size(); ++t) {
+            const auto& tri = mesh.triangles()[t];
+            const int code = (values[tri[0]] >= iso) * 4 + (values[tri[1]] >= iso) * 2
+                + (values[tri[2]] >= iso);
+            if (code > 0 && code < 7) {
+                crossed.push_back(t);
+            }
+        }
+        auto single = contours(mesh, "field", iso);
+        EXPECT_EQ(single.size(), crossed.size());
+        for (size_t i = 0; i < single.size(); ++i) {
+            const auto& a = all[offset + i];
+            const auto& b = single[i];
+            EXPECT_EQ(a.value, iso);
+            EXPECT_ARRAY_EQ(a.p1, b.p1);
+            EXPECT_ARRAY_EQ(a.p2, b.p2);
+        }
+        offset += single.size();
+    }
+    EXPECT_EQ(offset, all.size());
+}
+
+TEST(contours, isolines) {
+    // Concentric circles: one closed line per level
+    auto mesh = grid_mesh(80, 80, [](double x, double y) {
+        return std::sqrt((x - 0.5) * (x - 0.5) + (y - 0.5) * (y - 0.5));
+    });
+
+    std::vector<double> isos = { 0.1, 0.2, 0.3, 0.45 };
+    auto lines = isolines(mesh, "field", isos);
+    EXPECT_EQ(lines.size(), 4);
+    for (size_t k = 0; k < lines.size(); ++k) {
+        const auto& line = lines[k];
+        EXPECT_EQ(line.value, isos[k]);
+        EXPECT_TRUE(line.closed);
+        EXPECT_ARRAY_EQ(line.points.front(), line.points.back());
+        EXPECT_EQ(line.points.size(), contours(mesh, "field", isos[k]).size() + 1);
+        for (const auto& p : line.points) {
+            const double r = std::sqrt((p[0] - 0.5) * (p[0] - 0.5) + (p[1] - 0.5) * (p[1] - 0.5));
+            EXPECT_NEAR(r, isos[k], 5e-3);
+        }
+    }
+
+    // Circle cut by the border of the mesh: open lines
+    auto open = isolines(mesh, "field", 0.6);
+    EXPECT_EQ(open.size(), 4);
+    for (const auto& line : open) {
+        EXPECT_FALSE(line.closed);
+    }
+}
+
 TEST(iso_contours, different_generation_methods) {
     // Create test mesh and data
     Serie<Vector2> vertices = {
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <dataframe/geo/grid/contours.h>
+#include <map>
+
+using namespace df;
+
+namespace {
+
+    Grid2D grid_2d(uint n, std::function<double(double, double)> f)
+    {
+        Grid2D grid { { -1.0, -1.0 }, { 2.0 / (n - 1), 2.0 / (n - 1) }, { n, n } };
+        Serie<double> values(grid.total_points());
+        for (uint j = 0; j < n; ++j) {
+            for (uint i = 0; i < n; ++i) {
+                auto p = grid.point_at(i, j);
+                values[grid.linear_index(i, j)] = f(p[0], p[1]);
+            }
+        }
+        grid.attributes.add("f", values);
+        return grid;
+    }
+
+    Grid3D grid_3d(uint n)
+    {
+        const double h = 2.0 / (n - 1);
+        Grid3D grid { { -1.0, -1.0, -1.0 }, { h, h, h }, { n, n, n } };
+        Serie<double> f(grid.total_points());
+        Serie<double> x(grid.total_points());
+        Serie<Vector3> p(grid.total_points());
+        for (size_t id = 0; id < grid.total_points(); ++id) {
+            auto [i, j, k] = grid.grid_indices(id);
+            auto q = grid.point_at(i, j, k);
+            f[id] = q[0] * q[0] + q[1] * q[1] + q[2] * q[2];
+            x[id] = q[0];
+            p[id] = q;
+        }
+        grid.attributes.add("f", f);
+        grid.attributes.add("x", x);
+        grid.attributes.add("p", p);
+        return grid;
+    }
+
+} // namespace
+
+TEST(grid_contours, linear)
+{
+    auto grid = grid_2d(11, [](double x, double) { return x; });
+    auto segments = contours(grid, "f", 0.25);
+    EXPECT_EQ(segments.size(), 10);
+    segments.forEach([](const IsoSegment<2>& seg, size_t) {
+        EXPECT_NEAR(seg.p1[0], 0.25, 1e-12);
+        EXPECT_NEAR(seg.p2[0], 0.25, 1e-12);
+        EXPECT_NEAR(std::abs(seg.p2[1] - seg.p1[1]), 0.2, 1e-12);
+        EXPECT_EQ(seg.value, 0.25);
+    });
+
+    EXPECT_THROW(contours(grid, "g", 0.0), std::runtime_error);
+}
+
+TEST(grid_contours, saddle)
+{
+    Grid2D grid { { 0.0, 0.0 }, { 1.0, 1.0 }, { 2, 2 } };
+    grid.attributes.add("f", Serie<double> { 1.0, 0.0, 0.0, 1.0 });
+
+    // Center (0.5) above the iso: the two high corners are connected
+    auto low = contours(grid, "f", 0.4);
+    EXPECT_EQ(low.size(), 2);
+    for (size_t s = 0; s < 2; ++s) {
+        // Each segment cuts off one of the low corners (1, 0) or (0, 1)
+        const auto& seg = low[s];
+        const double cx = 0.5 * (seg.p1[0] + seg.p2[0]);
+        const double cy = 0.5 * (seg.p1[1] + seg.p2[1]);
+        EXPECT_TRUE((cx > 0.5 && cy < 0.5) || (cx < 0.5 && cy > 0.5));
+    }
+
+    // Center below the iso: the two high corners are isolated
+    auto high = contours(grid, "f", 0.6);
+    EXPECT_EQ(high.size(), 2);
+    for (size_t s = 0; s < 2; ++s) {
+        const auto& seg = high[s];
+        const double cx = 0.5 * (seg.p1[0] + seg.p2[0]);
+        const double cy = 0.5 * (seg.p1[1] + seg.p2[1]);
+        EXPECT_TRUE((cx < 0.5 && cy < 0.5) || (cx > 0.5 && cy > 0.5));
+    }
+}
+
+TEST(grid_contours, circle)
+{
+    auto grid = grid_2d(201, [](double x, double y) { return x * x + y * y; });
+    auto segments = contours(grid, "f", std::vector<double> { 0.25, 0.5625 });
+
+    // Grouped by iso value
+    size_t n1 = 0;
+    while (n1 < segments.size() && segments[n1].value == 0.25) {
+        ++n1;
+    }
+    EXPECT_GT(n1, 0);
+    for (size_t s = n1; s < segments.size(); ++s) {
+        EXPECT_EQ(segments[s].value, 0.5625);
+    }
+
+    double length1 = 0, length2 = 0;
+    for (size_t s = 0; s < segments.size(); ++s) {
+        const auto& seg = segments[s];
+        const double r = std::sqrt(seg.value);
+        EXPECT_NEAR(std::hypot(seg.p1[0], seg.p1[1]), r, 1e-3);
+        EXPECT_NEAR(std::hypot(seg.p2[0], seg.p2[1]), r, 1e-3);
+        const double l = std::hypot(seg.p2[0] - seg.p1[0], seg.p2[1] - seg.p1[1]);
+        (s < n1 ? length1 : length2) += l;
+    }
+    EXPECT_NEAR(length1, M_PI, 1e-2);
+    EXPECT_NEAR(length2, 1.5 * M_PI, 1e-2);
+
+    // NaN cells are skipped
+    auto values = grid.attributes.get<double>("f");
+    for (uint j = 0; j < 201; ++j) {
+        for (uint i = 100; i < 201; ++i) {
+            values[grid.linear_index(i, j)] = std::nan("");
+        }
+    }
+    grid.attributes.remove("f");
+    grid.attributes.add("f", values);
+    auto half = contours(grid, "f", 0.25);
+    EXPECT_GT(half.size(), 0);
+    half.forEach([](const IsoSegment<2>& seg, size_t) {
+        EXPECT_LE(seg.p1[0], 1e-12);
+        EXPECT_LE(seg.p2[0], 1e-12);
+    });
+}
+
+TEST(grid_contours, isosurface)
+{
+    auto grid = grid_3d(41);
+    auto surface = isosurface(grid, "f", 0.25);
+    const auto& vertices = surface.vertices();
+    const auto& triangles = surface.triangles();
+    EXPECT_GT(triangles.size(), 0);
+
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        const auto& p = vertices[v];
+        EXPECT_NEAR(std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]), 0.5, 5e-3);
+    }
+
+    // Interpolated attributes (exact for linear attributes)
+    const auto& x = surface.vertexAttribute<double>("x");
+    const auto& p = surface.vertexAttribute<Vector3>("p");
+    EXPECT_FALSE(surface.vertexAttributes().has("f"));
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        EXPECT_NEAR(x[v], vertices[v][0], 1e-12);
+        EXPECT_ARRAY_NEAR(p[v], vertices[v], 1e-12);
+    }
+
+    // Closed and consistently oriented: each directed edge appears once,
+    // along with its opposite
+    std::map<std::pair<uint, uint>, int> edges;
+    double volume = 0;
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        const auto& tri = triangles[t];
+        for (int e = 0; e < 3; ++e) {
+            ++edges[{ tri[e], tri[(e + 1) % 3] }];
+        }
+        const auto &a = vertices[tri[0]], &b = vertices[tri[1]], &c = vertices[tri[2]];
+        volume += (a[0] * (b[1] * c[2] - b[2] * c[1]) - a[1] * (b[0] * c[2] - b[2] * c[0])
+                      + a[2] * (b[0] * c[1] - b[1] * c[0]))
+            / 6.0;
+    }
+    bool manifold = true;
+    for (const auto& [e, count] : edges) {
+        auto opposite = edges.find({ e.second, e.first });
+        manifold = manifold && count == 1 && opposite != edges.end() && opposite->second == 1;
+    }
+    EXPECT_TRUE(manifold);
+
+    // Normals point toward decreasing values, i.e. inward here
+    EXPECT_NEAR(volume, -4.0 / 3.0 * M_PI * 0.125, 5e-3);
+
+    EXPECT_EQ(isosurface(grid, "f", 10.0).triangles().size(), 0);
+}
+
+RUN_TESTS()
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <map>
+#include <dataframe/geo/curvature.h>
+#include <dataframe/geo/mesh/operators.h>
+
+using namespace df;
+
+namespace {
+
+    // Regular n x n grid of [0, 1]^2, two triangles per cell (CCW)
+    Mesh2D grid_mesh(uint n)
+    {
+        Serie<Vector2> vertices;
+        Triangles triangles;
+        for (uint j = 0; j < n; ++j) {
+            for (uint i = 0; i < n; ++i) {
+                // Jitter the interior nodes so that the cotangent weights differ
+                const bool interior = i > 0 && j > 0 && i + 1 < n && j + 1 < n;
+                const double dx = interior ? 0.2 * std::sin(7.0 * i + 3.0 * j) : 0.0;
+                const double dy = interior ? 0.2 * std::cos(5.0 * i + 11.0 * j) : 0.0;
+                vertices.add({ (i + dx) / (n - 1), (j + dy) / (n - 1) });
+            }
+        }
+        for (uint j = 0; j + 1 < n; ++j) {
+            for (uint i = 0; i + 1 < n; ++i) {
+                const uint a = j * n + i;
+                triangles.add({ a, a + 1, a + n + 1 });
+                triangles.add({ a, a + n + 1, a + n });
+            }
+        }
+        return Mesh2D(vertices, triangles);
+    }
+
+    // Subdivided octahedron projected on a sphere, triangles oriented outward
+    std::pair<Positions3, Triangles> sphere(double radius, int refinement)
+    {
+        std::vector<Vector3> vertices { { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 },
+            { 0, 1, 0 }, { 0, -1, 0 } };
+        std::vector<iVector3> triangles { { 0, 2, 4 }, { 0, 5, 2 }, { 0, 3, 5 }, { 0, 4, 3 },
+            { 1, 4, 2 }, { 1, 2, 5 }, { 1, 5, 3 }, { 1, 3, 4 } };
+        for (int r = 0; r < refinement; ++r) {
+            std::map<std::pair<uint, uint>, uint> middles;
+            auto middle = [&](uint a, uint b) {
+                auto [it, inserted] = middles.try_emplace(
+                    { std::min(a, b), std::max(a, b) }, static_cast<uint>(vertices.size()));
+                if (inserted) {
+                    vertices.push_back(normalize((vertices[a] + vertices[b]) * 0.5));
+                }
+                return it->second;
+            };
+            std::vector<iVector3> refined;
+            for (const auto& t : triangles) {
+                const uint a = middle(t[0], t[1]), b = middle(t[1], t[2]), c = middle(t[2], t[0]);
+                refined.insert(refined.end(),
+                    { { t[0], a, c }, { a, t[1], b }, { c, b, t[2] }, { a, b, c } });
+            }
+            triangles = refined;
+        }
+        for (auto& v : vertices) {
+            v = v * radius;
+        }
+        return { Positions3(vertices), Triangles(triangles) };
+    }
+
+    bool interior(uint n, size_t v)
+    {
+        const size_t i = v % n, j = v / n;
+        return i > 0 && j > 0 && i + 1 < n && j + 1 < n;
+    }
+
+} // namespace
+
+TEST(mesh_operators, laplacians)
+{
+    auto mesh = grid_mesh(12);
+    MeshOperators<2> ops(mesh);
+
+    const auto& U = ops.uniformLaplacian();
+    const auto& L = ops.cotanLaplacian();
+    EXPECT_EQ(U.rows(), mesh.vertexCount());
+    EXPECT_EQ(U.nonZeros(), L.nonZeros());
+
+    // Constants are in the kernel of both
+    Serie<double> ones(mesh.vertexCount(), 1.0);
+    ops.laplacian(ones, false).forEach([](double v, size_t) { EXPECT_NEAR(v, 0.0, 1e-12); });
+    ops.laplacian(ones).forEach([](double v, size_t) { EXPECT_NEAR(v, 0.0, 1e-12); });
+
+    // Uniform: minus the number of neighbors on the diagonal. Corner 0 is
+    // linked to 1, n and n + 1.
+    EXPECT_EQ(U(0, 0), -3.0);
+    EXPECT_EQ(U(0, 13), 1.0);
+    EXPECT_EQ(U(0, 2), 0.0);
+
+    // Cotangent: symmetric, and exact for linear functions on a planar mesh
+    Serie<double> linear = mesh.vertices().map([](const Vector2& p, size_t) { return 2.0 * p[0] - 3.0 * p[1]; });
+    auto Lf = ops.laplacian(linear);
+    for (size_t i = 0; i < mesh.vertexCount(); ++i) {
+        if (interior(12, i)) {
+            EXPECT_NEAR(Lf[i], 0.0, 1e-12);
+        }
+        for (size_t k = L.offsets[i]; k < L.offsets[i + 1]; ++k) {
+            EXPECT_NEAR(L.values[k], L(L.columns[k], i), 1e-12);
+        }
+    }
+}
+
+TEST(mesh_operators, mass_and_gradient)
+{
+    auto mesh = grid_mesh(9);
+    MeshOperators<2> ops(mesh);
+
+    double area = 0;
+    ops.massMatrix().forEach([&](double a, size_t) { area += a; });
+    EXPECT_NEAR(area, 1.0, 1e-12);
+
+    Serie<double> linear = mesh.vertices().map([](const Vector2& p, size_t) { return 2.0 * p[0] - 3.0 * p[1]; });
+    auto grad = ops.gradient(linear);
+    EXPECT_EQ(grad.size(), mesh.triangleCount());
+    grad.forEach([](const Vector2& g, size_t) { EXPECT_ARRAY_NEAR(g, Vector2({ 2.0, -3.0 }), 1e-10); });
+}
+
+TEST(mesh_operators, smoothing)
+{
+    auto mesh = grid_mesh(20);
+    MeshOperators<2> ops(mesh);
+
+    Serie<double> noise = mesh.vertices().map([](const Vector2&, size_t i) { return (i * 7919 % 13) / 13.0; });
+    auto variance = [](const Serie<double>& s) {
+        double mean = 0, var = 0;
+        s.forEach([&](double v, size_t) { mean += v; });
+        mean /= s.size();
+        s.forEach([&](double v, size_t) { var += (v - mean) * (v - mean); });
+        return var / s.size();
+    };
+
+    auto smoothed = ops.smooth(noise, 10);
+    EXPECT_LT(variance(smoothed), 0.1 * variance(noise));
+    auto cot = ops.smooth(noise, 10, 0.5, true);
+    EXPECT_LT(variance(cot), 0.1 * variance(noise));
+
+    // Vector values
+    auto positions = ops.smooth(mesh.vertices(), 3);
+    EXPECT_EQ(positions.size(), mesh.vertexCount());
+}
+
+TEST(mesh_operators, sphere)
+{
+    const double radius = 2.0;
+    auto [vertices, triangles] = sphere(radius, 4);
+    MeshOperators<3> ops(vertices, triangles);
+
+    auto H = ops.meanCurvature();
+    auto normals = ops.vertexNormals();
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        EXPECT_NEAR(H[i], 1.0 / radius, 0.05 / radius);
+        EXPECT_NEAR(normals[i].dot(vertices[i]) / radius, 1.0, 1e-3);
+    }
+
+    // Same mean curvature through surface_curvature, reusing the cache
+    auto curvature = surface_curvature(ops);
+    EXPECT_ARRAY_NEAR(curvature.get<double>("mean_curvature").asArray(), H.asArray(), 1e-12);
+
+    // Diffusion preserves the integral of a field over a closed surface
+    Serie<double> u = vertices.map([](const Vector3& p, size_t) { return p[0] * p[0] + p[2]; });
+    auto integral = [&](const Serie<double>& f) {
+        double sum = 0;
+        for (size_t i = 0; i < f.size(); ++i) {
+            sum += ops.massMatrix()[i] * f[i];
+        }
+        return sum;
+    };
+    auto v = ops.diffuse(u, 1e-4, 10);
+    EXPECT_NEAR(integral(v), integral(u), 1e-9);
+}
+
+TEST(mesh_operators, invalidate)
+{
+    Positions3 vertices { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    Triangles triangles { { 0, 2, 1 }, { 0, 1, 3 }, { 0, 3, 2 }, { 1, 2, 3 } };
+    MeshOperators<3> ops(vertices, triangles);
+
+    const double area = ops.massMatrix()[0];
+    const size_t nnz = ops.uniformLaplacian().nonZeros();
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        vertices[i] = vertices[i] * 2.0;
+    }
+    EXPECT_NEAR(ops.massMatrix()[0], area, 1e-15); // cached
+    ops.invalidate();
+    EXPECT_NEAR(ops.massMatrix()[0], 4.0 * area, 1e-12);
+    EXPECT_EQ(ops.uniformLaplacian().nonZeros(), nnz);
+
+    Triangles invalid { { 0, 1, 4 } };
+    MeshOperators<3> bad(vertices, invalid);
+    EXPECT_THROW(bad.uniformLaplacian(), std::out_of_range);
+
+    // Temporaries would leave dangling references
+    static_assert(!std::is_constructible_v<MeshOperators<3>, Positions3, const Triangles&>);
+    static_assert(!std::is_constructible_v<MeshOperators<3>, const Positions3&, Triangles>);
+    static_assert(!std::is_constructible_v<MeshOperators<3>, Positions3, Triangles>);
+    static_assert(!std::is_constructible_v<MeshOperators<3>, Mesh<3>>);
+    static_assert(std::is_constructible_v<MeshOperators<3>, Positions3&, const Triangles&>);
+}
+
+RUN_TESTS()
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <dataframe/geo/interpolation/natural_neighbor.h>
+#include <map>
+#include <random>
+
+using namespace df;
+
+namespace {
+
+    double test_function(double x, double y) { return std::sin(x) * std::cos(y); }
+
+    Serie<Vector2> random_points(size_t n, unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        std::vector<Vector2> points(n);
+        for (auto& p : points) {
+            p = Vector2 { u(gen), u(gen) };
+        }
+        return Serie<Vector2>(std::move(points));
+    }
+
+    Serie<double> linear(const Serie<Vector2>& points)
+    {
+        return points.map([](const Vector2& p, size_t) { return 1.0 + 2.0 * p[0] - 3.0 * p[1]; });
+    }
+
+} // namespace
+
+TEST(NaturalNeighbor, BasicInterpolation)
+{
+    Serie<Vector2> points = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 } };
+    Serie<double> values = { 0.0, 1.0, 1.0, 2.0 };
+    Serie<Vector2> targets = { { 0.5, 0.5 } };
+
+    auto result = natural_neighbor_2d(points, values, targets);
+    EXPECT_NEAR(result[0], 1.0, 1e-10);
+}
+
+TEST(NaturalNeighbor, ExactInterpolation)
+{
+    Serie<Vector2> points = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 }, { 0.5, 0.5 } };
+    Serie<double> values = { 0.0, 1.0, 1.0, 2.0, 1.5 };
+
+    auto result = natural_neighbor_2d(points, values, points);
+    EXPECT_ARRAY_NEAR(result.asArray(), values.asArray(), 1e-10);
+}
+
+TEST(NaturalNeighbor, Continuity)
+{
+    Serie<Vector2> points = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 } };
+    Serie<double> values = { 0.0, 1.0, 1.0, 2.0 };
+
+    double eps = 1e-6;
+    Serie<Vector2> targets = { { 0.5, 0.5 }, { 0.5 + eps, 0.5 + eps } };
+
+    auto result = natural_neighbor_2d(points, values, targets);
+    // The data is linear (f = x + y): the values differ by 2 eps
+    EXPECT_NEAR(result[1] - result[0], 2 * eps, 1e-12);
+}
+
+TEST(NaturalNeighbor, LinearFunction)
+{
+    // f(x,y) = 2x + 3y
+    Serie<Vector2> points = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 } };
+    Serie<double> values = { 0.0, 2.0, 3.0, 5.0 };
+    Serie<Vector2> targets = { { 0.5, 0.5 }, { 0.3, 0.7 }, { 0.8, 0.2 } };
+
+    auto result = natural_neighbor_2d(points, values, targets);
+    EXPECT_NEAR(result[0], 2.5, 1e-10);
+    EXPECT_NEAR(result[1], 2.7, 1e-10);
+    EXPECT_NEAR(result[2], 2.2, 1e-10);
+}
+
+TEST(NaturalNeighbor, LinearReproduction)
+{
+    // Both Sibson and Laplace coordinates reproduce linear functions
+    auto points = random_points(2000, 1);
+    auto values = linear(points);
+    auto targets = random_points(5000, 2).map([](const Vector2& p, size_t) {
+        return Vector2 { 0.05 + 0.9 * p[0], 0.05 + 0.9 * p[1] };
+    });
+    auto expected = linear(targets);
+
+    for (auto method : { NaturalNeighborWeights::Sibson, NaturalNeighborWeights::Laplace }) {
+        auto result = natural_neighbor_2d(points, values, targets, method);
+        EXPECT_ARRAY_NEAR(result.asArray(), expected.asArray(), 1e-9);
+    }
+}
+
+TEST(NaturalNeighbor, SmoothFunction)
+{
+    // Fine enough for the error to be small (5 nodes give 0.25 instead of
+    // 0.5 at the center of the first cell)
+    const int grid_size = 20;
+    Serie<Vector2> points;
+    Serie<double> values;
+    for (int i = 0; i < grid_size; ++i) {
+        for (int j = 0; j < grid_size; ++j) {
+            double x = i * (2.0 * M_PI / (grid_size - 1));
+            double y = j * (2.0 * M_PI / (grid_size - 1));
+            points.add({ x, y });
+            values.add(test_function(x, y));
+        }
+    }
+
+    Serie<Vector2> targets
+        = { { M_PI / 4, M_PI / 4 }, { M_PI / 2, M_PI / 2 }, { 3 * M_PI / 4, 3 * M_PI / 4 } };
+
+    auto result = natural_neighbor_2d(points, values, targets);
+    for (size_t i = 0; i < targets.size(); ++i) {
+        EXPECT_NEAR(result[i], test_function(targets[i][0], targets[i][1]), 0.1);
+    }
+}
+
+TEST(NaturalNeighbor, EdgeCases)
+{
+    Serie<Vector2> points = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 } };
+    Serie<double> values = { 0.0, 1.0, 1.0, 2.0 };
+
+    // Outside the convex hull: NaN
+    Serie<Vector2> targets = { { -0.5, -0.5 }, { 1.5, 1.5 }, { 0.5, 0.0 }, { 1.0, 0.25 } };
+    auto result = natural_neighbor_2d(points, values, targets);
+    EXPECT_TRUE(std::isnan(result[0]));
+    EXPECT_TRUE(std::isnan(result[1]));
+
+    // On the hull: linear along the hull edge
+    EXPECT_NEAR(result[2], 0.5, 1e-12);
+    EXPECT_NEAR(result[3], 1.25, 1e-12);
+
+    // Duplicated points: values are averaged
+    Serie<Vector2> duplicated = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 0.0, 0.0 } };
+    Serie<double> dvalues = { 1.0, 4.0, 4.0, 3.0 };
+    auto d = natural_neighbor_2d(duplicated, dvalues, Serie<Vector2> { { 0.0, 0.0 } });
+    EXPECT_NEAR(d[0], 2.0, 1e-12);
+
+    EXPECT_THROW(natural_neighbor_2d(points, Serie<double> { 1.0 }, targets), std::runtime_error);
+}
+
+TEST(NaturalNeighbor, Collinear)
+{
+    Serie<Vector2> points = { { 0.0, 0.0 }, { 0.5, 0.0 }, { 1.0, 0.0 } };
+    Serie<double> values = { 0.0, 0.5, 1.0 };
+    Serie<Vector2> targets = { { 0.25, 0.0 }, { 0.75, 0.0 }, { 0.5, 1.0 } };
+
+    auto result = natural_neighbor_2d(points, values, targets);
+    EXPECT_NEAR(result[0], 0.25, 1e-10);
+    EXPECT_NEAR(result[1], 0.75, 1e-10);
+    EXPECT_TRUE(std::isnan(result[2]));
+}
+
+TEST(NaturalNeighbor, VectorValues)
+{
+    Serie<Vector2> points = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 } };
+    Serie<Vector3> values = { { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 1, 1, 1 } };
+
+    auto result = natural_neighbor_2d(points, values, Serie<Vector2> { { 0.25, 0.75 } });
+    EXPECT_ARRAY_NEAR(result[0], Vector3({ 0.25, 0.75, 1.0 }), 1e-12);
+}
+
+TEST(NaturalNeighbor, Consistency)
+{
+    Serie<Vector2> points1 = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 1.0, 1.0 } };
+    Serie<Vector2> points2 = { { 1.0, 1.0 }, { 0.0, 1.0 }, { 1.0, 0.0 }, { 0.0, 0.0 } };
+    Serie<double> values1 = { 0.0, 1.0, 1.0, 2.0 };
+    Serie<double> values2 = { 2.0, 1.0, 1.0, 0.0 };
+    Serie<Vector2> targets = { { 0.5, 0.5 }, { 0.2, 0.6 } };
+
+    auto result1 = natural_neighbor_2d(points1, values1, targets);
+    auto result2 = natural_neighbor_2d(points2, values2, targets);
+    EXPECT_ARRAY_NEAR(result1.asArray(), result2.asArray(), 1e-10);
+}
+
+TEST(NaturalNeighbor, Delaunay)
+{
+    // Empty circumcircles, and a triangulation of the whole convex hull
+    auto points = random_points(3000, 3);
+    Delaunay2D dt(points);
+    auto triangles = dt.triangles();
+
+    const auto& p = points.data();
+    double area = 0;
+    for (const auto& t : triangles) {
+        area += 0.5 * detail::dt_orient(p[t[0]], p[t[1]], p[t[2]]);
+    }
+    // Euler: T = 2n - 2 - h, h being the number of hull edges (used once)
+    std::map<std::pair<uint, uint>, int> edges;
+    for (const auto& t : triangles) {
+        for (size_t i = 0; i < 3; ++i) {
+            ++edges[std::minmax(t[i], t[(i + 1) % 3])];
+        }
+    }
+    size_t hull = 0;
+    for (const auto& [edge, count] : edges) {
+        EXPECT_LE(count, 2);
+        hull += count == 1 ? 1 : 0;
+    }
+    EXPECT_EQ(triangles.size(), 2 * points.size() - 2 - hull);
+
+    size_t violations = 0;
+    for (size_t k = 0; k < triangles.size(); k += 7) {
+        const auto& t = triangles[k];
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (i != t[0] && i != t[1] && i != t[2]
+                && detail::dt_incircle(p[t[0]], p[t[1]], p[t[2]], p[i]) > 1e-12) {
+                ++violations;
+            }
+        }
+    }
+    EXPECT_EQ(violations, 0);
+
+    // The triangles cover the convex hull (< 1, close to 1)
+    EXPECT_GT(area, 0.98);
+    EXPECT_LE(area, 1.0);
+}
+
+TEST(NaturalNeighbor, Performance)
+{
+    // Scattered data onto a grid: the walk is warm-started row by row
+    auto points = random_points(100000, 4);
+    Serie<double> values = points.map([](const Vector2& p, size_t) { return test_function(p[0], p[1]); });
+
+    const size_t nx = 500;
+    std::vector<Vector2> nodes;
+    nodes.reserve(nx * nx);
+    for (size_t j = 0; j < nx; ++j) {
+        for (size_t i = 0; i < nx; ++i) {
+            nodes.push_back(Vector2 { 0.01 + 0.98 * i / (nx - 1), 0.01 + 0.98 * j / (nx - 1) });
+        }
+    }
+    Serie<Vector2> targets(std::move(nodes));
+
+    Serie<double> result;
+    double build = 0, query = 0;
+    build = TIMING([&]() {
+        NaturalNeighborInterpolator<double> nn(points, values);
+        query = TIMING([&]() { result = nn.interpolate(targets); });
+    });
+    MSG("Triangulation of ", points.size(), " points + ", targets.size(), " queries: ", build,
+        " ms (queries ", query, " ms)");
+
+    double max_error = 0;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        max_error = std::max(max_error, std::abs(result[i] - test_function(targets[i][0], targets[i][1])));
+    }
+    EXPECT_LT(max_error, 1e-3);
+}
+
+RUN_TESTS()
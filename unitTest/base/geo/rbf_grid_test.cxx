@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <dataframe/geo/grid/rbf_grid.h>
+
+using namespace df;
+
+namespace {
+
+    // Reference: one dense local system per target
+    template <size_t D, typename Point, typename Index>
+    double brute_force(const Point& target, const std::array<double, D>& origin,
+        const std::array<double, D>& spacing, const std::array<int, D>& dims,
+        const Serie<double>& values, Index index, RBFKernel kernel, double epsilon, int radius)
+    {
+        auto fn = get_kernel_function(kernel);
+        const double h = radius * *std::max_element(spacing.begin(), spacing.end());
+        std::array<int, D> node;
+        for (size_t d = 0; d < D; ++d) {
+            node[d] = static_cast<int>(std::round((target[d] - origin[d]) / spacing[d]));
+        }
+
+        std::vector<std::array<double, D>> pts;
+        std::vector<double> vals;
+        std::array<int, D> off;
+        off.fill(-radius);
+        while (true) {
+            std::array<int, D> p;
+            std::array<double, D> x;
+            bool inside = true;
+            double r2 = 0;
+            for (size_t d = 0; d < D; ++d) {
+                p[d] = node[d] + off[d];
+                inside = inside && p[d] >= 0 && p[d] < dims[d];
+                x[d] = origin[d] + p[d] * spacing[d];
+                r2 += (x[d] - target[d]) * (x[d] - target[d]);
+            }
+            if (inside && r2 <= h * h) {
+                pts.push_back(x);
+                vals.push_back(values[index(p)]);
+            }
+            size_t d = 0;
+            while (d < D && ++off[d] > radius) {
+                off[d++] = -radius;
+            }
+            if (d == D) {
+                break;
+            }
+        }
+
+        auto dist = [](const auto& a, const auto& b) {
+            double r2 = 0;
+            for (size_t d = 0; d < D; ++d) {
+                r2 += (a[d] - b[d]) * (a[d] - b[d]);
+            }
+            return std::sqrt(r2);
+        };
+
+        const size_t n = pts.size();
+        Eigen::MatrixXd A(n, n);
+        Eigen::VectorXd b(n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                A(i, j) = fn(dist(pts[i], pts[j]), epsilon);
+            }
+            A(i, i) += 1e-10;
+            b(i) = vals[i];
+        }
+        Eigen::VectorXd w = A.ldlt().solve(b);
+        double sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += w(i) * fn(dist(target, pts[i]), epsilon);
+        }
+        return sum;
+    }
+
+} // namespace
+
+TEST(rbf_grid, grid_2d)
+{
+    Grid2D grid { { 0.0, 0.0 }, { 0.5, 0.25 }, { 40, 30 } };
+    Serie<double> values(grid.total_points());
+    for (uint j = 0; j < 30; ++j) {
+        for (uint i = 0; i < 40; ++i) {
+            const auto p = grid.point_at(i, j);
+            values[grid.linear_index(i, j)] = std::sin(p[0]) * std::cos(2.0 * p[1]);
+        }
+    }
+
+    // Interior, boundary and outside targets
+    Serie<Vector2> targets(2000);
+    for (size_t t = 0; t < targets.size(); ++t) {
+        targets[t] = { -1.0 + 22.0 * std::fmod(t * 0.6180339887, 1.0),
+            -0.5 + 8.5 * std::fmod(t * 0.7548776662, 1.0) };
+    }
+
+    for (auto kernel : { RBFKernel::Multiquadric, RBFKernel::Gaussian, RBFKernel::ThinPlate }) {
+        auto result = rbf_grid_2d(grid, values, targets, kernel, 1.0, 2);
+        for (size_t t = 0; t < targets.size(); ++t) {
+            const auto& x = targets[t];
+            const bool outside = x[0] < -0.75 || x[1] < -0.375 || x[0] > 19.75 || x[1] > 7.375;
+            if (outside) {
+                continue;
+            }
+            const double expected = brute_force<2>(x, { 0.0, 0.0 }, { 0.5, 0.25 }, { 40, 30 },
+                values, [&](auto p) { return grid.linear_index(p[0], p[1]); }, kernel, 1.0, 2);
+            EXPECT_NEAR(result[t], expected, 1e-6 * (1.0 + std::abs(expected)));
+        }
+    }
+
+    // Far outside: nearest grid value
+    auto far = rbf_grid_2d(grid, values, Serie<Vector2> { { 100.0, 100.0 } });
+    EXPECT_NEAR(far[0], values[grid.linear_index(39, 29)], 1e-15);
+
+    EXPECT_THROW(rbf_grid_2d(grid, Serie<double>(10), targets), std::runtime_error);
+}
+
+TEST(rbf_grid, grid_3d)
+{
+    Grid3D grid { { 1.0, 2.0, 3.0 }, { 0.2, 0.2, 0.4 }, { 12, 10, 8 } };
+    Serie<double> values(grid.total_points());
+    for (uint k = 0; k < 8; ++k) {
+        for (uint j = 0; j < 10; ++j) {
+            for (uint i = 0; i < 12; ++i) {
+                const auto p = grid.point_at(i, j, k);
+                values[grid.linear_index(i, j, k)] = p[0] * p[0] - p[1] + 0.5 * p[2];
+            }
+        }
+    }
+
+    Serie<Vector3> targets(500);
+    for (size_t t = 0; t < targets.size(); ++t) {
+        targets[t] = { 1.0 + 2.2 * std::fmod(t * 0.6180339887, 1.0),
+            2.0 + 1.8 * std::fmod(t * 0.7548776662, 1.0),
+            3.0 + 2.8 * std::fmod(t * 0.5698402910, 1.0) };
+    }
+
+    auto result = rbf_grid_3d(grid, values, targets, RBFKernel::InverseMultiquadric, 2.0, 1);
+    for (size_t t = 0; t < targets.size(); ++t) {
+        const double expected = brute_force<3>(targets[t], { 1.0, 2.0, 3.0 }, { 0.2, 0.2, 0.4 },
+            { 12, 10, 8 }, values,
+            [&](auto p) { return grid.linear_index(p[0], p[1], p[2]); },
+            RBFKernel::InverseMultiquadric, 2.0, 1);
+        EXPECT_NEAR(result[t], expected, 1e-6 * (1.0 + std::abs(expected)));
+    }
+}
+
+RUN_TESTS()
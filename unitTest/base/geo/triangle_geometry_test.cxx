@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <dataframe/core/pipe.h>
+#include <dataframe/geo/area.h>
+#include <dataframe/geo/normals.h>
+#include <dataframe/geo/triangle_geometry.h>
+
+using namespace df;
+
+TEST(triangle_geometry, single_3d)
+{
+    Serie<Vector3> vertices { { 0, 0, 0 }, { 2, 0, 0 }, { 0, 2, 0 }, { 1, 1, 0 }, { 3, 3, 0 } };
+    Triangles triangles { { 0, 1, 2 }, { 0, 2, 1 }, { 0, 3, 4 }, { 1, 1, 2 } };
+
+    auto geom = triangle_geometry(vertices, triangles);
+    EXPECT_EQ(geom.get<double>("area").size(), 4);
+
+    auto area = geom.get<double>("area");
+    EXPECT_NEAR(area[0], 2.0, 1e-12);
+    EXPECT_NEAR(area[1], 2.0, 1e-12);
+    EXPECT_NEAR(area[2], 0.0, 1e-12);
+
+    auto normal = geom.get<Vector3>("normal");
+    EXPECT_ARRAY_NEAR(normal[0], Vector3({ 0, 0, 1 }), 1e-12);
+    EXPECT_ARRAY_NEAR(normal[1], Vector3({ 0, 0, -1 }), 1e-12);
+    EXPECT_ARRAY_NEAR(normal[2], Vector3({ 0, 0, 0 }), 1e-12);
+
+    auto centroid = geom.get<Vector3>("centroid");
+    EXPECT_ARRAY_NEAR(centroid[0], Vector3({ 2.0 / 3.0, 2.0 / 3.0, 0 }), 1e-12);
+
+    auto lengths = geom.get<Vector3>("edge_lengths");
+    EXPECT_ARRAY_NEAR(lengths[0], Vector3({ 2, std::sqrt(8.0), 2 }), 1e-12);
+    EXPECT_ARRAY_NEAR(lengths[3], Vector3({ 0, std::sqrt(8.0), std::sqrt(8.0) }), 1e-12);
+
+    // Collinear and repeated vertices are flagged, not thrown
+    auto degenerate = geom.get<bool>("degenerate").asArray();
+    EXPECT_FALSE(degenerate[0]);
+    EXPECT_FALSE(degenerate[1]);
+    EXPECT_TRUE(degenerate[2]);
+    EXPECT_TRUE(degenerate[3]);
+
+    EXPECT_THROW(triangle_geometry(vertices, Triangles { { 0, 1, 5 } }), std::out_of_range);
+}
+
+TEST(triangle_geometry, single_2d)
+{
+    Serie<Vector2> vertices { { 0, 0 }, { 1, 0 }, { 0, 1 } };
+    Triangles triangles { { 0, 2, 1 } };
+
+    auto geom = vertices | bind_triangle_geometry<2>(triangles);
+    EXPECT_FALSE(geom.has("normal"));
+    EXPECT_NEAR(geom.get<double>("area")[0], 0.5, 1e-12);
+    EXPECT_ARRAY_NEAR(geom.get<Vector2>("centroid")[0], Vector2({ 1.0 / 3.0, 1.0 / 3.0 }), 1e-12);
+    EXPECT_FALSE(geom.get<bool>("degenerate").asArray()[0]);
+}
+
+TEST(triangle_geometry, large_mesh)
+{
+    // Wavy grid, large enough to be split in blocks and chunks
+    const uint n = 120;
+    std::vector<Vector3> points;
+    for (uint j = 0; j < n; ++j) {
+        for (uint i = 0; i < n; ++i) {
+            points.push_back({ double(i), double(j), std::sin(0.3 * i) * std::cos(0.2 * j) });
+        }
+    }
+    std::vector<iVector3> cells;
+    for (uint j = 0; j + 1 < n; ++j) {
+        for (uint i = 0; i + 1 < n; ++i) {
+            uint a = j * n + i;
+            cells.push_back({ a, a + 1, a + n + 1 });
+            cells.push_back({ a, a + n + 1, a + n });
+        }
+    }
+    // A few collapsed triangles
+    cells.push_back({ 0, 0, 1 });
+    cells.push_back({ 5, 6, 7 });
+
+    Serie<Vector3> vertices(points);
+    Triangles triangles(cells);
+    auto geom = triangle_geometry(vertices, triangles);
+
+    auto expected_area = area(vertices, triangles);
+    EXPECT_ARRAY_NEAR(geom.get<double>("area").asArray(), expected_area.asArray(), 1e-12);
+
+    auto normal = geom.get<Vector3>("normal");
+    auto degenerate = geom.get<bool>("degenerate").asArray();
+    auto centroid = geom.get<Vector3>("centroid");
+    size_t count = 0;
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const auto& t = triangles[i];
+        Vector3 c = (vertices[t[0]] + vertices[t[1]] + vertices[t[2]]) / 3.0;
+        EXPECT_ARRAY_NEAR(centroid[i], c, 1e-12);
+        if (degenerate[i]) {
+            ++count;
+            continue;
+        }
+        auto expected = detail::triangle_normal<double>(vertices[t[0]], vertices[t[1]], vertices[t[2]]);
+        EXPECT_ARRAY_NEAR(normal[i], expected, 1e-12);
+    }
+    EXPECT_EQ(count, 1);
+    EXPECT_TRUE(degenerate[triangles.size() - 2]);
+}
+
+RUN_TESTS()
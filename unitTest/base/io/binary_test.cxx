@@ -0,0 +1,54 @@
+#include "../../TEST.h"
+#include <dataframe/io/binary_serialization.h>
+#include <sstream>
+
+TEST(IO, Binary_Nulls) {
+    df::Serie<int64_t> ids{1, 2, 3, 4};
+    ids.setNull(2);
+
+    std::stringstream ss;
+    EXPECT_TRUE(df::io::save(ids, ss));
+    auto loaded = df::io::load<int64_t>(ss);
+    EXPECT_ARRAY_EQ(loaded.data(), ids.data());
+    EXPECT_EQ(loaded.nullCount(), 1);
+    EXPECT_TRUE(loaded.isNull(2));
+
+    // Type-erased loading
+    std::stringstream erased;
+    df::io::save(ids, erased);
+    auto serie = std::dynamic_pointer_cast<df::Serie<int64_t>>(df::io::load(erased));
+    EXPECT_TRUE(serie != nullptr);
+    EXPECT_TRUE(serie->isNull(2));
+
+    // Without nulls
+    std::stringstream plain;
+    df::io::save(df::Serie<double>{1.5, 2.5}, plain);
+    EXPECT_FALSE(df::io::load<double>(plain).hasNulls());
+}
+
+TEST(IO, Binary_StringSerie) {
+    df::StringSerie cities{"Paris", "", "Lyon"};
+    cities.addNull();
+
+    // Same format as Serie<std::string>
+    std::stringstream ss;
+    EXPECT_TRUE(df::io::save(cities, ss));
+    auto strings = df::io::load<std::string>(ss);
+    EXPECT_EQ(strings.size(), 4);
+    EXPECT_STREQ(strings[2], "Lyon");
+    EXPECT_TRUE(strings.isNull(3));
+
+    std::stringstream back;
+    df::io::save(strings, back);
+    auto loaded = df::io::load_strings(back);
+    EXPECT_EQ(loaded.size(), 4);
+    EXPECT_STREQ(std::string(loaded[0]), "Paris");
+    EXPECT_TRUE(loaded[1].empty());
+    EXPECT_TRUE(loaded.isNull(3));
+
+    std::stringstream numbers;
+    df::io::save(df::Serie<double>{1.5}, numbers);
+    EXPECT_THROW(df::io::load_strings(numbers), std::runtime_error);
+}
+
+RUN_TESTS()
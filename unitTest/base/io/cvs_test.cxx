@@ -74,4 +74,84 @@ col1,col2,col3
 }
 */
 
+TEST(IO, CSV_Nulls) {
+    std::string csv_content = R"(id,depth,name
+1,10.5,a
+NA,,NA
+3,NA,
+)";
+
+    std::ofstream test_file("test_nulls.csv");
+    test_file << csv_content;
+    test_file.close();
+
+    auto df = df::io::read_csv("test_nulls.csv");
+    const auto &id = df.get<int64_t>("id");
+    const auto &depth = df.get<double>("depth");
+    const auto &name = df.get<std::string>("name");
+    EXPECT_EQ(id.nullCount(), 1);
+    EXPECT_TRUE(id.isNull(1));
+    EXPECT_EQ(id[2], 3);
+    EXPECT_EQ(depth.nullCount(), 2);
+    EXPECT_TRUE(name.isNull(1));
+    EXPECT_FALSE(name.isNull(2));
+
+    // Round trip
+    std::ostringstream os;
+    df::io::write_csv(df, os);
+    EXPECT_STREQ(os.str(), "depth,id,name\n10.5,1,a\nNA,NA,NA\nNA,3,NA\n");
+}
+
+TEST(IO, CSV_StringArena) {
+    std::ofstream test_file("test_arena.csv");
+    test_file << "id,city\n1,Paris\n2,NA\n3,\"Lyon, France\"\n";
+    test_file.close();
+
+    df::io::CSVOptions options;
+    options.string_arena = true;
+    auto df = df::io::read_csv("test_arena.csv", options);
+    const auto &city = df.strings("city");
+    EXPECT_EQ(city.size(), 3);
+    EXPECT_STREQ(std::string(city[0]), "Paris");
+    EXPECT_TRUE(city.isNull(1));
+    EXPECT_EQ(df.get<int64_t>("id")[2], 3);
+
+    std::ostringstream os;
+    df::io::write_csv(df, os);
+    EXPECT_STREQ(os.str(), "city,id\nParis,1\nNA,2\n\"Lyon, France\",3\n");
+}
+
+TEST(IO, CSV_Categorical) {
+    std::ofstream("test_cat1.csv") << "zone,depth\nA,1\nB,2\nA,3\nNA,4\n";
+    std::ofstream("test_cat2.csv") << "zone,depth\nC,5\nA,6\n";
+
+    // Low cardinality columns
+    df::io::CSVOptions options;
+    options.max_categories = 2;
+    auto df = df::io::read_csv("test_cat1.csv", options);
+    const auto &zone = df.categorical("zone");
+    EXPECT_EQ(zone.dictionary()->size(), 2);
+    EXPECT_EQ(zone.code(2), 0);
+    EXPECT_TRUE(zone.isNull(3));
+
+    std::ostringstream os;
+    df::io::write_csv(df, os);
+    EXPECT_STREQ(os.str(), "depth,zone\n1,A\n2,B\n3,A\n4,NA\n");
+
+    options.max_categories = 1;
+    EXPECT_TRUE(
+        df::io::read_csv("test_cat1.csv", options).has<std::string>("zone"));
+
+    // Shared dictionary: the codes are the same in both files
+    df::io::CSVOptions shared;
+    shared.dictionaries["zone"] = std::make_shared<df::Dictionary>();
+    auto first = df::io::read_csv("test_cat1.csv", shared);
+    auto second = df::io::read_csv("test_cat2.csv", shared);
+    EXPECT_TRUE(first.categorical("zone").dictionary() ==
+                second.categorical("zone").dictionary());
+    EXPECT_EQ(second.categorical("zone").code(0), 2);
+    EXPECT_EQ(second.categorical("zone").code(1),
+              first.categorical("zone").code(0));
+}
+
 RUN_TESTS()
\ No newline at end of file
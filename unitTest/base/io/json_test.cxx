@@ -35,4 +35,15 @@ TEST(IO, JSON_Empty) {
     EXPECT_EQ(read_df.size(), 0);
 }
 
+TEST(IO, JSON_StringArena) {
+    df::Dataframe test_df;
+    test_df.add("names", std::make_shared<df::StringSerie>(
+                             df::StringSerie{"John", "Jane"}));
+    df::io::write_json(test_df, "test_arena.json", false);
+
+    auto read_df = df::io::read_json("test_arena.json", true);
+    EXPECT_EQ(read_df.strings("names").size(), 2);
+    EXPECT_STREQ(std::string(read_df.strings("names")[1]), "Jane");
+}
+
 RUN_TESTS()
\ No newline at end of file
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "../TEST.h"
+#include <dataframe/Mask.h>
+#include <dataframe/core/filter.h>
+#include <dataframe/core/parallel_map.h>
+#include <dataframe/core/where.h>
+
+using namespace df;
+
+TEST(mask, basic) {
+    Mask m{true, false, true, true};
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_EQ(m.count(), 3);
+    EXPECT_TRUE(m[0]);
+    EXPECT_FALSE(m.test(1));
+    EXPECT_THROW(m.test(4), std::out_of_range);
+
+    m.set(1);
+    m.set(3, false);
+    EXPECT_ARRAY_EQ(m.indices(), std::vector<size_t>({0, 1, 2}));
+    EXPECT_TRUE(m.any());
+    EXPECT_FALSE(m.all());
+
+    EXPECT_TRUE(Mask(130, true).all());
+    EXPECT_EQ(Mask(130, true).count(), 130);
+    EXPECT_TRUE(Mask(130).none());
+}
+
+TEST(mask, logical) {
+    const size_t n = 200; // more than three words
+    Mask even = Mask::generate(n, [](size_t i) { return i % 2 == 0; });
+    Mask third = Mask::generate(n, [](size_t i) { return i % 3 == 0; });
+
+    // The bits past the size stay cleared
+    EXPECT_EQ((~even).count(), n / 2);
+    EXPECT_EQ((even & third).count(), 34);
+    EXPECT_EQ((even | third).count(), 100 + 67 - 34);
+    EXPECT_EQ((even ^ third).count(), 100 + 67 - 2 * 34);
+    EXPECT_TRUE((even | ~even).all());
+
+    EXPECT_THROW(even & Mask(n + 1), std::runtime_error);
+}
+
+TEST(mask, compare) {
+    Serie<double> x{1, 5, 3, 8, 2};
+    Serie<int> y{2, 4, 3, 9, 1};
+
+    EXPECT_ARRAY_EQ((x > 2.5).indices(), std::vector<size_t>({1, 2, 3}));
+    EXPECT_ARRAY_EQ((x <= 2).indices(), std::vector<size_t>({0, 4}));
+    EXPECT_ARRAY_EQ((x == 3).indices(), std::vector<size_t>({2}));
+    EXPECT_ARRAY_EQ((x < y).indices(), std::vector<size_t>({0, 3}));
+    EXPECT_ARRAY_EQ((x >= y).indices(), std::vector<size_t>({1, 2, 4}));
+    EXPECT_THROW(x < Serie<int>{1}, std::runtime_error);
+
+    // Serie<bool> round trip
+    Serie<bool> b{true, false, true};
+    EXPECT_TRUE(Mask(b) == (Mask{true, false, true}));
+    EXPECT_ARRAY_EQ(Mask(b).toSerie().asArray(), b.asArray());
+}
+
+TEST(mask, filter_where) {
+    Serie<double> x{1, 5, 3, 8, 2};
+    auto m = x > 2.5;
+
+    EXPECT_ARRAY_EQ(filter(m, x).asArray(), std::vector<double>({5, 3, 8}));
+    EXPECT_ARRAY_EQ(where(m, x, Serie<double>(5, 0.0)).asArray(),
+                    std::vector<double>({0, 5, 3, 8, 0}));
+    EXPECT_ARRAY_EQ(where(m, 1, -1).asArray(),
+                    std::vector<int>({-1, 1, 1, 1, -1}));
+    EXPECT_THROW(filter(Mask(2), x), std::runtime_error);
+}
+
+TEST(mask, parallel) {
+    // Large enough to be split between threads
+    const size_t n = 1'000'003;
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<double>((i * 7919) % 1000);
+    }
+    Serie<double> x(values);
+
+    auto m = x >= 500.0;
+    size_t expected = 0;
+    for (double v : values) {
+        expected += v >= 500.0;
+    }
+    EXPECT_EQ(m.count(), expected);
+
+    // parallel_map returning bool writes whole words per thread
+    auto b = parallel_map([](double v, size_t) { return v >= 500.0; }, x);
+    EXPECT_TRUE(Mask(b) == m);
+
+    // The nulls follow the values on the parallel paths
+    Serie<double> y = x;
+    y.setNull(3);
+    x.setNull(n - 1);
+    auto half = parallel_map([](double v, size_t) { return v / 2; }, x);
+    EXPECT_EQ(half.nullCount(), 1);
+    EXPECT_TRUE(half.isNull(n - 1));
+    auto sum = parallel_map(
+        [](double a, double b, size_t) { return a + b; }, x, y);
+    EXPECT_EQ(sum.nullCount(), 2);
+    EXPECT_TRUE(sum.isNull(3));
+    EXPECT_TRUE(sum.isNull(n - 1));
+}
+
+RUN_TESTS();
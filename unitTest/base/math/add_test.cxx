@@ -511,4 +511,20 @@ TEST(add, multiple_operators) {
     EXPECT_ARRAY_EQ(s.asArray(), std::vector<int>({2, 4, 6, 8, 10}));
 }
 
+TEST(add, nulls) {
+    df::Serie<int> a{1, 2, 3, 4};
+    df::Serie<int> b{10, 20, 30, 40};
+    a.setNull(1);
+    b.setNull(3);
+
+    auto result = a + b;
+    EXPECT_ARRAY_EQ(result.dropNulls().data(), std::vector<int>({11, 33}));
+    EXPECT_TRUE(result.isNull(1));
+    EXPECT_TRUE(result.isNull(3));
+
+    auto right = df::Serie<int>{1, 1, 1, 1} + b;
+    EXPECT_EQ(right.nullCount(), 1);
+    EXPECT_TRUE(right.isNull(3));
+}
+
 RUN_TESTS()
\ No newline at end of file
@@ -170,4 +170,17 @@ TEST(NanOperations, MixedOperations) {
     EXPECT_EQ(result[4], 3.0);
 }
 
+TEST(NanOperations, Nulls) {
+    auto serie = df::Serie<int64_t>({10, 0, 0, 40, 50});
+    serie.setNull(1);
+    serie.setNull(2);
+
+    auto linear = df::nan::interpolate(serie);
+    EXPECT_FALSE(linear.hasNulls());
+    EXPECT_ARRAY_EQ(linear.data(), std::vector<int64_t>({10, 20, 30, 40, 50}));
+
+    auto previous = df::nan::interpolate(serie, df::nan::FillMethod::PREVIOUS);
+    EXPECT_ARRAY_EQ(previous.data(), std::vector<int64_t>({10, 10, 10, 40, 50}));
+}
+
 RUN_TESTS();
\ No newline at end of file
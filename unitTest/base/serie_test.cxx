@@ -117,4 +117,85 @@ TEST(serie, size_constructor_edge_cases) {
     }
 }
 
+TEST(serie, type_registry) {
+    static_assert(type_id<double> >= 0);
+    static_assert(type_id<std::vector<double>> == -1);
+    static_assert(type_label<std::string>() == "string");
+
+    EXPECT_STREQ(Serie<double>{}.type(), "double");
+    EXPECT_STREQ(Serie<std::string>{}.type(), "string");
+    EXPECT_STREQ(Serie<Matrix3D>{}.type(), "df::FullMatrix<double, 3>");
+    EXPECT_STREQ(Serie<std::vector<std::string>>{}.type(), "vector<string>");
+
+    Serie<int> ints{1, 2, 3};
+    Serie<Vector3> vectors{{1, 2, 3}};
+    Serie<std::vector<int>> unregistered{{1}};
+
+    auto sum = [](const SerieBase &column) {
+        double result = -1;
+        bool visited = visit(column, [&](const auto &serie) {
+            using T = typename std::decay_t<decltype(serie)>::value_type;
+            if constexpr (std::is_arithmetic_v<T>) {
+                result = 0;
+                for (const auto &v : serie.data()) {
+                    result += v;
+                }
+            } else {
+                result = -2;
+            }
+        });
+        return visited ? result : -3;
+    };
+    EXPECT_EQ(sum(ints), 6);
+    EXPECT_EQ(sum(vectors), -2);
+    EXPECT_EQ(sum(unregistered), -3);
+}
+
+TEST(serie, nulls) {
+    MSG("Testing the validity bitmap of Serie");
+
+    Serie<int64_t> ages{31, 12, 45};
+    EXPECT_FALSE(ages.hasNulls());
+    EXPECT_TRUE(ages.validity().empty());
+
+    ages.setNull(1);
+    ages.add(28);
+    ages.addNull();
+    EXPECT_EQ(ages.size(), 5);
+    EXPECT_EQ(ages.nullCount(), 2);
+    EXPECT_TRUE(ages.isNull(1));
+    EXPECT_TRUE(ages.isValid(3));
+    EXPECT_TRUE(ages.isNull(4));
+    EXPECT_EQ(ages[1], 0);
+    EXPECT_ARRAY_EQ(ages.dropNulls().data(), std::vector<int64_t>({31, 45, 28}));
+    EXPECT_THROW(ages.setNull(5), std::out_of_range);
+
+    // The nulls follow the values
+    auto doubled = ages.map([](int64_t v) { return 2 * v; });
+    EXPECT_EQ(doubled.nullCount(), 2);
+    EXPECT_TRUE(doubled.isNull(4));
+    auto real = ages.as<double>();
+    EXPECT_TRUE(real.isNull(1));
+
+    auto gathered = std::static_pointer_cast<Serie<int64_t>>(ages.gather({3, 1, -1, 0}));
+    EXPECT_ARRAY_EQ(gathered->dropNulls().data(), std::vector<int64_t>({28, 31}));
+    EXPECT_TRUE(gathered->isNull(1));
+    EXPECT_TRUE(gathered->isNull(2));
+
+    auto selected = Mask{false, true, true, true, false}.select(ages);
+    EXPECT_EQ(selected.size(), 3);
+    EXPECT_TRUE(selected.isNull(0));
+    EXPECT_EQ(selected.nullCount(), 1);
+
+    // Floating point nulls hold NaN
+    Serie<double> values{1.0, 2.0};
+    values.addNull();
+    EXPECT_TRUE(std::isnan(values[2]));
+
+    // Marking every value valid again drops the bitmap
+    ages.setValidity(Mask(5, true));
+    EXPECT_TRUE(ages.validity().empty());
+    EXPECT_THROW(ages.setValidity(Mask(3, true)), std::runtime_error);
+}
+
 RUN_TESTS();
\ No newline at end of file
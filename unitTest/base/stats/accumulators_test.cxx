@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <dataframe/core/chunk.h>
+#include <dataframe/core/pipe.h>
+#include <dataframe/stats/accumulators.h>
+#include <dataframe/stats/bins.h>
+#include <dataframe/stats/stats.h>
+
+using namespace df;
+
+TEST(accumulators, moments)
+{
+    Serie<double> values { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 };
+
+    stats::Moments<double> m;
+    m.add(values);
+    EXPECT_EQ(m.count(), 8);
+    EXPECT_NEAR(m.mean(), 5.0, 1e-12);
+    EXPECT_NEAR(m.variance(true), 4.0, 1e-12);
+    EXPECT_NEAR(m.variance(), stats::variance(values), 1e-12);
+    EXPECT_NEAR(m.std_dev(true), 2.0, 1e-12);
+
+    // Chunked and merged must give the same result
+    auto chunks = chunk(3, values);
+    stats::Moments<double> a, b;
+    a.add(chunks[0]);
+    b.add(chunks[1]);
+    b.add(chunks[2]);
+    a.merge(b);
+    EXPECT_EQ(a.count(), 8);
+    EXPECT_NEAR(a.mean(), m.mean(), 1e-12);
+    EXPECT_NEAR(a.variance(), m.variance(), 1e-12);
+    EXPECT_NEAR(a.skewness(), m.skewness(), 1e-12);
+    EXPECT_NEAR(a.kurtosis(), m.kurtosis(), 1e-12);
+
+    // Symmetric data has no skewness
+    stats::Moments<double> sym;
+    sym.add(Serie<double> { 1, 2, 3, 4, 5 });
+    EXPECT_NEAR(sym.skewness(), 0.0, 1e-12);
+    EXPECT_NEAR(sym.kurtosis(), -1.3, 1e-12);
+
+    stats::Moments<double> empty;
+    EXPECT_THROW(empty.mean(), std::runtime_error);
+}
+
+TEST(accumulators, min_max)
+{
+    stats::MinMax<double> mm;
+    mm.add(Serie<double> { 3.0, -1.0, std::nan(""), 8.0 });
+    EXPECT_EQ(mm.count(), 3);
+    EXPECT_EQ(mm.min(), -1.0);
+    EXPECT_EQ(mm.max(), 8.0);
+
+    stats::MinMax<double> other;
+    other.add(-5.0);
+    mm.merge(other);
+    EXPECT_EQ(mm.min(), -5.0);
+    EXPECT_EQ(mm.max(), 8.0);
+
+    EXPECT_THROW(stats::MinMax<int>().max(), std::runtime_error);
+}
+
+TEST(accumulators, covariance_matrix)
+{
+    Serie<double> x { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    Serie<double> y { 5.0, 4.0, 3.0, 2.0, 1.0 };
+
+    stats::CovarianceMatrix<2> cov;
+    cov.add(x, y);
+    EXPECT_NEAR(cov.covariance(0, 1), stats::covariance(x, y), 1e-12);
+    EXPECT_NEAR(cov.covariance(0, 1, false), stats::covariance(x, y, false), 1e-12);
+    EXPECT_NEAR(cov.covariance(0, 0), 2.0, 1e-12);
+    EXPECT_NEAR(cov.correlation(0, 1), -1.0, 1e-12);
+    EXPECT_NEAR(cov.mean(1), 3.0, 1e-12);
+
+    // Same thing from array samples, chunked, through the pipe
+    Serie<std::array<double, 2>> xy { { 1, 5 }, { 2, 4 }, { 3, 3 }, { 4, 2 }, { 5, 1 } };
+    auto acc = xy | bind_chunk<std::array<double, 2>>(2)
+        | stats::bind_accumulate(stats::CovarianceMatrix<2>());
+    auto m = acc.matrix();
+    EXPECT_NEAR(m[0][1], -2.0, 1e-12);
+    EXPECT_NEAR(m[1][0], -2.0, 1e-12);
+    EXPECT_NEAR(m[1][1], 2.0, 1e-12);
+
+    // Multi-Serie chunks
+    auto acc2 = stats::accumulate(chunk(2, x, y), stats::CovarianceMatrix<2>());
+    EXPECT_NEAR(acc2.covariance(0, 1), -2.0, 1e-12);
+}
+
+TEST(accumulators, histogram)
+{
+    Serie<double> data { -1.0, 0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 10.0 };
+    auto expected = stats::bins(data, 5, 0.0, 5.0);
+
+    auto h = stats::accumulate(chunk(3, data), stats::Histogram<double>(5, 0.0, 5.0));
+    EXPECT_ARRAY_EQ(h.counts().asArray(), expected.asArray());
+    EXPECT_EQ(h.count(), data.size());
+
+    stats::Histogram<double> other(4, 0.0, 5.0);
+    EXPECT_THROW(h.merge(other), std::invalid_argument);
+    EXPECT_THROW(stats::Histogram<double>(0, 0.0, 1.0), std::invalid_argument);
+
+    // Integral values: bin widths are not truncated
+    stats::Histogram<int> hi(3, 0, 10);
+    hi.add(Serie<int> { 0, 3, 4, 6, 7, 9, 10, 12 });
+    EXPECT_ARRAY_EQ(hi.counts().asArray(), std::vector<size_t>({ 2, 2, 4 }));
+
+    // More bins than integers in the range
+    stats::Histogram<int> wide(20, 0, 10);
+    wide.add(Serie<int> { 0, 1, 9 });
+    EXPECT_EQ(wide.counts()[0], size_t(1));
+    EXPECT_EQ(wide.counts()[2], size_t(1));
+    EXPECT_EQ(wide.counts()[18], size_t(1));
+
+    // NaN values are skipped, infinities go in the outer bins
+    stats::Histogram<double> hn(4, 0.0, 4.0);
+    hn.add(Serie<double> { NAN, 1.5, -INFINITY, INFINITY, NAN });
+    EXPECT_ARRAY_EQ(hn.counts().asArray(), std::vector<size_t>({ 1, 1, 0, 1 }));
+    EXPECT_EQ(hn.count(), size_t(3));
+}
+
+TEST(accumulators, quantile_sketch)
+{
+    // Exact for small inputs
+    Serie<double> small { 9.0, 1.0, 5.0, 3.0, 7.0, 2.0, 8.0, 4.0, 6.0 };
+    stats::QuantileSketch<double> exact;
+    exact.add(small);
+    EXPECT_NEAR(exact.quantile(0.25), stats::quantile(small, 0.25), 1e-12);
+    EXPECT_NEAR(exact.median(), stats::median(small), 1e-12);
+
+    // Approximate for large inputs, merged from several sketches
+    const size_t n = 100000;
+    Serie<double> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<double>((i * 7919) % n);
+    }
+    auto sketch = stats::parallel_accumulate(values, stats::QuantileSketch<double>(128));
+    EXPECT_EQ(sketch.count(), n);
+    EXPECT_LT(sketch.retained(), 4000);
+    EXPECT_NEAR(sketch.quantile(0.5), n / 2.0, n * 0.02);
+    EXPECT_NEAR(sketch.quantile(0.9), n * 0.9, n * 0.02);
+    EXPECT_EQ(sketch.quantile(0.0), 0.0);
+    EXPECT_EQ(sketch.quantile(1.0), static_cast<double>(n - 1));
+
+    EXPECT_THROW(sketch.quantile(1.5), std::runtime_error);
+}
+
+TEST(accumulators, distinct_count)
+{
+    Serie<int> values(50000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i % 20000);
+    }
+
+    auto dc = stats::parallel_accumulate(values, stats::DistinctCount<int>());
+    EXPECT_EQ(dc.count(), 50000);
+    EXPECT_NEAR(dc.estimate(), 20000.0, 20000.0 * 0.05);
+
+    stats::DistinctCount<int> few;
+    few.add(Serie<int> { 1, 2, 3, 1, 2, 3 });
+    EXPECT_NEAR(few.estimate(), 3.0, 0.1);
+
+    EXPECT_THROW(few.merge(stats::DistinctCount<int>(10)), std::invalid_argument);
+}
+
+TEST(accumulators, parallel)
+{
+    const size_t n = 200000;
+    Serie<double> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = std::sin(static_cast<double>(i)) * 10.0 + 3.0;
+    }
+
+    auto seq = stats::accumulate(values, stats::Moments<double>());
+    auto par = stats::parallel_accumulate(values, stats::Moments<double>());
+    EXPECT_EQ(par.count(), n);
+    EXPECT_NEAR(par.mean(), seq.mean(), 1e-9);
+    EXPECT_NEAR(par.variance(), stats::variance(values), 1e-9);
+
+    auto piped = values | stats::bind_accumulate(stats::MinMax<double>());
+    EXPECT_NEAR(piped.max(), 13.0, 1e-6);
+}
+
+RUN_TESTS()
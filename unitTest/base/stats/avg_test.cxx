@@ -115,4 +115,18 @@ TEST(avg, pipeline) {
     EXPECT_ARRAY_NEAR(vec_result, std::vector<double>({2.0, 3.0}), 1e-10);
 }
 
+TEST(avg, nulls) {
+    MSG("Testing that mean and variance skip the nulls");
+
+    Serie<int64_t> data{2, 1000, 4, 6};
+    data.setNull(1);
+    EXPECT_EQ(df::stats::mean(data), 4);
+    EXPECT_NEAR(df::stats::variance(data), 4.0, 1e-10);
+    EXPECT_NEAR(df::stats::variance(data, true), 8.0 / 3.0, 1e-10);
+
+    Serie<double> none{1.0};
+    none.setNull(0);
+    EXPECT_THROW(df::stats::avg(none), std::runtime_error);
+}
+
 RUN_TESTS()
\ No newline at end of file
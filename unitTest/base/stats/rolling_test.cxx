@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <dataframe/core/pipe.h>
+#include <dataframe/stats/moving_avg.h>
+#include <dataframe/stats/rolling.h>
+#include <dataframe/stats/stats.h>
+
+using namespace df;
+using stats::WindowAlignment;
+
+namespace {
+
+    // Brute-force reference: apply `stat` on every window [lo, hi)
+    template <typename F>
+    std::vector<double> brute_force(const Serie<double>& s, size_t before, size_t after, F stat)
+    {
+        std::vector<double> result(s.size());
+        for (size_t i = 0; i < s.size(); ++i) {
+            size_t lo = i >= before ? i - before : 0;
+            size_t hi = std::min(s.size(), i + after + 1);
+            std::vector<double> window(s.data().begin() + lo, s.data().begin() + hi);
+            result[i] = stat(Serie<double>(window));
+        }
+        return result;
+    }
+
+    Serie<double> signal(size_t n)
+    {
+        Serie<double> s(n);
+        for (size_t i = 0; i < n; ++i) {
+            s[i] = std::sin(0.1 * i) * 10.0 + static_cast<double>((i * 37) % 11);
+        }
+        return s;
+    }
+
+} // namespace
+
+TEST(rolling, mean)
+{
+    Serie<double> series { 1.0, 2.0, 3.0, 4.0, 5.0 };
+
+    auto trailing = stats::rolling_mean(series, 3);
+    EXPECT_ARRAY_EQ(trailing.asArray(), std::vector<double>({ 1.0, 1.5, 2.0, 3.0, 4.0 }));
+
+    auto centered = stats::rolling_mean(series, 3, WindowAlignment::CENTERED);
+    EXPECT_ARRAY_EQ(centered.asArray(), std::vector<double>({ 1.5, 2.0, 3.0, 4.0, 4.5 }));
+
+    auto s = signal(3000);
+    auto expected = brute_force(s, 50, 49, [](const Serie<double>& w) { return stats::mean(w); });
+    auto actual = stats::rolling_mean(s, 100, WindowAlignment::CENTERED);
+    EXPECT_ARRAY_NEAR(actual.asArray(), expected, 1e-9);
+
+    EXPECT_THROW(stats::rolling_mean(Serie<double>(), 3), std::runtime_error);
+    EXPECT_THROW(stats::rolling_mean(series, 0), std::runtime_error);
+}
+
+TEST(rolling, variance)
+{
+    auto s = signal(2500);
+    auto expected
+        = brute_force(s, 19, 0, [](const Serie<double>& w) { return stats::variance(w); });
+    auto actual = stats::rolling_variance(s, 20);
+    EXPECT_ARRAY_NEAR(actual.asArray(), expected, 1e-8);
+
+    auto sd = stats::rolling_std(s, 20, true, WindowAlignment::CENTERED);
+    auto expected_sd
+        = brute_force(s, 10, 9, [](const Serie<double>& w) { return stats::std_dev(w, true); });
+    EXPECT_ARRAY_NEAR(sd.asArray(), expected_sd, 1e-8);
+}
+
+TEST(rolling, non_finite)
+{
+    // A NaN or an Inf only affects the windows holding it
+    auto same = [](const Serie<double>& actual, const std::vector<double>& expected) {
+        EXPECT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (std::isnan(expected[i])) {
+                EXPECT_TRUE(std::isnan(actual[i]));
+            } else {
+                EXPECT_EQ(actual[i], expected[i]);
+            }
+        }
+    };
+    const double inf = INFINITY;
+
+    Serie<double> holes { 1.0, 2.0, NAN, 4.0, 5.0, 6.0, 7.0, 8.0 };
+    same(stats::moving_avg(holes, 2), { 1.0, 1.5, NAN, NAN, 4.5, 5.5, 6.5, 7.5 });
+    same(stats::rolling_mean(holes, 2), { 1.0, 1.5, NAN, NAN, 4.5, 5.5, 6.5, 7.5 });
+
+    Serie<double> spikes { 1.0, inf, -inf, 2.0, 3.0, 4.0 };
+    same(stats::rolling_mean(spikes, 2), { 1.0, inf, NAN, -inf, 2.5, 3.5 });
+    same(stats::rolling_mean(spikes, 3), { 1.0, inf, NAN, NAN, -inf, 3.0 });
+
+    same(stats::rolling_variance(holes, 2), { 0.0, 0.5, NAN, NAN, 0.5, 0.5, 0.5, 0.5 });
+    same(stats::rolling_variance(spikes, 2, true), { 0.0, NAN, NAN, NAN, 0.25, 0.25 });
+}
+
+TEST(rolling, min_max)
+{
+    Serie<double> series { 3.0, 1.0, 4.0, 1.0, 5.0, 9.0, 2.0, 6.0 };
+    auto mn = stats::rolling_min(series, 3);
+    auto mx = stats::rolling_max(series, 3);
+    EXPECT_ARRAY_EQ(mn.asArray(), std::vector<double>({ 3, 1, 1, 1, 1, 1, 2, 2 }));
+    EXPECT_ARRAY_EQ(mx.asArray(), std::vector<double>({ 3, 3, 4, 4, 5, 9, 9, 9 }));
+
+    auto s = signal(4000);
+    auto expected = brute_force(s, 64, 63, [](const Serie<double>& w) {
+        return *std::max_element(w.begin(), w.end());
+    });
+    auto actual = stats::rolling_max(s, 128, WindowAlignment::CENTERED);
+    EXPECT_ARRAY_EQ(actual.asArray(), expected);
+
+    auto piped = series | stats::bind_rolling_min<double>(2);
+    EXPECT_ARRAY_EQ(piped.asArray(), std::vector<double>({ 3, 1, 1, 1, 1, 5, 2, 2 }));
+}
+
+TEST(rolling, quantile)
+{
+    Serie<double> series { 5.0, 1.0, 4.0, 2.0, 3.0 };
+    auto med = stats::rolling_median(series, 3);
+    EXPECT_ARRAY_EQ(med.asArray(), std::vector<double>({ 5.0, 3.0, 4.0, 2.0, 3.0 }));
+
+    auto s = signal(3000);
+    for (double q : { 0.0, 0.1, 0.5, 0.75, 1.0 }) {
+        auto expected
+            = brute_force(s, 30, 0, [q](const Serie<double>& w) { return stats::quantile(w, q); });
+        auto actual = stats::rolling_quantile(s, 31, q);
+        EXPECT_ARRAY_NEAR(actual.asArray(), expected, 1e-9);
+    }
+
+    EXPECT_THROW(stats::rolling_quantile(s, 3, 1.5), std::runtime_error);
+
+    // NaN values are skipped
+    Serie<double> holes { 1.0, 2.0, NAN, 4.0, NAN, NAN, 7.0 };
+    auto mh = stats::rolling_median(holes, 3);
+    EXPECT_ARRAY_EQ(mh.asArray(), std::vector<double>({ 1.0, 1.5, 1.5, 3.0, 4.0, 4.0, 7.0 }));
+    auto only_nan = stats::rolling_median(holes, 2);
+    EXPECT_TRUE(std::isnan(only_nan[5]));
+    EXPECT_EQ(only_nan[6], 7.0);
+}
+
+TEST(rolling, array_types)
+{
+    Serie<Vector2> points { { 1.0, 10.0 }, { 3.0, 8.0 }, { 5.0, 6.0 }, { 7.0, 4.0 } };
+
+    auto mean = stats::rolling_mean(points, 2);
+    EXPECT_ARRAY_NEAR(mean[1], Vector2({ 2.0, 9.0 }), 1e-12);
+    EXPECT_ARRAY_NEAR(mean[3], Vector2({ 6.0, 5.0 }), 1e-12);
+
+    auto mn = stats::rolling_min(points, 3);
+    EXPECT_ARRAY_NEAR(mn[3], Vector2({ 3.0, 4.0 }), 1e-12);
+
+    auto var = stats::rolling_variance(points, 2, true);
+    EXPECT_ARRAY_NEAR(var[2], (std::array<double, 2> { 1.0, 1.0 }), 1e-12);
+
+    auto med = stats::rolling_median(points, 3);
+    EXPECT_ARRAY_NEAR(med[2], (std::array<double, 2> { 3.0, 8.0 }), 1e-12);
+}
+
+TEST(rolling, time_window)
+{
+    Serie<double> values { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    Serie<double> times { 0.0, 0.5, 1.0, 3.0, 3.2, 10.0 };
+
+    // (t - 1, t]
+    auto mean = stats::rolling_mean(values, stats::time_window(times, 1.0));
+    EXPECT_ARRAY_NEAR(mean.asArray(), std::vector<double>({ 1.0, 1.5, 2.5, 4.0, 4.5, 6.0 }), 1e-12);
+
+    // [t - 1, t + 1]
+    auto centered
+        = stats::rolling_max(values, stats::time_window(times, 2.0), WindowAlignment::CENTERED);
+    EXPECT_ARRAY_EQ(centered.asArray(), std::vector<double>({ 3, 3, 3, 5, 5, 6 }));
+
+    Serie<double> unsorted { 0.0, 2.0, 1.0, 3.0, 4.0, 5.0 };
+    EXPECT_THROW(stats::rolling_mean(values, stats::time_window(unsorted, 1.0)), std::runtime_error);
+    EXPECT_THROW(stats::rolling_mean(values, stats::time_window(Serie<double> { 1.0 }, 1.0)),
+        std::runtime_error);
+}
+
+RUN_TESTS()
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include "../../TEST.h"
+#include <cmath>
+#include <dataframe/stats/variogram.h>
+#include <random>
+
+using namespace df;
+
+namespace {
+
+    template <typename Vec>
+    stats::ExperimentalVariogram brute_force(const Serie<Vec>& positions,
+        const Serie<double>& values, const stats::VariogramOptions& options)
+    {
+        constexpr size_t D = std::tuple_size<Vec>::value;
+        std::vector<double> g(options.n_lags, 0.0), dist(options.n_lags, 0.0);
+        std::vector<uint64_t> count(options.n_lags, 0);
+        double dn = 0;
+        for (size_t d = 0; d < D; ++d) {
+            dn += options.direction[d] * options.direction[d];
+        }
+        for (size_t i = 0; i < positions.size(); ++i) {
+            for (size_t j = i + 1; j < positions.size(); ++j) {
+                double d2 = 0, proj = 0;
+                for (size_t d = 0; d < D; ++d) {
+                    double h = positions[j][d] - positions[i][d];
+                    d2 += h * h;
+                    proj += h * options.direction[d];
+                }
+                double h = std::sqrt(d2);
+                if (dn > 0 && std::abs(proj) < std::cos(options.angle_tolerance) * h * std::sqrt(dn)) {
+                    continue;
+                }
+                size_t lag = static_cast<size_t>(h / options.lag_distance);
+                if (lag < options.n_lags) {
+                    double dv = values[i] - values[j];
+                    g[lag] += 0.5 * dv * dv;
+                    dist[lag] += h;
+                    ++count[lag];
+                }
+            }
+        }
+        for (size_t k = 0; k < options.n_lags; ++k) {
+            if (count[k] > 0) {
+                g[k] /= count[k];
+                dist[k] /= count[k];
+            }
+        }
+        return { Serie<double>(dist), Serie<double>(g), Serie<uint64_t>(count), Serie<double>() };
+    }
+
+    // Smooth field plus noise, sampled at random positions in [0, size]^2
+    void dataset(size_t n, double size, Serie<Vector2>& positions, Serie<double>& values)
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> u(0.0, size);
+        std::normal_distribution<double> noise(0.0, 0.1);
+        std::vector<Vector2> p(n);
+        std::vector<double> v(n);
+        for (size_t i = 0; i < n; ++i) {
+            p[i] = { u(rng), u(rng) };
+            v[i] = std::sin(p[i][0] / 7.0) + std::cos(p[i][1] / 11.0) + noise(rng);
+        }
+        positions = Serie<Vector2>(p);
+        values = Serie<double>(v);
+    }
+
+} // namespace
+
+TEST(variogram, exhaustive)
+{
+    Serie<Vector2> positions;
+    Serie<double> values;
+    dataset(3000, 100.0, positions, values);
+
+    stats::VariogramOptions options;
+    options.lag_distance = 2.5;
+    options.n_lags = 12;
+
+    auto vario = stats::experimental_variogram(positions, values, options);
+    auto expected = brute_force(positions, values, options);
+    EXPECT_ARRAY_EQ(vario.counts.asArray(), expected.counts.asArray());
+    EXPECT_ARRAY_NEAR(vario.values.asArray(), expected.values.asArray(), 1e-10);
+    EXPECT_ARRAY_NEAR(vario.distances.asArray(), expected.distances.asArray(), 1e-10);
+
+    // Spatially correlated field: the semivariance grows with the lag
+    EXPECT_LT(vario.values[0], vario.values[11]);
+    EXPECT_GT(vario.std_errors[5], 0.0);
+
+    // 3D, with empty lags
+    Serie<Vector3> p3 { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 0, 2 }, { 0, 3, 3 } };
+    Serie<double> v3 { 1, 2, 4, 8 };
+    options.lag_distance = 1;
+    options.n_lags = 6;
+    auto v = stats::experimental_variogram(p3, v3, options);
+    auto e = brute_force(p3, v3, options);
+    EXPECT_ARRAY_EQ(v.counts.asArray(), e.counts.asArray());
+    EXPECT_ARRAY_NEAR(v.values.asArray(), e.values.asArray(), 1e-12);
+    EXPECT_EQ(v.counts[5], 0);
+    EXPECT_EQ(v.values[5], 0.0);
+}
+
+TEST(variogram, directional)
+{
+    // The field only varies along x
+    std::vector<Vector2> p;
+    std::vector<double> v;
+    for (size_t j = 0; j < 40; ++j) {
+        for (size_t i = 0; i < 40; ++i) {
+            p.push_back({ double(i), double(j) });
+            v.push_back(std::sin(0.3 * i));
+        }
+    }
+    Serie<Vector2> positions(p);
+    Serie<double> values(v);
+
+    stats::VariogramOptions options;
+    options.lag_distance = 1.5;
+    options.n_lags = 8;
+    options.angle_tolerance = 0.05;
+
+    options.direction = { 0, 1, 0 };
+    auto along_y = stats::experimental_variogram(positions, values, options);
+    auto expected = brute_force(positions, values, options);
+    EXPECT_ARRAY_EQ(along_y.counts.asArray(), expected.counts.asArray());
+    for (size_t k = 0; k < options.n_lags; ++k) {
+        EXPECT_NEAR(along_y.values[k], 0.0, 1e-12);
+    }
+
+    options.direction = { 2, 0, 0 };
+    auto along_x = stats::experimental_variogram(positions, values, options);
+    expected = brute_force(positions, values, options);
+    EXPECT_ARRAY_EQ(along_x.counts.asArray(), expected.counts.asArray());
+    EXPECT_ARRAY_NEAR(along_x.values.asArray(), expected.values.asArray(), 1e-12);
+    EXPECT_GT(along_x.values[2], 0.1);
+}
+
+TEST(variogram, monte_carlo)
+{
+    Serie<Vector2> positions;
+    Serie<double> values;
+    dataset(40000, 400.0, positions, values);
+
+    stats::VariogramOptions options;
+    options.lag_distance = 3;
+    options.n_lags = 10;
+    auto exact = stats::experimental_variogram(positions, values, options);
+
+    options.sample_size = 4000;
+    auto sampled = stats::experimental_variogram(positions, values, options);
+    for (size_t k = 0; k < options.n_lags; ++k) {
+        EXPECT_GT(sampled.std_errors[k], 0.0);
+        EXPECT_LT(std::abs(sampled.values[k] - exact.values[k]), 5 * sampled.std_errors[k]);
+    }
+    // About 2 * 4000 / 40000 of the pairs
+    EXPECT_NEAR(double(sampled.counts[5]) / double(exact.counts[5]), 0.2, 0.02);
+
+    // Reproducible
+    auto again = stats::experimental_variogram(positions, values, options);
+    EXPECT_ARRAY_EQ(again.values.asArray(), sampled.values.asArray());
+}
+
+TEST(variogram, errors)
+{
+    Serie<Vector2> positions { { 0, 0 }, { 1, 1 } };
+    stats::VariogramOptions options;
+    EXPECT_THROW(stats::experimental_variogram(positions, Serie<double> { 1.0 }, options),
+        std::runtime_error);
+    options.lag_distance = 0;
+    EXPECT_THROW(stats::experimental_variogram(positions, Serie<double> { 1.0, 2.0 }, options),
+        std::runtime_error);
+
+    options.lag_distance = 1;
+    auto empty = stats::experimental_variogram(Serie<Vector2>(), Serie<double>(), options);
+    EXPECT_EQ(empty.values.size(), 10);
+    EXPECT_EQ(empty.counts[0], 0);
+}
+
+RUN_TESTS()
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024-now fmaerten@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "../TEST.h"
+#include <dataframe/Dataframe.h>
+#include <dataframe/StringSerie.h>
+#include <dataframe/core/sort.h>
+#include <dataframe/core/unique.h>
+
+using namespace df;
+
+TEST(stringSerie, basic) {
+    StringSerie s{"Paris", "", "Lyon"};
+    EXPECT_EQ(s.size(), 3);
+    EXPECT_STREQ(std::string(s[0]), "Paris");
+    EXPECT_TRUE(s[1].empty());
+    EXPECT_THROW(s[3], std::out_of_range);
+
+    // One contiguous buffer
+    EXPECT_EQ(s.bytes().size(), 9);
+    EXPECT_ARRAY_EQ(s.offsets(), std::vector<StringSerie::Offset>({0, 5, 5, 9}));
+
+    s.addNull();
+    EXPECT_EQ(s.size(), 4);
+    EXPECT_EQ(s.nullCount(), 1);
+    EXPECT_TRUE(s.isNull(3));
+    EXPECT_FALSE(s.isNull(1));
+
+    // Conversions
+    Serie<std::string> strings = s.toSerie();
+    EXPECT_EQ(strings.size(), 4);
+    EXPECT_STREQ(strings[2], "Lyon");
+    EXPECT_TRUE(strings.isNull(3));
+    StringSerie back(strings);
+    EXPECT_TRUE(back.isNull(3));
+    EXPECT_STREQ(std::string(back[0]), "Paris");
+}
+
+TEST(stringSerie, gather) {
+    StringSerie s{"a", "bb", "ccc", "dd"};
+
+    auto gathered =
+        std::dynamic_pointer_cast<StringSerie>(s.gather({3, 0, -1}));
+    EXPECT_TRUE(gathered != nullptr);
+    EXPECT_EQ(gathered->size(), 3);
+    EXPECT_STREQ(std::string((*gathered)[0]), "dd");
+    EXPECT_STREQ(std::string((*gathered)[1]), "a");
+    EXPECT_TRUE(gathered->isNull(2));
+
+    auto selected = s.select(Mask{false, true, true, false});
+    EXPECT_EQ(selected.size(), 2);
+    EXPECT_STREQ(std::string(selected[1]), "ccc");
+
+    Dataframe frame;
+    frame.add("name", std::make_shared<StringSerie>(s));
+    frame.add("id", Serie<int64_t>{1, 2, 3, 4});
+    auto rows = frame.filter_rows(Mask{true, false, false, true});
+    EXPECT_EQ(rows.strings("name").size(), 2);
+    EXPECT_STREQ(std::string(rows.strings("name")[1]), "dd");
+    EXPECT_THROW(frame.strings("id"), std::runtime_error);
+}
+
+TEST(stringSerie, sort_unique) {
+    StringSerie s{"pear", "apple", "fig", "apple"};
+    s.addNull();
+
+    auto order = argsort(s);
+    EXPECT_ARRAY_EQ(order.data(), std::vector<uint32_t>({1, 3, 2, 0, 4}));
+
+    auto sorted = sort(s, SortOrder::DESCENDING);
+    EXPECT_STREQ(std::string(sorted[0]), "pear");
+    EXPECT_STREQ(std::string(sorted[3]), "apple");
+    EXPECT_TRUE(sorted.isNull(4)); // nulls last
+
+    auto distinct = unique(s);
+    EXPECT_EQ(distinct.size(), 4);
+    EXPECT_STREQ(std::string(distinct[0]), "pear");
+    EXPECT_STREQ(std::string(distinct[2]), "fig");
+    EXPECT_TRUE(distinct.isNull(3));
+}
+
+RUN_TESTS();